@@ -8,9 +8,13 @@
 
 #include <spdlog/spdlog.h>
 #include <boost/asio/ip/tcp.hpp>
+#include <boost/optional.hpp>
+#include <chrono>
 #include <memory>
 #include <string>
 
+#include "storage/leveldb/leveldb_profile.hpp"
+
 namespace kagome::application {
 
   /**
@@ -24,6 +28,22 @@ namespace kagome::application {
       kFullSyncing,
     };
 
+    /// storage of trie nodes
+    enum struct TrieBackend {
+      /// prefixed keys in the common leveldb
+      kLevelDb,
+      /// memory-mapped append-only segment files
+      kMmap,
+    };
+
+    /// execution of the runtime code
+    enum struct WasmExecution {
+      /// binaryen interpreter
+      kInterpreted,
+      /// binaryen interpreter, the code being optimized by binaryen passes
+      kOptimized,
+    };
+
    public:
     virtual ~AppConfiguration() = default;
 
@@ -42,6 +62,38 @@ namespace kagome::application {
      */
     virtual const std::string &leveldb_path() const = 0;
 
+    /**
+     * @return number of the last finalized blocks, whose states are kept in
+     * the storage, or none if all states are kept (archive mode).
+     */
+    virtual const boost::optional<uint32_t> &state_pruning_window() const = 0;
+
+    /**
+     * @return storage of trie nodes.
+     */
+    virtual TrieBackend trie_backend() const = 0;
+
+    /**
+     * @return tuning of the leveldb with blocks, headers and other data.
+     */
+    virtual const storage::LevelDbProfile &leveldb_profile() const = 0;
+
+    /**
+     * @return tuning of the leveldb with trie nodes.
+     */
+    virtual const storage::LevelDbProfile &trie_leveldb_profile() const = 0;
+
+    /**
+     * @return period of logging leveldb statistics, zero if they are not
+     * logged.
+     */
+    virtual std::chrono::seconds leveldb_stats_period() const = 0;
+
+    /**
+     * @return execution of the runtime code.
+     */
+    virtual WasmExecution wasm_execution() const = 0;
+
     /**
      * @return port for peer to peer interactions.
      */
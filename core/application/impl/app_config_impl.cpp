@@ -28,6 +28,16 @@ namespace {
   const int def_verbosity = 2;
   const bool def_is_only_finalizing = false;
   const bool def_is_already_synchronized = false;
+  const uint32_t def_state_pruning_window = 256;
+  const std::string kStatePruningArchive = "archive";
+  const std::string kTrieBackendLevelDb = "leveldb";
+  const std::string kTrieBackendMmap = "mmap";
+  const std::string kCompressionSnappy = "snappy";
+  const std::string kCompressionNone = "none";
+  const uint32_t def_leveldb_stats_period = 600;
+  const std::string kWasmExecutionInterpreted = "interpreted";
+  const std::string kWasmExecutionOptimized = "optimized";
+  constexpr size_t kMiB = 1024 * 1024;
 }  // namespace
 
 namespace kagome::application {
@@ -38,6 +48,12 @@ namespace kagome::application {
         rpc_ws_host_(def_rpc_ws_host),
         rpc_http_port_(def_rpc_http_port),
         rpc_ws_port_(def_rpc_ws_port),
+        state_pruning_window_(def_state_pruning_window),
+        trie_backend_(TrieBackend::kLevelDb),
+        leveldb_profile_(storage::LevelDbProfile::blocks()),
+        trie_leveldb_profile_(storage::LevelDbProfile::trieNodes()),
+        leveldb_stats_period_(def_leveldb_stats_period),
+        wasm_execution_(WasmExecution::kInterpreted),
         p2p_port_(def_p2p_port),
         verbosity_(static_cast<spdlog::level::level_enum>(def_verbosity)),
         is_only_finalizing_(def_is_only_finalizing),
@@ -61,6 +77,17 @@ namespace kagome::application {
     return false;
   }
 
+  bool AppConfigurationImpl::load_u32(const rapidjson::Value &val,
+                                      char const *name,
+                                      uint32_t &target) {
+    auto m = val.FindMember(name);
+    if (val.MemberEnd() != m && m->value.IsUint()) {
+      target = m->value.GetUint();
+      return true;
+    }
+    return false;
+  }
+
   bool AppConfigurationImpl::load_bool(const rapidjson::Value &val,
                                        char const *name,
                                        bool &target) {
@@ -88,6 +115,106 @@ namespace kagome::application {
     return false;
   }
 
+  bool AppConfigurationImpl::parse_state_pruning(const std::string &str) {
+    if (str == kStatePruningArchive) {
+      state_pruning_window_ = boost::none;
+      return true;
+    }
+    try {
+      auto window = std::stoul(str);
+      if (window > 0 and window <= std::numeric_limits<uint32_t>::max()) {
+        state_pruning_window_ = static_cast<uint32_t>(window);
+        return true;
+      }
+    } catch (const std::exception &) {
+    }
+    logger_->error("State pruning must be either '{}' or a positive number",
+                   kStatePruningArchive);
+    return false;
+  }
+
+  bool AppConfigurationImpl::load_state_pruning(const rapidjson::Value &val,
+                                                char const *name) {
+    auto m = val.FindMember(name);
+    if (val.MemberEnd() == m) {
+      return false;
+    }
+    if (m->value.IsUint() and m->value.GetUint() > 0) {
+      state_pruning_window_ = m->value.GetUint();
+      return true;
+    }
+    if (m->value.IsString()) {
+      return parse_state_pruning(m->value.GetString());
+    }
+    return false;
+  }
+
+  bool AppConfigurationImpl::parse_trie_backend(const std::string &str) {
+    if (str == kTrieBackendLevelDb) {
+      trie_backend_ = TrieBackend::kLevelDb;
+      return true;
+    }
+    if (str == kTrieBackendMmap) {
+      trie_backend_ = TrieBackend::kMmap;
+      return true;
+    }
+    logger_->error("Trie backend must be either '{}' or '{}'",
+                   kTrieBackendLevelDb,
+                   kTrieBackendMmap);
+    return false;
+  }
+
+  bool AppConfigurationImpl::parse_wasm_execution(const std::string &str) {
+    if (str == kWasmExecutionInterpreted) {
+      wasm_execution_ = WasmExecution::kInterpreted;
+      return true;
+    }
+    if (str == kWasmExecutionOptimized) {
+      wasm_execution_ = WasmExecution::kOptimized;
+      return true;
+    }
+    logger_->error("Wasm execution must be either '{}' or '{}'",
+                   kWasmExecutionInterpreted,
+                   kWasmExecutionOptimized);
+    return false;
+  }
+
+  bool AppConfigurationImpl::parse_compression(const std::string &str,
+                                               bool &target) {
+    if (str == kCompressionSnappy or str == kCompressionNone) {
+      target = str == kCompressionSnappy;
+      return true;
+    }
+    logger_->error("Compression must be either '{}' or '{}'",
+                   kCompressionSnappy,
+                   kCompressionNone);
+    return false;
+  }
+
+  bool AppConfigurationImpl::load_leveldb_profile(
+      const rapidjson::Value &val,
+      char const *name,
+      storage::LevelDbProfile &target) {
+    auto m = val.FindMember(name);
+    if (val.MemberEnd() == m or not m->value.IsObject()) {
+      return false;
+    }
+    const auto &obj = m->value;
+    uint32_t v{};
+    if (load_u32(obj, "cache_size", v)) {
+      target.block_cache_size = v * kMiB;
+    }
+    load_u32(obj, "bloom_bits", target.bloom_filter_bits);
+    if (load_u32(obj, "write_buffer_size", v)) {
+      target.write_buffer_size = v * kMiB;
+    }
+    std::string compression;
+    if (load_str(obj, "compression", compression)) {
+      return parse_compression(compression, target.compression);
+    }
+    return true;
+  }
+
   void AppConfigurationImpl::parse_general_segment(rapidjson::Value &val) {
     uint16_t v{};
     if (load_u16(val, "verbosity", v) && v <= SPDLOG_LEVEL_OFF)
@@ -100,6 +227,17 @@ namespace kagome::application {
 
   void AppConfigurationImpl::parse_storage_segment(rapidjson::Value &val) {
     load_str(val, "leveldb", leveldb_path_);
+    load_state_pruning(val, "state_pruning");
+    std::string trie_backend;
+    if (load_str(val, "trie_backend", trie_backend)) {
+      parse_trie_backend(trie_backend);
+    }
+    load_leveldb_profile(val, "db", leveldb_profile_);
+    load_leveldb_profile(val, "trie_db", trie_leveldb_profile_);
+    uint32_t stats_period{};
+    if (load_u32(val, "db_stats_period", stats_period)) {
+      leveldb_stats_period_ = std::chrono::seconds{stats_period};
+    }
   }
 
   void AppConfigurationImpl::parse_authority_segment(rapidjson::Value &val) {
@@ -117,6 +255,10 @@ namespace kagome::application {
   void AppConfigurationImpl::parse_additional_segment(rapidjson::Value &val) {
     load_bool(val, "single_finalizing_node", is_only_finalizing_);
     load_bool(val, "already_synchronized", is_already_synchronized_);
+    std::string wasm_execution;
+    if (load_str(val, "wasm_execution", wasm_execution)) {
+      parse_wasm_execution(wasm_execution);
+    }
   }
 
   bool AppConfigurationImpl::validate_config(
@@ -226,6 +368,17 @@ namespace kagome::application {
     po::options_description storage_desc("Storage options");
     storage_desc.add_options()
         ("leveldb,l", po::value<std::string>(), "required, leveldb directory path")
+        ("state_pruning", po::value<std::string>(), "number of the last finalized blocks to keep the states of, or 'archive' to keep all states (256 by default)")
+        ("trie_backend", po::value<std::string>(), "storage of trie nodes: 'leveldb' or memory-mapped append-only files 'mmap' ('leveldb' by default)")
+        ("db_cache_size", po::value<uint32_t>(), "block cache of the leveldb with blocks, MiB (32 by default)")
+        ("db_bloom_bits", po::value<uint32_t>(), "bits per key of bloom filters of the leveldb with blocks, 0 disables them (10 by default)")
+        ("db_write_buffer_size", po::value<uint32_t>(), "write buffer of the leveldb with blocks, MiB (16 by default)")
+        ("db_compression", po::value<std::string>(), "compression of the leveldb with blocks: 'snappy' or 'none' ('snappy' by default)")
+        ("trie_db_cache_size", po::value<uint32_t>(), "block cache of the leveldb with trie nodes, MiB (256 by default)")
+        ("trie_db_bloom_bits", po::value<uint32_t>(), "bits per key of bloom filters of the leveldb with trie nodes, 0 disables them (10 by default)")
+        ("trie_db_write_buffer_size", po::value<uint32_t>(), "write buffer of the leveldb with trie nodes, MiB (64 by default)")
+        ("trie_db_compression", po::value<std::string>(), "compression of the leveldb with trie nodes: 'snappy' or 'none' ('none' by default)")
+        ("db_stats_period", po::value<uint32_t>(), "period of logging leveldb statistics, seconds, 0 disables it (600 by default)")
         ;
 
     po::options_description authority_desc("Authority options");
@@ -246,6 +399,7 @@ namespace kagome::application {
     additional_desc.add_options()
         ("single_finalizing_node,f", "if this is the only finalizing node")
         ("already_synchronized,s", "if need to consider synchronized")
+        ("wasm_execution", po::value<std::string>(), "execution of the runtime: 'interpreted', or 'optimized' to interpret the code optimized by binaryen passes, which takes a while once per code, as the optimized code is kept in the <leveldb>_runtime_cache directory ('interpreted' by default)")
         ;
     // clang-format on
 
@@ -297,6 +451,51 @@ namespace kagome::application {
     find_argument<std::string>(
         vm, "leveldb", [&](std::string const &val) { leveldb_path_ = val; });
 
+    bool state_pruning_valid = true;
+    find_argument<std::string>(
+        vm, "state_pruning", [&](std::string const &val) {
+          state_pruning_valid = parse_state_pruning(val);
+        });
+
+    bool trie_backend_valid = true;
+    find_argument<std::string>(vm, "trie_backend", [&](std::string const &val) {
+      trie_backend_valid = parse_trie_backend(val);
+    });
+
+    bool compression_valid = true;
+    auto find_leveldb_profile = [&](const std::string &prefix,
+                                    storage::LevelDbProfile &profile) {
+      find_argument<uint32_t>(
+          vm, (prefix + "_cache_size").c_str(), [&](uint32_t val) {
+            profile.block_cache_size = val * kMiB;
+          });
+      find_argument<uint32_t>(
+          vm, (prefix + "_bloom_bits").c_str(), [&](uint32_t val) {
+            profile.bloom_filter_bits = val;
+          });
+      find_argument<uint32_t>(
+          vm, (prefix + "_write_buffer_size").c_str(), [&](uint32_t val) {
+            profile.write_buffer_size = val * kMiB;
+          });
+      find_argument<std::string>(
+          vm, (prefix + "_compression").c_str(), [&](std::string const &val) {
+            compression_valid = parse_compression(val, profile.compression)
+                                and compression_valid;
+          });
+    };
+    find_leveldb_profile("db", leveldb_profile_);
+    find_leveldb_profile("trie_db", trie_leveldb_profile_);
+
+    find_argument<uint32_t>(vm, "db_stats_period", [&](uint32_t val) {
+      leveldb_stats_period_ = std::chrono::seconds{val};
+    });
+
+    bool wasm_execution_valid = true;
+    find_argument<std::string>(
+        vm, "wasm_execution", [&](std::string const &val) {
+          wasm_execution_valid = parse_wasm_execution(val);
+        });
+
     find_argument<std::string>(
         vm, "keystore", [&](std::string const &val) { keystore_path_ = val; });
 
@@ -326,7 +525,9 @@ namespace kagome::application {
     rpc_ws_endpoint_ = get_endpoint_from(rpc_ws_host_, rpc_ws_port_);
 
     // if something wrong with config print help message
-    if (not validate_config(scheme) ){
+    if (not state_pruning_valid or not trie_backend_valid
+        or not compression_valid or not wasm_execution_valid
+        or not validate_config(scheme)) {
       std::cout << desc << std::endl;
       return false;
     }
@@ -96,7 +96,18 @@ namespace kagome::application {
     bool load_u16(const rapidjson::Value &val,
                   char const *name,
                   uint16_t &target);
+    bool load_u32(const rapidjson::Value &val,
+                  char const *name,
+                  uint32_t &target);
     bool load_bool(const rapidjson::Value &val, char const *name, bool &target);
+    bool load_state_pruning(const rapidjson::Value &val, char const *name);
+    bool parse_state_pruning(const std::string &str);
+    bool parse_trie_backend(const std::string &str);
+    bool parse_wasm_execution(const std::string &str);
+    bool load_leveldb_profile(const rapidjson::Value &val,
+                              char const *name,
+                              storage::LevelDbProfile &target);
+    bool parse_compression(const std::string &str, bool &target);
 
     boost::asio::ip::tcp::endpoint get_endpoint_from(const std::string &host,
                                                      uint16_t port);
@@ -119,6 +130,12 @@ namespace kagome::application {
     DECLARE_PROPERTY(std::string, genesis_path);
     DECLARE_PROPERTY(std::string, keystore_path);
     DECLARE_PROPERTY(std::string, leveldb_path);
+    DECLARE_PROPERTY(boost::optional<uint32_t>, state_pruning_window);
+    DECLARE_PROPERTY(TrieBackend, trie_backend);
+    DECLARE_PROPERTY(storage::LevelDbProfile, leveldb_profile);
+    DECLARE_PROPERTY(storage::LevelDbProfile, trie_leveldb_profile);
+    DECLARE_PROPERTY(std::chrono::seconds, leveldb_stats_period);
+    DECLARE_PROPERTY(WasmExecution, wasm_execution);
     DECLARE_PROPERTY(uint16_t, p2p_port);
     DECLARE_PROPERTY(boost::asio::ip::tcp::endpoint, rpc_http_endpoint);
     DECLARE_PROPERTY(boost::asio::ip::tcp::endpoint, rpc_ws_endpoint);
@@ -49,6 +49,7 @@ namespace kagome::application {
     sptr<network::Router> router_;
 
     sptr<api::ApiService> jrpc_api_service_;
+    sptr<storage::LevelDbStatsReporter> leveldb_stats_reporter_;
 
     common::Logger logger_;
   };
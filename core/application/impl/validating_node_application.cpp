@@ -34,6 +34,8 @@ namespace kagome::application {
     router_ = injector_.create<sptr<network::Router>>();
 
     jrpc_api_service_ = injector_.create<sptr<api::ApiService>>();
+    leveldb_stats_reporter_ =
+        injector_.create<sptr<storage::LevelDbStatsReporter>>();
   }
 
   void ValidatingNodeApplication::run() {
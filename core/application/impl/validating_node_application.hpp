@@ -63,6 +63,7 @@ namespace kagome::application {
     sptr<network::Router> router_;
 
     sptr<api::ApiService> jrpc_api_service_;
+    sptr<storage::LevelDbStatsReporter> leveldb_stats_reporter_;
 
     Babe::ExecutionStrategy babe_execution_strategy_;
 
@@ -39,6 +39,17 @@ namespace kagome::blockchain {
     virtual outcome::result<primitives::Justification> getJustification(
         const primitives::BlockId &block) const = 0;
 
+    /**
+     * @return SCALE-encoded header of the block, as it is stored
+     */
+    virtual outcome::result<common::Buffer> getEncodedBlockHeader(
+        const primitives::BlockId &id) const = 0;
+    /**
+     * @return SCALE-encoded BlockData of the block, as it is stored
+     */
+    virtual outcome::result<common::Buffer> getEncodedBlockData(
+        const primitives::BlockId &id) const = 0;
+
     virtual outcome::result<primitives::BlockHash> putBlockHeader(
         const primitives::BlockHeader &header) = 0;
 
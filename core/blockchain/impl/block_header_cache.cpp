@@ -0,0 +1,167 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "blockchain/impl/block_header_cache.hpp"
+
+#include <boost/assert.hpp>
+
+#include "common/visitor.hpp"
+
+namespace kagome::blockchain {
+
+  BlockHeaderCache::BlockHeaderCache(size_t capacity)
+      : capacity_{capacity},
+        logger_{common::createLogger("BlockHeaderCache")} {
+    BOOST_ASSERT(capacity_ > 0);
+  }
+
+  uint64_t BlockHeaderCache::generation() const {
+    std::lock_guard lock{mutex_};
+    return generation_;
+  }
+
+  boost::optional<primitives::BlockHeader> BlockHeaderCache::getHeader(
+      const primitives::BlockId &id) {
+    onLookup();
+    std::lock_guard lock{mutex_};
+    auto *hash = visit_in_place(
+        id,
+        [this](const primitives::BlockNumber &number)
+            -> const primitives::BlockHash * { return hashes_.get(number); },
+        [](const primitives::BlockHash &hash)
+            -> const primitives::BlockHash * { return &hash; });
+    auto *header = hash != nullptr ? headers_.get(*hash) : nullptr;
+    if (header == nullptr) {
+      header_misses_++;
+      return boost::none;
+    }
+    header_hits_++;
+    return *header;
+  }
+
+  boost::optional<primitives::BlockHash> BlockHeaderCache::getHashByNumber(
+      primitives::BlockNumber number) {
+    onLookup();
+    std::lock_guard lock{mutex_};
+    if (auto *hash = hashes_.get(number)) {
+      hash_hits_++;
+      return *hash;
+    }
+    hash_misses_++;
+    return boost::none;
+  }
+
+  boost::optional<primitives::BlockNumber> BlockHeaderCache::getNumberByHash(
+      const primitives::BlockHash &hash) {
+    onLookup();
+    std::lock_guard lock{mutex_};
+    if (auto *number = numbers_.get(hash)) {
+      number_hits_++;
+      return *number;
+    }
+    if (auto *header = headers_.get(hash)) {
+      number_hits_++;
+      return header->number;
+    }
+    number_misses_++;
+    return boost::none;
+  }
+
+  void BlockHeaderCache::putHeader(const primitives::BlockHash &hash,
+                                   const primitives::BlockHeader &header,
+                                   bool by_number,
+                                   uint64_t generation) {
+    std::lock_guard lock{mutex_};
+    if (generation != generation_) {
+      return;
+    }
+    headers_.put(hash, header, capacity_);
+    numbers_.put(hash, header.number, capacity_);
+    if (by_number) {
+      hashes_.put(header.number, hash, capacity_);
+    }
+  }
+
+  void BlockHeaderCache::putHashByNumber(primitives::BlockNumber number,
+                                         const primitives::BlockHash &hash,
+                                         uint64_t generation) {
+    std::lock_guard lock{mutex_};
+    if (generation != generation_) {
+      return;
+    }
+    hashes_.put(number, hash, capacity_);
+    numbers_.put(hash, number, capacity_);
+  }
+
+  void BlockHeaderCache::putNumberByHash(const primitives::BlockHash &hash,
+                                         primitives::BlockNumber number,
+                                         uint64_t generation) {
+    std::lock_guard lock{mutex_};
+    if (generation != generation_) {
+      return;
+    }
+    numbers_.put(hash, number, capacity_);
+  }
+
+  void BlockHeaderCache::onHeaderStored(const primitives::BlockHash &hash,
+                                        const primitives::BlockHeader &header) {
+    std::lock_guard lock{mutex_};
+    generation_++;
+    headers_.put(hash, header, capacity_);
+    hashes_.put(header.number, hash, capacity_);
+    numbers_.put(hash, header.number, capacity_);
+  }
+
+  void BlockHeaderCache::onNumberIndexed(primitives::BlockNumber number) {
+    std::lock_guard lock{mutex_};
+    generation_++;
+    hashes_.erase(number);
+  }
+
+  void BlockHeaderCache::onBlockRemoved(const primitives::BlockHash &hash,
+                                        primitives::BlockNumber number) {
+    std::lock_guard lock{mutex_};
+    generation_++;
+    headers_.erase(hash);
+    numbers_.erase(hash);
+    if (auto *indexed_hash = hashes_.get(number);
+        indexed_hash != nullptr and *indexed_hash == hash) {
+      hashes_.erase(number);
+    }
+  }
+
+  BlockHeaderCache::Stats BlockHeaderCache::getStats() const {
+    size_t size;
+    {
+      std::lock_guard lock{mutex_};
+      size = headers_.size();
+    }
+    return Stats{header_hits_.load(),
+                 header_misses_.load(),
+                 hash_hits_.load(),
+                 hash_misses_.load(),
+                 number_hits_.load(),
+                 number_misses_.load(),
+                 size};
+  }
+
+  void BlockHeaderCache::onLookup() {
+    if (++lookups_ % kStatsLogPeriod != 0) {
+      return;
+    }
+    auto stats = getStats();
+    logger_->debug(
+        "{} headers cached; hits/misses of headers {}/{}, of hashes {}/{}, "
+        "of numbers {}/{}",
+        stats.size,
+        stats.header_hits,
+        stats.header_misses,
+        stats.hash_hits,
+        stats.hash_misses,
+        stats.number_hits,
+        stats.number_misses);
+  }
+
+}  // namespace kagome::blockchain
@@ -0,0 +1,205 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_BLOCKCHAIN_IMPL_BLOCK_HEADER_CACHE_HPP
+#define KAGOME_CORE_BLOCKCHAIN_IMPL_BLOCK_HEADER_CACHE_HPP
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include <boost/optional.hpp>
+
+#include "common/logger.hpp"
+#include "primitives/block_header.hpp"
+#include "primitives/block_id.hpp"
+
+namespace kagome::blockchain {
+
+  /**
+   * Bounded LRU cache of decoded block headers by their hashes, together with
+   * the index of block numbers to the hashes of the blocks the storage maps
+   * them to, and the index of block hashes to their numbers. Shared by the
+   * block storage and the header repository, so that the recent headers are
+   * not read from the database and decoded again on every request.
+   * The storage reports its writes, which invalidate the affected entries,
+   * e.g. as a block of another fork or a finalized block takes its number.
+   * Entries read from the database are put with the generation of the cache
+   * taken before the read, and are dropped if a write happened in the
+   * meantime, as they might be outdated already.
+   * The statistics of the lookups are logged at debug level periodically
+   */
+  class BlockHeaderCache {
+   public:
+    static constexpr size_t kDefaultCapacity = 8192;
+    /// Number of lookups, after which the statistics are logged
+    static constexpr uint64_t kStatsLogPeriod = 100000;
+
+    struct Stats {
+      uint64_t header_hits;
+      uint64_t header_misses;
+      uint64_t hash_hits;
+      uint64_t hash_misses;
+      uint64_t number_hits;
+      uint64_t number_misses;
+      size_t size;
+    };
+
+    /**
+     * @param capacity - maximal number of entries of each kind
+     */
+    explicit BlockHeaderCache(size_t capacity = kDefaultCapacity);
+
+    /**
+     * @return the current generation, which changes with every write of the
+     * storage
+     */
+    uint64_t generation() const;
+
+    /**
+     * @return the cached header of the block with {@param id}
+     */
+    boost::optional<primitives::BlockHeader> getHeader(
+        const primitives::BlockId &id);
+
+    /**
+     * @return the cached hash of the block, which the storage maps
+     * {@param number} to and has the header of
+     */
+    boost::optional<primitives::BlockHash> getHashByNumber(
+        primitives::BlockNumber number);
+
+    /**
+     * @return the cached number of the block with {@param hash}
+     */
+    boost::optional<primitives::BlockNumber> getNumberByHash(
+        const primitives::BlockHash &hash);
+
+    /**
+     * Caches {@param header} of the block with {@param hash} read from the
+     * storage, unless the storage was written to since {@param generation}
+     * @param by_number - whether the header was read by its number, so the
+     * storage maps the number to the block
+     */
+    void putHeader(const primitives::BlockHash &hash,
+                   const primitives::BlockHeader &header,
+                   bool by_number,
+                   uint64_t generation);
+
+    /**
+     * Caches {@param hash} of the block, which header is in the storage and
+     * which the storage maps {@param number} to, unless the storage was
+     * written to since {@param generation}
+     */
+    void putHashByNumber(primitives::BlockNumber number,
+                         const primitives::BlockHash &hash,
+                         uint64_t generation);
+
+    /**
+     * Caches {@param number} of the block with {@param hash}, unless the
+     * storage was written to since {@param generation}, as the block might
+     * have been removed
+     */
+    void putNumberByHash(const primitives::BlockHash &hash,
+                         primitives::BlockNumber number,
+                         uint64_t generation);
+
+    /**
+     * To be called once {@param header} of the block with {@param hash} is
+     * stored, which makes the storage map its number to the block
+     */
+    void onHeaderStored(const primitives::BlockHash &hash,
+                        const primitives::BlockHeader &header);
+
+    /**
+     * To be called once the storage maps {@param number} to a block, which
+     * header might be absent
+     */
+    void onNumberIndexed(primitives::BlockNumber number);
+
+    /**
+     * To be called once the block with {@param hash} and {@param number} is
+     * removed from the storage
+     */
+    void onBlockRemoved(const primitives::BlockHash &hash,
+                        primitives::BlockNumber number);
+
+    Stats getStats() const;
+
+   private:
+    /**
+     * Counts a lookup, logging the statistics once in kStatsLogPeriod of them
+     */
+    void onLookup();
+
+    /**
+     * Entries of a kind in the order of their use, the most recent first
+     */
+    template <typename Key, typename Value>
+    class Lru {
+     public:
+      Value *get(const Key &key) {
+        auto it = index_.find(key);
+        if (it == index_.end()) {
+          return nullptr;
+        }
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return &it->second->second;
+      }
+
+      void put(const Key &key, Value value, size_t capacity) {
+        if (auto it = index_.find(key); it != index_.end()) {
+          it->second->second = std::move(value);
+          entries_.splice(entries_.begin(), entries_, it->second);
+          return;
+        }
+        entries_.emplace_front(key, std::move(value));
+        index_.emplace(key, entries_.begin());
+        if (entries_.size() > capacity) {
+          index_.erase(entries_.back().first);
+          entries_.pop_back();
+        }
+      }
+
+      void erase(const Key &key) {
+        if (auto it = index_.find(key); it != index_.end()) {
+          entries_.erase(it->second);
+          index_.erase(it);
+        }
+      }
+
+      size_t size() const {
+        return entries_.size();
+      }
+
+     private:
+      using Entries = std::list<std::pair<Key, Value>>;
+      Entries entries_;
+      std::unordered_map<Key, typename Entries::iterator> index_;
+    };
+
+    const size_t capacity_;
+
+    mutable std::mutex mutex_;
+    uint64_t generation_ = 0;
+    Lru<primitives::BlockHash, primitives::BlockHeader> headers_;
+    Lru<primitives::BlockNumber, primitives::BlockHash> hashes_;
+    Lru<primitives::BlockHash, primitives::BlockNumber> numbers_;
+
+    std::atomic<uint64_t> header_hits_{0};
+    std::atomic<uint64_t> header_misses_{0};
+    std::atomic<uint64_t> hash_hits_{0};
+    std::atomic<uint64_t> hash_misses_{0};
+    std::atomic<uint64_t> number_hits_{0};
+    std::atomic<uint64_t> number_misses_{0};
+    std::atomic<uint64_t> lookups_{0};
+
+    common::Logger logger_;
+  };
+
+}  // namespace kagome::blockchain
+
+#endif  // KAGOME_CORE_BLOCKCHAIN_IMPL_BLOCK_HEADER_CACHE_HPP
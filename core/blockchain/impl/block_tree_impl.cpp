@@ -34,28 +34,69 @@ namespace kagome::blockchain {
   using Prefix = prefix::Prefix;
   using DatabaseError = kagome::storage::DatabaseError;
 
+  namespace {
+    /**
+     * Height of the ancestor, which a node of the given height skips to. The
+     * skips make each node reachable from its descendants in a logarithmic
+     * number of steps, as in the skip list of the block index of Bitcoin Core
+     */
+    size_t skipHeight(size_t height) {
+      auto clear_lowest_bit = [](size_t n) { return n & (n - 1); };
+      if (height < 2) {
+        return 0;
+      }
+      return (height & 1u) != 0
+                 ? clear_lowest_bit(clear_lowest_bit(height - 1)) + 1
+                 : clear_lowest_bit(height);
+    }
+  }  // namespace
+
   BlockTreeImpl::TreeNode::TreeNode(primitives::BlockHash hash,
                                     primitives::BlockNumber depth,
                                     const std::shared_ptr<TreeNode> &parent,
                                     bool finalized)
-      : block_hash{hash}, depth{depth}, parent{parent}, finalized{finalized} {}
-
-  std::shared_ptr<BlockTreeImpl::TreeNode> BlockTreeImpl::TreeNode::getByHash(
-      const primitives::BlockHash &hash) {
-    // standard BFS
-    std::queue<std::shared_ptr<TreeNode>> nodes_to_scan;
-    nodes_to_scan.push(shared_from_this());
-    while (!nodes_to_scan.empty()) {
-      const auto &node = nodes_to_scan.front();
-      if (node->block_hash == hash) {
-        return node;
-      }
-      for (const auto &child : node->children) {
-        nodes_to_scan.push(child);
+      : block_hash{hash},
+        depth{depth},
+        parent{parent},
+        height{parent ? parent->height + 1 : 0},
+        finalized{finalized} {
+    if (parent) {
+      skip = parent->getAncestor(skipHeight(height));
+    }
+  }
+
+  std::shared_ptr<BlockTreeImpl::TreeNode>
+  BlockTreeImpl::TreeNode::getAncestor(size_t ancestor_height) {
+    if (ancestor_height > height) {
+      return nullptr;
+    }
+    auto node = shared_from_this();
+    while (node->height > ancestor_height) {
+      auto skip_height = skipHeight(node->height);
+      auto prev_skip_height = skipHeight(node->height - 1);
+      // the skip is taken unless the skip of the parent leads closer to the
+      // ancestor
+      auto skip = node->skip.lock();
+      if (skip
+          and (skip_height == ancestor_height
+               or (skip_height > ancestor_height
+                   and not(prev_skip_height + 2 < skip_height
+                           and prev_skip_height >= ancestor_height)))) {
+        node = std::move(skip);
+      } else {
+        node = node->parent.lock();
+        if (not node) {
+          // the ancestor is below the root of the tree
+          return nullptr;
+        }
       }
-      nodes_to_scan.pop();
     }
-    return nullptr;
+    return node;
+  }
+
+  bool BlockTreeImpl::TreeNode::isDescendantOf(
+      const std::shared_ptr<TreeNode> &ancestor) {
+    return getAncestor(ancestor->height) == ancestor;
   }
 
   bool BlockTreeImpl::TreeNode::operator==(const TreeNode &other) const {
@@ -78,8 +119,10 @@ namespace kagome::blockchain {
         [&](std::shared_ptr<TreeNode> node) {
           // avoid of deep recurse
           while (node->children.size() == 1) {
+            nodes.emplace(node->block_hash, node);
             node = node->children.front();
           }
+          nodes.emplace(node->block_hash, node);
 
           // is leaf
           if (node->children.empty()) {
@@ -99,13 +142,11 @@ namespace kagome::blockchain {
     handle(subtree_root_node.shared_from_this());
   }
 
-  BlockTreeImpl::TreeMeta::TreeMeta(
-      std::unordered_set<primitives::BlockHash> leaves,
-      TreeNode &deepest_leaf,
-      TreeNode &last_finalized)
-      : leaves{std::move(leaves)},
-        deepest_leaf{deepest_leaf},
-        last_finalized{last_finalized} {}
+  std::shared_ptr<BlockTreeImpl::TreeNode> BlockTreeImpl::TreeMeta::getByHash(
+      const primitives::BlockHash &hash) const {
+    auto it = nodes.find(hash);
+    return it != nodes.end() ? it->second : nullptr;
+  }
 
   outcome::result<std::shared_ptr<BlockTreeImpl>> BlockTreeImpl::create(
       std::shared_ptr<BlockHeaderRepository> header_repo,
@@ -114,12 +155,20 @@ namespace kagome::blockchain {
       std::shared_ptr<network::ExtrinsicObserver> extrinsic_observer,
       std::shared_ptr<crypto::Hasher> hasher,
       subscriptions::EventsSubscriptionEnginePtr events_engine,
-      std::shared_ptr<runtime::Core> runtime_core) {
+      std::shared_ptr<runtime::Core> runtime_core,
+      std::shared_ptr<storage::trie::TriePruner> state_pruner,
+      boost::optional<primitives::BlockNumber> state_pruning_window) {
     // retrieve the block's header: we need data from it
     OUTCOME_TRY(header, storage->getBlockHeader(last_finalized_block));
     // create meta structures from the retrieved header
     OUTCOME_TRY(hash_res, header_repo->getHashById(last_finalized_block));
 
+    if (state_pruning_window) {
+      // the chain builds on the last finalized state, so its nodes must be
+      // counted before a state sharing them is pruned
+      OUTCOME_TRY(state_pruner->addExistingState(Buffer{header.state_root}));
+    }
+
     auto tree =
         std::make_shared<TreeNode>(hash_res, header.number, nullptr, true);
     auto meta = std::make_shared<TreeMeta>(*tree);
@@ -131,7 +180,9 @@ namespace kagome::blockchain {
                              std::move(extrinsic_observer),
                              std::move(hasher),
                              std::move(events_engine),
-                             std::move(runtime_core)};
+                             std::move(runtime_core),
+                             std::move(state_pruner),
+                             state_pruning_window};
     return std::make_shared<BlockTreeImpl>(std::move(block_tree));
   }
 
@@ -143,7 +194,9 @@ namespace kagome::blockchain {
       std::shared_ptr<network::ExtrinsicObserver> extrinsic_observer,
       std::shared_ptr<crypto::Hasher> hasher,
       subscriptions::EventsSubscriptionEnginePtr events_engine,
-      std::shared_ptr<runtime::Core> runtime_core)
+      std::shared_ptr<runtime::Core> runtime_core,
+      std::shared_ptr<storage::trie::TriePruner> state_pruner,
+      boost::optional<primitives::BlockNumber> state_pruning_window)
       : header_repo_{std::move(header_repo)},
         storage_{std::move(storage)},
         tree_{std::move(tree)},
@@ -151,14 +204,19 @@ namespace kagome::blockchain {
         extrinsic_observer_{std::move(extrinsic_observer)},
         hasher_{std::move(hasher)},
         events_engine_(std::move(events_engine)),
-        runtime_core_(std::move(runtime_core)) {
+        runtime_core_(std::move(runtime_core)),
+        state_pruner_(std::move(state_pruner)),
+        state_pruning_window_(state_pruning_window) {
     BOOST_ASSERT(events_engine_);
     BOOST_ASSERT(runtime_core_);
+    BOOST_ASSERT(state_pruner_);
+    // the state of the last finalized block is always kept
+    BOOST_ASSERT(not state_pruning_window_ or *state_pruning_window_ > 0);
   }
 
   outcome::result<void> BlockTreeImpl::addBlockHeader(
       const primitives::BlockHeader &header) {
-    auto parent = tree_->getByHash(header.parent_hash);
+    auto parent = tree_meta_->getByHash(header.parent_hash);
     if (!parent) {
       return BlockTreeError::NO_PARENT;
     }
@@ -166,13 +224,7 @@ namespace kagome::blockchain {
     // update local meta with the new block
     auto new_node =
         std::make_shared<TreeNode>(block_hash, header.number, parent);
-    parent->children.push_back(new_node);
-
-    tree_meta_->leaves.insert(new_node->block_hash);
-    tree_meta_->leaves.erase(parent->block_hash);
-    if (new_node->depth > tree_meta_->deepest_leaf.get().depth) {
-      tree_meta_->deepest_leaf = *new_node;
-    }
+    updateMeta(new_node);
 
     events_engine_->notify(primitives::SubscriptionEventType::kNewHeads,
                            header);
@@ -184,6 +236,7 @@ namespace kagome::blockchain {
     auto parent = new_node->parent.lock();
     parent->children.push_back(new_node);
 
+    tree_meta_->nodes.emplace(new_node->block_hash, new_node);
     tree_meta_->leaves.insert(new_node->block_hash);
     tree_meta_->leaves.erase(parent->block_hash);
     if (new_node->depth > tree_meta_->deepest_leaf.get().depth) {
@@ -194,7 +247,7 @@ namespace kagome::blockchain {
   outcome::result<void> BlockTreeImpl::addBlock(
       const primitives::Block &block) {
     // Check if we know parent of this block; if not, we cannot insert it
-    auto parent = tree_->getByHash(block.header.parent_hash);
+    auto parent = tree_meta_->getByHash(block.header.parent_hash);
     if (!parent) {
       return BlockTreeError::NO_PARENT;
     }
@@ -215,13 +268,13 @@ namespace kagome::blockchain {
   outcome::result<void> BlockTreeImpl::addExistingBlock(
       const primitives::BlockHash &block_hash,
       const primitives::BlockHeader &block_header) {
-    auto node = tree_->getByHash(block_hash);
+    auto node = tree_meta_->getByHash(block_hash);
     // Check if tree doesn't have this block; if not, we skip that
     if (node != nullptr) {
       return BlockTreeError::BLOCK_EXISTS;
     }
     // Check if we know parent of this block; if not, we cannot insert it
-    auto parent = tree_->getByHash(block_header.parent_hash);
+    auto parent = tree_meta_->getByHash(block_header.parent_hash);
     if (parent == nullptr) {
       return BlockTreeError::NO_PARENT;
     }
@@ -246,7 +299,7 @@ namespace kagome::blockchain {
   outcome::result<void> BlockTreeImpl::finalize(
       const primitives::BlockHash &block,
       const primitives::Justification &justification) {
-    auto node = tree_->getByHash(block);
+    auto node = tree_meta_->getByHash(block);
     if (!node) {
       return BlockTreeError::NO_SUCH_BLOCK;
     }
@@ -261,6 +314,8 @@ namespace kagome::blockchain {
     // update our local meta
     node->finalized = true;
 
+    const auto prev_finalized_number = tree_meta_->last_finalized.get().depth;
+
     OUTCOME_TRY(prune(node));
 
     tree_ = node;
@@ -272,6 +327,9 @@ namespace kagome::blockchain {
     OUTCOME_TRY(storage_->setLastFinalizedBlockHash(node->block_hash));
     OUTCOME_TRY(header, storage_->getBlockHeader(node->block_hash));
 
+    OUTCOME_TRY(pruneFinalizedStates({node->depth, node->block_hash},
+                                     prev_finalized_number));
+
     events_engine_->notify(primitives::SubscriptionEventType::kFinalizedHeads,
                            header);
 
@@ -362,27 +420,28 @@ namespace kagome::blockchain {
       const primitives::BlockHash &bottom_block) {
     std::vector<primitives::BlockHash> result;
 
-    auto top_block_node_ptr = tree_->getByHash(top_block);
-    auto bottom_block_node_ptr = tree_->getByHash(bottom_block);
+    auto top_block_node_ptr = tree_meta_->getByHash(top_block);
+    auto bottom_block_node_ptr = tree_meta_->getByHash(bottom_block);
 
     // if both nodes are in our light tree, we can use this representation only
     if (top_block_node_ptr && bottom_block_node_ptr) {
       if (top_block_node_ptr->depth > bottom_block_node_ptr->depth) {
         return result;
       }
-      auto current_node = bottom_block_node_ptr;
-      while (current_node != top_block_node_ptr) {
+      if (not bottom_block_node_ptr->isDescendantOf(top_block_node_ptr)) {
+        log_->warn(
+            "impossible to get chain by blocks: "
+            "most probably, block {} is not an ancestor of {}",
+            top_block.toHex(),
+            bottom_block.toHex());
+        return BlockTreeError::INCORRECT_ARGS;
+      }
+      result.reserve(bottom_block_node_ptr->height
+                     - top_block_node_ptr->height + 1);
+      for (auto current_node = bottom_block_node_ptr;
+           current_node != top_block_node_ptr;
+           current_node = current_node->parent.lock()) {
         result.push_back(current_node->block_hash);
-        if (auto parent = current_node->parent; !parent.expired()) {
-          current_node = parent.lock();
-        } else {
-          log_->warn(
-              "impossible to get chain by blocks: "
-              "most probably, block {} is not an ancestor of {}",
-              top_block.toHex(),
-              bottom_block.toHex());
-          return BlockTreeError::INCORRECT_ARGS;
-        }
       }
       result.push_back(top_block_node_ptr->block_hash);
       std::reverse(result.begin(), result.end());
@@ -410,20 +469,12 @@ namespace kagome::blockchain {
 
   bool BlockTreeImpl::hasDirectChain(const primitives::BlockHash &ancestor,
                                      const primitives::BlockHash &descendant) {
-    auto ancestor_node_ptr = tree_->getByHash(ancestor);
-    auto descendant_node_ptr = tree_->getByHash(descendant);
+    auto ancestor_node_ptr = tree_meta_->getByHash(ancestor);
+    auto descendant_node_ptr = tree_meta_->getByHash(descendant);
 
     // if both nodes are in our light tree, we can use this representation only
     if (ancestor_node_ptr && descendant_node_ptr) {
-      auto current_node = descendant_node_ptr;
-      while (current_node != ancestor_node_ptr) {
-        if (auto parent = current_node->parent; !parent.expired()) {
-          current_node = parent.lock();
-        } else {
-          return false;
-        }
-      }
-      return true;
+      return descendant_node_ptr->isDescendantOf(ancestor_node_ptr);
     }
 
     // else, we need to use a database
@@ -517,7 +568,7 @@ namespace kagome::blockchain {
 
   BlockTreeImpl::BlockHashVecRes BlockTreeImpl::getChildren(
       const primitives::BlockHash &block) {
-    auto node = tree_->getByHash(block);
+    auto node = tree_meta_->getByHash(block);
     if (!node) {
       return BlockTreeError::NO_SUCH_BLOCK;
     }
@@ -541,7 +592,7 @@ namespace kagome::blockchain {
     auto leaves = getLeaves();
     leaf_depths.reserve(leaves.size());
     for (auto &leaf : leaves) {
-      auto leaf_node = tree_->getByHash(leaf);
+      auto leaf_node = tree_meta_->getByHash(leaf);
       leaf_depths.emplace_back(
           primitives::BlockInfo{leaf_node->depth, leaf_node->block_hash});
     }
@@ -581,7 +632,7 @@ namespace kagome::blockchain {
 
     for (;;) {
       auto parent_node = current_node->parent.lock();
-      if (!parent_node || parent_node->finalized) {
+      if (!parent_node) {
         break;
       }
 
@@ -598,6 +649,11 @@ namespace kagome::blockchain {
 
       // remove (in memory) all child, except main chain block
       current_node->children = {main_chain_node};
+
+      // forks of the previously finalized block are the last ones to remove
+      if (current_node->finalized) {
+        break;
+      }
     }
 
     std::vector<primitives::Extrinsic> extrinsics;
@@ -612,6 +668,14 @@ namespace kagome::blockchain {
         }
       }
 
+      if (state_pruning_window_) {
+        // the state of a block, which was not executed, is not stored
+        if (auto header = storage_->getBlockHeader(hash); header) {
+          OUTCOME_TRY(state_pruner_->pruneState(
+              Buffer{header.value().state_root}));
+        }
+      }
+
       OUTCOME_TRY(storage_->removeBlock(hash, number));
     }
 
@@ -628,6 +692,48 @@ namespace kagome::blockchain {
     return outcome::success();
   }
 
+  outcome::result<void> BlockTreeImpl::pruneFinalizedStates(
+      const primitives::BlockInfo &finalized,
+      primitives::BlockNumber prev_finalized_number) {
+    if (not state_pruning_window_) {
+      return outcome::success();
+    }
+    const auto window = state_pruning_window_.value();
+
+    // newly finalized blocks; after a restart the blocks finalized before it
+    // and still in the window are collected too, so that they are pruned
+    primitives::BlockNumber first_number = prev_finalized_number + 1;
+    if (finalized_states_.empty()) {
+      first_number = prev_finalized_number >= window
+                         ? prev_finalized_number - window + 1
+                         : 0;
+    }
+    std::vector<std::pair<primitives::BlockNumber, common::Hash256>>
+        new_states;
+    auto current_hash = finalized.block_hash;
+    for (;;) {
+      OUTCOME_TRY(header, storage_->getBlockHeader(current_hash));
+      if (header.number < first_number) {
+        break;
+      }
+      new_states.emplace_back(header.number, header.state_root);
+      if (header.number == first_number or header.number == 0) {
+        break;
+      }
+      current_hash = header.parent_hash;
+    }
+    finalized_states_.insert(
+        finalized_states_.end(), new_states.rbegin(), new_states.rend());
+
+    while (finalized_states_.size() > window) {
+      const auto &[number, state_root] = finalized_states_.front();
+      OUTCOME_TRY(state_pruner_->pruneState(Buffer{state_root}));
+      log_->debug("Pruned state of finalized block #{}", number);
+      finalized_states_.pop_front();
+    }
+    return outcome::success();
+  }
+
   void BlockTreeImpl::collectDescendants(
       std::shared_ptr<TreeNode> node,
       std::vector<std::pair<primitives::BlockHash, primitives::BlockNumber>>
@@ -9,9 +9,10 @@
 #include "blockchain/block_tree.hpp"
 
 #include <boost/optional.hpp>
+#include <deque>
 #include <functional>
 #include <memory>
-#include <queue>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "blockchain/block_header_repository.hpp"
@@ -22,6 +23,7 @@
 #include "network/extrinsic_observer.hpp"
 #include "primitives/event_types.hpp"
 #include "runtime/core.hpp"
+#include "storage/trie/trie_pruner.hpp"
 #include "transaction_pool/transaction_pool.hpp"
 
 namespace kagome::blockchain {
@@ -45,15 +47,29 @@ namespace kagome::blockchain {
 
       std::weak_ptr<TreeNode> parent;
 
+      /// number of the ancestors of the node, which are or were in the tree
+      size_t height;
+
+      /// an ancestor of the node, which height is given by skipHeight(); the
+      /// skips of the nodes form a skip list, which lets to find an ancestor
+      /// in a logarithmic number of steps
+      std::weak_ptr<TreeNode> skip;
+
       bool finalized;
 
       std::vector<std::shared_ptr<TreeNode>> children{};
 
       /**
-       * Get a node of the tree, containing block with the specified hash, if it
-       * can be found
+       * Get the ancestor of the node, or the node itself, with the specified
+       * height, if it is in the tree
        */
-      std::shared_ptr<TreeNode> getByHash(const primitives::BlockHash &hash);
+      std::shared_ptr<TreeNode> getAncestor(size_t ancestor_height);
+
+      /**
+       * @return whether the node is a descendant of \arg ancestor or is the
+       * ancestor itself
+       */
+      bool isDescendantOf(const std::shared_ptr<TreeNode> &ancestor);
 
       bool operator==(const TreeNode &other) const;
       bool operator!=(const TreeNode &other) const;
@@ -66,9 +82,16 @@ namespace kagome::blockchain {
     struct TreeMeta {
       explicit TreeMeta(TreeNode &subtree_root_node);
 
-      TreeMeta(std::unordered_set<primitives::BlockHash> leaves,
-               TreeNode &deepest_leaf,
-               TreeNode &last_finalized);
+      /**
+       * Get a node of the tree, containing block with the specified hash, if it
+       * can be found
+       */
+      std::shared_ptr<TreeNode> getByHash(
+          const primitives::BlockHash &hash) const;
+
+      /// all the nodes of the tree by the hashes of their blocks
+      std::unordered_map<primitives::BlockHash, std::shared_ptr<TreeNode>>
+          nodes;
 
       std::unordered_set<primitives::BlockHash> leaves;
       std::reference_wrapper<TreeNode> deepest_leaf;
@@ -94,6 +117,11 @@ namespace kagome::blockchain {
      * @param last_finalized_block - last finalized block, from which the tree
      * is going to grow
      * @param hasher - pointer to the hasher
+     * @param state_pruner - pruner of the states of removed blocks
+     * @param state_pruning_window - number of the last finalized blocks, whose
+     * states are kept; if none, no states are pruned at all. Otherwise, the
+     * state of the last finalized block is registered in the pruner, as it
+     * might have been written before the pruning was enabled
      * @return ptr to the created instance or error
      */
     static outcome::result<std::shared_ptr<BlockTreeImpl>> create(
@@ -103,7 +131,9 @@ namespace kagome::blockchain {
         std::shared_ptr<network::ExtrinsicObserver> extrinsic_observer,
         std::shared_ptr<crypto::Hasher> hasher,
         subscriptions::EventsSubscriptionEnginePtr events_engine,
-        std::shared_ptr<runtime::Core> runtime_core);
+        std::shared_ptr<runtime::Core> runtime_core,
+        std::shared_ptr<storage::trie::TriePruner> state_pruner,
+        boost::optional<primitives::BlockNumber> state_pruning_window);
 
     ~BlockTreeImpl() override = default;
 
@@ -176,7 +206,9 @@ namespace kagome::blockchain {
         std::shared_ptr<network::ExtrinsicObserver> extrinsic_observer,
         std::shared_ptr<crypto::Hasher> hasher,
         subscriptions::EventsSubscriptionEnginePtr events_engine,
-        std::shared_ptr<runtime::Core> runtime_core);
+        std::shared_ptr<runtime::Core> runtime_core,
+        std::shared_ptr<storage::trie::TriePruner> state_pruner,
+        boost::optional<primitives::BlockNumber> state_pruning_window);
 
     /**
      * Update local meta with the provided node
@@ -204,6 +236,15 @@ namespace kagome::blockchain {
     outcome::result<void> prune(
         const std::shared_ptr<TreeNode> &lastFinalizedNode);
 
+    /**
+     * Prunes the states of finalized blocks, which are out of the pruning
+     * window after finalization of block \param finalized
+     * @param prev_finalized_number - number of the previous finalized block
+     */
+    outcome::result<void> pruneFinalizedStates(
+        const primitives::BlockInfo &finalized,
+        primitives::BlockNumber prev_finalized_number);
+
     std::shared_ptr<BlockHeaderRepository> header_repo_;
     std::shared_ptr<BlockStorage> storage_;
 
@@ -215,6 +256,11 @@ namespace kagome::blockchain {
     std::shared_ptr<crypto::Hasher> hasher_;
     subscriptions::EventsSubscriptionEnginePtr events_engine_;
     std::shared_ptr<runtime::Core> runtime_core_;
+    std::shared_ptr<storage::trie::TriePruner> state_pruner_;
+    boost::optional<primitives::BlockNumber> state_pruning_window_;
+    /// state roots of finalized blocks kept by the pruner, ordered by number
+    std::deque<std::pair<primitives::BlockNumber, common::Hash256>>
+        finalized_states_;
     std::optional<primitives::Version> actual_runtime_version_;
     common::Logger log_ = common::createLogger("BlockTreeImpl");
   };
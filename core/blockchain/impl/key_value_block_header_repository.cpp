@@ -22,37 +22,60 @@ namespace kagome::blockchain {
 
   KeyValueBlockHeaderRepository::KeyValueBlockHeaderRepository(
       std::shared_ptr<storage::BufferStorage> map,
-      std::shared_ptr<crypto::Hasher> hasher)
-      : map_{std::move(map)}, hasher_{std::move(hasher)} {
+      std::shared_ptr<crypto::Hasher> hasher,
+      std::shared_ptr<BlockHeaderCache> cache)
+      : map_{std::move(map)},
+        hasher_{std::move(hasher)},
+        cache_{std::move(cache)} {
     BOOST_ASSERT(hasher_);
   }
 
   outcome::result<BlockNumber> KeyValueBlockHeaderRepository::getNumberByHash(
       const Hash256 &hash) const {
+    if (cache_) {
+      if (auto number = cache_->getNumberByHash(hash)) {
+        return number.value();
+      }
+    }
+    auto generation = cache_ ? cache_->generation() : 0;
     OUTCOME_TRY(key, idToLookupKey(*map_, hash));
-
-    auto maybe_number = lookupKeyToNumber(key);
-
-    return maybe_number;
+    OUTCOME_TRY(number, lookupKeyToNumber(key));
+    if (cache_) {
+      cache_->putNumberByHash(hash, number, generation);
+    }
+    return number;
   }
 
   outcome::result<common::Hash256>
   KeyValueBlockHeaderRepository::getHashByNumber(
       const primitives::BlockNumber &number) const {
-    OUTCOME_TRY(header, getBlockHeader(number));
-    OUTCOME_TRY(enc_header, scale::encode(header));
-    return hasher_->blake2b_256(enc_header);
+    if (cache_) {
+      if (auto hash = cache_->getHashByNumber(number)) {
+        return hash.value();
+      }
+    }
+    auto generation = cache_ ? cache_->generation() : 0;
+    // the lookup key contains the hash, so the header is not decoded and
+    // hashed, but it has to be in the storage still
+    OUTCOME_TRY(key, idToLookupKey(*map_, number));
+    if (not map_->contains(prependPrefix(key, Prefix::HEADER))) {
+      return Error::BLOCK_NOT_FOUND;
+    }
+    OUTCOME_TRY(hash, lookupKeyToHash(key));
+    if (cache_) {
+      cache_->putHashByNumber(number, hash, generation);
+    }
+    return hash;
   }
 
   outcome::result<primitives::BlockHeader>
   KeyValueBlockHeaderRepository::getBlockHeader(const BlockId &id) const {
-    auto header_res = getWithPrefix(*map_, Prefix::HEADER, id);
+    auto header_res = getBlockHeaderWithCache(*map_, id, cache_);
     if (!header_res) {
       return (isNotFoundError(header_res.error())) ? Error::BLOCK_NOT_FOUND
                                                    : header_res.error();
     }
-
-    return scale::decode<primitives::BlockHeader>(header_res.value());
+    return header_res;
   }
 
   outcome::result<BlockStatus> KeyValueBlockHeaderRepository::getBlockStatus(
@@ -40,9 +40,11 @@ namespace kagome::blockchain {
 
   KeyValueBlockStorage::KeyValueBlockStorage(
       std::shared_ptr<storage::BufferStorage> storage,
-      std::shared_ptr<crypto::Hasher> hasher)
+      std::shared_ptr<crypto::Hasher> hasher,
+      std::shared_ptr<BlockHeaderCache> header_cache)
       : storage_{std::move(storage)},
         hasher_{std::move(hasher)},
+        header_cache_{std::move(header_cache)},
         logger_{common::createLogger("Block Storage:")} {}
 
   outcome::result<std::shared_ptr<KeyValueBlockStorage>>
@@ -50,21 +52,28 @@ namespace kagome::blockchain {
       common::Buffer state_root,
       const std::shared_ptr<storage::BufferStorage> &storage,
       const std::shared_ptr<crypto::Hasher> &hasher,
-      const BlockHandler &on_finalized_block_found) {
+      const BlockHandler &on_finalized_block_found,
+      std::shared_ptr<BlockHeaderCache> header_cache) {
     auto block_storage = std::make_shared<KeyValueBlockStorage>(
-        KeyValueBlockStorage(storage, hasher));
+        KeyValueBlockStorage(storage, hasher, header_cache));
 
     auto last_finalized_block_hash_res =
         block_storage->getLastFinalizedBlockHash();
 
     if (last_finalized_block_hash_res.has_value()) {
-      return loadExisting(storage, hasher, on_finalized_block_found);
+      return loadExisting(storage,
+                          hasher,
+                          on_finalized_block_found,
+                          std::move(header_cache));
     }
 
     if (last_finalized_block_hash_res
         == outcome::failure(Error::FINALIZED_BLOCK_NOT_FOUND)) {
-      return createWithGenesis(
-          std::move(state_root), storage, hasher, on_finalized_block_found);
+      return createWithGenesis(std::move(state_root),
+                               storage,
+                               hasher,
+                               on_finalized_block_found,
+                               std::move(header_cache));
     }
 
     return last_finalized_block_hash_res.error();
@@ -74,9 +83,11 @@ namespace kagome::blockchain {
   KeyValueBlockStorage::loadExisting(
       const std::shared_ptr<storage::BufferStorage> &storage,
       std::shared_ptr<crypto::Hasher> hasher,
-      const BlockHandler &on_finalized_block_found) {
+      const BlockHandler &on_finalized_block_found,
+      std::shared_ptr<BlockHeaderCache> header_cache) {
     auto block_storage = std::make_shared<KeyValueBlockStorage>(
-        KeyValueBlockStorage(storage, std::move(hasher)));
+        KeyValueBlockStorage(
+            storage, std::move(hasher), std::move(header_cache)));
 
     OUTCOME_TRY(last_finalized_block_hash,
                 block_storage->getLastFinalizedBlockHash());
@@ -97,9 +108,11 @@ namespace kagome::blockchain {
       common::Buffer state_root,
       const std::shared_ptr<storage::BufferStorage> &storage,
       std::shared_ptr<crypto::Hasher> hasher,
-      const BlockHandler &on_genesis_created) {
+      const BlockHandler &on_genesis_created,
+      std::shared_ptr<BlockHeaderCache> header_cache) {
     auto block_storage = std::make_shared<KeyValueBlockStorage>(
-        KeyValueBlockStorage(storage, std::move(hasher)));
+        KeyValueBlockStorage(
+            storage, std::move(hasher), std::move(header_cache)));
 
     OUTCOME_TRY(block_storage->ensureGenesisNotExists());
 
@@ -131,9 +144,7 @@ namespace kagome::blockchain {
 
   outcome::result<primitives::BlockHeader> KeyValueBlockStorage::getBlockHeader(
       const primitives::BlockId &id) const {
-    OUTCOME_TRY(encoded_header, getWithPrefix(*storage_, Prefix::HEADER, id));
-    OUTCOME_TRY(header, scale::decode<primitives::BlockHeader>(encoded_header));
-    return std::move(header);
+    return getBlockHeaderWithCache(*storage_, id, header_cache_);
   }
 
   outcome::result<primitives::BlockBody> KeyValueBlockStorage::getBlockBody(
@@ -154,6 +165,16 @@ namespace kagome::blockchain {
     return std::move(block_data);
   }
 
+  outcome::result<common::Buffer> KeyValueBlockStorage::getEncodedBlockHeader(
+      const primitives::BlockId &id) const {
+    return getWithPrefix(*storage_, Prefix::HEADER, id);
+  }
+
+  outcome::result<common::Buffer> KeyValueBlockStorage::getEncodedBlockData(
+      const primitives::BlockId &id) const {
+    return getWithPrefix(*storage_, Prefix::BLOCK_DATA, id);
+  }
+
   outcome::result<primitives::Justification>
   KeyValueBlockStorage::getJustification(
       const primitives::BlockId &block) const {
@@ -173,6 +194,9 @@ namespace kagome::blockchain {
                               header.number,
                               block_hash,
                               Buffer{std::move(encoded_header)}));
+    if (header_cache_) {
+      header_cache_->onHeaderStored(block_hash, header);
+    }
     return block_hash;
   }
 
@@ -210,6 +234,10 @@ namespace kagome::blockchain {
                               block_number,
                               block_data.hash,
                               Buffer{encoded_block_data}));
+    if (header_cache_) {
+      // the number is mapped to the block, which header might be absent
+      header_cache_->onNumberIndexed(block_number);
+    }
     return outcome::success();
   }
 
@@ -272,6 +300,9 @@ namespace kagome::blockchain {
                      rm_res.error().message());
       return rm_res;
     }
+    if (header_cache_) {
+      header_cache_->onBlockRemoved(hash, number);
+    }
     return outcome::success();
   }
 
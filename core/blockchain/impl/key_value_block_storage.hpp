@@ -8,6 +8,7 @@
 
 #include "blockchain/block_storage.hpp"
 
+#include "blockchain/impl/block_header_cache.hpp"
 #include "blockchain/impl/common.hpp"
 #include "common/logger.hpp"
 #include "crypto/hasher.hpp"
@@ -34,29 +35,36 @@ namespace kagome::blockchain {
         common::Buffer state_root,
         const std::shared_ptr<storage::BufferStorage> &storage,
         const std::shared_ptr<crypto::Hasher> &hasher,
-        const BlockHandler &on_finalized_block_found);
+        const BlockHandler &on_finalized_block_found,
+        std::shared_ptr<BlockHeaderCache> header_cache = nullptr);
 
     /**
      * Initialise block storage with existing data
      * @param storage underlying storage (must be empty)
      * @param hasher a hasher instance
+     * @param header_cache cache of headers, which the storage reports its
+     * writes to, none if headers are not cached
      */
     static outcome::result<std::shared_ptr<KeyValueBlockStorage>> loadExisting(
         const std::shared_ptr<storage::BufferStorage> &storage,
         std::shared_ptr<crypto::Hasher> hasher,
-        const BlockHandler &on_finalized_block_found);
+        const BlockHandler &on_finalized_block_found,
+        std::shared_ptr<BlockHeaderCache> header_cache = nullptr);
 
     /**
      * Initialise block storage with a genesis block which is created inside
      * from merkle trie root
      * @param storage underlying storage (must be empty)
      * @param hasher a hasher instance
+     * @param header_cache cache of headers, which the storage reports its
+     * writes to, none if headers are not cached
      */
     static outcome::result<std::shared_ptr<KeyValueBlockStorage>>
     createWithGenesis(common::Buffer state_root,
                       const std::shared_ptr<storage::BufferStorage> &storage,
                       std::shared_ptr<crypto::Hasher> hasher,
-                      const BlockHandler &on_genesis_created);
+                      const BlockHandler &on_genesis_created,
+                      std::shared_ptr<BlockHeaderCache> header_cache = nullptr);
 
     outcome::result<primitives::BlockHash> getGenesisBlockHash() const override;
 
@@ -74,6 +82,12 @@ namespace kagome::blockchain {
     outcome::result<primitives::Justification> getJustification(
         const primitives::BlockId &block) const override;
 
+    outcome::result<common::Buffer> getEncodedBlockHeader(
+        const primitives::BlockId &id) const override;
+
+    outcome::result<common::Buffer> getEncodedBlockData(
+        const primitives::BlockId &id) const override;
+
     outcome::result<primitives::BlockHash> putBlockHeader(
         const primitives::BlockHeader &header) override;
     outcome::result<void> putBlockData(
@@ -93,12 +107,14 @@ namespace kagome::blockchain {
 
    private:
     KeyValueBlockStorage(std::shared_ptr<storage::BufferStorage> storage,
-                         std::shared_ptr<crypto::Hasher> hasher);
+                         std::shared_ptr<crypto::Hasher> hasher,
+                         std::shared_ptr<BlockHeaderCache> header_cache);
 
     outcome::result<void> ensureGenesisNotExists() const;
 
     std::shared_ptr<storage::BufferStorage> storage_;
     std::shared_ptr<crypto::Hasher> hasher_;
+    std::shared_ptr<BlockHeaderCache> header_cache_;
     common::Logger logger_;
   };
 }  // namespace kagome::blockchain
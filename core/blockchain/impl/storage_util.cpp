@@ -6,6 +6,7 @@
 #include "blockchain/impl/storage_util.hpp"
 
 #include "blockchain/impl/common.hpp"
+#include "scale/scale.hpp"
 #include "storage/database_error.hpp"
 
 using kagome::blockchain::prefix::Prefix;
@@ -75,6 +76,37 @@ namespace kagome::blockchain {
            | (uint64_t(key[2]) << 8u) | uint64_t(key[3]);
   }
 
+  outcome::result<common::Hash256> lookupKeyToHash(const common::Buffer &key) {
+    if (key.size() != 4 + common::Hash256::size()) {
+      return outcome::failure(KeyValueRepositoryError::INVALID_KEY);
+    }
+    return common::Hash256::fromSpan(
+        gsl::span<const uint8_t>(key).subspan(4));
+  }
+
+  outcome::result<primitives::BlockHeader> getBlockHeaderWithCache(
+      const storage::BufferStorage &map,
+      const primitives::BlockId &block_id,
+      const std::shared_ptr<BlockHeaderCache> &cache) {
+    if (cache == nullptr) {
+      OUTCOME_TRY(encoded_header, getWithPrefix(map, Prefix::HEADER, block_id));
+      return scale::decode<primitives::BlockHeader>(encoded_header);
+    }
+    if (auto header = cache->getHeader(block_id)) {
+      return std::move(header.value());
+    }
+    auto generation = cache->generation();
+    OUTCOME_TRY(key, idToLookupKey(map, block_id));
+    OUTCOME_TRY(encoded_header, map.get(prependPrefix(key, Prefix::HEADER)));
+    OUTCOME_TRY(header, scale::decode<primitives::BlockHeader>(encoded_header));
+    OUTCOME_TRY(hash, lookupKeyToHash(key));
+    cache->putHeader(hash,
+                     header,
+                     boost::get<primitives::BlockNumber>(&block_id) != nullptr,
+                     generation);
+    return std::move(header);
+  }
+
   common::Buffer prependPrefix(const common::Buffer &key,
                                prefix::Prefix key_column) {
     return common::Buffer{}
@@ -6,6 +6,7 @@
 #ifndef KAGOME_CORE_BLOCKCHAIN_IMPL_PERSISTENT_MAP_UTIL_HPP
 #define KAGOME_CORE_BLOCKCHAIN_IMPL_PERSISTENT_MAP_UTIL_HPP
 
+#include "blockchain/impl/block_header_cache.hpp"
 #include "common/buffer.hpp"
 #include "primitives/block_header.hpp"
 #include "primitives/block_id.hpp"
@@ -36,7 +37,10 @@ namespace kagome::blockchain {
       JUSTIFICATION = 6,
 
       // node of a trie db
-      TRIE_NODE = 7
+      TRIE_NODE = 7,
+
+      // reference count of a node of a trie db, used by the state pruning
+      TRIE_NODE_REFCOUNT = 8
     };
   }
 
@@ -102,6 +106,24 @@ namespace kagome::blockchain {
   outcome::result<primitives::BlockNumber> lookupKeyToNumber(
       const common::Buffer &key);
 
+  /**
+   * Convert lookup key to a block hash
+   */
+  outcome::result<common::Hash256> lookupKeyToHash(const common::Buffer &key);
+
+  /**
+   * Get a decoded block header from the database, unless it is in the cache
+   * @param map to get the header from
+   * @param block_id - id of the block to get the header of
+   * @param cache - cache of the headers, which the header read from the
+   * database is put to; none if headers are not cached
+   * @return the header or error
+   */
+  outcome::result<primitives::BlockHeader> getBlockHeaderWithCache(
+      const storage::BufferStorage &map,
+      const primitives::BlockId &block_id,
+      const std::shared_ptr<BlockHeaderCache> &cache);
+
   /**
    * For a persistant map based storage checks
    * whether result should be considered as `NOT FOUND` error
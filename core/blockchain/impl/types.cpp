@@ -7,7 +7,7 @@
 #include "blockchain/impl/storage_util.hpp"
 #include "common/visitor.hpp"
 #include "storage/in_memory/in_memory_storage.hpp"
-#include "storage/trie/polkadot_trie/polkadot_trie_impl.hpp"
+#include "storage/trie/serialization/trie_root_builder.hpp"
 #include "storage/trie/serialization/trie_serializer_impl.hpp"
 
 OUTCOME_CPP_DEFINE_CATEGORY(kagome::blockchain, Error, e) {
@@ -41,19 +41,12 @@ namespace kagome::blockchain {
 
   common::Buffer trieRoot(
       const std::vector<std::pair<common::Buffer, common::Buffer>> &key_vals) {
-    auto trie = storage::trie::PolkadotTrieImpl();
-    auto codec = storage::trie::PolkadotCodec();
-
+    storage::trie::TrieRootBuilder builder;
     for (const auto &[key, val] : key_vals) {
-      auto res = trie.put(key, val);
-      BOOST_ASSERT_MSG(res.has_value(), "Insertion into trie failed");
-    }
-    auto root = trie.getRoot();
-    if (root == nullptr) {
-      return common::Buffer{codec.hash256({0})};
+      builder.add(key, val);
     }
-    auto encode_res = codec.encodeNode(*root);
-    BOOST_ASSERT_MSG(encode_res.has_value(), "Trie encoding failed");
-    return common::Buffer{codec.hash256(encode_res.value())};
+    auto root = builder.calculateRoot();
+    BOOST_ASSERT_MSG(root.has_value(), "Trie encoding failed");
+    return common::Buffer{root.value()};
   }
 }  // namespace kagome::blockchain
@@ -0,0 +1,56 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_COMMON_THREAD_POOL_HPP
+#define KAGOME_CORE_COMMON_THREAD_POOL_HPP
+
+#include <future>
+#include <memory>
+
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
+
+namespace kagome::common {
+
+  /**
+   * Worker threads, which run submitted tasks and provide their results as
+   * futures. The threads are joined on destruction, once the submitted tasks
+   * are done
+   */
+  class ThreadPool {
+   public:
+    /**
+     * @param threads number of worker threads
+     */
+    explicit ThreadPool(size_t threads) : pool_{threads} {}
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    ~ThreadPool() {
+      pool_.join();
+    }
+
+    /**
+     * Schedules a task to a worker thread
+     * @return the future result of the task, which keeps an exception thrown
+     * by the task
+     */
+    template <typename F>
+    auto submit(F &&f) -> std::future<decltype(f())> {
+      auto task = std::make_shared<std::packaged_task<decltype(f())()>>(
+          std::forward<F>(f));
+      auto result = task->get_future();
+      boost::asio::post(pool_, [task] { (*task)(); });
+      return result;
+    }
+
+   private:
+    boost::asio::thread_pool pool_;
+  };
+
+}  // namespace kagome::common
+
+#endif  // KAGOME_CORE_COMMON_THREAD_POOL_HPP
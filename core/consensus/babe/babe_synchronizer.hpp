@@ -26,11 +26,12 @@ namespace kagome::consensus {
     /**
      * Request blocks between provided ones
      * @param from block id of the first requested block
-     * @param to block hash of the last requested block
-     * @param block_list_handler handles received blocks
+     * @param to number and hash of the last requested block
+     * @param block_list_handler handles received blocks; might be called
+     * several times with consecutive parts of the range in their order
      */
     virtual void request(const primitives::BlockId &from,
-                         const primitives::BlockHash &to,
+                         const primitives::BlockInfo &to,
                          primitives::AuthorityIndex authority_index,
                          const BlocksHandler &block_list_handler) = 0;
   };
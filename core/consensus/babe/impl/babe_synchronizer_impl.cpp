@@ -5,46 +5,421 @@
 
 #include "consensus/babe/impl/babe_synchronizer_impl.hpp"
 
+#include <algorithm>
 #include <random>
 
+#include <boost/asio/steady_timer.hpp>
 #include <boost/assert.hpp>
 #include "blockchain/block_tree_error.hpp"
 #include "common/visitor.hpp"
 #include "primitives/block.hpp"
 
 namespace kagome::consensus {
+
+  namespace {
+    primitives::BlocksRequestId generateRequestId() {
+      static std::random_device rd{};
+      static std::uniform_int_distribution<primitives::BlocksRequestId> dis{};
+      return dis(rd);
+    }
+
+    /// weight of the last observation in the moving averages of peer stats
+    constexpr double kStatsWeight = 0.3;
+
+    /// time a failure adds to the expected time a peer takes to provide a
+    /// chunk, ms
+    constexpr double kFailurePenaltyMs = 1000;
+  }  // namespace
+
   BabeSynchronizerImpl::BabeSynchronizerImpl(
-      std::shared_ptr<network::SyncClientsSet> sync_clients)
+      std::shared_ptr<network::SyncClientsSet> sync_clients,
+      std::shared_ptr<blockchain::BlockHeaderRepository> block_headers,
+      std::shared_ptr<boost::asio::io_context> io_context,
+      std::chrono::milliseconds request_timeout)
       : sync_clients_{std::move(sync_clients)},
+        block_headers_{std::move(block_headers)},
+        io_context_{std::move(io_context)},
+        request_timeout_{request_timeout},
         logger_{common::createLogger("BabeSynchronizer")} {
     BOOST_ASSERT(sync_clients_);
     BOOST_ASSERT(std::all_of(sync_clients_->clients.begin(),
                              sync_clients_->clients.end(),
                              [](const auto &client) { return client; }));
+    BOOST_ASSERT(block_headers_);
+    BOOST_ASSERT(io_context_);
   }
 
   void BabeSynchronizerImpl::request(const primitives::BlockId &from,
-                                     const primitives::BlockHash &to,
+                                     const primitives::BlockInfo &to,
                                      primitives::AuthorityIndex authority_index,
                                      const BlocksHandler &block_list_handler) {
     std::string from_str = visit_in_place(
         from,
         [](const primitives::BlockHash &hash) { return hash.toHex(); },
         [](primitives::BlockNumber number) { return std::to_string(number); });
-    logger_->info("Requesting blocks from {} to {}", from_str, to.toHex());
+    logger_->info("Requesting blocks from {} to {}",
+                  from_str,
+                  to.block_hash.toHex());
+
+    if (download(from, to, authority_index, block_list_handler)) {
+      return;
+    }
 
-    static std::random_device rd{};
-    static std::uniform_int_distribution<primitives::BlocksRequestId> dis{};
-    network::BlocksRequest request{dis(rd),
+    network::BlocksRequest request{generateRequestId(),
                                    network::BlocksRequest::kBasicAttributes,
                                    from,
-                                   to,
+                                   to.block_hash,
                                    network::Direction::DESCENDING,
                                    boost::none};
 
     return pollClients(request, authority_index, block_list_handler);
   }
 
+  boost::optional<BabeSynchronizerImpl::PeerStats>
+  BabeSynchronizerImpl::getPeerStats(
+      const std::shared_ptr<network::SyncProtocolClient> &client) const {
+    auto it = peer_stats_.find(client);
+    if (it == peer_stats_.end()) {
+      return boost::none;
+    }
+    return it->second;
+  }
+
+  bool BabeSynchronizerImpl::download(
+      const primitives::BlockId &from,
+      const primitives::BlockInfo &to,
+      primitives::AuthorityIndex authority_index,
+      const BlocksHandler &block_list_handler) {
+    auto from_number_res = block_headers_->getNumberById(from);
+    auto from_hash_res = block_headers_->getHashById(from);
+    auto clients = servingClients();
+    if (not from_number_res or not from_hash_res or clients == 0) {
+      return false;
+    }
+    // the first block is known, so the range starts after it
+    auto first = from_number_res.value() + 1;
+    if (to.block_number < first + kChunkSize) {
+      return false;
+    }
+
+    logger_->info("Downloading blocks {}..{} from {} peers",
+                  first,
+                  to.block_number,
+                  clients);
+    auto download = std::make_shared<Download>(Download{to,
+                                                        authority_index,
+                                                        block_list_handler,
+                                                        {},
+                                                        first,
+                                                        from_hash_res.value()});
+    schedule(download);
+    return true;
+  }
+
+  void BabeSynchronizerImpl::schedule(
+      const std::shared_ptr<Download> &download) {
+    if (download->finished) {
+      return;
+    }
+
+    auto max_chunks = kChunksAheadPerPeer * servingClients();
+    while (download->chunks.size() < max_chunks
+           and download->next_number <= download->to.block_number) {
+      auto first = download->next_number;
+      auto last = std::min(download->to.block_number, first + kChunkSize - 1);
+      download->chunks.push_back(Chunk{first, last});
+      download->next_number = last + 1;
+    }
+
+    for (auto &chunk : download->chunks) {
+      if (chunk.blocks or not chunk.requested_from.empty()) {
+        continue;
+      }
+      if (auto client = selectPeer(chunk)) {
+        requestChunk(download, chunk, client.value());
+      }
+    }
+
+    // the chunk to be handled next holds the others back, so a peer left idle
+    // races the one it is requested from
+    auto &next_chunk = download->chunks.front();
+    if (not next_chunk.blocks and next_chunk.requested_from.size() == 1) {
+      if (auto client = selectPeer(next_chunk)) {
+        requestChunk(download, next_chunk, client.value());
+      }
+    }
+
+    if (not next_chunk.blocks and next_chunk.requested_from.empty()
+        and std::all_of(sync_clients_->clients.begin(),
+                        sync_clients_->clients.end(),
+                        [&next_chunk](const auto &client) {
+                          return not client->servesRequests()
+                                 or next_chunk.failed.count(client) != 0;
+                        })) {
+      fallBack(download);
+    }
+  }
+
+  void BabeSynchronizerImpl::requestChunk(
+      const std::shared_ptr<Download> &download,
+      Chunk &chunk,
+      const Client &client) {
+    chunk.requested_from.insert(client);
+    peer_stats_[client].requests_in_flight++;
+
+    network::BlocksRequest request{
+        generateRequestId(),
+        network::BlocksRequest::kBasicAttributes,
+        chunk.first,
+        boost::none,
+        network::Direction::DESCENDING,
+        static_cast<uint32_t>(chunk.last - chunk.first + 1)};
+
+    // either the response or the timeout is handled, whichever comes first;
+    // the wait keeps the timer, as a peer might drop the callback
+    auto answered = std::make_shared<bool>(false);
+    auto timer = std::make_shared<boost::asio::steady_timer>(*io_context_);
+    auto start = std::chrono::steady_clock::now();
+    timer->expires_after(request_timeout_);
+    timer->async_wait([self_wp{weak_from_this()},
+                       download,
+                       first{chunk.first},
+                       client,
+                       start,
+                       answered,
+                       timer](const boost::system::error_code &ec) {
+      if (ec or *answered) {
+        return;
+      }
+      *answered = true;
+      if (auto self = self_wp.lock()) {
+        self->onChunk(download,
+                      first,
+                      client,
+                      start,
+                      std::make_error_code(std::errc::timed_out));
+      }
+    });
+
+    client->requestBlocks(
+        request,
+        [self_wp{weak_from_this()},
+         download,
+         first{chunk.first},
+         client,
+         start,
+         answered,
+         timer](auto &&response_res) {
+          if (*answered) {
+            return;
+          }
+          *answered = true;
+          timer->cancel();
+          if (auto self = self_wp.lock()) {
+            self->onChunk(
+                download, first, client, start, std::move(response_res));
+          }
+        });
+  }
+
+  /**
+   * Get blocks of the chunk from response
+   * @param response containing block data for the blocks starting from the
+   * first one of the chunk
+   * @return blocks of the chunk and the hash of the last one, if the response
+   * contains at least the first of them, linked by their parent hashes. The
+   * peer might cut the response by its size limits, so the rest of the chunk
+   * might be missing
+   */
+  boost::optional<
+      std::pair<std::vector<primitives::Block>, primitives::BlockHash>>
+  getChunkBlocks(const network::BlocksResponse &response,
+                 primitives::BlockNumber first,
+                 primitives::BlockNumber last,
+                 const primitives::BlockInfo &to) {
+    auto size = std::min<size_t>(last - first + 1, response.blocks.size());
+    if (size == 0) {
+      return boost::none;
+    }
+    std::vector<primitives::Block> blocks;
+    blocks.reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+      const auto &block_data = response.blocks[i];
+      if (not block_data.header or block_data.header->number != first + i) {
+        return boost::none;
+      }
+      if (i != 0
+          and block_data.header->parent_hash != response.blocks[i - 1].hash) {
+        return boost::none;
+      }
+      primitives::Block block;
+      block.header = *block_data.header;
+      if (block_data.body) {
+        block.body = *block_data.body;
+      }
+      blocks.push_back(std::move(block));
+    }
+    const auto &last_hash = response.blocks[size - 1].hash;
+    if (first + size - 1 == to.block_number and last_hash != to.block_hash) {
+      // the peer has another block with the number of the requested one
+      return boost::none;
+    }
+    return std::make_pair(std::move(blocks), last_hash);
+  }
+
+  void BabeSynchronizerImpl::onChunk(
+      const std::shared_ptr<Download> &download,
+      primitives::BlockNumber first,
+      const Client &client,
+      std::chrono::steady_clock::time_point start,
+      outcome::result<network::BlocksResponse> response_res) {
+    auto &stats = peer_stats_[client];
+    stats.requests_in_flight--;
+
+    auto chunk = std::find_if(
+        download->chunks.begin(),
+        download->chunks.end(),
+        [first](const auto &chunk) { return chunk.first == first; });
+    // the chunk might be handled already, if another peer was faster
+    auto awaited = chunk != download->chunks.end() and not chunk->blocks;
+    if (chunk != download->chunks.end()) {
+      chunk->requested_from.erase(client);
+    }
+
+    auto last = chunk != download->chunks.end()
+                    ? chunk->last
+                    : std::min(download->to.block_number, first + kChunkSize - 1);
+    auto blocks =
+        response_res
+            ? getChunkBlocks(response_res.value(), first, last, download->to)
+            : boost::none;
+    if (not blocks) {
+      logger_->debug("Peer did not provide blocks {}..{}: {}",
+                     first,
+                     last,
+                     response_res ? "incomplete response"
+                                  : response_res.error().message());
+      stats.failures++;
+      if (awaited) {
+        chunk->failed.insert(client);
+      }
+    } else {
+      auto elapsed_ms = std::max<double>(
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+              std::chrono::steady_clock::now() - start)
+              .count(),
+          1);
+      auto received = blocks->first.size();
+      auto blocks_per_second = 1000 * received / elapsed_ms;
+      if (stats.measured) {
+        stats.latency_ms += kStatsWeight * (elapsed_ms - stats.latency_ms);
+        stats.blocks_per_second +=
+            kStatsWeight * (blocks_per_second - stats.blocks_per_second);
+      } else {
+        stats.latency_ms = elapsed_ms;
+        stats.blocks_per_second = blocks_per_second;
+        stats.measured = true;
+      }
+      stats.failures = 0;
+      if (awaited) {
+        chunk->blocks = std::move(blocks->first);
+        chunk->last_hash = blocks->second;
+        chunk->provider = client;
+        if (first + received - 1 < last) {
+          // the response was cut, so the chunk keeps the received blocks, and
+          // the rest of them makes a new chunk to be requested
+          logger_->debug("Peer provided blocks {}..{} of {}..{}",
+                         first,
+                         first + received - 1,
+                         first,
+                         last);
+          chunk->last = first + received - 1;
+          download->chunks.insert(std::next(chunk),
+                                  Chunk{chunk->last + 1, last});
+        }
+      }
+    }
+
+    handleChunks(download);
+    schedule(download);
+  }
+
+  void BabeSynchronizerImpl::handleChunks(
+      const std::shared_ptr<Download> &download) {
+    while (not download->finished and not download->chunks.empty()
+           and download->chunks.front().blocks) {
+      auto &chunk = download->chunks.front();
+      if (chunk.blocks->front().header.parent_hash != download->last_hash) {
+        // the peer provided blocks of another chain
+        logger_->debug("Blocks {}..{} do not follow the handled ones",
+                       chunk.first,
+                       chunk.last);
+        peer_stats_[chunk.provider].failures++;
+        chunk.failed.insert(chunk.provider);
+        chunk.blocks = boost::none;
+        return;
+      }
+
+      auto blocks = std::move(chunk.blocks.value());
+      download->last_hash = chunk.last_hash;
+      download->finished = chunk.last == download->to.block_number;
+      download->chunks.pop_front();
+      if (download->finished) {
+        logger_->info("Downloaded blocks up to {}", download->to.block_number);
+      }
+      download->handler(blocks);
+    }
+  }
+
+  void BabeSynchronizerImpl::fallBack(
+      const std::shared_ptr<Download> &download) {
+    download->finished = true;
+    logger_->warn(
+        "No peer provided blocks starting from {}, requesting the rest at once",
+        download->chunks.front().first);
+
+    network::BlocksRequest request{generateRequestId(),
+                                   network::BlocksRequest::kBasicAttributes,
+                                   download->last_hash,
+                                   download->to.block_hash,
+                                   network::Direction::DESCENDING,
+                                   boost::none};
+    pollClients(request, download->authority_index, download->handler);
+  }
+
+  size_t BabeSynchronizerImpl::servingClients() const {
+    return std::count_if(
+        sync_clients_->clients.begin(),
+        sync_clients_->clients.end(),
+        [](const auto &client) { return client->servesRequests(); });
+  }
+
+  boost::optional<BabeSynchronizerImpl::Client>
+  BabeSynchronizerImpl::selectPeer(const Chunk &chunk) {
+    boost::optional<Client> best_client;
+    double best_time = 0;
+    for (const auto &client : sync_clients_->clients) {
+      if (not client->servesRequests() or chunk.failed.count(client) != 0
+          or chunk.requested_from.count(client) != 0) {
+        continue;
+      }
+      const auto &stats = peer_stats_[client];
+      if (stats.requests_in_flight >= kMaxRequestsPerPeer) {
+        continue;
+      }
+      // peers, which were not measured yet, are tried first
+      auto time = stats.measured ? 1000 * (chunk.last - chunk.first + 1)
+                                       / stats.blocks_per_second
+                                 : 0.;
+      time += stats.failures * kFailurePenaltyMs;
+      if (not best_client or time < best_time) {
+        best_client = client;
+        best_time = time;
+      }
+    }
+    return best_client;
+  }
+
   std::shared_ptr<network::SyncProtocolClient>
   BabeSynchronizerImpl::selectNextClient(
       std::unordered_set<std::shared_ptr<network::SyncProtocolClient>>
@@ -109,14 +484,42 @@ namespace kagome::consensus {
         request,
         [self_wp{weak_from_this()},
          request{std::move(request)},
+         authority_index,
          requested_blocks_handler{requested_blocks_handler}](
             auto &&response_res) mutable {
           if (auto self = self_wp.lock()) {
             // if response exists then get blocks and send them to handle
             if (response_res and not response_res.value().blocks.empty()) {
-              auto blocks_opt = getBlocks(response_res.value());
-              if (blocks_opt) {
-                return requested_blocks_handler(blocks_opt.value());
+              auto &response = response_res.value();
+              // the response starts with the block the request starts from,
+              // which the requester already has
+              const auto *from_hash =
+                  boost::get<primitives::BlockHash>(&request.from);
+              if (from_hash and response.blocks.front().hash == *from_hash) {
+                response.blocks.erase(response.blocks.begin());
+              }
+              if (response.blocks.empty()) {
+                self->logger_->error("Could not sync. No new blocks");
+                return;
+              }
+              auto blocks_opt = getBlocks(response);
+              if (not blocks_opt) {
+                return;
+              }
+              requested_blocks_handler(blocks_opt.value());
+
+              // the peer might cut the response by its size limits, then the
+              // rest is requested starting from the last received block
+              const auto &last_hash = response.blocks.back().hash;
+              if (request.to and last_hash != request.to.value()) {
+                self->logger_->debug(
+                    "Received blocks up to {}, requesting the rest",
+                    last_hash.toHex());
+                request.id = generateRequestId();
+                request.from = last_hash;
+                self->pollClients(std::move(request),
+                                  authority_index,
+                                  requested_blocks_handler);
               }
             } else if (not response_res) {
               self->logger_->error("Could not sync. Error: {}",
@@ -8,6 +8,13 @@
 
 #include "consensus/babe/babe_synchronizer.hpp"
 
+#include <chrono>
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <boost/asio/io_context.hpp>
+#include "blockchain/block_header_repository.hpp"
 #include "common/logger.hpp"
 #include "network/types/sync_clients_set.hpp"
 
@@ -15,23 +22,150 @@ namespace kagome::consensus {
 
   /**
    * Implementation of babe synchronizer that requests blocks from provided
-   * peers
+   * peers. Short ranges are requested from the author of the last block at
+   * once; longer ones are split into chunks, which are downloaded from several
+   * peers concurrently and handled in their order
    */
   class BabeSynchronizerImpl
       : public BabeSynchronizer,
         public std::enable_shared_from_this<BabeSynchronizerImpl> {
    public:
+    /// maximal number of blocks requested from a peer at once
+    static constexpr primitives::BlockNumber kChunkSize = 128;
+    /// maximal number of chunks requested from a peer at the same time
+    static constexpr size_t kMaxRequestsPerPeer = 2;
+    /// number of chunks, which are downloaded ahead of the one to be handled
+    /// next, per peer
+    static constexpr size_t kChunksAheadPerPeer = 4;
+    /// time a peer is given to respond to a chunk request, before the chunk
+    /// is requested from another one
+    static constexpr std::chrono::seconds kRequestTimeout{10};
+
+    /**
+     * Performance of a peer observed by the responses to chunk requests
+     */
+    struct PeerStats {
+      /// moving average of the time to respond, ms
+      double latency_ms = 0;
+      /// moving average of the blocks received per second of a request
+      double blocks_per_second = 0;
+      /// number of the chunks the peer failed to provide in a row
+      size_t failures = 0;
+      /// number of the requests awaiting a response
+      size_t requests_in_flight = 0;
+      /// whether any chunk was received from the peer
+      bool measured = false;
+    };
+
     ~BabeSynchronizerImpl() override = default;
 
-    explicit BabeSynchronizerImpl(
-        std::shared_ptr<network::SyncClientsSet> sync_clients);
+    /**
+     * @param io_context runs the timeouts of the chunk requests
+     * @param request_timeout time a peer is given to respond to a chunk
+     * request
+     */
+    BabeSynchronizerImpl(
+        std::shared_ptr<network::SyncClientsSet> sync_clients,
+        std::shared_ptr<blockchain::BlockHeaderRepository> block_headers,
+        std::shared_ptr<boost::asio::io_context> io_context,
+        std::chrono::milliseconds request_timeout);
 
     void request(const primitives::BlockId &from,
-                 const primitives::BlockHash &to,
+                 const primitives::BlockInfo &to,
                  primitives::AuthorityIndex authority_index,
                  const BlocksHandler &block_list_handler) override;
 
+    /**
+     * @return performance of the peer, if it was requested for chunks
+     */
+    boost::optional<PeerStats> getPeerStats(
+        const std::shared_ptr<network::SyncProtocolClient> &client) const;
+
    private:
+    using Client = std::shared_ptr<network::SyncProtocolClient>;
+
+    /**
+     * Consecutive blocks of a range, which are requested by one request
+     */
+    struct Chunk {
+      primitives::BlockNumber first;
+      primitives::BlockNumber last;
+      /// peers, which are requested for the chunk at the moment
+      std::unordered_set<Client> requested_from;
+      /// peers, which failed to provide the chunk
+      std::unordered_set<Client> failed;
+      /// received blocks, hash of the last one and the peer provided them
+      boost::optional<std::vector<primitives::Block>> blocks;
+      primitives::BlockHash last_hash;
+      Client provider;
+    };
+
+    /**
+     * State of the download of a long range
+     */
+    struct Download {
+      primitives::BlockInfo to;
+      primitives::AuthorityIndex authority_index;
+      BlocksHandler handler;
+      /// chunks, which are not handled yet, in their order
+      std::deque<Chunk> chunks;
+      /// number of the first block, which is not in a chunk yet
+      primitives::BlockNumber next_number;
+      /// hash of the last handled block, the parent of the next one
+      primitives::BlockHash last_hash;
+      bool finished = false;
+    };
+
+    /**
+     * Splits the range into chunks and requests them from the peers
+     * @return false if the range cannot be split, as the first block is
+     * unknown
+     */
+    bool download(const primitives::BlockId &from,
+                  const primitives::BlockInfo &to,
+                  primitives::AuthorityIndex authority_index,
+                  const BlocksHandler &block_list_handler);
+
+    /**
+     * Requests the chunks, which are not requested yet, from the idle peers
+     * in the order of the chunks. Idle peers left also request the chunk to
+     * be handled next, in case its peer is slow
+     */
+    void schedule(const std::shared_ptr<Download> &download);
+
+    void requestChunk(const std::shared_ptr<Download> &download,
+                      Chunk &chunk,
+                      const Client &client);
+
+    void onChunk(const std::shared_ptr<Download> &download,
+                 primitives::BlockNumber first,
+                 const Client &client,
+                 std::chrono::steady_clock::time_point start,
+                 outcome::result<network::BlocksResponse> response_res);
+
+    /**
+     * Passes the received chunks, which follow the handled blocks, to the
+     * handler
+     */
+    void handleChunks(const std::shared_ptr<Download> &download);
+
+    /**
+     * Requests the rest of the range from the author of the last block at
+     * once, as no peer could provide the next chunk
+     */
+    void fallBack(const std::shared_ptr<Download> &download);
+
+    /**
+     * @return number of the peers, which serve the requests
+     */
+    size_t servingClients() const;
+
+    /**
+     * @return an idle peer, which is expected to provide the chunk the
+     * fastest, if any
+     */
+    boost::optional<Client> selectPeer(const Chunk &chunk);
+
     /**
      * Select next client to be polled
      * @param polled_clients clients that we already polled
@@ -51,6 +185,10 @@ namespace kagome::consensus {
                      const BlocksHandler &requested_blocks_handler) const;
 
     std::shared_ptr<network::SyncClientsSet> sync_clients_;
+    std::shared_ptr<blockchain::BlockHeaderRepository> block_headers_;
+    std::shared_ptr<boost::asio::io_context> io_context_;
+    std::chrono::milliseconds request_timeout_;
+    std::unordered_map<Client, PeerStats> peer_stats_;
     common::Logger logger_;
   };
 }  // namespace kagome::consensus
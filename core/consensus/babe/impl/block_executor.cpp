@@ -6,6 +6,7 @@
 #include "consensus/babe/impl/block_executor.hpp"
 
 #include <chrono>
+#include <deque>
 
 #include "blockchain/block_tree_error.hpp"
 #include "consensus/babe/impl/babe_digests_util.hpp"
@@ -25,7 +26,8 @@ namespace kagome::consensus {
       std::shared_ptr<transaction_pool::TransactionPool> tx_pool,
       std::shared_ptr<crypto::Hasher> hasher,
       std::shared_ptr<authority::AuthorityUpdateObserver>
-          authority_update_observer)
+          authority_update_observer,
+      std::shared_ptr<BlockImportPool> import_pool)
       : block_tree_{std::move(block_tree)},
         core_{std::move(core)},
         genesis_configuration_{std::move(configuration)},
@@ -35,6 +37,7 @@ namespace kagome::consensus {
         tx_pool_{std::move(tx_pool)},
         hasher_{std::move(hasher)},
         authority_update_observer_{std::move(authority_update_observer)},
+        import_pool_{std::move(import_pool)},
         logger_{common::createLogger("BlockExecutor")} {
     BOOST_ASSERT(block_tree_ != nullptr);
     BOOST_ASSERT(core_ != nullptr);
@@ -67,11 +70,15 @@ namespace kagome::consensus {
         const auto &[last_number, last_hash] = block_tree_->getLastFinalized();
         // we should request blocks between last finalized one and received
         // block
-        requestBlocks(
-            last_hash, block_hash, babe_header.authority_index, [] {});
+        requestBlocks(last_hash,
+                      {header.number, block_hash},
+                      babe_header.authority_index,
+                      [] {});
       } else {
-        requestBlocks(
-            header.parent_hash, block_hash, babe_header.authority_index, [] {});
+        requestBlocks(header.parent_hash,
+                      {header.number, block_hash},
+                      babe_header.authority_index,
+                      [] {});
       }
     }
   }
@@ -84,13 +91,13 @@ namespace kagome::consensus {
     BOOST_ASSERT(new_header.number >= last_number);
     auto [_, babe_header] = getBabeDigests(new_header).value();
     return requestBlocks(last_hash,
-                         new_block_hash,
+                         {new_header.number, new_block_hash},
                          babe_header.authority_index,
                          std::move(next));
   }
 
   void BlockExecutor::requestBlocks(const primitives::BlockId &from,
-                                    const primitives::BlockHash &to,
+                                    const primitives::BlockInfo &to,
                                     primitives::AuthorityIndex authority_index,
                                     std::function<void()> &&next) {
     babe_synchronizer_->request(
@@ -98,9 +105,12 @@ namespace kagome::consensus {
         to,
         authority_index,
         [self_wp{weak_from_this()},
-         next(std::move(next))](const std::vector<primitives::Block> &blocks) {
+         last_number{to.block_number},
+         next(std::move(next)),
+         done{std::make_shared<bool>(false)}](
+            const std::vector<primitives::Block> &blocks) {
           auto self = self_wp.lock();
-          if (not self) return;
+          if (not self or *done) return;
 
           if (blocks.empty()) {
             self->logger_->warn("Received empty list of blocks");
@@ -117,29 +127,130 @@ namespace kagome::consensus {
                                 front_block_hex,
                                 back_block_hex);
           }
-          for (const auto &block : blocks) {
-            if (auto apply_res = self->applyBlock(block); not apply_res) {
-              if (apply_res
-                  == outcome::failure(
-                      blockchain::BlockTreeError::BLOCK_EXISTS)) {
-                continue;
-              }
-              self->logger_->warn(
-                  "Could not apply block during synchronizing slots.Error: {}",
-                  apply_res.error().message());
-              break;
-            }
+          // the blocks might come in several parts, the sync is done once the
+          // last one is applied or a block could not be applied
+          if (not self->applyBlocks(blocks) or blocks.empty()
+              or blocks.back().header.number >= last_number) {
+            *done = true;
+            next();
           }
-          next();
         });
   }
 
+  bool BlockExecutor::applyBlocks(
+      const std::vector<primitives::Block> &blocks) {
+    auto lookahead = import_pool_ ? import_pool_->lookahead() : 1;
+    std::unordered_map<EpochIndex, NextEpochDescriptor> announced_epochs;
+    std::deque<std::future<PreparedBlock>> prepared_blocks;
+    size_t next_to_prepare = 0;
+    auto applied = true;
+
+    for (const auto &block : blocks) {
+      while (next_to_prepare < blocks.size()
+             and prepared_blocks.size() < lookahead) {
+        const auto &next = blocks[next_to_prepare++];
+        // contexts are found in the order of the blocks, so that the epochs
+        // announced by the previous blocks are known
+        auto prepare = [this,
+                        &next,
+                        context = validationContext(next.header,
+                                                    announced_epochs)] {
+          return prepareBlock(next, context);
+        };
+        prepared_blocks.push_back(
+            import_pool_ ? import_pool_->submit(std::move(prepare))
+                         : std::async(std::launch::deferred, std::move(prepare)));
+      }
+
+      auto prepared = prepared_blocks.front().get();
+      prepared_blocks.pop_front();
+      if (auto apply_res = applyBlock(block, std::move(prepared));
+          not apply_res) {
+        if (apply_res
+            == outcome::failure(blockchain::BlockTreeError::BLOCK_EXISTS)) {
+          continue;
+        }
+        logger_->warn(
+            "Could not apply block during synchronizing slots.Error: {}",
+            apply_res.error().message());
+        applied = false;
+        break;
+      }
+    }
+
+    // the blocks being prepared have to outlive the preparation
+    for (auto &prepared : prepared_blocks) {
+      prepared.wait();
+    }
+    return applied;
+  }
+
+  outcome::result<BlockExecutor::HeaderValidationContext>
+  BlockExecutor::validationContext(
+      const primitives::BlockHeader &header,
+      std::unordered_map<EpochIndex, NextEpochDescriptor> &announced_epochs)
+      const {
+    OUTCOME_TRY(babe_digests, getBabeDigests(header));
+    auto &babe_header = babe_digests.second;
+    auto epoch_index =
+        babe_header.slot_number / genesis_configuration_->epoch_length;
+
+    // TODO (kamilsa): PRE-364 fail if the epoch is unknown instead of taking
+    // authorities and randomness from config
+    NextEpochDescriptor epoch_descriptor{
+        .authorities = genesis_configuration_->genesis_authorities,
+        .randomness = genesis_configuration_->randomness};
+    if (auto it = announced_epochs.find(epoch_index);
+        it != announced_epochs.end()) {
+      epoch_descriptor = it->second;
+    } else if (auto stored = epoch_storage_->getEpochDescriptor(epoch_index)) {
+      epoch_descriptor = std::move(stored.value());
+    }
+
+    if (auto next_epoch_digest_res = getNextEpochDigest(header)) {
+      announced_epochs[epoch_index + 2] =
+          std::move(next_epoch_digest_res.value());
+    }
+
+    auto threshold = calculateThreshold(genesis_configuration_->leadership_rate,
+                                        epoch_descriptor.authorities,
+                                        babe_header.authority_index);
+    return HeaderValidationContext{
+        epoch_descriptor.authorities[babe_header.authority_index].id,
+        threshold,
+        epoch_descriptor.randomness};
+  }
+
+  BlockExecutor::PreparedBlock BlockExecutor::prepareBlock(
+      const primitives::Block &block,
+      const outcome::result<HeaderValidationContext> &context) const {
+    PreparedBlock prepared{
+        hasher_->blake2b_256(scale::encode(block.header).value()),
+        outcome::success(),
+        {}};
+    if (context) {
+      prepared.header_validation =
+          block_validator_->validateHeader(block.header,
+                                           context.value().authority_id,
+                                           context.value().threshold,
+                                           context.value().randomness);
+    } else {
+      prepared.header_validation = context.error();
+    }
+    prepared.extrinsic_hashes.reserve(block.body.size());
+    for (const auto &extrinsic : block.body) {
+      prepared.extrinsic_hashes.push_back(
+          hasher_->blake2b_256(extrinsic.data));
+    }
+    return prepared;
+  }
+
   outcome::result<void> BlockExecutor::applyBlock(
-      const primitives::Block &block) {
+      const primitives::Block &block, PreparedBlock prepared) {
     // get current time to measure performance if block execution
     auto t_start = std::chrono::high_resolution_clock::now();
 
-    auto block_hash = hasher_->blake2b_256(scale::encode(block.header).value());
+    const auto &block_hash = prepared.hash;
 
     // check if block body already exists. If so, do not apply
     if (block_tree_->getBlockBody(block_hash)) {
@@ -155,31 +266,11 @@ namespace kagome::consensus {
                   block_hash.toHex());
 
     OUTCOME_TRY(babe_digests, getBabeDigests(block.header));
-
-    auto [seal, babe_header] = babe_digests;
+    auto &babe_header = babe_digests.second;
 
     auto epoch_index =
         babe_header.slot_number / genesis_configuration_->epoch_length;
 
-    // TODO (kamilsa): PRE-364 uncomment outcome try and remove dirty workaround
-    // below
-    //    OUTCOME_TRY(this_block_epoch_descriptor,
-    //                epoch_storage_->getEpochDescriptor(epoch_index));
-    auto this_block_epoch_descriptor_res =
-        epoch_storage_->getEpochDescriptor(epoch_index);
-    if (not this_block_epoch_descriptor_res) {  // take authorities and
-                                                // randomness
-                                                // from config
-      this_block_epoch_descriptor_res = NextEpochDescriptor{
-          .authorities = genesis_configuration_->genesis_authorities,
-          .randomness = genesis_configuration_->randomness};
-    }
-    auto this_block_epoch_descriptor = this_block_epoch_descriptor_res.value();
-
-    auto threshold = calculateThreshold(genesis_configuration_->leadership_rate,
-                                        this_block_epoch_descriptor.authorities,
-                                        babe_header.authority_index);
-
     // update authorities and randomnesss
     auto next_epoch_digest_res = getNextEpochDigest(block.header);
     if (next_epoch_digest_res) {
@@ -189,11 +280,7 @@ namespace kagome::consensus {
           .value();
     }
 
-    OUTCOME_TRY(block_validator_->validateHeader(
-        block.header,
-        this_block_epoch_descriptor.authorities[babe_header.authority_index].id,
-        threshold,
-        this_block_epoch_descriptor.randomness));
+    OUTCOME_TRY(prepared.header_validation);
 
     auto block_without_seal_digest = block;
 
@@ -220,8 +307,8 @@ namespace kagome::consensus {
     }
 
     // remove block's extrinsics from tx pool
-    for (const auto &extrinsic : block.body) {
-      auto res = tx_pool_->removeOne(hasher_->blake2b_256(extrinsic.data));
+    for (const auto &extrinsic_hash : prepared.extrinsic_hashes) {
+      auto res = tx_pool_->removeOne(extrinsic_hash);
       if (res.has_error()
           && res
                  != outcome::failure(
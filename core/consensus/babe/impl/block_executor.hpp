@@ -6,11 +6,15 @@
 #ifndef KAGOME_CORE_CONSENSUS_BABE_IMPL_BLOCK_EXECUTOR_HPP
 #define KAGOME_CORE_CONSENSUS_BABE_IMPL_BLOCK_EXECUTOR_HPP
 
+#include <future>
+#include <unordered_map>
+
 #include "blockchain/block_tree.hpp"
 #include "common/logger.hpp"
 #include "consensus/authority/authority_update_observer.hpp"
 #include "consensus/babe/babe_synchronizer.hpp"
 #include "consensus/babe/epoch_storage.hpp"
+#include "consensus/babe/impl/block_import_pool.hpp"
 #include "consensus/validation/block_validator.hpp"
 #include "crypto/hasher.hpp"
 #include "primitives/babe_configuration.hpp"
@@ -31,7 +35,8 @@ namespace kagome::consensus {
                   std::shared_ptr<transaction_pool::TransactionPool> tx_pool,
                   std::shared_ptr<crypto::Hasher> hasher,
                   std::shared_ptr<authority::AuthorityUpdateObserver>
-                      authority_update_observer);
+                      authority_update_observer,
+                  std::shared_ptr<BlockImportPool> import_pool = nullptr);
 
     /**
      * Processes next header: if header is observed first it is added to the
@@ -61,13 +66,60 @@ namespace kagome::consensus {
      * @param next action after the sync is done
      */
     void requestBlocks(const primitives::BlockId &from,
-                       const primitives::BlockHash &to,
+                       const primitives::BlockInfo &to,
                        primitives::AuthorityIndex authority_index,
                        std::function<void()> &&next);
 
    private:
+    /**
+     * Authority, threshold and randomness the header of a block is validated
+     * with
+     */
+    struct HeaderValidationContext {
+      primitives::AuthorityId authority_id;
+      Threshold threshold;
+      Randomness randomness;
+    };
+
+    /**
+     * Results of the processing of a block, which does not depend on the
+     * execution of the blocks before it
+     */
+    struct PreparedBlock {
+      primitives::BlockHash hash;
+      outcome::result<void> header_validation;
+      std::vector<common::Hash256> extrinsic_hashes;
+    };
+
+    /**
+     * Imports the blocks in their order, while the next ones are prepared by
+     * the import pool, if any
+     * @return false if a block could not be applied
+     */
+    bool applyBlocks(const std::vector<primitives::Block> &blocks);
+
+    /**
+     * Finds the context to validate the header with
+     * @param announced_epochs descriptors of the epochs announced by the
+     * previous blocks of the batch, which are not stored before the blocks
+     * are applied; the epoch announced by the header is added to them
+     */
+    outcome::result<HeaderValidationContext> validationContext(
+        const primitives::BlockHeader &header,
+        std::unordered_map<EpochIndex, NextEpochDescriptor> &announced_epochs)
+        const;
+
+    /**
+     * Hashes the block and its extrinsics and validates its header. Is safe
+     * to be called from any thread
+     */
+    PreparedBlock prepareBlock(
+        const primitives::Block &block,
+        const outcome::result<HeaderValidationContext> &context) const;
+
     // should only be invoked when parent of block exists
-    outcome::result<void> applyBlock(const primitives::Block &block);
+    outcome::result<void> applyBlock(const primitives::Block &block,
+                                     PreparedBlock prepared);
 
     std::shared_ptr<blockchain::BlockTree> block_tree_;
     std::shared_ptr<runtime::Core> core_;
@@ -79,6 +131,7 @@ namespace kagome::consensus {
     std::shared_ptr<crypto::Hasher> hasher_;
     std::shared_ptr<authority::AuthorityUpdateObserver>
         authority_update_observer_;
+    std::shared_ptr<BlockImportPool> import_pool_;
     common::Logger logger_;
   };
 
@@ -0,0 +1,43 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_CONSENSUS_BABE_IMPL_BLOCK_IMPORT_POOL_HPP
+#define KAGOME_CORE_CONSENSUS_BABE_IMPL_BLOCK_IMPORT_POOL_HPP
+
+#include "common/thread_pool.hpp"
+
+namespace kagome::consensus {
+
+  /**
+   * Worker threads, which hash and verify the blocks of a synchronized batch
+   * ahead of the block being executed
+   */
+  class BlockImportPool : public common::ThreadPool {
+   public:
+    /**
+     * Number of blocks prepared ahead of the executed one by default
+     */
+    static constexpr size_t kDefaultLookahead = 64;
+
+    /**
+     * @param threads number of worker threads
+     * @param lookahead maximal number of blocks prepared ahead of the
+     * executed one
+     */
+    explicit BlockImportPool(size_t threads,
+                             size_t lookahead = kDefaultLookahead)
+        : ThreadPool{threads}, lookahead_{lookahead} {}
+
+    size_t lookahead() const {
+      return lookahead_;
+    }
+
+   private:
+    size_t lookahead_;
+  };
+
+}  // namespace kagome::consensus
+
+#endif  // KAGOME_CORE_CONSENSUS_BABE_IMPL_BLOCK_IMPORT_POOL_HPP
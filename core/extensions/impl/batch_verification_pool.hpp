@@ -0,0 +1,28 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_EXTENSIONS_BATCH_VERIFICATION_POOL_HPP
+#define KAGOME_EXTENSIONS_BATCH_VERIFICATION_POOL_HPP
+
+#include "common/thread_pool.hpp"
+
+namespace kagome::extensions {
+
+  /**
+   * Worker threads, which verify the signatures of the batches started by
+   * runtime calls while the calls go on. Shared by the runtime calls of all
+   * threads
+   */
+  class BatchVerificationPool : public common::ThreadPool {
+   public:
+    /**
+     * @param threads number of worker threads
+     */
+    explicit BatchVerificationPool(size_t threads) : ThreadPool{threads} {}
+  };
+
+}  // namespace kagome::extensions
+
+#endif  // KAGOME_EXTENSIONS_BATCH_VERIFICATION_POOL_HPP
@@ -10,6 +10,7 @@
 #include <gsl/span>
 
 #include <boost/assert.hpp>
+#include "common/hexutil.hpp"
 #include "crypto/bip39/bip39_provider.hpp"
 #include "crypto/bip39/mnemonic.hpp"
 #include "crypto/crypto_store.hpp"
@@ -41,7 +42,8 @@ namespace kagome::extensions {
       std::shared_ptr<crypto::Secp256k1Provider> secp256k1_provider,
       std::shared_ptr<crypto::Hasher> hasher,
       std::shared_ptr<crypto::CryptoStore> crypto_store,
-      std::shared_ptr<crypto::Bip39Provider> bip39_provider)
+      std::shared_ptr<crypto::Bip39Provider> bip39_provider,
+      std::shared_ptr<BatchVerificationPool> verification_pool)
       : memory_(std::move(memory)),
         sr25519_provider_(std::move(sr25519_provider)),
         ed25519_provider_(std::move(ed25519_provider)),
@@ -49,6 +51,7 @@ namespace kagome::extensions {
         hasher_(std::move(hasher)),
         crypto_store_(std::move(crypto_store)),
         bip39_provider_(std::move(bip39_provider)),
+        verification_pool_(std::move(verification_pool)),
         logger_{common::createLogger("CryptoExtension")} {
     BOOST_ASSERT(memory_ != nullptr);
     BOOST_ASSERT(sr25519_provider_ != nullptr);
@@ -57,13 +60,14 @@ namespace kagome::extensions {
     BOOST_ASSERT(hasher_ != nullptr);
     BOOST_ASSERT(crypto_store_ != nullptr);
     BOOST_ASSERT(bip39_provider_ != nullptr);
+    BOOST_ASSERT(verification_pool_ != nullptr);
     BOOST_ASSERT(logger_ != nullptr);
   }
 
   void CryptoExtension::ext_blake2_128(runtime::WasmPointer data,
                                        runtime::WasmSize len,
                                        runtime::WasmPointer out_ptr) {
-    const auto &buf = memory_->loadN(data, len);
+    auto buf = memory_->view(data, len);
 
     auto hash = hasher_->blake2b_128(buf);
 
@@ -73,7 +77,7 @@ namespace kagome::extensions {
   void CryptoExtension::ext_blake2_256(runtime::WasmPointer data,
                                        runtime::WasmSize len,
                                        runtime::WasmPointer out_ptr) {
-    const auto &buf = memory_->loadN(data, len);
+    auto buf = memory_->view(data, len);
 
     auto hash = hasher_->blake2b_256(buf);
 
@@ -83,7 +87,7 @@ namespace kagome::extensions {
   void CryptoExtension::ext_keccak_256(runtime::WasmPointer data,
                                        runtime::WasmSize len,
                                        runtime::WasmPointer out_ptr) {
-    const auto &buf = memory_->loadN(data, len);
+    auto buf = memory_->view(data, len);
 
     auto hash = hasher_->keccak_256(buf);
 
@@ -103,11 +107,13 @@ namespace kagome::extensions {
       throw std::runtime_error("No batch_verify is started");
     }
 
-    auto &verification_queue = batch_verify_.value();
+    // the batch is over whatever the result, the verifications, which are
+    // still running when a failed one is met, are not waited for
+    auto verification_queue = std::move(batch_verify_.value());
+    batch_verify_.reset();
     while (not verification_queue.empty()) {
       auto single_verification_result = verification_queue.front().get();
       if (single_verification_result == kLegacyVerifyFail) {
-        batch_verify_.reset();
         return kVerifyBatchFail;
       }
       BOOST_ASSERT_MSG(single_verification_result == kLegacyVerifySuccess,
@@ -123,46 +129,44 @@ namespace kagome::extensions {
       runtime::WasmSize msg_len,
       runtime::WasmPointer sig_data,
       runtime::WasmPointer pubkey_data) {
-    auto msg = memory_->loadN(msg_data, msg_len);
-    auto sig_bytes =
-        memory_->loadN(sig_data, ed25519_constants::SIGNATURE_SIZE).toVector();
+    auto msg = memory_->view(msg_data, msg_len);
 
-    auto signature_res = crypto::Ed25519Signature::fromSpan(sig_bytes);
+    auto signature_res = crypto::Ed25519Signature::fromSpan(
+        memory_->view(sig_data, ed25519_constants::SIGNATURE_SIZE));
     if (!signature_res) {
       BOOST_UNREACHABLE_RETURN(kEd25519LegacyVerifyFail);
     }
     auto &&signature = signature_res.value();
 
-    auto pubkey_bytes =
-        memory_->loadN(pubkey_data, ed25519_constants::PUBKEY_SIZE).toVector();
-    auto pubkey_res = crypto::Ed25519PublicKey::fromSpan(pubkey_bytes);
+    auto pubkey_res = crypto::Ed25519PublicKey::fromSpan(
+        memory_->view(pubkey_data, ed25519_constants::PUBKEY_SIZE));
     if (!pubkey_res) {
       BOOST_UNREACHABLE_RETURN(kEd25519LegacyVerifyFail);
     }
     auto pubkey = pubkey_res.value();
 
-    auto verifier = [self_weak = weak_from_this(),
-                     signature = std::move(signature),
-                     msg = std::move(msg),
-                     pubkey = std::move(pubkey)]() mutable {
-      auto self = self_weak.lock();
-      if (not self) {
-        BOOST_UNREACHABLE_RETURN(kEd25519LegacyVerifyFail);
-      }
-
-      auto result = self->ed25519_provider_->verify(signature, msg, pubkey);
+    auto verify = [provider = ed25519_provider_,
+                   signature = std::move(signature),
+                   pubkey = std::move(pubkey)](
+                      gsl::span<const uint8_t> msg) {
+      auto result = provider->verify(signature, msg, pubkey);
       auto is_succeeded = result && result.value();
 
       return is_succeeded ? kLegacyVerifySuccess : kLegacyVerifyFail;
     };
     if (batch_verify_.has_value()) {
+      // owns everything it needs, as it is run by a worker thread, while the
+      // wasm memory may change
+      auto verifier = [verify = std::move(verify), msg = common::Buffer{msg}] {
+        return verify(msg);
+      };
       auto &verification_queue = batch_verify_.value();
       verification_queue.emplace(
-          std::async(std::launch::deferred, std::move(verifier)));
+          verification_pool_->submit(std::move(verifier)));
       return kLegacyVerifySuccess;
     }
 
-    return verifier();
+    return verify(msg);
   }
 
   runtime::WasmSize CryptoExtension::ext_sr25519_verify(
@@ -170,55 +174,52 @@ namespace kagome::extensions {
       runtime::WasmSize msg_len,
       runtime::WasmPointer sig_data,
       runtime::WasmPointer pubkey_data) {
-    auto msg = memory_->loadN(msg_data, msg_len);
-    auto signature_buffer =
-        memory_->loadN(sig_data, sr25519_constants::SIGNATURE_SIZE);
+    auto msg = memory_->view(msg_data, msg_len);
+    auto signature_bytes =
+        memory_->view(sig_data, sr25519_constants::SIGNATURE_SIZE);
 
-    auto pubkey_buffer =
-        memory_->loadN(pubkey_data, sr25519_constants::PUBLIC_SIZE);
-    auto key_res = crypto::Sr25519PublicKey::fromSpan(pubkey_buffer);
+    auto key_res = crypto::Sr25519PublicKey::fromSpan(
+        memory_->view(pubkey_data, sr25519_constants::PUBLIC_SIZE));
     if (!key_res) {
       BOOST_UNREACHABLE_RETURN(kSr25519LegacyVerifyFail)
     }
     auto &&key = key_res.value();
 
     crypto::Sr25519Signature signature{};
-    std::copy_n(signature_buffer.begin(),
+    std::copy_n(signature_bytes.begin(),
                 sr25519_constants::SIGNATURE_SIZE,
                 signature.begin());
 
-    auto verifier = [self_weak = weak_from_this(),
-                     signature = std::move(signature),
-                     msg = std::move(msg),
-                     pubkey = std::move(key)]() mutable {
-      auto self = self_weak.lock();
-      if (not self) {
-        BOOST_ASSERT(!"This is unreachable");
-      }
-
-      auto res = self->sr25519_provider_->verify(signature, msg, pubkey);
+    auto verify = [provider = sr25519_provider_,
+                   signature = std::move(signature),
+                   pubkey = std::move(key)](gsl::span<const uint8_t> msg) {
+      auto res = provider->verify(signature, msg, pubkey);
       bool is_succeeded = res && res.value();
       return is_succeeded ? kLegacyVerifySuccess : kLegacyVerifyFail;
     };
     if (batch_verify_.has_value()) {
+      // owns everything it needs, as it is run by a worker thread, while the
+      // wasm memory may change
+      auto verifier = [verify = std::move(verify), msg = common::Buffer{msg}] {
+        return verify(msg);
+      };
       auto &verification_queue = batch_verify_.value();
       verification_queue.emplace(
-          std::async(std::launch::deferred, std::move(verifier)));
+          verification_pool_->submit(std::move(verifier)));
       return kLegacyVerifySuccess;
     }
 
-    return verifier();
+    return verify(msg);
   }
 
   void CryptoExtension::ext_twox_64(runtime::WasmPointer data,
                                     runtime::WasmSize len,
                                     runtime::WasmPointer out_ptr) {
-    const auto &buf = memory_->loadN(data, len);
+    auto buf = memory_->view(data, len);
 
     auto hash = hasher_->twox_64(buf);
-    logger_->trace("twox64. Data: {}, Data hex: {}, hash: {}",
-                   buf.data(),
-                   buf.toHex(),
+    logger_->trace("twox64. Data hex: {}, hash: {}",
+                   common::hex_lower(buf),
                    hash.toHex());
 
     memory_->storeBuffer(out_ptr, hash);
@@ -227,12 +228,11 @@ namespace kagome::extensions {
   void CryptoExtension::ext_twox_128(runtime::WasmPointer data,
                                      runtime::WasmSize len,
                                      runtime::WasmPointer out_ptr) {
-    const auto &buf = memory_->loadN(data, len);
+    auto buf = memory_->view(data, len);
 
     auto hash = hasher_->twox_128(buf);
-    logger_->trace("twox128. Data: {}, Data hex: {}, hash: {}",
-                   buf.data(),
-                   buf.toHex(),
+    logger_->trace("twox128. Data hex: {}, hash: {}",
+                   common::hex_lower(buf),
                    hash.toHex());
 
     memory_->storeBuffer(out_ptr, common::Buffer(hash));
@@ -241,7 +241,7 @@ namespace kagome::extensions {
   void CryptoExtension::ext_twox_256(runtime::WasmPointer data,
                                      runtime::WasmSize len,
                                      runtime::WasmPointer out_ptr) {
-    const auto &buf = memory_->loadN(data, len);
+    auto buf = memory_->view(data, len);
 
     auto hash = hasher_->twox_256(buf);
 
@@ -253,7 +253,7 @@ namespace kagome::extensions {
   runtime::WasmPointer CryptoExtension::ext_hashing_keccak_256_version_1(
       runtime::WasmSpan data) {
     auto [ptr, size] = runtime::WasmResult(data);
-    const auto &buf = memory_->loadN(ptr, size);
+    auto buf = memory_->view(ptr, size);
     auto hash = hasher_->keccak_256(buf);
 
     return memory_->storeBuffer(hash);
@@ -262,7 +262,7 @@ namespace kagome::extensions {
   runtime::WasmPointer CryptoExtension::ext_hashing_sha2_256_version_1(
       runtime::WasmSpan data) {
     auto [ptr, size] = runtime::WasmResult(data);
-    const auto &buf = memory_->loadN(ptr, size);
+    auto buf = memory_->view(ptr, size);
     auto hash = hasher_->sha2_256(buf);
 
     return memory_->storeBuffer(hash);
@@ -271,7 +271,7 @@ namespace kagome::extensions {
   runtime::WasmPointer CryptoExtension::ext_hashing_blake2_128_version_1(
       runtime::WasmSpan data) {
     auto [ptr, size] = runtime::WasmResult(data);
-    const auto &buf = memory_->loadN(ptr, size);
+    auto buf = memory_->view(ptr, size);
     auto hash = hasher_->blake2b_128(buf);
 
     return memory_->storeBuffer(hash);
@@ -280,7 +280,7 @@ namespace kagome::extensions {
   runtime::WasmPointer CryptoExtension::ext_hashing_blake2_256_version_1(
       runtime::WasmSpan data) {
     auto [ptr, size] = runtime::WasmResult(data);
-    const auto &buf = memory_->loadN(ptr, size);
+    auto buf = memory_->view(ptr, size);
     auto hash = hasher_->blake2b_256(buf);
 
     return memory_->storeBuffer(hash);
@@ -289,7 +289,7 @@ namespace kagome::extensions {
   runtime::WasmPointer CryptoExtension::ext_hashing_twox_64_version_1(
       runtime::WasmSpan data) {
     auto [ptr, size] = runtime::WasmResult(data);
-    const auto &buf = memory_->loadN(ptr, size);
+    auto buf = memory_->view(ptr, size);
     auto hash = hasher_->twox_64(buf);
 
     return memory_->storeBuffer(hash);
@@ -298,7 +298,7 @@ namespace kagome::extensions {
   runtime::WasmPointer CryptoExtension::ext_hashing_twox_128_version_1(
       runtime::WasmSpan data) {
     auto [ptr, size] = runtime::WasmResult(data);
-    const auto &buf = memory_->loadN(ptr, size);
+    auto buf = memory_->view(ptr, size);
     auto hash = hasher_->twox_128(buf);
 
     return memory_->storeBuffer(hash);
@@ -307,7 +307,7 @@ namespace kagome::extensions {
   runtime::WasmPointer CryptoExtension::ext_hashing_twox_256_version_1(
       runtime::WasmSpan data) {
     auto [ptr, size] = runtime::WasmResult(data);
-    const auto &buf = memory_->loadN(ptr, size);
+    auto buf = memory_->view(ptr, size);
     auto hash = hasher_->twox_256(buf);
 
     return memory_->storeBuffer(hash);
@@ -384,7 +384,7 @@ namespace kagome::extensions {
     }
 
     auto [seed_ptr, seed_len] = runtime::WasmResult(seed);
-    auto seed_buffer = memory_->loadN(seed_ptr, seed_len);
+    auto seed_buffer = memory_->view(seed_ptr, seed_len);
     auto seed_res = scale::decode<boost::optional<std::string>>(seed_buffer);
     if (!seed_res) {
       logger_->error("failed to decode seed");
@@ -425,9 +425,10 @@ namespace kagome::extensions {
                     common::int_to_hex(key_type_id, 8));
     }
 
-    auto public_buffer = memory_->loadN(key, crypto::Ed25519PublicKey::size());
+    auto public_buffer = memory_->view(key, crypto::Ed25519PublicKey::size());
     auto [msg_data, msg_len] = runtime::WasmResult(msg);
-    auto msg_buffer = memory_->loadN(msg_data, msg_len);
+    // stays valid, as the memory is not changed before the message is signed
+    auto msg_buffer = memory_->view(msg_data, msg_len);
     auto pk = crypto::Ed25519PublicKey::fromSpan(public_buffer);
     if (!pk) {
       BOOST_UNREACHABLE_RETURN({});
@@ -497,7 +498,7 @@ namespace kagome::extensions {
     }
 
     auto [seed_ptr, seed_len] = runtime::WasmResult(seed);
-    auto seed_buffer = memory_->loadN(seed_ptr, seed_len);
+    auto seed_buffer = memory_->view(seed_ptr, seed_len);
     auto seed_res = scale::decode<boost::optional<std::string>>(seed_buffer);
     if (!seed_res) {
       logger_->error("failed to decode seed");
@@ -543,9 +544,10 @@ namespace kagome::extensions {
                     common::int_to_hex(key_type_id, 8));
     }
 
-    auto public_buffer = memory_->loadN(key, crypto::Sr25519PublicKey::size());
+    auto public_buffer = memory_->view(key, crypto::Sr25519PublicKey::size());
     auto [msg_data, msg_len] = runtime::WasmResult(msg);
-    auto msg_buffer = memory_->loadN(msg_data, msg_len);
+    // stays valid, as the memory is not changed before the message is signed
+    auto msg_buffer = memory_->view(msg_data, msg_len);
     auto pk = crypto::Sr25519PublicKey::fromSpan(public_buffer);
     if (!pk) {
       // error is not possible, since we loaded correct number of bytes
@@ -615,8 +617,8 @@ namespace kagome::extensions {
     constexpr auto signature_size = RSVSignature::size();
     constexpr auto message_size = MessageHash::size();
 
-    auto sig_buffer = memory_->loadN(sig, signature_size);
-    auto msg_buffer = memory_->loadN(msg, message_size);
+    auto sig_buffer = memory_->view(sig, signature_size);
+    auto msg_buffer = memory_->view(msg, message_size);
 
     auto signature = RSVSignature::fromSpan(sig_buffer).value();
     auto message = MessageHash::fromSpan(msg_buffer).value();
@@ -654,8 +656,8 @@ namespace kagome::extensions {
     constexpr auto signature_size = RSVSignature::size();
     constexpr auto message_size = MessageHash::size();
 
-    auto sig_buffer = memory_->loadN(sig, signature_size);
-    auto msg_buffer = memory_->loadN(msg, message_size);
+    auto sig_buffer = memory_->view(sig, signature_size);
+    auto msg_buffer = memory_->view(msg, message_size);
 
     auto signature = RSVSignature::fromSpan(sig_buffer).value();
     auto message = MessageHash::fromSpan(msg_buffer).value();
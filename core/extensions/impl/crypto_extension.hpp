@@ -13,6 +13,7 @@
 #include "common/logger.hpp"
 #include "crypto/bip39/bip39_types.hpp"
 #include "crypto/crypto_store.hpp"
+#include "extensions/impl/batch_verification_pool.hpp"
 #include "runtime/wasm_memory.hpp"
 
 namespace kagome::crypto {
@@ -47,7 +48,8 @@ namespace kagome::extensions {
         std::shared_ptr<crypto::Secp256k1Provider> secp256k1_provider,
         std::shared_ptr<crypto::Hasher> hasher,
         std::shared_ptr<crypto::CryptoStore> crypto_store,
-        std::shared_ptr<crypto::Bip39Provider> bip39_provider);
+        std::shared_ptr<crypto::Bip39Provider> bip39_provider,
+        std::shared_ptr<BatchVerificationPool> verification_pool);
 
     inline void reset() {
       batch_verify_ = boost::none;
@@ -234,6 +236,7 @@ namespace kagome::extensions {
     std::shared_ptr<crypto::Hasher> hasher_;
     std::shared_ptr<crypto::CryptoStore> crypto_store_;
     std::shared_ptr<crypto::Bip39Provider> bip39_provider_;
+    std::shared_ptr<BatchVerificationPool> verification_pool_;
     boost::optional<std::queue<std::future<runtime::WasmSize>>> batch_verify_;
     common::Logger logger_;
   };
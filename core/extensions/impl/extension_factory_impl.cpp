@@ -17,6 +17,7 @@ namespace kagome::extensions {
       std::shared_ptr<crypto::Hasher> hasher,
       std::shared_ptr<crypto::CryptoStore> crypto_store,
       std::shared_ptr<crypto::Bip39Provider> bip39_provider,
+      std::shared_ptr<BatchVerificationPool> verification_pool,
       MiscExtension::CoreFactoryMethod core_factory_method)
       : changes_tracker_{std::move(tracker)},
         sr25519_provider_(std::move(sr25519_provider)),
@@ -25,6 +26,7 @@ namespace kagome::extensions {
         hasher_(std::move(hasher)),
         crypto_store_(std::move(crypto_store)),
         bip39_provider_(std::move(bip39_provider)),
+        verification_pool_(std::move(verification_pool)),
         core_factory_method_{std::move(core_factory_method)}{
     BOOST_ASSERT(changes_tracker_ != nullptr);
     BOOST_ASSERT(sr25519_provider_ != nullptr);
@@ -33,6 +35,7 @@ namespace kagome::extensions {
     BOOST_ASSERT(hasher_ != nullptr);
     BOOST_ASSERT(crypto_store_ != nullptr);
     BOOST_ASSERT(bip39_provider_ != nullptr);
+    BOOST_ASSERT(verification_pool_ != nullptr);
     BOOST_ASSERT(core_factory_method_ != nullptr);
   }
 
@@ -48,6 +51,7 @@ namespace kagome::extensions {
                                            hasher_,
                                            crypto_store_,
                                            bip39_provider_,
+                                           verification_pool_,
                                            core_factory_method_);
   }
 }  // namespace kagome::extensions
@@ -8,6 +8,7 @@
 
 #include "extensions/extension_factory.hpp"
 
+#include "extensions/impl/batch_verification_pool.hpp"
 #include "extensions/impl/misc_extension.hpp"
 #include "crypto/bip39/bip39_provider.hpp"
 #include "crypto/crypto_store.hpp"
@@ -31,6 +32,7 @@ namespace kagome::extensions {
         std::shared_ptr<crypto::Hasher> hasher,
         std::shared_ptr<crypto::CryptoStore> crypto_store,
         std::shared_ptr<crypto::Bip39Provider> bip39_provider,
+        std::shared_ptr<BatchVerificationPool> verification_pool,
         MiscExtension::CoreFactoryMethod core_factory_method);
 
     std::unique_ptr<Extension> createExtension(
@@ -46,6 +48,7 @@ namespace kagome::extensions {
     std::shared_ptr<crypto::Hasher> hasher_;
     std::shared_ptr<crypto::CryptoStore> crypto_store_;
     std::shared_ptr<crypto::Bip39Provider> bip39_provider_;
+    std::shared_ptr<BatchVerificationPool> verification_pool_;
     MiscExtension::CoreFactoryMethod core_factory_method_;
   };
 
@@ -26,6 +26,7 @@ namespace kagome::extensions {
       std::shared_ptr<crypto::Hasher> hasher,
       std::shared_ptr<crypto::CryptoStore> crypto_store,
       std::shared_ptr<crypto::Bip39Provider> bip39_provider,
+      std::shared_ptr<BatchVerificationPool> verification_pool,
       MiscExtension::CoreFactoryMethod core_factory_method)
       : memory_(memory),
         storage_provider_(std::move(storage_provider)),
@@ -36,7 +37,8 @@ namespace kagome::extensions {
                                               std::move(secp256k1_provider),
                                               std::move(hasher),
                                               std::move(crypto_store),
-                                              std::move(bip39_provider))},
+                                              std::move(bip39_provider),
+                                              std::move(verification_pool))},
         io_ext_(memory),
         memory_ext_(memory),
         misc_ext_(DEFAULT_CHAIN_ID, memory, std::move(core_factory_method)),
@@ -30,6 +30,7 @@ namespace kagome::extensions {
         std::shared_ptr<crypto::Hasher> hasher,
         std::shared_ptr<crypto::CryptoStore> crypto_store,
         std::shared_ptr<crypto::Bip39Provider> bip39_provider,
+        std::shared_ptr<BatchVerificationPool> verification_pool,
         MiscExtension::CoreFactoryMethod core_factory_method);
 
     ~ExtensionImpl() override = default;
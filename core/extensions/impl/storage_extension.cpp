@@ -5,13 +5,14 @@
 
 #include "extensions/impl/storage_extension.hpp"
 
-#include <forward_list>
+#include <vector>
 
 #include "runtime/common/runtime_transaction_error.hpp"
 #include "runtime/wasm_result.hpp"
-#include "scale/encode_append.hpp"
+#include "scale/scale.hpp"
 #include "storage/trie/polkadot_trie/trie_error.hpp"
 #include "storage/trie/serialization/ordered_trie_hash.hpp"
+#include "storage/trie/serialization/trie_root_builder.hpp"
 
 using kagome::common::Buffer;
 
@@ -163,7 +164,7 @@ namespace kagome::extensions {
     auto key = memory_->loadN(key_data, key_length);
     auto value = memory_->loadN(value_data, value_length);
 
-    if (value.toHex().size() < 500) {
+    if (value.size() < 250) {
       logger_->trace(
           "Set storage. Key: {}, Key hex: {} Value: {}, Value hex {}",
           key.toString(),
@@ -178,7 +179,7 @@ namespace kagome::extensions {
     }
 
     auto batch = storage_provider_->getCurrentBatch();
-    auto put_result = batch->put(key, value);
+    auto put_result = batch->put(key, std::move(value));
     if (not put_result) {
       logger_->error(
           "ext_set_storage failed, due to fail in trie db with reason: {}",
@@ -197,11 +198,11 @@ namespace kagome::extensions {
     for (size_t i = 0; i < values_num; i++) {
       lengths.at(i) = memory_->load32u(lengths_data + i * 4);
     }
-    std::forward_list<Buffer> values(values_num);
+    // no memory is allocated until the hash is stored, so the views stay valid
+    std::vector<gsl::span<const uint8_t>> values(values_num);
     uint32_t offset = 0;
-    auto curr_value = values.begin();
-    for (size_t i = 0; i < values_num; i++, curr_value++) {
-      *curr_value = memory_->loadN(values_data + offset, lengths.at(i));
+    for (size_t i = 0; i < values_num; i++) {
+      values.at(i) = memory_->view(values_data + offset, lengths.at(i));
       offset += lengths.at(i);
     }
     auto ordered_hash =
@@ -223,7 +224,7 @@ namespace kagome::extensions {
       return 0;
     }
     auto parent_hash_bytes =
-        memory_->loadN(parent_hash_data, common::Hash256::size());
+        memory_->view(parent_hash_data, common::Hash256::size());
     common::Hash256 parent_hash;
     std::copy_n(parent_hash_bytes.begin(),
                 common::Hash256::size(),
@@ -241,10 +242,12 @@ namespace kagome::extensions {
     outcome::result<Buffer> res{{}};
     if (auto opt_batch = storage_provider_->tryGetPersistentBatch();
         opt_batch.has_value() and opt_batch.value() != nullptr) {
-      res = opt_batch.value()->commit();
+      // the changes are written to the storage once the block is imported,
+      // here the root is only calculated in memory
+      res = opt_batch.value()->calculateRoot();
     } else {
       logger_->warn("ext_storage_root called in an ephemeral extension");
-      res = storage_provider_->forceCommit();
+      res = storage_provider_->calculatePersistentRoot();
     }
     if (res.has_error()) {
       logger_->error("ext_storage_root resulted with an error: {}",
@@ -362,10 +365,12 @@ namespace kagome::extensions {
     outcome::result<Buffer> res{{}};
     if (auto opt_batch = storage_provider_->tryGetPersistentBatch();
         opt_batch.has_value() and opt_batch.value() != nullptr) {
-      res = opt_batch.value()->commit();
+      // the changes are written to the storage once the block is imported,
+      // here the root is only calculated in memory
+      res = opt_batch.value()->calculateRoot();
     } else {
       logger_->warn("ext_storage_root called in an ephemeral extension");
-      res = storage_provider_->forceCommit();
+      res = storage_provider_->calculatePersistentRoot();
     }
     if (res.has_error()) {
       logger_->error("ext_storage_root resulted with an error: {}",
@@ -379,7 +384,7 @@ namespace kagome::extensions {
       runtime::WasmSpan parent_hash_data) {
     auto parent_hash_span = runtime::WasmResult(parent_hash_data);
     auto parent_hash_bytes =
-        memory_->loadN(parent_hash_span.address, parent_hash_span.length);
+        memory_->view(parent_hash_span.address, common::Hash256::size());
     common::Hash256 parent_hash;
     std::copy_n(parent_hash_bytes.begin(),
                 common::Hash256::size(),
@@ -420,21 +425,15 @@ namespace kagome::extensions {
     auto [key_ptr, key_size] = runtime::WasmResult(key_span);
     auto [append_ptr, append_size] = runtime::WasmResult(append_span);
     auto key_bytes = memory_->loadN(key_ptr, key_size);
-    auto append_bytes = memory_->loadN(append_ptr, append_size);
-
-    auto &&val_res = get(key_bytes);
-    auto &&val = val_res ? std::move(val_res.value()) : common::Buffer();
-
-    if (scale::append_or_new_vec(val.toVector(), append_bytes).has_value()) {
-      auto batch = storage_provider_->getCurrentBatch();
-      auto &&put_result = batch->put(key_bytes, std::move(val));
-      if (not put_result) {
-        logger_->error(
-            "ext_storage_append_version_1 failed, due to fail in trie db with "
-            "reason: {}",
-            put_result.error().message());
-      }
-      return;
+    auto append_bytes = memory_->view(append_ptr, append_size);
+
+    auto batch = storage_provider_->getCurrentBatch();
+    auto &&append_result = batch->append(key_bytes, append_bytes);
+    if (not append_result) {
+      logger_->error(
+          "ext_storage_append_version_1 failed, due to fail in trie db with "
+          "reason: {}",
+          append_result.error().message());
     }
   }
 
@@ -454,43 +453,26 @@ namespace kagome::extensions {
   runtime::WasmPointer StorageExtension::ext_trie_blake2_256_root_version_1(
       runtime::WasmSpan values_data) {
     auto [ptr, size] = runtime::WasmResult(values_data);
-    const auto &buffer = memory_->loadN(ptr, size);
+    auto buffer = memory_->view(ptr, size);
     const auto &pairs = scale::decode<KeyValueCollection>(buffer);
     if (!pairs) {
       logger_->error("failed to decode pairs: {}", pairs.error().message());
       std::terminate();
     }
 
-    auto &&pv = pairs.value();
-    storage::trie::PolkadotCodec codec;
-    if (pv.empty()) {
-      static const auto empty_root = common::Buffer{}.put(codec.hash256({0}));
-      auto res = memory_->storeBuffer(empty_root);
-      return runtime::WasmResult(res).address;
-    }
-    storage::trie::PolkadotTrieImpl trie;
-    for (auto &&p : pv) {
-      auto &&key = p.first;
-      auto &&value = p.second;
+    storage::trie::TrieRootBuilder builder;
+    for (auto &&[key, value] : pairs.value()) {
       // already scale-encoded
-      auto put_res = trie.put(key, value);
-      if (not put_res) {
-        logger_->error(
-            "Insertion of value {} with key {} into the trie failed due to "
-            "error: {}",
-            value.toHex(),
-            key.toHex(),
-            put_res.error().message());
-      }
+      builder.add(key, value);
     }
-    const auto &enc = codec.encodeNode(*trie.getRoot());
-    if (!enc) {
-      logger_->error("failed to encode trie root: {}", enc.error().message());
+    const auto &hash = builder.calculateRoot();
+    if (!hash) {
+      logger_->error("failed to calculate trie root: {}",
+                     hash.error().message());
       std::terminate();
     }
-    const auto &hash = codec.hash256(enc.value());
 
-    auto res = memory_->storeBuffer(hash);
+    auto res = memory_->storeBuffer(hash.value());
     return runtime::WasmResult(res).address;
   }
 
@@ -498,7 +480,7 @@ namespace kagome::extensions {
   StorageExtension::ext_trie_blake2_256_ordered_root_version_1(
       runtime::WasmSpan values_data) {
     auto [ptr, size] = runtime::WasmResult(values_data);
-    const auto &buffer = memory_->loadN(ptr, size);
+    auto buffer = memory_->view(ptr, size);
     const auto &values = scale::decode<ValuesCollection>(buffer);
     if (!values) {
       logger_->error("failed to decode values: {}", values.error().message());
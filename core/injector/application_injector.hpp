@@ -8,6 +8,7 @@
 
 #include <boost/di.hpp>
 #include <boost/di/extension/scopes/shared.hpp>
+#include <boost/filesystem/operations.hpp>
 #include <libp2p/injector/host_injector.hpp>
 #include <libp2p/peer/peer_info.hpp>
 
@@ -27,6 +28,7 @@
 #include "api/transport/impl/ws/ws_listener_impl.hpp"
 #include "api/transport/impl/ws/ws_session.hpp"
 #include "api/transport/rpc_thread_pool.hpp"
+#include "application/app_config.hpp"
 #include "application/impl/app_state_manager_impl.hpp"
 #include "application/impl/configuration_storage_impl.hpp"
 #include "authorship/impl/block_builder_factory_impl.hpp"
@@ -47,6 +49,7 @@
 #include "consensus/babe/common.hpp"
 #include "consensus/babe/impl/babe_lottery_impl.hpp"
 #include "consensus/babe/impl/babe_synchronizer_impl.hpp"
+#include "consensus/babe/impl/block_import_pool.hpp"
 #include "consensus/babe/impl/epoch_storage_impl.hpp"
 #include "consensus/grandpa/finalization_observer.hpp"
 #include "consensus/grandpa/impl/environment_impl.hpp"
@@ -91,9 +94,13 @@
 #include "runtime/common/trie_storage_provider_impl.hpp"
 #include "storage/changes_trie/impl/storage_changes_tracker_impl.hpp"
 #include "storage/leveldb/leveldb.hpp"
+#include "storage/leveldb/leveldb_stats_reporter.hpp"
 #include "storage/predefined_keys.hpp"
+#include "storage/trie/impl/mmap_trie_storage_backend.hpp"
 #include "storage/trie/impl/trie_storage_backend_impl.hpp"
+#include "storage/trie/impl/trie_pruner_impl.hpp"
 #include "storage/trie/impl/trie_storage_impl.hpp"
+#include "storage/trie/impl/trie_storage_migration.hpp"
 #include "storage/trie/polkadot_trie/polkadot_node.hpp"
 #include "storage/trie/polkadot_trie/polkadot_trie_factory_impl.hpp"
 #include "storage/trie/serialization/polkadot_codec.hpp"
@@ -295,7 +302,8 @@ namespace kagome::injector {
               std::exit(1);
             }
           }
-        });
+        },
+        injector.template create<sptr<blockchain::BlockHeaderCache>>());
     if (storage.has_error()) {
       common::raise(storage.error());
     }
@@ -305,7 +313,9 @@ namespace kagome::injector {
 
   // block tree getter
   template <typename Injector>
-  sptr<blockchain::BlockTree> get_block_tree(const Injector &injector) {
+  sptr<blockchain::BlockTree> get_block_tree(
+      const Injector &injector,
+      boost::optional<uint32_t> state_pruning_window) {
     static auto initialized =
         boost::optional<sptr<blockchain::BlockTree>>(boost::none);
 
@@ -335,6 +345,9 @@ namespace kagome::injector {
     auto &&runtime_core =
         injector.template create<std::shared_ptr<runtime::Core>>();
 
+    auto &&state_pruner =
+        injector.template create<sptr<storage::trie::TriePruner>>();
+
     auto &&tree =
         blockchain::BlockTreeImpl::create(std::move(header_repo),
                                           storage,
@@ -342,7 +355,9 @@ namespace kagome::injector {
                                           std::move(extrinsic_observer),
                                           std::move(hasher),
                                           std::move(events_engine),
-                                          std::move(runtime_core));
+                                          std::move(runtime_core),
+                                          std::move(state_pruner),
+                                          state_pruning_window);
     if (!tree) {
       common::raise(tree.error());
     }
@@ -350,6 +365,34 @@ namespace kagome::injector {
     return initialized.value();
   }
 
+  template <typename Injector>
+  sptr<extensions::BatchVerificationPool> get_batch_verification_pool(
+      const Injector &injector) {
+    static auto initialized =
+        boost::optional<sptr<extensions::BatchVerificationPool>>(boost::none);
+
+    if (initialized) {
+      return initialized.value();
+    }
+    initialized = std::make_shared<extensions::BatchVerificationPool>(
+        std::max(1u, std::thread::hardware_concurrency()));
+    return initialized.value();
+  }
+
+  template <typename Injector>
+  sptr<consensus::BlockImportPool> get_block_import_pool(
+      const Injector &injector) {
+    static auto initialized =
+        boost::optional<sptr<consensus::BlockImportPool>>(boost::none);
+
+    if (initialized) {
+      return initialized.value();
+    }
+    initialized = std::make_shared<consensus::BlockImportPool>(
+        std::max(1u, std::thread::hardware_concurrency()));
+    return initialized.value();
+  }
+
   template <typename Injector>
   sptr<extensions::ExtensionFactoryImpl> get_extension_factory(
       const Injector &injector) {
@@ -370,6 +413,8 @@ namespace kagome::injector {
     auto crypto_store = injector.template create<sptr<crypto::CryptoStore>>();
     auto bip39_provider =
         injector.template create<sptr<crypto::Bip39Provider>>();
+    auto verification_pool =
+        injector.template create<sptr<extensions::BatchVerificationPool>>();
     auto core_factory_method =
         [&injector](sptr<runtime::WasmProvider> wasm_provider) {
           auto core_factory =
@@ -385,26 +430,239 @@ namespace kagome::injector {
                                                            hasher,
                                                            crypto_store,
                                                            bip39_provider,
+                                                           verification_pool,
                                                            core_factory_method);
     return initialized.value();
   }
 
+  // level db getter
   template <typename Injector>
-  sptr<storage::trie::TrieStorageBackendImpl> get_trie_storage_backend(
-      const Injector &injector) {
+  sptr<storage::LevelDB> get_level_db(std::string_view leveldb_path,
+                                      const storage::LevelDbProfile &profile,
+                                      const Injector &injector) {
     static auto initialized =
-        boost::optional<sptr<storage::trie::TrieStorageBackendImpl>>(
-            boost::none);
+        boost::optional<sptr<storage::LevelDB>>(boost::none);
+    if (initialized) {
+      return initialized.value();
+    }
+    auto db = storage::LevelDB::create(leveldb_path, profile);
+    if (!db) {
+      common::raise(db.error());
+    }
+    initialized = db.value();
+    return initialized.value();
+  };
 
+  // getter of the level db with trie nodes, which are read by random keys
+  // unlike the other data, thus are tuned separately
+  template <typename Injector>
+  sptr<storage::LevelDB> get_trie_level_db(
+      const std::string &leveldb_path,
+      const storage::LevelDbProfile &profile,
+      const Injector &injector) {
+    static auto initialized =
+        boost::optional<sptr<storage::LevelDB>>(boost::none);
     if (initialized) {
       return initialized.value();
     }
-    auto storage = injector.template create<sptr<storage::BufferStorage>>();
+    auto db = storage::LevelDB::create(leveldb_path + "_trie", profile);
+    if (!db) {
+      common::raise(db.error());
+    }
+    initialized = db.value();
+    return initialized.value();
+  };
+
+  // moves trie nodes and their reference counts, which a database created
+  // before they got a database of their own keeps, to their storages
+  inline void migrate_trie_entries(
+      storage::BufferStorage &main_db,
+      storage::trie::TrieStorageBackend &node_storage,
+      const sptr<storage::LevelDB> &trie_db) {
+    using blockchain::prefix::TRIE_NODE;
+    using blockchain::prefix::TRIE_NODE_REFCOUNT;
+    storage::trie::TrieStorageBackendImpl refcount_storage{
+        trie_db, common::Buffer{TRIE_NODE_REFCOUNT}};
+    std::pair<common::Buffer, storage::BufferStorage *> targets[]{
+        {common::Buffer{TRIE_NODE}, &node_storage},
+        {common::Buffer{TRIE_NODE_REFCOUNT}, &refcount_storage}};
+    for (auto &[prefix, target] : targets) {
+      auto moved = storage::trie::moveEntriesByPrefix(main_db, prefix, *target);
+      if (!moved) {
+        spdlog::error(
+            "Cannot move trie nodes from the main database to the trie one: "
+            "{}. Remove the database to synchronize the node anew",
+            moved.error().message());
+        common::raise(moved.error());
+      }
+      if (moved.value() > 0) {
+        spdlog::info("Moved {} trie entries to their own database",
+                     moved.value());
+      }
+    }
+  }
+
+  // directory of the mmap trie backend, next to the database
+  constexpr auto kMmapTrieNodesSuffix = "_trie_nodes";
+
+  // moves the trie nodes kept by the backend, which is not chosen, to the
+  // chosen one, as the nodes of an existing database would be lost otherwise
+  inline void migrate_trie_backend(
+      const std::string &leveldb_path,
+      application::AppConfiguration::TrieBackend trie_backend,
+      storage::trie::TrieStorageBackend &backend,
+      storage::LevelDB &trie_db) {
     using blockchain::prefix::TRIE_NODE;
-    auto backend = std::make_shared<storage::trie::TrieStorageBackendImpl>(
-        storage, common::Buffer{TRIE_NODE});
+    outcome::result<size_t> moved{0};
+    if (trie_backend == application::AppConfiguration::TrieBackend::kMmap) {
+      moved = storage::trie::moveEntriesByPrefix(
+          trie_db, common::Buffer{TRIE_NODE}, backend);
+    } else {
+      const boost::filesystem::path mmap_path{leveldb_path
+                                              + kMmapTrieNodesSuffix};
+      if (not boost::filesystem::exists(mmap_path)) {
+        return;
+      }
+      storage::trie::MmapTrieStorageBackend::Config config;
+      config.background_compaction = false;
+      auto mmap_backend =
+          storage::trie::MmapTrieStorageBackend::create(mmap_path, config);
+      if (!mmap_backend) {
+        common::raise(mmap_backend.error());
+      }
+      moved = storage::trie::moveEntriesByPrefix(
+          *mmap_backend.value(), common::Buffer{}, backend);
+      mmap_backend.value().reset();
+      if (moved) {
+        // all the nodes are moved, so the segments are not needed anymore
+        boost::system::error_code ec;
+        boost::filesystem::remove_all(mmap_path, ec);
+        if (ec) {
+          spdlog::warn(
+              "Cannot remove {}: {}", mmap_path.string(), ec.message());
+        }
+      }
+    }
+    if (!moved) {
+      spdlog::error(
+          "Cannot move trie nodes between the storage backends: {}. Start "
+          "with the former --trie_backend to keep using the database",
+          moved.error().message());
+      common::raise(moved.error());
+    }
+    if (moved.value() > 0) {
+      spdlog::info("Moved {} trie nodes to the {} storage backend",
+                   moved.value(),
+                   trie_backend
+                           == application::AppConfiguration::TrieBackend::kMmap
+                       ? "mmap"
+                       : "leveldb");
+    }
+  }
+
+  template <typename Injector>
+  sptr<storage::trie::TrieStorageBackend> get_trie_storage_backend(
+      const Injector &injector,
+      const std::string &leveldb_path,
+      application::AppConfiguration::TrieBackend trie_backend,
+      const storage::LevelDbProfile &leveldb_profile,
+      const storage::LevelDbProfile &trie_leveldb_profile) {
+    static auto initialized =
+        boost::optional<sptr<storage::trie::TrieStorageBackend>>(boost::none);
+
+    if (initialized) {
+      return initialized.value();
+    }
+    auto trie_db =
+        get_trie_level_db(leveldb_path, trie_leveldb_profile, injector);
+    sptr<storage::trie::TrieStorageBackend> backend;
+    if (trie_backend == application::AppConfiguration::TrieBackend::kMmap) {
+      auto mmap_backend = storage::trie::MmapTrieStorageBackend::create(
+          leveldb_path + kMmapTrieNodesSuffix,
+          storage::trie::MmapTrieStorageBackend::Config{});
+      if (!mmap_backend) {
+        common::raise(mmap_backend.error());
+      }
+      backend = mmap_backend.value();
+    } else {
+      using blockchain::prefix::TRIE_NODE;
+      backend = std::make_shared<storage::trie::TrieStorageBackendImpl>(
+          trie_db, common::Buffer{TRIE_NODE});
+    }
+    migrate_trie_backend(leveldb_path, trie_backend, *backend, *trie_db);
+    migrate_trie_entries(
+        *get_level_db(leveldb_path, leveldb_profile, injector),
+        *backend,
+        trie_db);
     initialized = backend;
-    return backend;
+    return initialized.value();
+  }
+
+  template <typename Injector>
+  sptr<blockchain::BlockHeaderCache> get_block_header_cache(
+      const Injector &injector) {
+    static auto initialized =
+        boost::optional<sptr<blockchain::BlockHeaderCache>>(boost::none);
+
+    if (initialized) {
+      return initialized.value();
+    }
+    initialized = std::make_shared<blockchain::BlockHeaderCache>(
+        blockchain::BlockHeaderCache::kDefaultCapacity);
+    return initialized.value();
+  }
+
+  template <typename Injector>
+  sptr<storage::trie::TrieNodeCache> get_trie_node_cache(
+      const Injector &injector) {
+    static auto initialized =
+        boost::optional<sptr<storage::trie::TrieNodeCache>>(boost::none);
+
+    if (initialized) {
+      return initialized.value();
+    }
+    initialized = std::make_shared<storage::trie::TrieNodeCache>(
+        storage::trie::TrieNodeCache::kDefaultCapacity);
+    return initialized.value();
+  }
+
+  template <typename Injector>
+  sptr<storage::trie::TrieHashingPool> get_trie_hashing_pool(
+      const Injector &injector) {
+    static auto initialized =
+        boost::optional<sptr<storage::trie::TrieHashingPool>>(boost::none);
+
+    if (initialized) {
+      return initialized.value();
+    }
+    initialized = std::make_shared<storage::trie::TrieHashingPool>(
+        std::max(1u, std::thread::hardware_concurrency()));
+    return initialized.value();
+  }
+
+  template <typename Injector>
+  sptr<storage::trie::TriePruner> get_trie_pruner(
+      const Injector &injector,
+      const std::string &leveldb_path,
+      const storage::LevelDbProfile &trie_leveldb_profile) {
+    static auto initialized =
+        boost::optional<sptr<storage::trie::TriePruner>>(boost::none);
+
+    if (initialized) {
+      return initialized.value();
+    }
+    auto storage =
+        get_trie_level_db(leveldb_path, trie_leveldb_profile, injector);
+    auto node_storage =
+        injector.template create<sptr<storage::trie::TrieStorageBackend>>();
+    auto codec = injector.template create<sptr<storage::trie::Codec>>();
+    using blockchain::prefix::TRIE_NODE_REFCOUNT;
+    auto refcount_storage =
+        std::make_shared<storage::trie::TrieStorageBackendImpl>(
+            storage, common::Buffer{TRIE_NODE_REFCOUNT});
+    initialized = std::make_shared<storage::trie::TriePrunerImpl>(
+        std::move(node_storage), std::move(refcount_storage), codec);
+    return initialized.value();
   }
 
   template <typename Injector>
@@ -423,8 +681,9 @@ namespace kagome::injector {
         injector.template create<sptr<storage::trie::TrieSerializer>>();
     auto tracker =
         injector.template create<sptr<storage::changes_trie::ChangesTracker>>();
+    auto pruner = injector.template create<sptr<storage::trie::TriePruner>>();
     auto trie_storage_res = storage::trie::TrieStorageImpl::createEmpty(
-        factory, codec, serializer, tracker);
+        factory, codec, serializer, tracker, pruner);
     if (!trie_storage_res) {
       common::raise(trie_storage_res.error());
     }
@@ -467,24 +726,29 @@ namespace kagome::injector {
     return trie_storage;
   }
 
-  // level db getter
   template <typename Injector>
-  sptr<storage::BufferStorage> get_level_db(std::string_view leveldb_path,
-                                            const Injector &injector) {
+  sptr<storage::LevelDbStatsReporter> get_leveldb_stats_reporter(
+      const Injector &injector,
+      const std::string &leveldb_path,
+      const storage::LevelDbProfile &leveldb_profile,
+      const storage::LevelDbProfile &trie_leveldb_profile,
+      std::chrono::seconds period) {
     static auto initialized =
-        boost::optional<sptr<storage::BufferStorage>>(boost::none);
+        boost::optional<sptr<storage::LevelDbStatsReporter>>(boost::none);
     if (initialized) {
       return initialized.value();
     }
-    auto options = leveldb::Options{};
-    options.create_if_missing = true;
-    auto db = storage::LevelDB::create(leveldb_path, options);
-    if (!db) {
-      common::raise(db.error());
-    }
-    initialized = db.value();
+    std::vector<storage::LevelDbStatsReporter::Database> databases{
+        {"main", get_level_db(leveldb_path, leveldb_profile, injector)},
+        {"trie",
+         get_trie_level_db(leveldb_path, trie_leveldb_profile, injector)}};
+    initialized = std::make_shared<storage::LevelDbStatsReporter>(
+        injector.template create<sptr<application::AppStateManager>>(),
+        injector.template create<sptr<boost::asio::io_context>>(),
+        std::move(databases),
+        period);
     return initialized.value();
-  };
+  }
 
   // configuration storage getter
   template <typename Injector>
@@ -541,6 +805,22 @@ namespace kagome::injector {
     return res;
   }
 
+  template <typename Injector>
+  sptr<consensus::BabeSynchronizer> get_babe_synchronizer(
+      const Injector &injector) {
+    static auto initialized =
+        boost::optional<sptr<consensus::BabeSynchronizer>>(boost::none);
+    if (initialized) {
+      return initialized.value();
+    }
+    initialized = std::make_shared<consensus::BabeSynchronizerImpl>(
+        injector.template create<sptr<network::SyncClientsSet>>(),
+        injector.template create<sptr<blockchain::BlockHeaderRepository>>(),
+        injector.template create<sptr<boost::asio::io_context>>(),
+        consensus::BabeSynchronizerImpl::kRequestTimeout);
+    return initialized.value();
+  }
+
   template <typename Injector>
   sptr<primitives::BabeConfiguration> get_babe_configuration(
       const Injector &injector) {
@@ -619,6 +899,12 @@ namespace kagome::injector {
   auto makeApplicationInjector(
       const std::string &genesis_path,
       const std::string &leveldb_path,
+      boost::optional<uint32_t> state_pruning_window,
+      application::AppConfiguration::TrieBackend trie_backend,
+      const storage::LevelDbProfile &leveldb_profile,
+      const storage::LevelDbProfile &trie_leveldb_profile,
+      std::chrono::seconds leveldb_stats_period,
+      application::AppConfiguration::WasmExecution wasm_execution,
       const boost::asio::ip::tcp::endpoint &rpc_http_endpoint,
       const boost::asio::ip::tcp::endpoint &rpc_ws_endpoint,
       Ts &&... args) {
@@ -631,6 +917,11 @@ namespace kagome::injector {
     transaction_pool::PoolModeratorImpl::Params pool_moderator_config{};
     transaction_pool::TransactionPool::Limits tp_pool_limits{};
     libp2p::protocol::PingConfig ping_config{};
+    runtime::binaryen::WasmModuleFactoryImpl::Configuration
+        wasm_module_factory_config{
+            wasm_execution
+                == application::AppConfiguration::WasmExecution::kOptimized,
+            leveldb_path + "_runtime_cache"};
 
     return di::make_injector(
         // bind configs
@@ -640,6 +931,7 @@ namespace kagome::injector {
         injector::useConfig(pool_moderator_config),
         injector::useConfig(tp_pool_limits),
         injector::useConfig(ping_config),
+        injector::useConfig(wasm_module_factory_config),
 
         // inherit host injector
         libp2p::injector::makeHostInjector(
@@ -678,13 +970,29 @@ namespace kagome::injector {
         di::bind<authorship::BlockBuilder>.template to<authorship::BlockBuilderImpl>(),
         di::bind<authorship::BlockBuilderFactory>.template to<authorship::BlockBuilderFactoryImpl>(),
         di::bind<storage::BufferStorage>.to(
-            [leveldb_path](const auto &injector) {
-              return get_level_db(leveldb_path, injector);
+            [leveldb_path, leveldb_profile](const auto &injector)
+                -> sptr<storage::BufferStorage> {
+              return get_level_db(leveldb_path, leveldb_profile, injector);
+            }),
+        di::bind<storage::LevelDbStatsReporter>.to(
+            [leveldb_path,
+             leveldb_profile,
+             trie_leveldb_profile,
+             leveldb_stats_period](const auto &injector) {
+              return get_leveldb_stats_reporter(injector,
+                                                leveldb_path,
+                                                leveldb_profile,
+                                                trie_leveldb_profile,
+                                                leveldb_stats_period);
             }),
         di::bind<blockchain::BlockStorage>.to(
             [](const auto &injector) { return get_block_storage(injector); }),
+        di::bind<blockchain::BlockHeaderCache>.to(
+            [](auto const &inj) { return get_block_header_cache(inj); }),
         di::bind<blockchain::BlockTree>.to(
-            [](auto const &inj) { return get_block_tree(inj); }),
+            [state_pruning_window](auto const &inj) {
+              return get_block_tree(inj, state_pruning_window);
+            }),
         di::bind<blockchain::BlockHeaderRepository>.template to<blockchain::KeyValueBlockHeaderRepository>(),
         di::bind<clock::SystemClock>.template to<clock::SystemClockImpl>(),
         di::bind<clock::SteadyClock>.template to<clock::SteadyClockImpl>(),
@@ -692,7 +1000,9 @@ namespace kagome::injector {
         di::bind<primitives::BabeConfiguration>.to([](auto const &injector) {
           return get_babe_configuration(injector);
         }),
-        di::bind<consensus::BabeSynchronizer>.template to<consensus::BabeSynchronizerImpl>(),
+        di::bind<consensus::BabeSynchronizer>.to([](auto const &injector) {
+          return get_babe_synchronizer(injector);
+        }),
         di::bind<consensus::grandpa::Environment>.template to<consensus::grandpa::EnvironmentImpl>(),
         di::bind<consensus::grandpa::VoteCryptoProvider>.template to<consensus::grandpa::VoteCryptoProviderImpl>(),
         di::bind<consensus::EpochStorage>.template to<consensus::EpochStorageImpl>(),
@@ -733,7 +1043,26 @@ namespace kagome::injector {
         di::bind<transaction_pool::PoolModerator>.template to<transaction_pool::PoolModeratorImpl>(),
         di::bind<storage::changes_trie::ChangesTracker>.template to<storage::changes_trie::StorageChangesTrackerImpl>(),
         di::bind<storage::trie::TrieStorageBackend>.to(
-            [](auto const &inj) { return get_trie_storage_backend(inj); }),
+            [leveldb_path, trie_backend, leveldb_profile, trie_leveldb_profile](
+                auto const &inj) {
+              return get_trie_storage_backend(inj,
+                                              leveldb_path,
+                                              trie_backend,
+                                              leveldb_profile,
+                                              trie_leveldb_profile);
+            }),
+        di::bind<storage::trie::TrieNodeCache>.to(
+            [](auto const &inj) { return get_trie_node_cache(inj); }),
+        di::bind<storage::trie::TrieHashingPool>.to(
+            [](auto const &inj) { return get_trie_hashing_pool(inj); }),
+        di::bind<extensions::BatchVerificationPool>.to(
+            [](auto const &inj) { return get_batch_verification_pool(inj); }),
+        di::bind<consensus::BlockImportPool>.to(
+            [](auto const &inj) { return get_block_import_pool(inj); }),
+        di::bind<storage::trie::TriePruner>.to(
+            [leveldb_path, trie_leveldb_profile](auto const &inj) {
+              return get_trie_pruner(inj, leveldb_path, trie_leveldb_profile);
+            }),
         di::bind<storage::trie::TrieStorageImpl>.to(
             [](auto const &inj) { return get_trie_storage_impl(inj); }),
         di::bind<storage::trie::TrieStorage>.to(
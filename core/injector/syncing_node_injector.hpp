@@ -59,6 +59,12 @@ namespace kagome::injector {
         // inherit application injector
         makeApplicationInjector(app_config->genesis_path(),
                                 app_config->leveldb_path(),
+                                app_config->state_pruning_window(),
+                                app_config->trie_backend(),
+                                app_config->leveldb_profile(),
+                                app_config->trie_leveldb_profile(),
+                                app_config->leveldb_stats_period(),
+                                app_config->wasm_execution(),
                                 app_config->rpc_http_endpoint(),
                                 app_config->rpc_ws_endpoint()),
 
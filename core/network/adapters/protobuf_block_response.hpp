@@ -23,6 +23,12 @@ namespace kagome::network {
         const BlocksResponse &t,
         std::vector<uint8_t> &out,
         std::vector<uint8_t>::iterator loaded) {
+      const size_t distance_was = std::distance(out.begin(), loaded);
+      const size_t was_size = out.size();
+
+      // a message with several blocks is serialized as the concatenation of
+      // the messages with one of them, so the blocks are serialized one by
+      // one instead of building the message of all of them first
       ::api::v1::BlockResponse msg;
       for (const auto &src_block : t.blocks) {
         auto *dst_block = msg.add_blocks();
@@ -45,13 +51,29 @@ namespace kagome::network {
 
         if (src_block.justification)
           dst_block->set_justification(src_block.justification->data.asString());
+
+        append(msg, out);
       }
 
-      const size_t distance_was = std::distance(out.begin(), loaded);
-      const size_t was_size = out.size();
+      // stored encodings are copied as they are
+      for (const auto &src_block : t.encoded_blocks) {
+        auto *dst_block = msg.add_blocks();
+        dst_block->set_hash(src_block.hash.data(), src_block.hash.size());
 
-      out.resize(was_size + msg.ByteSizeLong());
-      msg.SerializeToArray(&out[was_size], msg.ByteSizeLong());
+        if (src_block.header)
+          dst_block->set_header(src_block.header->data(),
+                                src_block.header->size());
+
+        if (src_block.body)
+          for (const auto &ext_body : *src_block.body)
+            dst_block->add_body(ext_body.data(), ext_body.size());
+
+        if (src_block.justification)
+          dst_block->set_justification(src_block.justification->data(),
+                                       src_block.justification->size());
+
+        append(msg, out);
+      }
 
       auto res_it = out.begin();
       std::advance(res_it, std::min(distance_was, was_size));
@@ -111,6 +133,17 @@ namespace kagome::network {
     }
 
    private:
+    /**
+     * Serializes the message to the end of the buffer and clears it
+     */
+    static void append(::api::v1::BlockResponse &msg,
+                       std::vector<uint8_t> &out) {
+      const size_t was_size = out.size();
+      out.resize(was_size + msg.ByteSizeLong());
+      msg.SerializeToArray(&out[was_size], msg.ByteSizeLong());
+      msg.Clear();
+    }
+
     template <typename T, typename F>
     static outcome::result<T> extract_value(F &&f) {
       if (const auto &buffer = std::forward<F>(f)(); !buffer.empty()) {
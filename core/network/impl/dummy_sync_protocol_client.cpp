@@ -31,4 +31,8 @@ namespace kagome::network {
         });
   }
 
+  bool DummySyncProtocolClient::servesRequests() const {
+    return false;
+  }
+
 }  // namespace kagome::network
@@ -25,6 +25,8 @@ namespace kagome::network {
         const BlocksRequest &request,
         std::function<void(outcome::result<BlocksResponse>)> cb) override;
 
+    bool servesRequests() const override;
+
    private:
     common::Logger log_;
   };
@@ -166,7 +166,7 @@ namespace kagome::network {
               " to {}",
               stream->remotePeerId().value().toBase58(),
               from,
-              request.to->toHex());
+              request.to ? request.to->toHex() : "the best block");
           return self->sync_observer_->onBlocksRequest(
               std::forward<decltype(request)>(request));
         },
@@ -7,7 +7,10 @@
 
 #include <boost/assert.hpp>
 
+#include "common/outcome_throw.hpp"
 #include "network/common.hpp"
+#include "scale/scale_decoder_stream.hpp"
+#include "scale/scale_error.hpp"
 
 OUTCOME_CPP_DEFINE_CATEGORY(kagome::network,
                             SyncProtocolObserverImpl::Error,
@@ -20,16 +23,111 @@ OUTCOME_CPP_DEFINE_CATEGORY(kagome::network,
   return "unknown error";
 }
 
+namespace {
+  using kagome::common::Buffer;
+  using kagome::scale::CompactInteger;
+  using kagome::scale::ScaleDecoderStream;
+
+  /**
+   * Reads the stored encoding of BlockData field by field; length-prefixed
+   * fields are sliced out of it instead of being decoded
+   */
+  class BlockDataReader {
+   public:
+    explicit BlockDataReader(gsl::span<const uint8_t> encoded)
+        : encoded_{encoded} {}
+
+    template <typename T>
+    T read() {
+      ScaleDecoderStream stream{encoded_.subspan(offset_)};
+      T value{};
+      stream >> value;
+      offset_ += stream.currentIndex();
+      return value;
+    }
+
+    /**
+     * @param with_prefix whether the length prefix is the part of the slice
+     * @return length-prefixed bytes at the current position
+     */
+    gsl::span<const uint8_t> slice(bool with_prefix) {
+      auto begin = offset_;
+      auto length = read<CompactInteger>();
+      if (length > encoded_.size() - offset_) {
+        kagome::common::raise(kagome::scale::DecodeError::NOT_ENOUGH_DATA);
+      }
+      if (not with_prefix) {
+        begin = offset_;
+      }
+      offset_ += length.convert_to<size_t>();
+      return encoded_.subspan(begin, offset_ - begin);
+    }
+
+   private:
+    gsl::span<const uint8_t> encoded_;
+    size_t offset_ = 0;
+  };
+
+  /**
+   * Takes the encoded extrinsics and the justification data of the block
+   * from the stored encoding of its BlockData
+   */
+  outcome::result<void> splitBlockData(
+      const Buffer &encoded_block_data,
+      bool body_needed,
+      bool justification_needed,
+      kagome::network::EncodedBlockData &block) {
+    BlockDataReader reader{encoded_block_data};
+    try {
+      reader.read<kagome::primitives::BlockHash>();
+      // the header is encoded with no length prefix, so it has to be decoded
+      // to be skipped
+      reader.read<boost::optional<kagome::primitives::BlockHeader>>();
+      if (reader.read<uint8_t>() != 0) {
+        auto count = reader.read<CompactInteger>();
+        std::vector<Buffer> body;
+        for (CompactInteger i = 0; i < count; ++i) {
+          auto extrinsic = reader.slice(true);
+          if (body_needed) {
+            body.emplace_back(extrinsic);
+          }
+        }
+        if (body_needed) {
+          block.body = std::move(body);
+        }
+      }
+      // receipt and message queue
+      for (auto i = 0; i < 2; ++i) {
+        if (reader.read<uint8_t>() != 0) {
+          reader.slice(false);
+        }
+      }
+      if (reader.read<uint8_t>() != 0) {
+        auto justification = reader.slice(false);
+        if (justification_needed) {
+          block.justification = Buffer{justification};
+        }
+      }
+    } catch (std::system_error &e) {
+      return outcome::failure(e.code());
+    }
+    return outcome::success();
+  }
+}  // namespace
+
 namespace kagome::network {
 
   SyncProtocolObserverImpl::SyncProtocolObserverImpl(
       std::shared_ptr<blockchain::BlockTree> block_tree,
-      std::shared_ptr<blockchain::BlockHeaderRepository> blocks_headers)
+      std::shared_ptr<blockchain::BlockHeaderRepository> blocks_headers,
+      std::shared_ptr<blockchain::BlockStorage> block_storage)
       : block_tree_{std::move(block_tree)},
         blocks_headers_{std::move(blocks_headers)},
+        block_storage_{std::move(block_storage)},
         log_(common::createLogger("SyncProtocolObserver")) {
     BOOST_ASSERT(block_tree_);
     BOOST_ASSERT(blocks_headers_);
+    BOOST_ASSERT(block_storage_);
   }
 
   outcome::result<network::BlocksResponse>
@@ -61,8 +159,9 @@ namespace kagome::network {
 
     // thirdly, fill the resulting response with data, which we were asked for
     fillBlocksResponse(request, response, chain_hash_res.value());
-    if (not response.blocks.empty()) {
-      log_->debug("Return response: {}", response.blocks[0].hash.toHex());
+    if (not response.encoded_blocks.empty()) {
+      log_->debug("Return response: {}",
+                  response.encoded_blocks[0].hash.toHex());
     }
 
     requested_ids_.erase(request.id);
@@ -75,11 +174,15 @@ namespace kagome::network {
       const primitives::BlockHash &from_hash) const {
     auto ascending_direction =
         request.direction == network::Direction::ASCENDING;
+    size_t limit = maxRequestBlocks;
+    if (request.max and *request.max < limit) {
+      limit = *request.max;
+    }
     blockchain::BlockTree::BlockHashVecRes chain_hash_res{{}};
     if (!request.to) {
       // if there's no "stop" block, get as many as possible
-      chain_hash_res = block_tree_->getChainByBlock(
-          from_hash, ascending_direction, maxRequestBlocks);
+      chain_hash_res =
+          block_tree_->getChainByBlock(from_hash, ascending_direction, limit);
     } else {
       // else, both blocks are specified
       OUTCOME_TRY(chain_hash,
@@ -87,6 +190,9 @@ namespace kagome::network {
       if (ascending_direction) {
         std::reverse(chain_hash.begin(), chain_hash.end());
       }
+      if (chain_hash.size() > limit) {
+        chain_hash.resize(limit);
+      }
       chain_hash_res = chain_hash;
     }
     return chain_hash_res;
@@ -103,28 +209,49 @@ namespace kagome::network {
     auto justification_needed =
         request.attributeIsSet(network::BlockAttributesBits::JUSTIFICATION);
 
+    size_t response_bytes = 0;
     for (const auto &hash : hash_chain) {
-      auto &new_block =
-          response.blocks.emplace_back(primitives::BlockData{hash});
+      EncodedBlockData new_block{hash};
 
       if (header_needed) {
-        auto header_res = blocks_headers_->getBlockHeader(hash);
+        auto header_res = block_storage_->getEncodedBlockHeader(hash);
         if (header_res) {
           new_block.header = std::move(header_res.value());
         }
       }
-      if (body_needed) {
-        auto body_res = block_tree_->getBlockBody(hash);
-        if (body_res) {
-          new_block.body = std::move(body_res.value());
+      if (body_needed or justification_needed) {
+        auto block_data_res = block_storage_->getEncodedBlockData(hash);
+        if (block_data_res) {
+          auto split_res = splitBlockData(block_data_res.value(),
+                                          body_needed,
+                                          justification_needed,
+                                          new_block);
+          if (not split_res) {
+            log_->warn("cannot read stored data of block {}: {}",
+                       hash.toHex(),
+                       split_res.error().message());
+          }
         }
       }
-      if (justification_needed) {
-        auto justification_res = block_tree_->getBlockJustification(hash);
-        if (justification_res) {
-          new_block.justification = std::move(justification_res.value());
+
+      auto block_bytes = hash.size();
+      if (new_block.header) {
+        block_bytes += new_block.header->size();
+      }
+      if (new_block.body) {
+        for (const auto &extrinsic : *new_block.body) {
+          block_bytes += extrinsic.size();
         }
       }
+      if (new_block.justification) {
+        block_bytes += new_block.justification->size();
+      }
+      if (not response.encoded_blocks.empty()
+          and response_bytes + block_bytes > maxResponseBytes) {
+        break;
+      }
+      response_bytes += block_bytes;
+      response.encoded_blocks.emplace_back(std::move(new_block));
     }
   }
 }  // namespace kagome::network
@@ -12,6 +12,7 @@
 #include <libp2p/peer/peer_info.hpp>
 
 #include "blockchain/block_header_repository.hpp"
+#include "blockchain/block_storage.hpp"
 #include "blockchain/block_tree.hpp"
 #include "common/logger.hpp"
 #include "network/types/own_peer_info.hpp"
@@ -25,12 +26,16 @@ namespace kagome::network {
    public:
     /// how much blocks we can send at once
     static const size_t maxRequestBlocks = 128u;
+    /// how much bytes of blocks we can send at once; a block, which exceeds
+    /// it alone, is sent anyway
+    static const size_t maxResponseBytes = 8u * 1024 * 1024;
 
     enum class Error { DUPLICATE_REQUEST_ID = 1 };
 
     SyncProtocolObserverImpl(
         std::shared_ptr<blockchain::BlockTree> block_tree,
-        std::shared_ptr<blockchain::BlockHeaderRepository> blocks_headers);
+        std::shared_ptr<blockchain::BlockHeaderRepository> blocks_headers,
+        std::shared_ptr<blockchain::BlockStorage> block_storage);
 
     ~SyncProtocolObserverImpl() override = default;
 
@@ -42,6 +47,10 @@ namespace kagome::network {
         const network::BlocksRequest &request,
         const primitives::BlockHash &from_hash) const;
 
+    /**
+     * Fills the response with the stored encodings of the blocks of the
+     * chain, until maxResponseBytes are taken
+     */
     void fillBlocksResponse(
         const network::BlocksRequest &request,
         network::BlocksResponse &response,
@@ -49,6 +58,7 @@ namespace kagome::network {
 
     std::shared_ptr<blockchain::BlockTree> block_tree_;
     std::shared_ptr<blockchain::BlockHeaderRepository> blocks_headers_;
+    std::shared_ptr<blockchain::BlockStorage> block_storage_;
     mutable std::unordered_set<primitives::BlocksRequestId> requested_ids_;
     common::Logger log_;
   };
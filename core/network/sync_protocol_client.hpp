@@ -27,6 +27,14 @@ namespace kagome::network {
     virtual void requestBlocks(
         const BlocksRequest &request,
         std::function<void(outcome::result<BlocksResponse>)> cb) = 0;
+
+    /**
+     * @return false if the client never responds to the requests, as it
+     * stands for the node itself
+     */
+    virtual bool servesRequests() const {
+      return true;
+    }
   };
 }  // namespace kagome::network
 
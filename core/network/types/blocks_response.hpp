@@ -16,12 +16,33 @@
 #include "primitives/justification.hpp"
 
 namespace kagome::network {
+  /**
+   * Parts of a block as they are stored, to be sent without being decoded
+   */
+  struct EncodedBlockData {
+    primitives::BlockHash hash;
+    /// SCALE-encoded header
+    boost::optional<common::Buffer> header{};
+    /// SCALE-encoded extrinsics
+    boost::optional<std::vector<common::Buffer>> body{};
+    /// data of the justification
+    boost::optional<common::Buffer> justification{};
+
+    bool operator==(const EncodedBlockData &rhs) const {
+      return hash == rhs.hash && header == rhs.header && body == rhs.body
+             && justification == rhs.justification;
+    }
+  };
+
   /**
    * Response to the BlockRequest
    */
   struct BlocksResponse {
     primitives::BlocksRequestId id{0ull};
     std::vector<primitives::BlockData> blocks{};
+    /// blocks sent after the decoded ones; a received response has the
+    /// decoded blocks only
+    std::vector<EncodedBlockData> encoded_blocks{};
   };
 
   /**
@@ -31,7 +52,8 @@ namespace kagome::network {
    * @return true if equal false otherwise
    */
   inline bool operator==(const BlocksResponse &lhs, const BlocksResponse &rhs) {
-    return lhs.id == rhs.id && lhs.blocks == rhs.blocks;
+    return lhs.id == rhs.id && lhs.blocks == rhs.blocks
+           && lhs.encoded_blocks == rhs.encoded_blocks;
   }
 
   /**
@@ -0,0 +1,74 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_RUNTIME_BINARYEN_LINEAR_MEMORY_HPP
+#define KAGOME_CORE_RUNTIME_BINARYEN_LINEAR_MEMORY_HPP
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace kagome::runtime::binaryen {
+
+  /**
+   * Linear memory of a wasm module instance. It behaves like the memory of
+   * binaryen's shell interface, which keeps its bytes private, but also gives
+   * access to the bytes, so that host functions read them in place.
+   * The interpreter accesses it through RuntimeExternalInterface
+   */
+  class LinearMemory {
+   public:
+    /// The smallest size, with which most allocators provide page-aligned
+    /// storage, as in binaryen
+    static constexpr size_t kMinSize = 1u << 12u;
+
+    void resize(size_t new_size) {
+      const auto old_size = bytes_.size();
+      bytes_.resize(std::max(kMinSize, new_size));
+      if (new_size < old_size and new_size < kMinSize) {
+        std::memset(&bytes_[new_size], 0, kMinSize - new_size);
+      }
+    }
+
+    size_t size() const {
+      return bytes_.size();
+    }
+
+    char *data() {
+      return bytes_.data();
+    }
+
+    const char *data() const {
+      return bytes_.data();
+    }
+
+    /**
+     * Stores a value at the address, which the interpreter or the caller has
+     * checked to lie within the memory
+     */
+    template <typename T>
+    void set(size_t address, const T &value) {
+      static_assert(std::is_trivially_copyable_v<T>);
+      // memcpy of a constant size does not depend on the alignment
+      std::memcpy(&bytes_[address], &value, sizeof(T));
+    }
+
+    template <typename T>
+    T get(size_t address) const {
+      static_assert(std::is_trivially_copyable_v<T>);
+      T value;
+      std::memcpy(&value, &bytes_[address], sizeof(T));
+      return value;
+    }
+
+   private:
+    // char does not run afoul of aliasing rules
+    std::vector<char> bytes_;
+  };
+
+}  // namespace kagome::runtime::binaryen
+
+#endif  // KAGOME_CORE_RUNTIME_BINARYEN_LINEAR_MEMORY_HPP
@@ -0,0 +1,125 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/binaryen/module/wasm_module_cache.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+#include <boost/filesystem/operations.hpp>
+
+#include "crypto/blake2/blake2b.h"
+
+namespace kagome::runtime::binaryen {
+
+  namespace {
+    constexpr std::string_view kMagic = "kagome prepared wasm";
+    const std::string kEntryExtension = ".wasm";
+  }  // namespace
+
+  WasmModuleCache::WasmModuleCache(boost::filesystem::path directory)
+      : directory_{std::move(directory)},
+        logger_{common::createLogger("WasmModuleCache")} {
+    BOOST_ASSERT(not directory_.empty());
+  }
+
+  boost::optional<common::Buffer> WasmModuleCache::load(
+      const common::Hash256 &code_hash) const {
+    auto path = entryPath(code_hash);
+    std::ifstream file{path.string(), std::ios::binary};
+    if (not file.is_open()) {
+      return boost::none;
+    }
+    std::vector<uint8_t> content{std::istreambuf_iterator<char>{file},
+                                 std::istreambuf_iterator<char>{}};
+    if (file.bad()) {
+      logger_->warn("Cannot read {}", path.string());
+      return boost::none;
+    }
+
+    auto expected_header = header(code_hash);
+    const auto module_offset =
+        expected_header.size() + common::Hash256::size();
+    if (content.size() <= module_offset
+        or not std::equal(expected_header.begin(),
+                          expected_header.end(),
+                          content.begin())) {
+      logger_->info("{} is outdated or corrupted and will be replaced",
+                    path.string());
+      return boost::none;
+    }
+    auto expected_checksum = checksum(
+        gsl::make_span(content).subspan(module_offset));
+    if (not std::equal(expected_checksum.begin(),
+                       expected_checksum.end(),
+                       content.begin() + expected_header.size())) {
+      logger_->warn("{} does not match its checksum and will be replaced",
+                    path.string());
+      return boost::none;
+    }
+    content.erase(content.begin(), content.begin() + module_offset);
+    return common::Buffer{std::move(content)};
+  }
+
+  void WasmModuleCache::store(const common::Hash256 &code_hash,
+                              gsl::span<const uint8_t> module) const {
+    boost::system::error_code ec;
+    boost::filesystem::create_directories(directory_, ec);
+    if (ec) {
+      logger_->warn("Cannot create {}: {}", directory_.string(), ec.message());
+      return;
+    }
+
+    auto path = entryPath(code_hash);
+    auto temporary_path =
+        directory_ / boost::filesystem::unique_path("%%%%-%%%%-%%%%.tmp");
+    {
+      std::ofstream file{temporary_path.string(),
+                         std::ios::binary | std::ios::trunc};
+      auto entry_header = header(code_hash);
+      entry_header.put(checksum(module));
+      file.write(reinterpret_cast<const char *>(entry_header.data()),  // NOLINT
+                 entry_header.size());
+      file.write(reinterpret_cast<const char *>(module.data()),  // NOLINT
+                 module.size());
+      if (not file.good()) {
+        logger_->warn("Cannot write {}", temporary_path.string());
+        file.close();
+        boost::filesystem::remove(temporary_path, ec);
+        return;
+      }
+    }
+    boost::filesystem::rename(temporary_path, path, ec);
+    if (ec) {
+      logger_->warn("Cannot replace {}: {}", path.string(), ec.message());
+      boost::filesystem::remove(temporary_path, ec);
+    }
+  }
+
+  boost::filesystem::path WasmModuleCache::entryPath(
+      const common::Hash256 &code_hash) const {
+    return directory_ / (code_hash.toHex() + kEntryExtension);
+  }
+
+  common::Buffer WasmModuleCache::header(
+      const common::Hash256 &code_hash) const {
+    common::Buffer header;
+    header.put(kMagic).putUint32(kFormatVersion).put(code_hash);
+    return header;
+  }
+
+  common::Hash256 WasmModuleCache::checksum(gsl::span<const uint8_t> module) {
+    common::Hash256 checksum;
+    blake2b(checksum.data(),
+            common::Hash256::size(),
+            nullptr,
+            0,
+            module.data(),
+            module.size());
+    return checksum;
+  }
+
+}  // namespace kagome::runtime::binaryen
@@ -0,0 +1,74 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_RUNTIME_BINARYEN_MODULE_WASM_MODULE_CACHE
+#define KAGOME_CORE_RUNTIME_BINARYEN_MODULE_WASM_MODULE_CACHE
+
+#include <boost/filesystem/path.hpp>
+#include <boost/optional.hpp>
+#include <gsl/span>
+
+#include "common/blob.hpp"
+#include "common/buffer.hpp"
+#include "common/logger.hpp"
+
+namespace kagome::runtime::binaryen {
+
+  /**
+   * On-disk cache of the prepared runtime modules, which spares a node the
+   * preparation of the code on every start. A module is kept in a file named
+   * after the hash of the code it was prepared from, in the wasm binary
+   * format, after a header with the version of the preparation and a checksum
+   * of the module. Entries of another version, or whose module does not match
+   * the checksum, e.g. corrupted or truncated ones, are ignored and replaced
+   */
+  class WasmModuleCache {
+   public:
+    /**
+     * Version of the preparation of the modules, which has to be increased
+     * whenever it changes, so that the modules prepared before are not used
+     */
+    static constexpr uint32_t kFormatVersion = 2;
+
+    /**
+     * @param directory where the modules are kept, created when a module is
+     * stored
+     */
+    explicit WasmModuleCache(boost::filesystem::path directory);
+
+    /**
+     * @return the module prepared from the code with \arg code_hash, none if
+     * there is no valid one
+     */
+    boost::optional<common::Buffer> load(
+        const common::Hash256 &code_hash) const;
+
+    /**
+     * Stores the \arg module prepared from the code with \arg code_hash. The
+     * module is written to a temporary file first, and then takes its place,
+     * so that neither a failure nor a concurrent store leaves a partial entry.
+     * Failures are logged, as the cache only saves time
+     */
+    void store(const common::Hash256 &code_hash,
+               gsl::span<const uint8_t> module) const;
+
+    /**
+     * @return path of the file with the module prepared from the code with
+     * \arg code_hash
+     */
+    boost::filesystem::path entryPath(const common::Hash256 &code_hash) const;
+
+   private:
+    common::Buffer header(const common::Hash256 &code_hash) const;
+
+    static common::Hash256 checksum(gsl::span<const uint8_t> module);
+
+    boost::filesystem::path directory_;
+    common::Logger logger_;
+  };
+
+}  // namespace kagome::runtime::binaryen
+
+#endif  // KAGOME_CORE_RUNTIME_BINARYEN_MODULE_WASM_MODULE_CACHE
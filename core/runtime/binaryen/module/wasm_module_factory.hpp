@@ -14,7 +14,8 @@
 namespace kagome::runtime::binaryen {
 
   /**
-   * An abstract factory to produce WasmModules
+   * An abstract factory to produce WasmModules. The implementation decides
+   * how the runtime code is executed, and is selected at startup
    */
   class WasmModuleFactory {
    public:
@@ -5,19 +5,78 @@
 
 #include "runtime/binaryen/module/wasm_module_factory_impl.hpp"
 
+#include <chrono>
+
+#include "crypto/blake2/blake2b.h"
 #include "runtime/binaryen/module/wasm_module_impl.hpp"
 
 namespace kagome::runtime::binaryen {
 
+  namespace {
+    auto millisecondsSince(std::chrono::steady_clock::time_point start) {
+      return std::chrono::duration_cast<std::chrono::milliseconds>(
+                 std::chrono::steady_clock::now() - start)
+          .count();
+    }
+  }  // namespace
+
+  WasmModuleFactoryImpl::WasmModuleFactoryImpl()
+      : WasmModuleFactoryImpl(Configuration{}) {}
+
+  WasmModuleFactoryImpl::WasmModuleFactoryImpl(
+      const Configuration &configuration)
+      : configuration_{configuration},
+        logger_{common::createLogger("WasmModuleFactory")} {
+    // only the optimization takes long enough to be worth caching its result,
+    // as parsing of the cached module takes as long as parsing of the code
+    if (configuration_.optimize and not configuration_.cache_directory.empty()) {
+      cache_.emplace(configuration_.cache_directory);
+    }
+  }
+
   outcome::result<std::unique_ptr<WasmModule>>
   WasmModuleFactoryImpl::createModule(
       const common::Buffer &code,
       std::shared_ptr<RuntimeExternalInterface> rei) const {
-    auto res = WasmModuleImpl::createFromCode(code, rei);
-    if (res.has_value()) {
-      return std::unique_ptr<WasmModule>(res.value().release());
+    if (not cache_) {
+      OUTCOME_TRY(module,
+                  WasmModuleImpl::createFromCode(
+                      code, rei, configuration_.optimize));
+      return std::unique_ptr<WasmModule>(module.release());
     }
-    return res.error();
+
+    auto start = std::chrono::steady_clock::now();
+    common::Hash256 code_hash;
+    blake2b(code_hash.data(),
+            common::Hash256::size(),
+            nullptr,
+            0,
+            code.data(),
+            code.size());
+    if (auto cached = cache_->load(code_hash)) {
+      auto module = WasmModuleImpl::createFromCode(*cached, rei, false);
+      if (module) {
+        logger_->info("Optimized runtime module {} loaded from {} in {} ms",
+                      code_hash.toHex(),
+                      cache_->entryPath(code_hash).string(),
+                      millisecondsSince(start));
+        return std::unique_ptr<WasmModule>(module.value().release());
+      }
+      logger_->warn("Cached runtime module {} is invalid: {}",
+                    code_hash.toHex(),
+                    module.error().message());
+    }
+
+    OUTCOME_TRY(module, WasmModuleImpl::createFromCode(code, rei, true));
+    auto store_start = std::chrono::steady_clock::now();
+    cache_->store(code_hash, module->serialize());
+    logger_->info(
+        "Runtime module {} prepared in {} ms, of which {} ms took storing it "
+        "to the cache",
+        code_hash.toHex(),
+        millisecondsSince(start),
+        millisecondsSince(store_start));
+    return std::unique_ptr<WasmModule>(module.release());
   }
 
 }  // namespace kagome::runtime::binaryen
@@ -8,15 +8,43 @@
 
 #include "runtime/binaryen/module/wasm_module_factory.hpp"
 
+#include <boost/filesystem/path.hpp>
+
+#include "common/logger.hpp"
+#include "runtime/binaryen/module/wasm_module_cache.hpp"
+
 namespace kagome::runtime::binaryen {
 
+  /**
+   * Creates modules executed by the binaryen interpreter
+   */
   class WasmModuleFactoryImpl final : public WasmModuleFactory {
    public:
+    struct Configuration {
+      /// whether the code is optimized by binaryen passes before it is
+      /// interpreted, which takes a while once per code, but makes the
+      /// interpreter evaluate fewer expressions on every call
+      bool optimize = false;
+      /// directory of the on-disk cache of the optimized modules, so that
+      /// the code is optimized once rather than on every start; empty
+      /// disables the cache. Modules which are not optimized are never
+      /// cached, as they are parsed from the code as fast as they would be
+      /// from the cache
+      boost::filesystem::path cache_directory{};
+    };
+
+    WasmModuleFactoryImpl();
+    explicit WasmModuleFactoryImpl(const Configuration &configuration);
     ~WasmModuleFactoryImpl() override = default;
 
     outcome::result<std::unique_ptr<WasmModule>> createModule(
         const common::Buffer &code,
         std::shared_ptr<RuntimeExternalInterface> rei) const override;
+
+   private:
+    Configuration configuration_;
+    boost::optional<WasmModuleCache> cache_;
+    common::Logger logger_;
   };
 
 }  // namespace kagome::runtime::binaryen
@@ -5,11 +5,14 @@
 
 #include "runtime/binaryen/module/wasm_module_impl.hpp"
 
+#include <chrono>
 #include <memory>
 
+#include <binaryen/pass.h>
 #include <binaryen/wasm-binary.h>
 #include <binaryen/wasm-interpreter.h>
 
+#include "common/logger.hpp"
 #include "runtime/binaryen/module/wasm_module_instance_impl.hpp"
 
 OUTCOME_CPP_DEFINE_CATEGORY(kagome::runtime::binaryen,
@@ -35,14 +38,17 @@ namespace kagome::runtime::binaryen {
   outcome::result<std::unique_ptr<WasmModuleImpl>>
   WasmModuleImpl::createFromCode(
       const common::Buffer &code,
-      const std::shared_ptr<RuntimeExternalInterface> &rei) {
+      const std::shared_ptr<RuntimeExternalInterface> &rei,
+      bool optimize) {
     // that nolint suppresses false positive in a library function
     // NOLINTNEXTLINE(clang-analyzer-core.NonNullParamChecker)
     if (code.empty()) {
       return Error::EMPTY_STATE_CODE;
     }
 
+    auto logger = common::createLogger("WasmModule");
     auto module = std::make_unique<wasm::Module>();
+    auto start = std::chrono::steady_clock::now();
     {
       wasm::WasmBinaryBuilder parser(
 
@@ -60,6 +66,23 @@ namespace kagome::runtime::binaryen {
         return Error::INVALID_STATE_CODE;
       }
     }
+    logger->debug("Runtime code parsed in {} ms",
+                  std::chrono::duration_cast<std::chrono::milliseconds>(
+                      std::chrono::steady_clock::now() - start)
+                      .count());
+    if (optimize) {
+      start = std::chrono::steady_clock::now();
+      wasm::PassOptions options;
+      // implicit traps are kept, as the runtime relies on them
+      options.optimizeLevel = 2;
+      wasm::PassRunner runner(module.get(), options);
+      runner.addDefaultOptimizationPasses();
+      runner.run();
+      logger->info("Runtime code optimized in {} ms",
+                   std::chrono::duration_cast<std::chrono::milliseconds>(
+                       std::chrono::steady_clock::now() - start)
+                       .count());
+    }
     std::unique_ptr<WasmModuleImpl> wasm_module_impl(
         new WasmModuleImpl(std::move(module)));
     return wasm_module_impl;
@@ -71,4 +94,11 @@ namespace kagome::runtime::binaryen {
         *module_, externalInterface);
   }
 
+  common::Buffer WasmModuleImpl::serialize() const {
+    wasm::BufferWithRandomAccess buffer;
+    wasm::WasmBinaryWriter writer(module_.get(), buffer);
+    writer.write();
+    return common::Buffer{std::vector<uint8_t>(buffer.begin(), buffer.end())};
+  }
+
 }  // namespace kagome::runtime::binaryen
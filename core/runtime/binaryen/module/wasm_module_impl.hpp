@@ -32,14 +32,26 @@ namespace kagome::runtime::binaryen {
 
     ~WasmModuleImpl() override = default;
 
+    /**
+     * Parses the module from \arg code
+     * @param optimize whether to run the binaryen optimization passes on the
+     * parsed module, which preserve its behaviour including traps
+     */
     static outcome::result<std::unique_ptr<WasmModuleImpl>> createFromCode(
         const common::Buffer &code,
-        const std::shared_ptr<RuntimeExternalInterface> &rei);
+        const std::shared_ptr<RuntimeExternalInterface> &rei,
+        bool optimize = false);
 
     std::unique_ptr<WasmModuleInstance> instantiate(
         const std::shared_ptr<RuntimeExternalInterface> &externalInterface)
         const override;
 
+    /**
+     * @return the module in the wasm binary format, which it can be parsed
+     * back from, e.g. to keep it once optimized
+     */
+    common::Buffer serialize() const;
+
    private:
     explicit WasmModuleImpl(std::unique_ptr<wasm::Module> &&module);
 
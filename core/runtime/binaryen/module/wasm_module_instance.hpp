@@ -25,6 +25,13 @@ namespace kagome::runtime::binaryen {
      */
     virtual wasm::Literal callExport(
         wasm::Name name, const std::vector<wasm::Literal> &arguments) = 0;
+
+    /**
+     * Restores the state of the instance right after its instantiation:
+     * values of globals, size of the memory and contents of its data
+     * segments, so that the instance can be reused for another call
+     */
+    virtual void reset() = 0;
   };
 }  // namespace kagome::runtime::binaryen
 
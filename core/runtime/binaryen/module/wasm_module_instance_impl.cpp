@@ -5,20 +5,54 @@
 
 #include "runtime/binaryen/module/wasm_module_instance_impl.hpp"
 
+#include <binaryen/wasm-interpreter.h>
 #include <binaryen/wasm.h>
 
 namespace kagome::runtime::binaryen {
 
+  /**
+   * Module instance, which remembers the values of globals it is
+   * instantiated with, to be able to return to the initial state
+   */
+  class WasmModuleInstanceImpl::ResettableModuleInstance
+      : public wasm::ModuleInstance {
+   public:
+    ResettableModuleInstance(
+        ::wasm::Module &module,
+        ::wasm::ModuleInstance::ExternalInterface *external_interface)
+        : ::wasm::ModuleInstance(module, external_interface),
+          initial_globals_{globals} {}
+
+    void reset() {
+      globals = initial_globals_;
+      memorySize = wasm.memory.initial;
+      // resizes the memory to the initial size and writes the data segments
+      // over whatever previous calls left there
+      externalInterface->init(wasm, *this);
+    }
+
+   private:
+    // the name of the module member hides the namespace here
+    const decltype(::wasm::ModuleInstance::globals) initial_globals_;
+  };
+
   WasmModuleInstanceImpl::WasmModuleInstanceImpl(
       wasm::Module &module,
       const std::shared_ptr<RuntimeExternalInterface> &rei)
       : module_instance_{
-          std::make_unique<wasm::ModuleInstance>(module, rei.get())} {
+          std::make_unique<ResettableModuleInstance>(module, rei.get())} {
     BOOST_ASSERT(module_instance_);
   }
 
+  WasmModuleInstanceImpl::~WasmModuleInstanceImpl() = default;
+
   wasm::Literal WasmModuleInstanceImpl::callExport(
       wasm::Name name, const wasm::LiteralList &arguments) {
     return module_instance_->callExport(name, arguments);
   }
+
+  void WasmModuleInstanceImpl::reset() {
+    module_instance_->reset();
+  }
+
 }  // namespace kagome::runtime::binaryen
@@ -12,7 +12,7 @@
 
 namespace wasm {
   using namespace ::wasm;  // NOLINT(google-build-using-namespace)
-  class ModuleInstance;
+  class Module;
 }  // namespace wasm
 
 namespace kagome::runtime::binaryen {
@@ -23,11 +23,17 @@ namespace kagome::runtime::binaryen {
         wasm::Module &module,
         const std::shared_ptr<RuntimeExternalInterface> &rei);
 
+    ~WasmModuleInstanceImpl() override;
+
     wasm::Literal callExport(
         wasm::Name name, const std::vector<wasm::Literal> &arguments) override;
 
+    void reset() override;
+
    private:
-    std::unique_ptr<wasm::ModuleInstance> module_instance_;
+    class ResettableModuleInstance;
+
+    std::unique_ptr<ResettableModuleInstance> module_instance_;
   };
 
 }  // namespace kagome::runtime::binaryen
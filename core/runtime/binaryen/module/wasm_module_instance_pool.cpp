@@ -0,0 +1,62 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/binaryen/module/wasm_module_instance_pool.hpp"
+
+namespace kagome::runtime::binaryen {
+
+  WasmModuleInstancePool::WasmModuleInstancePool(
+      std::shared_ptr<RuntimeExternalInterface> external_interface)
+      : external_interface_{std::move(external_interface)} {
+    BOOST_ASSERT(external_interface_);
+  }
+
+  std::shared_ptr<WasmModuleInstance> WasmModuleInstancePool::acquire(
+      const common::Hash256 &code_hash,
+      const std::shared_ptr<WasmModule> &module) {
+    BOOST_ASSERT(module);
+    std::unique_ptr<WasmModuleInstance> instance;
+    std::shared_ptr<WasmModule> pooled_module;
+    {
+      std::lock_guard lock{mutex_};
+      auto &idle = idle_instances_[code_hash];
+      if (not idle.empty()) {
+        instance = std::move(idle.back());
+        idle.pop_back();
+      } else {
+        pooled_module = modules_.emplace(code_hash, module).first->second;
+      }
+    }
+    if (instance != nullptr) {
+      instance->reset();
+    } else {
+      instance = pooled_module->instantiate(external_interface_);
+    }
+
+    return std::shared_ptr<WasmModuleInstance>(
+        instance.release(),
+        [weak_pool = weak_from_this(), code_hash](WasmModuleInstance *ptr) {
+          std::unique_ptr<WasmModuleInstance> instance{ptr};
+          if (auto pool = weak_pool.lock()) {
+            pool->release(code_hash, std::move(instance));
+          }
+        });
+  }
+
+  size_t WasmModuleInstancePool::idleCount(
+      const common::Hash256 &code_hash) const {
+    std::lock_guard lock{mutex_};
+    auto it = idle_instances_.find(code_hash);
+    return it == idle_instances_.end() ? 0 : it->second.size();
+  }
+
+  void WasmModuleInstancePool::release(
+      const common::Hash256 &code_hash,
+      std::unique_ptr<WasmModuleInstance> instance) {
+    std::lock_guard lock{mutex_};
+    idle_instances_[code_hash].push_back(std::move(instance));
+  }
+
+}  // namespace kagome::runtime::binaryen
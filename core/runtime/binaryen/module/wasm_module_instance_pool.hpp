@@ -0,0 +1,62 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_RUNTIME_BINARYEN_MODULE_WASM_MODULE_INSTANCE_POOL
+#define KAGOME_CORE_RUNTIME_BINARYEN_MODULE_WASM_MODULE_INSTANCE_POOL
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "common/blob.hpp"
+#include "runtime/binaryen/module/wasm_module.hpp"
+
+namespace kagome::runtime::binaryen {
+
+  /**
+   * Instances of wasm modules bound to a runtime external interface, which
+   * are reused by runtime calls instead of instantiating a module for every
+   * call. An instance returns to the pool once the last reference to it is
+   * released, and is reset to its initial state when it is taken again.
+   * Nested calls of the same code take different instances
+   */
+  class WasmModuleInstancePool
+      : public std::enable_shared_from_this<WasmModuleInstancePool> {
+   public:
+    explicit WasmModuleInstancePool(
+        std::shared_ptr<RuntimeExternalInterface> external_interface);
+
+    /**
+     * @param code_hash hash of the code of the module
+     * @param module to be instantiated if there is no idle instance of it
+     * @return instance of the module in its initial state
+     */
+    std::shared_ptr<WasmModuleInstance> acquire(
+        const common::Hash256 &code_hash,
+        const std::shared_ptr<WasmModule> &module);
+
+    /**
+     * @return number of instances of the code waiting in the pool
+     */
+    size_t idleCount(const common::Hash256 &code_hash) const;
+
+   private:
+    void release(const common::Hash256 &code_hash,
+                 std::unique_ptr<WasmModuleInstance> instance);
+
+    std::shared_ptr<RuntimeExternalInterface> external_interface_;
+
+    mutable std::mutex mutex_;
+    // all instances of a code are of the same module, which has to outlive
+    // them
+    std::map<common::Hash256, std::shared_ptr<WasmModule>> modules_;
+    std::map<common::Hash256, std::vector<std::unique_ptr<WasmModuleInstance>>>
+        idle_instances_;
+  };
+
+}  // namespace kagome::runtime::binaryen
+
+#endif  // KAGOME_CORE_RUNTIME_BINARYEN_MODULE_WASM_MODULE_INSTANCE_POOL
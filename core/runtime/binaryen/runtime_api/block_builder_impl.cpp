@@ -26,8 +26,11 @@ namespace kagome::runtime::binaryen {
   }
 
   outcome::result<BlockHeader> BlockBuilderImpl::finalise_block() {
-    return execute<BlockHeader>("BlockBuilder_finalize_block",
-                                CallPersistency::PERSISTENT);
+    OUTCOME_TRY(header,
+                execute<BlockHeader>("BlockBuilder_finalize_block",
+                                     CallPersistency::PERSISTENT));
+    OUTCOME_TRY(commitState());
+    return std::move(header);
   }
 
   outcome::result<std::vector<Extrinsic>> BlockBuilderImpl::inherent_extrinsics(
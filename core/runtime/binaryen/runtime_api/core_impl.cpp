@@ -41,10 +41,12 @@ namespace kagome::runtime::binaryen {
     OUTCOME_TRY(changes_tracker_->onBlockChange(
         block.header.parent_hash,
         block.header.number - 1));  // parent's number
-    return executeAt<void>("Core_execute_block",
-                           parent.state_root,
-                           CallPersistency::PERSISTENT,
-                           block);
+    OUTCOME_TRY(executeAt<void>("Core_execute_block",
+                                parent.state_root,
+                                CallPersistency::PERSISTENT,
+                                block));
+    OUTCOME_TRY(commitState());
+    return outcome::success();
   }
 
   outcome::result<void> CoreImpl::initialise_block(const BlockHeader &header) {
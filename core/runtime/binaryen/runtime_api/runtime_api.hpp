@@ -55,26 +55,24 @@ namespace kagome::runtime::binaryen {
         switch (persistency) {
           case CallPersistency::PERSISTENT:
             return runtime_manager_
-                ->createPersistentRuntimeEnvironmentAt(
-                    wasm_provider_->getStateCode(), state_root_opt.value())
+                ->createPersistentRuntimeEnvironmentAt(*wasm_provider_,
+                                                       state_root_opt.value())
                 .value();
           case CallPersistency::EPHEMERAL:
             return runtime_manager_
-                ->createEphemeralRuntimeEnvironmentAt(
-                    wasm_provider_->getStateCode(), state_root_opt.value())
+                ->createEphemeralRuntimeEnvironmentAt(*wasm_provider_,
+                                                      state_root_opt.value())
                 .value();
         }
       } else {
         switch (persistency) {
           case CallPersistency::PERSISTENT:
             return runtime_manager_
-                ->createPersistentRuntimeEnvironment(
-                    wasm_provider_->getStateCode())
+                ->createPersistentRuntimeEnvironment(*wasm_provider_)
                 .value();
           case CallPersistency::EPHEMERAL:
             return runtime_manager_
-                ->createEphemeralRuntimeEnvironment(
-                    wasm_provider_->getStateCode())
+                ->createEphemeralRuntimeEnvironment(*wasm_provider_)
                 .value();
         }
       }
@@ -82,6 +80,16 @@ namespace kagome::runtime::binaryen {
     }
 
    protected:
+    /**
+     * @brief writes the changes made by persistent calls to the state trie
+     * storage, which is only done once a block is complete, as calculating the
+     * storage root during the block execution does not touch the database
+     * @return the new state root
+     */
+    outcome::result<common::Buffer> commitState() {
+      return runtime_manager_->commitState();
+    }
+
     /**
      * @brief executes wasm export method returning non-void result
      * @tparam R result type including void
@@ -139,6 +147,29 @@ namespace kagome::runtime::binaryen {
         logger_->debug("Resetting state to: {}", state_root.value().toHex());
       }
 
+      common::Buffer encoded_args;
+      if constexpr (sizeof...(args) > 0) {
+        OUTCOME_TRY(buffer, scale::encode(std::forward<Args>(args)...));
+        encoded_args = common::Buffer{std::move(buffer)};
+      }
+
+      // pure calls are executed once per code
+      boost::optional<RuntimeCallCache::Key> cache_key;
+      if constexpr (!std::is_same_v<void, R>) {
+        if (persistency == CallPersistency::EPHEMERAL
+            and RuntimeCallCache::isPure(name)) {
+          // the key is of the current code, taken at once with its hash
+          cache_key =
+              RuntimeCallCache::Key{wasm_provider_->getStateCodeAndHash().hash,
+                                    std::string{name},
+                                    encoded_args};
+          if (auto cached = runtime_manager_->callCache().get(*cache_key)) {
+            logger_->debug("Result of {} is cached", name);
+            return scale::decode<R>(cached.value());
+          }
+        }
+      }
+
       auto environment = createRuntimeEnvironment(persistency, state_root);
       auto &&[module, memory, opt_batch] = environment;
 
@@ -146,10 +177,9 @@ namespace kagome::runtime::binaryen {
       runtime::WasmSize len = 0u;
 
       if constexpr (sizeof...(args) > 0) {
-        OUTCOME_TRY(buffer, scale::encode(std::forward<Args>(args)...));
-        len = buffer.size();
+        len = encoded_args.size();
         ptr = memory->allocate(len);
-        memory->storeBuffer(ptr, common::Buffer(std::move(buffer)));
+        memory->storeBuffer(ptr, encoded_args);
       }
 
       wasm::LiteralList ll{wasm::Literal(ptr), wasm::Literal(len)};
@@ -164,7 +194,12 @@ namespace kagome::runtime::binaryen {
         // TODO (yuraz) PRE-98: after check for memory overflow is done,
         //  refactor it
         memory->reset();
-        return scale::decode<R>(std::move(buffer));
+        OUTCOME_TRY(result, scale::decode<R>(buffer));
+        if (cache_key) {
+          runtime_manager_->callCache().put(std::move(cache_key.value()),
+                                            std::move(buffer));
+        }
+        return std::move(result);
       }
 
       if (opt_batch) {
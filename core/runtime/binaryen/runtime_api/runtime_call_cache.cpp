@@ -0,0 +1,55 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/binaryen/runtime_api/runtime_call_cache.hpp"
+
+#include <algorithm>
+#include <array>
+#include <tuple>
+
+namespace kagome::runtime::binaryen {
+
+  namespace {
+    /// the versions and the metadata are compiled into the runtime
+    constexpr std::array<std::string_view, 2> kPureMethods{
+        "Core_version",
+        "Metadata_metadata",
+    };
+  }  // namespace
+
+  bool RuntimeCallCache::Key::operator<(const Key &other) const {
+    return std::tie(code_hash, method, args)
+           < std::tie(other.code_hash, other.method, other.args);
+  }
+
+  bool RuntimeCallCache::isPure(std::string_view method) {
+    return std::find(kPureMethods.begin(), kPureMethods.end(), method)
+           != kPureMethods.end();
+  }
+
+  boost::optional<common::Buffer> RuntimeCallCache::get(const Key &key) const {
+    std::lock_guard lock{mutex_};
+    auto it = results_.find(key);
+    if (it == results_.end()) {
+      return boost::none;
+    }
+    return it->second;
+  }
+
+  void RuntimeCallCache::put(Key key, common::Buffer result) {
+    std::lock_guard lock{mutex_};
+    if (results_.size() >= kCapacity) {
+      // results of the codes replaced by upgrades are not needed anymore
+      results_.clear();
+    }
+    results_.insert_or_assign(std::move(key), std::move(result));
+  }
+
+  size_t RuntimeCallCache::size() const {
+    std::lock_guard lock{mutex_};
+    return results_.size();
+  }
+
+}  // namespace kagome::runtime::binaryen
@@ -0,0 +1,65 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_RUNTIME_BINARYEN_RUNTIME_API_RUNTIME_CALL_CACHE
+#define KAGOME_CORE_RUNTIME_BINARYEN_RUNTIME_API_RUNTIME_CALL_CACHE
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include <boost/optional.hpp>
+
+#include "common/blob.hpp"
+#include "common/buffer.hpp"
+
+namespace kagome::runtime::binaryen {
+
+  /**
+   * Results of runtime calls, which depend on the runtime code and the
+   * arguments only, so that they are not executed again for the same code.
+   * Only the methods known to be pure are cached, as the rest read the state
+   */
+  class RuntimeCallCache {
+   public:
+    /// Number of results kept, the cache is cleared once it is exceeded
+    static constexpr size_t kCapacity = 256;
+
+    struct Key {
+      common::Hash256 code_hash;
+      std::string method;
+      /// scale-encoded arguments
+      common::Buffer args;
+
+      bool operator<(const Key &other) const;
+    };
+
+    /**
+     * @return true if the result of \arg method depends on the runtime code
+     * and the arguments only
+     */
+    static bool isPure(std::string_view method);
+
+    /**
+     * @return scale-encoded result of the call, if it was cached
+     */
+    boost::optional<common::Buffer> get(const Key &key) const;
+
+    /**
+     * Caches scale-encoded \arg result of the call
+     */
+    void put(Key key, common::Buffer result);
+
+    size_t size() const;
+
+   private:
+    mutable std::mutex mutex_;
+    std::map<Key, common::Buffer> results_;
+  };
+
+}  // namespace kagome::runtime::binaryen
+
+#endif  // KAGOME_CORE_RUNTIME_BINARYEN_RUNTIME_API_RUNTIME_CALL_CACHE
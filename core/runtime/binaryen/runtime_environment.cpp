@@ -5,19 +5,15 @@
 
 #include "runtime/binaryen/runtime_environment.hpp"
 
-#include "crypto/hasher.hpp"
 #include "runtime/binaryen/module/wasm_module.hpp"
 
 namespace kagome::runtime::binaryen {
 
   outcome::result<RuntimeEnvironment> RuntimeEnvironment::create(
       const std::shared_ptr<RuntimeExternalInterface> &rei,
-      const std::shared_ptr<WasmModule> &module,
-
-      const common::Buffer &state_code) {
-
+      std::shared_ptr<WasmModuleInstance> module_instance) {
     return RuntimeEnvironment{
-        module->instantiate(rei), rei->memory(), boost::none};
+        std::move(module_instance), rei->memory(), boost::none};
   }
 
 }  // namespace kagome::runtime::binaryen
@@ -12,10 +12,6 @@
 
 #include "outcome/outcome.hpp"
 
-namespace kagome::common {
-  class Buffer;
-}
-
 namespace kagome::storage::trie {
   class TopperTrieBatch;
   class TrieBatch;
@@ -28,7 +24,6 @@ namespace kagome::runtime {
 namespace kagome::runtime::binaryen {
   class RuntimeExternalInterface;
   class WasmModuleInstance;
-  class WasmModule;
 
   /**
    * Runtime environment is a structure that contains data necessary to operate
@@ -36,10 +31,13 @@ namespace kagome::runtime::binaryen {
    */
   class RuntimeEnvironment {
    public:
+    /**
+     * @param rei external interface the module instance is bound to
+     * @param module_instance instance of the runtime module ready for a call
+     */
     static outcome::result<RuntimeEnvironment> create(
         const std::shared_ptr<RuntimeExternalInterface> &rei,
-        const std::shared_ptr<WasmModule> &module,
-        const common::Buffer &state_code);
+        std::shared_ptr<WasmModuleInstance> module_instance);
 
     RuntimeEnvironment(RuntimeEnvironment &&) = default;
     RuntimeEnvironment &operator=(RuntimeEnvironment &&) = default;
@@ -5,137 +5,249 @@
 
 #include "runtime/binaryen/runtime_external_interface.hpp"
 
+#include <algorithm>
+#include <iterator>
+
 #include "runtime/binaryen/wasm_memory_impl.hpp"
 
 namespace kagome::runtime::binaryen {
 
   const static wasm::Name env = "env";
 
-  const static wasm::Name ext_malloc = "ext_malloc";
-  const static wasm::Name ext_free = "ext_free";
-
-  const static wasm::Name ext_clear_prefix = "ext_clear_prefix";
-  const static wasm::Name ext_clear_storage = "ext_clear_storage";
-  const static wasm::Name ext_exists_storage = "ext_exists_storage";
-  const static wasm::Name ext_get_allocated_storage =
-      "ext_get_allocated_storage";
-  const static wasm::Name ext_get_storage_into = "ext_get_storage_into";
-  const static wasm::Name ext_set_storage = "ext_set_storage";
-  const static wasm::Name ext_blake2_256_enumerated_trie_root =
-      "ext_blake2_256_enumerated_trie_root";
-  const static wasm::Name ext_storage_changes_root = "ext_storage_changes_root";
-  const static wasm::Name ext_storage_root = "ext_storage_root";
-  const static wasm::Name ext_child_storage_root = "ext_child_storage_root";
-  const static wasm::Name ext_clear_child_storage = "ext_clear_child_storage";
-  const static wasm::Name ext_exists_child_storage = "ext_exists_child_storage";
-  const static wasm::Name ext_get_allocated_child_storage =
-      "ext_get_allocated_child_storage";
-  const static wasm::Name ext_get_child_storage_into =
-      "ext_get_child_storage_into";
-  const static wasm::Name ext_kill_child_storage = "ext_kill_child_storage";
-  const static wasm::Name ext_set_child_storage = "ext_set_child_storage";
-
-  const static wasm::Name ext_print_hex = "ext_print_hex";
-  const static wasm::Name ext_logging_log_version_1 =
-      "ext_logging_log_version_1";
-  const static wasm::Name ext_print_num = "ext_print_num";
-  const static wasm::Name ext_print_utf8 = "ext_print_utf8";
-
-  const static wasm::Name ext_blake2_128 = "ext_blake2_128";
-  const static wasm::Name ext_blake2_256 = "ext_blake2_256";
-  const static wasm::Name ext_keccak_256 = "ext_keccak_256";
-
-  const static wasm::Name ext_start_batch_verify = "ext_start_batch_verify";
-  const static wasm::Name ext_finish_batch_verify = "ext_finish_batch_verify";
-
-  const static wasm::Name ext_ed25519_verify = "ext_ed25519_verify";
-  const static wasm::Name ext_sr25519_verify = "ext_sr25519_verify";
-
-  const static wasm::Name ext_twox_64 = "ext_twox_64";
-  const static wasm::Name ext_twox_128 = "ext_twox_128";
-  const static wasm::Name ext_twox_256 = "ext_twox_256";
-
-  const static wasm::Name ext_chain_id = "ext_chain_id";
-
-  const static wasm::Name ext_misc_print_utf8_version_1 = "ext_misc_print_utf8_version_1";
-
-  // version 1
-  const static wasm::Name ext_hashing_keccak_256_version_1 =
-      "ext_hashing_keccak_256_version_1";
-  const static wasm::Name ext_hashing_sha2_256_version_1 =
-      "ext_hashing_sha2_256_version_1";
-  const static wasm::Name ext_hashing_blake2_128_version_1 =
-      "ext_hashing_blake2_128_version_1";
-  const static wasm::Name ext_hashing_blake2_256_version_1 =
-      "ext_hashing_blake2_256_version_1";
-  const static wasm::Name ext_hashing_twox_256_version_1 =
-      "ext_hashing_twox_256_version_1";
-  const static wasm::Name ext_hashing_twox_128_version_1 =
-      "ext_hashing_twox_128_version_1";
-  const static wasm::Name ext_hashing_twox_64_version_1 =
-      "ext_hashing_twox_64_version_1";
-
-  const static wasm::Name ext_allocator_malloc_version_1 =
-      "ext_allocator_malloc_version_1";
-  const static wasm::Name ext_allocator_free_version_1 =
-      "ext_allocator_free_version_1";
-
-  const static wasm::Name ext_storage_set_version_1 =
-      "ext_storage_set_version_1";
-  const static wasm::Name ext_storage_get_version_1 =
-      "ext_storage_get_version_1";
-  const static wasm::Name ext_storage_clear_version_1 =
-      "ext_storage_clear_version_1";
-  const static wasm::Name ext_storage_exists_version_1 =
-      "ext_storage_exists_version_1";
-  const static wasm::Name ext_storage_read_version_1 =
-      "ext_storage_read_version_1";
-  const static wasm::Name ext_storage_clear_prefix_version_1 =
-      "ext_storage_clear_prefix_version_1";
-  const static wasm::Name ext_storage_root_version_1 =
-      "ext_storage_root_version_1";
-  const static wasm::Name ext_storage_changes_root_version_1 =
-      "ext_storage_changes_root_version_1";
-  const static wasm::Name ext_storage_next_key_version_1 =
-      "ext_storage_next_key_version_1";
-  const static wasm::Name ext_storage_append_version_1 =
-      "ext_storage_append_version_1";
-
-  const static wasm::Name ext_crypto_start_batch_verify_version_1 =
-      "ext_crypto_start_batch_verify_version_1";
-  const static wasm::Name ext_crypto_finish_batch_verify_version_1 =
-      "ext_crypto_finish_batch_verify_version_1";
-
-  const static wasm::Name ext_crypto_ed25519_public_keys_version_1 =
-      "ext_crypto_ed25519_public_keys_version_1";
-  const static wasm::Name ext_crypto_ed25519_generate_version_1 =
-      "ext_crypto_ed25519_generate_version_1";
-  const static wasm::Name ext_crypto_ed25519_sign_version_1 =
-      "ext_crypto_ed25519_sign_version_1";
-  const static wasm::Name ext_crypto_ed25519_verify_version_1 =
-      "ext_crypto_ed25519_verify_version_1";
-
-  const static wasm::Name ext_crypto_sr25519_public_keys_version_1 =
-      "ext_crypto_sr25519_public_keys_version_1";
-  const static wasm::Name ext_crypto_sr25519_generate_version_1 =
-      "ext_crypto_sr25519_generate_version_1";
-  const static wasm::Name ext_crypto_sr25519_sign_version_1 =
-      "ext_crypto_sr25519_sign_version_1";
-  const static wasm::Name ext_crypto_sr25519_verify_version_1 =
-      "ext_crypto_sr25519_verify_version_1";
-  const static wasm::Name ext_crypto_sr25519_verify_version_2 =
-      "ext_crypto_sr25519_verify_version_2";
-
-  const static wasm::Name ext_crypto_secp256k1_ecdsa_recover_version_1 =
-      "ext_crypto_secp256k1_ecdsa_recover_version_1";
-  const static wasm::Name
-      ext_crypto_secp256k1_ecdsa_recover_compressed_version_1 =
-          "ext_crypto_secp256k1_ecdsa_recover_compressed_version_1";
-
-  const static wasm::Name ext_trie_blake2_256_root_version_1 =
-      "ext_trie_blake2_256_root_version_1";
-  const static wasm::Name ext_trie_blake2_256_ordered_root_version_1 =
-      "ext_trie_blake2_256_ordered_root_version_1";
+  /**
+   * Host function, which a runtime can import
+   */
+  struct RuntimeExternalInterface::HostFunction {
+    wasm::Name name;
+    std::vector<wasm::Type> params;
+    wasm::Type result;
+    wasm::Literal (*call)(extensions::Extension &extension,
+                          const wasm::LiteralList &arguments);
+  };
+
+  namespace {
+    using extensions::Extension;
+    using HostFunction = RuntimeExternalInterface::HostFunction;
+
+    /**
+     * Wasm type of a parameter or the result of a host function
+     */
+    template <typename T>
+    wasm::Type wasmType() {
+      if constexpr (std::is_void_v<T>) {
+        return wasm::Type::none;
+      } else {
+        static_assert(std::is_integral_v<T>
+                      and (sizeof(T) == 4 or sizeof(T) == 8));
+        return sizeof(T) == 8 ? wasm::Type::i64 : wasm::Type::i32;
+      }
+    }
+
+    template <typename T>
+    T fromLiteral(const wasm::Literal &literal) {
+      if constexpr (sizeof(T) == 8) {
+        return literal.geti64();
+      } else {
+        return literal.geti32();
+      }
+    }
+
+    template <auto method, typename R, typename... Args, size_t... I>
+    wasm::Literal invoke(Extension &extension,
+                         const wasm::LiteralList &arguments,
+                         std::index_sequence<I...>) {
+      if constexpr (std::is_void_v<R>) {
+        (extension.*method)(fromLiteral<Args>(arguments[I])...);
+        return wasm::Literal();
+      } else {
+        return wasm::Literal(
+            (extension.*method)(fromLiteral<Args>(arguments[I])...));
+      }
+    }
+
+    template <auto method, typename R, typename... Args>
+    HostFunction makeHostFunction(const char *name) {
+      return HostFunction{
+          name,
+          {wasmType<Args>()...},
+          wasmType<R>(),
+          [](Extension &extension, const wasm::LiteralList &arguments) {
+            return invoke<method, R, Args...>(
+                extension, arguments, std::index_sequence_for<Args...>{});
+          }};
+    }
+
+    template <auto method, typename R, typename... Args>
+    HostFunction deduceHostFunction(const char *name,
+                                    R (Extension::*)(Args...)) {
+      return makeHostFunction<method, R, Args...>(name);
+    }
+
+    template <auto method, typename R, typename... Args>
+    HostFunction deduceHostFunction(const char *name,
+                                    R (Extension::*)(Args...) const) {
+      return makeHostFunction<method, R, Args...>(name);
+    }
+
+    /**
+     * Host function, which calls the extension method with the arguments of
+     * the parameter types of the method
+     */
+    template <auto method>
+    HostFunction bind(const char *name) {
+      return deduceHostFunction<method>(name, method);
+    }
+
+    const std::vector<HostFunction> &hostFunctions() {
+      static const std::vector<HostFunction> functions{
+          // memory externals
+          bind<&Extension::ext_malloc>("ext_malloc"),
+          bind<&Extension::ext_free>("ext_free"),
+
+          // storage externals
+          bind<&Extension::ext_clear_prefix>("ext_clear_prefix"),
+          bind<&Extension::ext_clear_storage>("ext_clear_storage"),
+          bind<&Extension::ext_exists_storage>("ext_exists_storage"),
+          bind<&Extension::ext_get_allocated_storage>(
+              "ext_get_allocated_storage"),
+          bind<&Extension::ext_get_storage_into>("ext_get_storage_into"),
+          bind<&Extension::ext_set_storage>("ext_set_storage"),
+          bind<&Extension::ext_blake2_256_enumerated_trie_root>(
+              "ext_blake2_256_enumerated_trie_root"),
+          // the length of the parent hash is not needed, as it is fixed
+          HostFunction{"ext_storage_changes_root",
+                       {wasm::Type::i32, wasm::Type::i32, wasm::Type::i32},
+                       wasm::Type::i32,
+                       [](Extension &extension,
+                          const wasm::LiteralList &arguments) {
+                         return wasm::Literal(
+                             extension.ext_storage_changes_root(
+                                 arguments[0].geti32(), arguments[2].geti32()));
+                       }},
+          bind<&Extension::ext_storage_root>("ext_storage_root"),
+
+          // IO extensions
+          bind<&Extension::ext_print_hex>("ext_print_hex"),
+          bind<&Extension::ext_logging_log_version_1>(
+              "ext_logging_log_version_1"),
+          bind<&Extension::ext_print_num>("ext_print_num"),
+          bind<&Extension::ext_print_utf8>("ext_print_utf8"),
+
+          // cryptographic extensions
+          bind<&Extension::ext_blake2_128>("ext_blake2_128"),
+          bind<&Extension::ext_blake2_256>("ext_blake2_256"),
+          bind<&Extension::ext_keccak_256>("ext_keccak_256"),
+          bind<&Extension::ext_start_batch_verify>("ext_start_batch_verify"),
+          bind<&Extension::ext_finish_batch_verify>("ext_finish_batch_verify"),
+          bind<&Extension::ext_ed25519_verify>("ext_ed25519_verify"),
+          bind<&Extension::ext_sr25519_verify>("ext_sr25519_verify"),
+          bind<&Extension::ext_twox_64>("ext_twox_64"),
+          bind<&Extension::ext_twox_128>("ext_twox_128"),
+          bind<&Extension::ext_twox_256>("ext_twox_256"),
+          bind<&Extension::ext_chain_id>("ext_chain_id"),
+
+          // ----------------------- api version 1 ---------------------------
+
+          // crypto functions
+          bind<&Extension::ext_start_batch_verify>(
+              "ext_crypto_start_batch_verify_version_1"),
+          bind<&Extension::ext_finish_batch_verify>(
+              "ext_crypto_finish_batch_verify_version_1"),
+          bind<&Extension::ext_ed25519_public_keys_v1>(
+              "ext_crypto_ed25519_public_keys_version_1"),
+          bind<&Extension::ext_ed25519_generate_v1>(
+              "ext_crypto_ed25519_generate_version_1"),
+          bind<&Extension::ext_ed25519_sign_v1>(
+              "ext_crypto_ed25519_sign_version_1"),
+          bind<&Extension::ext_ed25519_verify_v1>(
+              "ext_crypto_ed25519_verify_version_1"),
+          bind<&Extension::ext_sr25519_public_keys_v1>(
+              "ext_crypto_sr25519_public_keys_version_1"),
+          bind<&Extension::ext_sr25519_generate_v1>(
+              "ext_crypto_sr25519_generate_version_1"),
+          bind<&Extension::ext_sr25519_sign_v1>(
+              "ext_crypto_sr25519_sign_version_1"),
+          bind<&Extension::ext_sr25519_verify_v1>(
+              "ext_crypto_sr25519_verify_version_1"),
+          bind<&Extension::ext_sr25519_verify_v1>(
+              "ext_crypto_sr25519_verify_version_2"),
+          bind<&Extension::ext_crypto_secp256k1_ecdsa_recover_v1>(
+              "ext_crypto_secp256k1_ecdsa_recover_version_1"),
+          bind<&Extension::ext_crypto_secp256k1_ecdsa_recover_compressed_v1>(
+              "ext_crypto_secp256k1_ecdsa_recover_compressed_version_1"),
+
+          // hashing functions
+          bind<&Extension::ext_hashing_keccak_256_version_1>(
+              "ext_hashing_keccak_256_version_1"),
+          bind<&Extension::ext_hashing_sha2_256_version_1>(
+              "ext_hashing_sha2_256_version_1"),
+          bind<&Extension::ext_hashing_blake2_128_version_1>(
+              "ext_hashing_blake2_128_version_1"),
+          bind<&Extension::ext_hashing_blake2_256_version_1>(
+              "ext_hashing_blake2_256_version_1"),
+          bind<&Extension::ext_hashing_twox_256_version_1>(
+              "ext_hashing_twox_256_version_1"),
+          bind<&Extension::ext_hashing_twox_128_version_1>(
+              "ext_hashing_twox_128_version_1"),
+          bind<&Extension::ext_hashing_twox_64_version_1>(
+              "ext_hashing_twox_64_version_1"),
+
+          // memory functions
+          bind<&Extension::ext_allocator_malloc_version_1>(
+              "ext_allocator_malloc_version_1"),
+          bind<&Extension::ext_allocator_free_version_1>(
+              "ext_allocator_free_version_1"),
+
+          // storage functions
+          bind<&Extension::ext_storage_set_version_1>(
+              "ext_storage_set_version_1"),
+          bind<&Extension::ext_storage_get_version_1>(
+              "ext_storage_get_version_1"),
+          bind<&Extension::ext_storage_clear_version_1>(
+              "ext_storage_clear_version_1"),
+          bind<&Extension::ext_storage_exists_version_1>(
+              "ext_storage_exists_version_1"),
+          bind<&Extension::ext_storage_read_version_1>(
+              "ext_storage_read_version_1"),
+          bind<&Extension::ext_storage_clear_prefix_version_1>(
+              "ext_storage_clear_prefix_version_1"),
+          bind<&Extension::ext_storage_root_version_1>(
+              "ext_storage_root_version_1"),
+          bind<&Extension::ext_storage_changes_root_version_1>(
+              "ext_storage_changes_root_version_1"),
+          bind<&Extension::ext_storage_next_key_version_1>(
+              "ext_storage_next_key_version_1"),
+          bind<&Extension::ext_storage_append_version_1>(
+              "ext_storage_append_version_1"),
+
+          // trie functions
+          bind<&Extension::ext_trie_blake2_256_root_version_1>(
+              "ext_trie_blake2_256_root_version_1"),
+          bind<&Extension::ext_trie_blake2_256_ordered_root_version_1>(
+              "ext_trie_blake2_256_ordered_root_version_1"),
+
+          // misc functions
+          bind<&Extension::ext_misc_print_utf8_version_1>(
+              "ext_misc_print_utf8_version_1"),
+      };
+      return functions;
+    }
+
+    /**
+     * Indices of the host functions by their interned names
+     */
+    const std::unordered_map<const char *, size_t> &hostFunctionIndices() {
+      static const auto indices = [] {
+        std::unordered_map<const char *, size_t> indices;
+        const auto &functions = hostFunctions();
+        for (size_t i = 0; i < functions.size(); ++i) {
+          indices.emplace(functions[i].name.str, i);
+        }
+        return indices;
+      }();
+      return indices;
+    }
+  }  // namespace
 
   /**
    * @note: some implementation details were taken from
@@ -144,544 +256,106 @@ namespace kagome::runtime::binaryen {
 
   RuntimeExternalInterface::RuntimeExternalInterface(
       const std::shared_ptr<extensions::ExtensionFactory> &extension_factory,
-      std::shared_ptr<TrieStorageProvider> storage_provider) {
+      std::shared_ptr<TrieStorageProvider> storage_provider)
+      : host_function_stats_(hostFunctions().size()) {
     BOOST_ASSERT_MSG(extension_factory != nullptr,
                      "extension factory is nullptr");
     BOOST_ASSERT_MSG(storage_provider != nullptr,
                      "storage provider is nullptr");
     auto memory_impl =
-        std::make_shared<WasmMemoryImpl>(&(ShellExternalInterface::memory));
+        std::make_shared<WasmMemoryImpl>(&linear_memory_);
     extension_ = extension_factory->createExtension(
         memory_impl, std::move(storage_provider));
+    const auto &functions = hostFunctions();
+    for (size_t i = 0; i < functions.size(); ++i) {
+      host_function_stats_[i].name = functions[i].name.str;
+    }
+  }
+
+  RuntimeExternalInterface::~RuntimeExternalInterface() {
+    for (const auto &stats : getHostFunctionStats()) {
+      logger_->debug("Host function {} called {} times, took {} us",
+                     stats.name,
+                     stats.calls,
+                     std::chrono::duration_cast<std::chrono::microseconds>(
+                         stats.time)
+                         .count());
+    }
+  }
+
+  void RuntimeExternalInterface::init(wasm::Module &wasm,
+                                      wasm::ModuleInstance &instance) {
+    ShellExternalInterface::init(wasm, instance);
+    // the shell interface has placed the data segments into its own memory,
+    // which is then copied through its public accessors, as the accesses of
+    // the interpreter are served from the linear memory afterwards
+    const auto initial_size =
+        static_cast<size_t>(wasm.memory.initial) * wasm::Memory::kPageSize;
+    linear_memory_.resize(initial_size);
+    for (size_t address = 0; address < initial_size;
+         address += sizeof(uint64_t)) {
+      linear_memory_.set(address, memory.get<uint64_t>(address));
+    }
+    memory.resize(0);
+
+    const auto &functions = hostFunctions();
+    const auto &indices = hostFunctionIndices();
+    for (const auto &function : wasm.functions) {
+      if (not function->imported() or function->module != env) {
+        continue;
+      }
+      auto it = indices.find(function->base.str);
+      if (it == indices.end()) {
+        // runtimes may import functions they never call
+        logger_->debug("Unknown import {}", function->base.str);
+        continue;
+      }
+      const auto &host_function = functions[it->second];
+      if (function->params != host_function.params
+          or function->result != host_function.result) {
+        logger_->error("Import {} does not match the host function signature",
+                       function->base.str);
+        continue;
+      }
+      imports_[function.get()] = it->second;
+    }
   }
 
   wasm::Literal RuntimeExternalInterface::callImport(
       wasm::Function *import, wasm::LiteralList &arguments) {
     logger_->trace("Call import {}", import->base);
-    // TODO(kamilsa): PRE-359 Replace ifs with switch case
-    if (import->module == env) {
-      /// memory externals
-      /// ext_malloc
-      if (import->base == ext_malloc) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        auto ptr = extension_->ext_malloc(arguments.at(0).geti32());
-        return wasm::Literal(ptr);
-      }
-      /// ext_free
-      if (import->base == ext_free) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        extension_->ext_free(arguments.at(0).geti32());
-        return wasm::Literal();
-      }
-      /// storage externals
-
-      /// ext_clear_prefix
-      if (import->base == ext_clear_prefix) {
-        checkArguments(import->base.c_str(), 2, arguments.size());
-        extension_->ext_clear_prefix(arguments.at(0).geti32(),
-                                     arguments.at(1).geti32());
-        return wasm::Literal();
-      }
-      /// ext_clear_storage
-      if (import->base == ext_clear_storage) {
-        checkArguments(import->base.c_str(), 2, arguments.size());
-        extension_->ext_clear_storage(arguments.at(0).geti32(),
-                                      arguments.at(1).geti32());
-        return wasm::Literal();
-      }
-      /// ext_exists_storage
-      if (import->base == ext_exists_storage) {
-        checkArguments(import->base.c_str(), 2, arguments.size());
-        auto storage_exists = extension_->ext_exists_storage(
-            arguments.at(0).geti32(), arguments.at(1).geti32());
-        return wasm::Literal(storage_exists);
-      }
-      /// ext_get_allocated_storage
-      if (import->base == ext_get_allocated_storage) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
-        auto ptr =
-            extension_->ext_get_allocated_storage(arguments.at(0).geti32(),
-                                                  arguments.at(1).geti32(),
-                                                  arguments.at(2).geti32());
-        return wasm::Literal(ptr);
-      }
-      /// ext_get_storage_into
-      if (import->base == ext_get_storage_into) {
-        checkArguments(import->base.c_str(), 5, arguments.size());
-        auto res = extension_->ext_get_storage_into(arguments.at(0).geti32(),
-                                                    arguments.at(1).geti32(),
-                                                    arguments.at(2).geti32(),
-                                                    arguments.at(3).geti32(),
-                                                    arguments.at(4).geti32());
-        return wasm::Literal(res);
-      }
-      /// ext_storage_read_version_1
-      if (import->base == ext_storage_read_version_1) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
-        auto res =
-            extension_->ext_storage_read_version_1(arguments.at(0).geti64(),
-                                                   arguments.at(1).geti64(),
-                                                   arguments.at(2).geti32());
-        return wasm::Literal(res);
-      }
-      /// ext_set_storage
-      if (import->base == ext_set_storage) {
-        checkArguments(import->base.c_str(), 4, arguments.size());
-        extension_->ext_set_storage(arguments.at(0).geti32(),
-                                    arguments.at(1).geti32(),
-                                    arguments.at(2).geti32(),
-                                    arguments.at(3).geti32());
-        return wasm::Literal();
-      }
-      /// ext_blake2_256_enumerated_trie_root
-      if (import->base == ext_blake2_256_enumerated_trie_root) {
-        checkArguments(import->base.c_str(), 4, arguments.size());
-        extension_->ext_blake2_256_enumerated_trie_root(
-            arguments.at(0).geti32(),
-            arguments.at(1).geti32(),
-            arguments.at(2).geti32(),
-            arguments.at(3).geti32());
-        return wasm::Literal();
-      }
-      /// ext_storage_changes_root
-      if (import->base == ext_storage_changes_root) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
-        auto res = extension_->ext_storage_changes_root(
-            arguments.at(0).geti32(), arguments.at(2).geti32());
-        return wasm::Literal(res);
-      }
-      /// ext_storage_root
-      if (import->base == ext_storage_root) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        extension_->ext_storage_root(arguments.at(0).geti32());
-        return wasm::Literal();
-      }
-
-      /// IO extensions
-
-      /// ext_print_hex
-      if (import->base == ext_print_hex) {
-        checkArguments(import->base.c_str(), 2, arguments.size());
-        extension_->ext_print_hex(arguments.at(0).geti32(),
-                                  arguments.at(1).geti32());
-        return wasm::Literal();
-      }
-      /// ext_logging_log_version_1
-      if (import->base == ext_logging_log_version_1) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
-        extension_->ext_logging_log_version_1(arguments.at(0).geti32(),
-                                              arguments.at(1).geti64(),
-                                              arguments.at(2).geti64());
-        return wasm::Literal();
-      }
-      /// ext_print_num
-      if (import->base == ext_print_num) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        extension_->ext_print_num(arguments.at(0).geti64());
-        return wasm::Literal();
-      }
-      /// ext_print_utf8
-      if (import->base == ext_print_utf8) {
-        checkArguments(import->base.c_str(), 2, arguments.size());
-        extension_->ext_print_utf8(arguments.at(0).geti32(),
-                                   arguments.at(1).geti32());
-        return wasm::Literal();
-      }
-
-      /// Cryptographic extensions
-      /// ext_blake2_128
-      if (import->base == ext_blake2_128) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
-        extension_->ext_blake2_128(arguments.at(0).geti32(),
-                                   arguments.at(1).geti32(),
-                                   arguments.at(2).geti32());
-        return wasm::Literal();
-      }
-
-      /// ext_blake2_256
-      if (import->base == ext_blake2_256) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
-        extension_->ext_blake2_256(arguments.at(0).geti32(),
-                                   arguments.at(1).geti32(),
-                                   arguments.at(2).geti32());
-        return wasm::Literal();
-      }
-
-      /// ext_keccak_256
-      if (import->base == ext_keccak_256) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
-        extension_->ext_keccak_256(arguments.at(0).geti32(),
-                                   arguments.at(1).geti32(),
-                                   arguments.at(2).geti32());
-        return wasm::Literal();
-      }
-
-      // ext_start_batch_verify
-      if (import->base == ext_start_batch_verify) {
-        checkArguments(import->base.c_str(), 0, arguments.size());
-        extension_->ext_start_batch_verify();
-        return wasm::Literal();
-      }
-
-      // ext_finish_batch_verify
-      if (import->base == ext_start_batch_verify) {
-        checkArguments(import->base.c_str(), 0, arguments.size());
-        auto res = extension_->ext_finish_batch_verify();
-        return wasm::Literal(res);
-      }
-
-      /// ext_ed25519_verify
-      if (import->base == ext_ed25519_verify) {
-        checkArguments(import->base.c_str(), 4, arguments.size());
-        auto res = extension_->ext_ed25519_verify(arguments.at(0).geti32(),
-                                                  arguments.at(1).geti32(),
-                                                  arguments.at(2).geti32(),
-                                                  arguments.at(3).geti32());
-        return wasm::Literal(res);
-      }
-      /// ext_sr25519_verify
-      if (import->base == ext_sr25519_verify) {
-        checkArguments(import->base.c_str(), 4, arguments.size());
-        auto res = extension_->ext_sr25519_verify(arguments.at(0).geti32(),
-                                                  arguments.at(1).geti32(),
-                                                  arguments.at(2).geti32(),
-                                                  arguments.at(3).geti32());
-        return wasm::Literal(res);
-      }
-      /// ext_twox_64
-      if (import->base == ext_twox_64) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
-        extension_->ext_twox_64(arguments.at(0).geti32(),
-                                arguments.at(1).geti32(),
-                                arguments.at(2).geti32());
-        return wasm::Literal();
-      }
-      /// ext_twox_128
-      if (import->base == ext_twox_128) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
-        extension_->ext_twox_128(arguments.at(0).geti32(),
-                                 arguments.at(1).geti32(),
-                                 arguments.at(2).geti32());
-        return wasm::Literal();
-      }
-      /// ext_twox_256
-      if (import->base == ext_twox_256) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
-
-        extension_->ext_twox_256(arguments.at(0).geti32(),
-                                 arguments.at(1).geti32(),
-                                 arguments.at(2).geti32());
-        return wasm::Literal();
-      }
-      /// ext_chain_id
-      if (import->base == ext_chain_id) {
-        checkArguments(import->base.c_str(), 0, arguments.size());
-        auto res = extension_->ext_chain_id();
-        return wasm::Literal(res);
-      }
-
-      // ----------------------- api version 1 ---------------------------
-
-      // ----------------------- crypto functions ------------------------
-
-	    // ext_crypto_start_batch_verify_version_1
-	    if (import->base == ext_crypto_start_batch_verify_version_1) {
-		    checkArguments(import->base.c_str(), 0, arguments.size());
-		    extension_->ext_start_batch_verify();
-		    return wasm::Literal();
-	    }
-
-	    // ext_crypto_finish_batch_verify_version_1
-	    if (import->base == ext_crypto_finish_batch_verify_version_1) {
-		    checkArguments(import->base.c_str(), 0, arguments.size());
-		    auto res = extension_->ext_finish_batch_verify();
-		    return wasm::Literal(res);
-	    }
-
-
-      /// ext_crypto_ed25519_public_keys_version_1
-      if (import->base == ext_crypto_ed25519_public_keys_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        auto res =
-            extension_->ext_ed25519_public_keys_v1(arguments.at(0).geti32());
-        return wasm::Literal(res);
-      }
-
-      /// ext_crypto_ed25519_generate_version_1
-      if (import->base == ext_crypto_ed25519_generate_version_1) {
-        checkArguments(import->base.c_str(), 2, arguments.size());
-        auto res = extension_->ext_ed25519_generate_v1(
-            arguments.at(0).geti32(), arguments.at(1).geti64());
-        return wasm::Literal(res);
-      }
-
-      /// ext_crypto_ed25519_sign_version_1
-      if (import->base == ext_crypto_ed25519_sign_version_1) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
-        auto res = extension_->ext_ed25519_sign_v1(arguments.at(0).geti32(),
-                                                   arguments.at(1).geti32(),
-                                                   arguments.at(2).geti64());
-        return wasm::Literal(res);
-      }
-
-      /// ext_crypto_ed25519_verify_version_1
-      if (import->base == ext_crypto_ed25519_verify_version_1) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
-        auto res = extension_->ext_ed25519_verify_v1(arguments.at(0).geti32(),
-                                                     arguments.at(1).geti64(),
-                                                     arguments.at(2).geti32());
-        return wasm::Literal(res);
-      }
-
-      /// ext_crypto_sr25519_public_keys_version_1
-      if (import->base == ext_crypto_sr25519_public_keys_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        auto res =
-            extension_->ext_sr25519_public_keys_v1(arguments.at(0).geti32());
-        return wasm::Literal(res);
-      }
-
-      /// ext_crypto_sr25519_generate_version_1
-      if (import->base == ext_crypto_sr25519_generate_version_1) {
-        checkArguments(import->base.c_str(), 2, arguments.size());
-        auto res = extension_->ext_sr25519_generate_v1(
-            arguments.at(0).geti32(), arguments.at(1).geti64());
-        return wasm::Literal(res);
-      }
-
-      /// ext_crypto_sr25519_sign_version_1
-      if (import->base == ext_crypto_sr25519_sign_version_1) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
-        auto res = extension_->ext_sr25519_sign_v1(arguments.at(0).geti32(),
-                                                   arguments.at(1).geti32(),
-                                                   arguments.at(2).geti64());
-        return wasm::Literal(res);
-      }
-
-      /// ext_crypto_sr25519_verify_version_1
-      if (import->base == ext_crypto_sr25519_verify_version_1) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
-        auto res = extension_->ext_sr25519_verify_v1(arguments.at(0).geti32(),
-                                                     arguments.at(1).geti64(),
-                                                     arguments.at(2).geti32());
-        return wasm::Literal(res);
-      }
-
-      /// ext_crypto_sr25519_verify_version_2
-      if (import->base == ext_crypto_sr25519_verify_version_2) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
-        auto res = extension_->ext_sr25519_verify_v1(arguments.at(0).geti32(),
-                                                     arguments.at(1).geti64(),
-                                                     arguments.at(2).geti32());
-        return wasm::Literal(res);
-      }
-
-      /// ext_crypto_secp256k1_ecdsa_recover_version_1
-      if (import->base == ext_crypto_secp256k1_ecdsa_recover_version_1) {
-        checkArguments(import->base.c_str(), 2, arguments.size());
-        auto res = extension_->ext_crypto_secp256k1_ecdsa_recover_v1(
-            arguments.at(0).geti32(), arguments.at(1).geti32());
-        return wasm::Literal(res);
-      }
-
-      /// ext_crypto_secp256k1_ecdsa_recover_compressed_version_1
-      if (import->base
-          == ext_crypto_secp256k1_ecdsa_recover_compressed_version_1) {
-        checkArguments(import->base.c_str(), 2, arguments.size());
-        auto res = extension_->ext_crypto_secp256k1_ecdsa_recover_compressed_v1(
-            arguments.at(0).geti32(), arguments.at(1).geti32());
-        return wasm::Literal(res);
-      }
-
-      // ----------------------- hashing functions ------------------------
-
-      /// ext_hashing_keccak_256_version_1
-      if (import->base == ext_hashing_keccak_256_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        auto res = extension_->ext_hashing_keccak_256_version_1(
-            arguments.at(0).geti64());
-        return wasm::Literal(res);
-      }
-
-      /// ext_hashing_sha2_256_version_1
-      if (import->base == ext_hashing_sha2_256_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        auto res = extension_->ext_hashing_sha2_256_version_1(
-            arguments.at(0).geti64());
-        return wasm::Literal(res);
-      }
-
-      /// ext_hashing_blake2_128_version_1
-      if (import->base == ext_hashing_blake2_128_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        auto res = extension_->ext_hashing_blake2_128_version_1(
-            arguments.at(0).geti64());
-        return wasm::Literal(res);
-      }
-
-      /// ext_hashing_blake2_256_version_1
-      if (import->base == ext_hashing_blake2_256_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        auto res = extension_->ext_hashing_blake2_256_version_1(
-            arguments.at(0).geti64());
-        return wasm::Literal(res);
-      }
-
-      /// ext_hashing_twox_256_version_1
-      if (import->base == ext_hashing_twox_256_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        auto res = extension_->ext_hashing_twox_256_version_1(
-            arguments.at(0).geti64());
-        return wasm::Literal(res);
-      }
-
-      /// ext_hashing_twox_128_version_1
-      if (import->base == ext_hashing_twox_128_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        auto res = extension_->ext_hashing_twox_128_version_1(
-            arguments.at(0).geti64());
-        return wasm::Literal(res);
-      }
-
-      /// ext_hashing_twox_64_version_1
-      if (import->base == ext_hashing_twox_64_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        auto res =
-            extension_->ext_hashing_twox_64_version_1(arguments.at(0).geti64());
-        return wasm::Literal(res);
-      }
-
-      /// ext_allocator_malloc_version_1
-      if (import->base == ext_allocator_malloc_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        auto res = extension_->ext_allocator_malloc_version_1(
-            arguments.at(0).geti32());
-        return wasm::Literal(res);
-      }
-
-      // ----------------------- memory functions ------------------------
-
-      /// ext_allocator_malloc_version_1
-      if (import->base == ext_allocator_malloc_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        auto res = extension_->ext_allocator_malloc_version_1(
-            arguments.at(0).geti32());
-        return wasm::Literal(res);
-      }
-
-      /// ext_allocator_free_version_1
-      if (import->base == ext_allocator_free_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        extension_->ext_allocator_free_version_1(arguments.at(0).geti32());
-        return wasm::Literal();
-      }
-
-      // ----------------------- storage functions ------------------------
-      /// ext_storage_set_version_1
-      if (import->base == ext_storage_set_version_1) {
-        checkArguments(import->base.c_str(), 2, arguments.size());
-        extension_->ext_storage_set_version_1(arguments.at(0).geti64(),
-                                              arguments.at(1).geti64());
-        return wasm::Literal();
-      }
-
-      /// ext_storage_get_version_1
-      if (import->base == ext_storage_get_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        auto res =
-            extension_->ext_storage_get_version_1(arguments.at(0).geti64());
-        return wasm::Literal(res);
-      }
-
-      /// ext_storage_clear_version_1
-      if (import->base == ext_storage_clear_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        extension_->ext_storage_clear_version_1(arguments.at(0).geti64());
-        return wasm::Literal();
-      }
-
-      /// ext_storage_exists_version_1
-      if (import->base == ext_storage_exists_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        auto res =
-            extension_->ext_storage_exists_version_1(arguments.at(0).geti64());
-        return wasm::Literal(res);
-      }
-
-      /// ext_storage_read_version_1
-      if (import->base == ext_storage_read_version_1) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
-        auto res =
-            extension_->ext_storage_read_version_1(arguments.at(0).geti64(),
-                                                   arguments.at(1).geti64(),
-                                                   arguments.at(2).geti32());
-        return wasm::Literal(res);
-      }
-
-      /// ext_storage_clear_prefix_version_1
-      if (import->base == ext_storage_clear_prefix_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        extension_->ext_storage_clear_prefix_version_1(
-            arguments.at(0).geti64());
-        return wasm::Literal();
-      }
-
-      /// ext_storage_root_version_1
-      if (import->base == ext_storage_root_version_1) {
-        checkArguments(import->base.c_str(), 0, arguments.size());
-        auto res = extension_->ext_storage_root_version_1();
-        return wasm::Literal(res);
-      }
-
-      /// ext_storage_changes_root_version_1
-      if (import->base == ext_storage_changes_root_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        auto res = extension_->ext_storage_changes_root_version_1(
-            arguments.at(0).geti64());
-        return wasm::Literal(res);
-      }
-
-      /// ext_storage_next_key_version_1
-      if (import->base == ext_storage_next_key_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        auto res = extension_->ext_storage_next_key_version_1(
-            arguments.at(0).geti64());
-        return wasm::Literal(res);
-      }
-      /// ext_storage_append_version_1
-      if (import->base == ext_storage_append_version_1) {
-        checkArguments(import->base.c_str(), 2, arguments.size());
-        extension_->ext_storage_append_version_1(arguments.at(0).geti64(),
-                                                 arguments.at(1).geti64());
-        return wasm::Literal();
-      }
-
-      /// ext_trie_blake2_256_root_version_1
-      if (import->base == ext_trie_blake2_256_root_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        auto res = extension_->ext_trie_blake2_256_root_version_1(
-            arguments.at(0).geti64());
-        return wasm::Literal(res);
-      }
-
-      /// ext_trie_blake2_256_ordered_root_version_1
-      if (import->base == ext_trie_blake2_256_ordered_root_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        auto res = extension_->ext_trie_blake2_256_ordered_root_version_1(
-            arguments.at(0).geti64());
-        return wasm::Literal(res);
-      }
-
-      if (import->base == ext_misc_print_utf8_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        extension_->ext_misc_print_utf8_version_1(arguments.at(0).geti64());
-        return wasm::Literal();
-      }
+    auto it = imports_.find(import);
+    if (it == imports_.end()) {
+      wasm::Fatal() << "callImport: unknown import: " << import->module.str
+                    << "." << import->name.str;
     }
+    // the index is copied, as the host function may instantiate a module,
+    // which updates the imports
+    const auto index = it->second;
+    const auto &host_function = hostFunctions()[index];
+    checkArguments(
+        import->base.c_str(), host_function.params.size(), arguments.size());
+
+    const auto start = std::chrono::steady_clock::now();
+    auto result = host_function.call(*extension_, arguments);
+    auto &stats = host_function_stats_[index];
+    stats.time += std::chrono::steady_clock::now() - start;
+    ++stats.calls;
+    return result;
+  }
 
-    wasm::Fatal() << "callImport: unknown import: " << import->module.str << "."
-                  << import->name.str;
-  }  // namespace kagome::runtime::binaryen
+  std::vector<RuntimeExternalInterface::HostFunctionStats>
+  RuntimeExternalInterface::getHostFunctionStats() const {
+    std::vector<HostFunctionStats> stats;
+    std::copy_if(host_function_stats_.begin(),
+                 host_function_stats_.end(),
+                 std::back_inserter(stats),
+                 [](const auto &stats) { return stats.calls != 0; });
+    std::sort(stats.begin(), stats.end(), [](const auto &lhs, const auto &rhs) {
+      return lhs.time > rhs.time;
+    });
+    return stats;
+  }
 
   void RuntimeExternalInterface::checkArguments(std::string_view extern_name,
                                                 size_t expected,
@@ -696,4 +370,55 @@ namespace kagome::runtime::binaryen {
     }
   }
 
+  int8_t RuntimeExternalInterface::load8s(wasm::Address addr) {
+    return linear_memory_.get<int8_t>(addr);
+  }
+  uint8_t RuntimeExternalInterface::load8u(wasm::Address addr) {
+    return linear_memory_.get<uint8_t>(addr);
+  }
+  int16_t RuntimeExternalInterface::load16s(wasm::Address addr) {
+    return linear_memory_.get<int16_t>(addr);
+  }
+  uint16_t RuntimeExternalInterface::load16u(wasm::Address addr) {
+    return linear_memory_.get<uint16_t>(addr);
+  }
+  int32_t RuntimeExternalInterface::load32s(wasm::Address addr) {
+    return linear_memory_.get<int32_t>(addr);
+  }
+  uint32_t RuntimeExternalInterface::load32u(wasm::Address addr) {
+    return linear_memory_.get<uint32_t>(addr);
+  }
+  int64_t RuntimeExternalInterface::load64s(wasm::Address addr) {
+    return linear_memory_.get<int64_t>(addr);
+  }
+  uint64_t RuntimeExternalInterface::load64u(wasm::Address addr) {
+    return linear_memory_.get<uint64_t>(addr);
+  }
+  std::array<uint8_t, 16> RuntimeExternalInterface::load128(
+      wasm::Address addr) {
+    return linear_memory_.get<std::array<uint8_t, 16>>(addr);
+  }
+
+  void RuntimeExternalInterface::store8(wasm::Address addr, int8_t value) {
+    linear_memory_.set(addr, value);
+  }
+  void RuntimeExternalInterface::store16(wasm::Address addr, int16_t value) {
+    linear_memory_.set(addr, value);
+  }
+  void RuntimeExternalInterface::store32(wasm::Address addr, int32_t value) {
+    linear_memory_.set(addr, value);
+  }
+  void RuntimeExternalInterface::store64(wasm::Address addr, int64_t value) {
+    linear_memory_.set(addr, value);
+  }
+  void RuntimeExternalInterface::store128(
+      wasm::Address addr, const std::array<uint8_t, 16> &value) {
+    linear_memory_.set(addr, value);
+  }
+
+  void RuntimeExternalInterface::growMemory(wasm::Address /*old_size*/,
+                                            wasm::Address new_size) {
+    linear_memory_.resize(new_size);
+  }
+
 }  // namespace kagome::runtime::binaryen
@@ -8,22 +8,72 @@
 
 #include <binaryen/shell-interface.h>
 
+#include <chrono>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
 #include "common/logger.hpp"
 #include "extensions/extension_factory.hpp"
+#include "runtime/binaryen/linear_memory.hpp"
 #include "runtime/wasm_memory.hpp"
 #include "runtime/trie_storage_provider.hpp"
 
 namespace kagome::runtime::binaryen {
 
+  /**
+   * Resolves the imports of a module to the host functions once the module is
+   * instantiated, checking their signatures, so that calling an import takes
+   * a single lookup. Counts the calls of the host functions and their time.
+   * Serves the memory accesses of the interpreter from a LinearMemory, which
+   * the host functions share
+   */
   class RuntimeExternalInterface : public wasm::ShellExternalInterface {
    public:
+    struct HostFunction;
+
+    struct HostFunctionStats {
+      std::string_view name;
+      uint64_t calls = 0;
+      std::chrono::nanoseconds time{0};
+    };
+
     explicit RuntimeExternalInterface(
         const std::shared_ptr<extensions::ExtensionFactory>& extension_factory,
         std::shared_ptr<TrieStorageProvider> storage_provider);
 
+    ~RuntimeExternalInterface();
+
+    void init(wasm::Module &wasm, wasm::ModuleInstance &instance) override;
+
     wasm::Literal callImport(wasm::Function *import,
                              wasm::LiteralList &arguments) override;
 
+    int8_t load8s(wasm::Address addr) override;
+    uint8_t load8u(wasm::Address addr) override;
+    int16_t load16s(wasm::Address addr) override;
+    uint16_t load16u(wasm::Address addr) override;
+    int32_t load32s(wasm::Address addr) override;
+    uint32_t load32u(wasm::Address addr) override;
+    int64_t load64s(wasm::Address addr) override;
+    uint64_t load64u(wasm::Address addr) override;
+    std::array<uint8_t, 16> load128(wasm::Address addr) override;
+
+    void store8(wasm::Address addr, int8_t value) override;
+    void store16(wasm::Address addr, int16_t value) override;
+    void store32(wasm::Address addr, int32_t value) override;
+    void store64(wasm::Address addr, int64_t value) override;
+    void store128(wasm::Address addr,
+                  const std::array<uint8_t, 16> &value) override;
+
+    void growMemory(wasm::Address old_size, wasm::Address new_size) override;
+
+    /**
+     * @return statistics of the host functions called through this interface,
+     * the most time consuming first
+     */
+    std::vector<HostFunctionStats> getHostFunctionStats() const;
+
     inline std::shared_ptr<WasmMemory> memory() const {
       return extension_->memory();
     }
@@ -41,7 +91,13 @@ namespace kagome::runtime::binaryen {
                         size_t expected,
                         size_t actual);
 
+    // constructed before the memory of the extension refers to it
+    LinearMemory linear_memory_;
     std::unique_ptr<extensions::Extension> extension_;
+    // indices of the host functions of the resolved imports
+    std::unordered_map<const wasm::Function *, size_t> imports_;
+    // indexed like the host functions
+    std::vector<HostFunctionStats> host_function_stats_;
     common::Logger logger_ = common::createLogger(kDefaultLoggerTag);
 
     constexpr static auto kDefaultLoggerTag = "Runtime external interface";
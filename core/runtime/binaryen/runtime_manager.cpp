@@ -7,7 +7,6 @@
 
 #include <gsl/gsl>
 
-#include "crypto/hasher/hasher_impl.hpp"
 #include "runtime/binaryen/runtime_external_interface.hpp"
 
 OUTCOME_CPP_DEFINE_CATEGORY(kagome::runtime::binaryen,
@@ -23,70 +22,85 @@ OUTCOME_CPP_DEFINE_CATEGORY(kagome::runtime::binaryen,
 
 namespace kagome::runtime::binaryen {
 
-  thread_local std::shared_ptr<RuntimeExternalInterface>
-      RuntimeManager::external_interface_{};
+  thread_local RuntimeManager::ThreadContext RuntimeManager::thread_context_{};
 
   RuntimeManager::RuntimeManager(
       std::shared_ptr<extensions::ExtensionFactory> extension_factory,
       std::shared_ptr<WasmModuleFactory> module_factory,
-      std::shared_ptr<TrieStorageProvider> storage_provider,
-      std::shared_ptr<crypto::Hasher> hasher)
+      std::shared_ptr<TrieStorageProvider> storage_provider)
       : storage_provider_{std::move(storage_provider)},
         extension_factory_{std::move(extension_factory)},
-        module_factory_{std::move(module_factory)},
-        hasher_{std::move(hasher)} {
+        module_factory_{std::move(module_factory)} {
     BOOST_ASSERT(storage_provider_);
     BOOST_ASSERT(extension_factory_);
     BOOST_ASSERT(module_factory_);
-    BOOST_ASSERT(hasher_);
   }
 
   outcome::result<RuntimeEnvironment>
   RuntimeManager::createPersistentRuntimeEnvironmentAt(
-      const common::Buffer &state_code, const common::Hash256 &state_root) {
-    OUTCOME_TRY(storage_provider_->setToPersistentAt(state_root));
-    auto env = createRuntimeEnvironment(state_code);
+      const WasmProvider &wasm_provider, const common::Hash256 &state_root) {
+    auto &storage_provider = *threadContext().storage_provider;
+    OUTCOME_TRY(storage_provider.setToPersistentAt(state_root));
+    auto env = createRuntimeEnvironment(wasm_provider);
     if (env.has_value()) {
       env.value().batch =
-          storage_provider_->tryGetPersistentBatch().value()->batchOnTop();
+          storage_provider.tryGetPersistentBatch().value()->batchOnTop();
     }
     return env;
   }
 
   outcome::result<RuntimeEnvironment>
   RuntimeManager::createEphemeralRuntimeEnvironmentAt(
-      const common::Buffer &state_code, const common::Hash256 &state_root) {
-    OUTCOME_TRY(storage_provider_->setToEphemeralAt(state_root));
-    return createRuntimeEnvironment(state_code);
+      const WasmProvider &wasm_provider, const common::Hash256 &state_root) {
+    OUTCOME_TRY(
+        threadContext().storage_provider->setToEphemeralAt(state_root));
+    return createRuntimeEnvironment(wasm_provider);
   }
 
   outcome::result<RuntimeEnvironment>
   RuntimeManager::createPersistentRuntimeEnvironment(
-      const common::Buffer &state_code) {
-    OUTCOME_TRY(storage_provider_->setToPersistent());
-    auto env = createRuntimeEnvironment(state_code);
+      const WasmProvider &wasm_provider) {
+    auto &storage_provider = *threadContext().storage_provider;
+    OUTCOME_TRY(storage_provider.setToPersistent());
+    auto env = createRuntimeEnvironment(wasm_provider);
     if (env.has_value()) {
       env.value().batch =
-          storage_provider_->tryGetPersistentBatch().value()->batchOnTop();
+          storage_provider.tryGetPersistentBatch().value()->batchOnTop();
     }
     return env;
   }
 
   outcome::result<RuntimeEnvironment>
   RuntimeManager::createEphemeralRuntimeEnvironment(
-      const common::Buffer &state_code) {
-    OUTCOME_TRY(storage_provider_->setToEphemeral());
-    return createRuntimeEnvironment(state_code);
+      const WasmProvider &wasm_provider) {
+    OUTCOME_TRY(threadContext().storage_provider->setToEphemeral());
+    return createRuntimeEnvironment(wasm_provider);
+  }
+
+  RuntimeManager::ThreadContext &RuntimeManager::threadContext() {
+    if (thread_context_.origin.lock() != storage_provider_) {
+      auto storage_provider = storage_provider_->createThreadProvider();
+      auto external_interface = std::make_shared<RuntimeExternalInterface>(
+          extension_factory_, storage_provider);
+      auto instance_pool =
+          std::make_shared<WasmModuleInstancePool>(external_interface);
+      thread_context_ = ThreadContext{storage_provider_,
+                                      std::move(storage_provider),
+                                      std::move(external_interface),
+                                      std::move(instance_pool)};
+    }
+    return thread_context_;
   }
 
   outcome::result<RuntimeEnvironment> RuntimeManager::createRuntimeEnvironment(
-      const common::Buffer &state_code) {
-    if (state_code.empty()) {
+      const WasmProvider &wasm_provider) {
+    // the code and the hash are taken at once, so that the module cached
+    // under the hash is made of that very code
+    const auto [state_code, hash] = wasm_provider.getStateCodeAndHash();
+    if (state_code == nullptr or state_code->empty()) {
       return Error::EMPTY_STATE_CODE;
     }
 
-    auto hash = hasher_->twox_256(state_code);
-
     std::shared_ptr<WasmModule> module;
 
     // Trying retrieve pre-prepared module
@@ -98,16 +112,14 @@ namespace kagome::runtime::binaryen {
       }
     }
 
-    if (external_interface_ == nullptr) {
-      external_interface_ = std::make_shared<RuntimeExternalInterface>(
-          extension_factory_, storage_provider_);
-    }
+    auto &context = threadContext();
 
     if (!module) {
       // Prepare new module
       OUTCOME_TRY(
           new_module,
-          module_factory_->createModule(state_code, external_interface_));
+          module_factory_->createModule(*state_code,
+                                        context.external_interface));
 
       // Trying to safe emplace new module, and use existed one
       //  if it already emplaced in another thread
@@ -116,10 +128,16 @@ namespace kagome::runtime::binaryen {
     }
 
     return RuntimeEnvironment::create(
-        external_interface_, module, state_code);
+        context.external_interface,
+        context.instance_pool->acquire(hash, module));
   }
+
   void RuntimeManager::reset() {
-    external_interface_->reset();
+    threadContext().external_interface->reset();
+  }
+
+  outcome::result<common::Buffer> RuntimeManager::commitState() {
+    return storage_provider_->forceCommit();
   }
 
 }  // namespace kagome::runtime::binaryen
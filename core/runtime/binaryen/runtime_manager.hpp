@@ -8,10 +8,11 @@
 
 #include "common/blob.hpp"
 #include "common/logger.hpp"
-#include "crypto/hasher.hpp"
 #include "extensions/extension_factory.hpp"
 #include "outcome/outcome.hpp"
 #include "runtime/binaryen/module/wasm_module_factory.hpp"
+#include "runtime/binaryen/module/wasm_module_instance_pool.hpp"
+#include "runtime/binaryen/runtime_api/runtime_call_cache.hpp"
 #include "runtime/binaryen/runtime_environment.hpp"
 #include "runtime/binaryen/runtime_external_interface.hpp"
 #include "runtime/trie_storage_provider.hpp"
@@ -24,7 +25,13 @@ namespace kagome::runtime::binaryen {
   /**
    * @brief RuntimeManager is a mechanism to prepare environment for launching
    * execute() function of runtime APIs. It supports in-memory cache to reuse
-   * existing environments, avoid hi-load operations.
+   * existing environments, avoid hi-load operations: parsed modules are
+   * cached by the hash of their code, and their instances are taken from a
+   * pool instead of instantiating a module for every call.
+   * Each thread runs its calls in a context of its own: the storage
+   * provider, the external interface with its memory and extensions, and the
+   * module instances. Thus calls of different threads can run in parallel,
+   * as long as only one of them is persistent.
    */
   class RuntimeManager {
    public:
@@ -33,46 +40,82 @@ namespace kagome::runtime::binaryen {
     RuntimeManager(
         std::shared_ptr<extensions::ExtensionFactory> extension_factory,
         std::shared_ptr<WasmModuleFactory> module_factory,
-        std::shared_ptr<TrieStorageProvider> storage_provider,
-        std::shared_ptr<crypto::Hasher> hasher);
+        std::shared_ptr<TrieStorageProvider> storage_provider);
 
+    /**
+     * The environments are created for the code of \arg wasm_provider, whose
+     * hash is taken from the provider as well
+     */
     outcome::result<RuntimeEnvironment> createPersistentRuntimeEnvironment(
-        const common::Buffer &state_code);
+        const WasmProvider &wasm_provider);
 
     outcome::result<RuntimeEnvironment> createEphemeralRuntimeEnvironment(
-        const common::Buffer &state_code);
+        const WasmProvider &wasm_provider);
 
     /**
      * @warning calling this with an \arg state_root older than the current root
      * will reset the storage to an older state once changes are committed
      */
     outcome::result<RuntimeEnvironment> createPersistentRuntimeEnvironmentAt(
-        const common::Buffer &state_code, const common::Hash256 &state_root);
+        const WasmProvider &wasm_provider, const common::Hash256 &state_root);
 
     outcome::result<RuntimeEnvironment> createEphemeralRuntimeEnvironmentAt(
-        const common::Buffer &state_code, const common::Hash256 &state_root);
+        const WasmProvider &wasm_provider, const common::Hash256 &state_root);
 
     /**
      * Resets state of extensions
      */
     void reset();
 
+    /**
+     * Writes the changes accumulated by persistent runtime calls to the
+     * storage
+     * @returns the new state root
+     */
+    outcome::result<common::Buffer> commitState();
+
+    /**
+     * @return results of the pure calls of the runtime APIs sharing this
+     * manager
+     */
+    RuntimeCallCache &callCache() {
+      return call_cache_;
+    }
+
    private:
+    /**
+     * State of the runtime calls made on a thread
+     */
+    struct ThreadContext {
+      // the provider the context was created from, as a thread might run
+      // the calls of different runtime managers
+      std::weak_ptr<TrieStorageProvider> origin;
+      std::shared_ptr<TrieStorageProvider> storage_provider;
+      std::shared_ptr<RuntimeExternalInterface> external_interface;
+      // instances are bound to the external interface
+      std::shared_ptr<WasmModuleInstancePool> instance_pool;
+    };
+
+    /**
+     * @return the context of the calling thread, created on the first call
+     */
+    ThreadContext &threadContext();
+
     outcome::result<RuntimeEnvironment> createRuntimeEnvironment(
-        const common::Buffer &state_code);
+        const WasmProvider &wasm_provider);
 
     common::Logger logger_ = common::createLogger("Runtime manager");
 
     std::shared_ptr<TrieStorageProvider> storage_provider_;
     std::shared_ptr<extensions::ExtensionFactory> extension_factory_;
     std::shared_ptr<WasmModuleFactory> module_factory_;
-    std::shared_ptr<crypto::Hasher> hasher_;
 
     std::mutex modules_mutex_;
     std::map<common::Hash256, std::shared_ptr<WasmModule>> modules_;
 
-    static thread_local std::shared_ptr<RuntimeExternalInterface>
-        external_interface_;
+    RuntimeCallCache call_cache_;
+
+    static thread_local ThreadContext thread_context_;
   };
 
 }  // namespace kagome::runtime::binaryen
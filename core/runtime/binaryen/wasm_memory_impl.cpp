@@ -5,25 +5,27 @@
 
 #include "runtime/binaryen/wasm_memory_impl.hpp"
 
+#include <algorithm>
+
 #include "runtime/wasm_result.hpp"
 
 namespace kagome::runtime::binaryen {
-  WasmMemoryImpl::WasmMemoryImpl(wasm::ShellExternalInterface::Memory *memory,
-                                 WasmSize size)
+
+  WasmMemoryImpl::WasmMemoryImpl(LinearMemory *memory, WasmSize size)
       : memory_(memory),
         size_(size),
         logger_{common::createLogger("WASM Memory")},
-        offset_{1}  // We should allocate very first byte to prohibit allocating
-                    // memory at 0 in future, as returning 0 from allocate
-                    // method means that wasm memory was exhausted
+        offset_{0}  // the first chunk is placed after its header, so 0 is
+                    // never allocated, as returning 0 from allocate method
+                    // means that wasm memory was exhausted
   {
+    free_lists_.fill(kNil);
     WasmMemoryImpl::resize(size_);
   }
 
   void WasmMemoryImpl::reset() {
-    offset_ = 1;
-    allocated_.clear();
-    deallocated_.clear();
+    offset_ = 0;
+    free_lists_.fill(kNil);
     logger_->trace("Memory reset");
   }
 
@@ -32,10 +34,6 @@ namespace kagome::runtime::binaryen {
   }
 
   void WasmMemoryImpl::resize(runtime::WasmSize new_size) {
-    /**
-     * We use this condition to avoid deallocated_ pointers fixup
-     */
-    BOOST_ASSERT(offset_ <= kMaxMemorySize - new_size);
     if (new_size >= size_) {
       size_ = new_size;
       memory_->resize(new_size);
@@ -46,85 +44,95 @@ namespace kagome::runtime::binaryen {
     if (size == 0) {
       return 0;
     }
-    const auto ptr = offset_;
-    const auto new_offset = roundUpAlign(ptr + size);  // align
-
-    BOOST_ASSERT(allocated_.find(ptr) == allocated_.end());
-    if (new_offset < static_cast<const uint32_t>(ptr)) {  // overflow
+    const auto order = orderOf(size);
+    if (not order) {
       logger_->error(
-          "overflow occured while trying to allocate {} bytes at offset 0x{:x}",
+          "cannot allocate {} bytes, at most {} bytes can be allocated at once",
           size,
-          offset_);
+          kMaxAllocation);
       return 0;
     }
-    if (new_offset <= size_) {
-      offset_ = new_offset;
-      allocated_[ptr] = size;
-      return ptr;
-    }
 
-    return freealloc(size);
+    WasmPointer header;
+    auto &free_list = free_lists_[*order];
+    if (free_list != kNil) {
+      header = free_list;
+      // the link is kept in the wasm memory, where the runtime may overwrite
+      // it, so it is followed only if it points to a chunk of the same size
+      const auto next = memory_->get<uint64_t>(header);
+      if (next != kNil
+          and (next % kAlignment != 0 or next >= offset_
+               or offset_ - next < kHeaderSize + (kMinAllocation << *order))) {
+        logger_->error(
+            "free list of {}-byte chunks is corrupted, header at 0x{:x} links "
+            "to 0x{:x}",
+            kMinAllocation << *order,
+            header,
+            next);
+        throw wasm::TrapException{};
+      }
+      free_list = static_cast<WasmPointer>(next);
+    } else {
+      const auto bumped = bump(*order);
+      if (not bumped) {
+        return 0;
+      }
+      header = *bumped;
+    }
+    memory_->set<uint64_t>(header, kOccupied | *order);
+    return header + kHeaderSize;
   }
 
   boost::optional<WasmSize> WasmMemoryImpl::deallocate(WasmPointer ptr) {
-    const auto it = allocated_.find(ptr);
-    if (it == allocated_.end()) {
+    // a chunk follows its header and precedes the next bumped one
+    if (ptr < kHeaderSize or ptr >= offset_ or ptr % kAlignment != 0) {
+      return boost::none;
+    }
+    const auto header = ptr - kHeaderSize;
+    const auto header_value = memory_->get<uint64_t>(header);
+    const auto order = header_value & ~kOccupied;
+    if ((header_value & kOccupied) == 0 or order >= kOrders) {
       return boost::none;
     }
-    const auto size = it->second;
 
-    allocated_.erase(ptr);
-    deallocated_[ptr] = size;
-    return size;
+    auto &free_list = free_lists_[order];
+    memory_->set<uint64_t>(header, free_list);
+    free_list = header;
+    return kMinAllocation << order;
   }
 
-  WasmPointer WasmMemoryImpl::freealloc(WasmSize size) {
-    auto ptr = findContaining(size);
-    if (ptr == 0) {
-      // if did not find available space among deallocated memory chunks, then
-      // grow memory and allocate in new space
-      return growAlloc(size);
+  boost::optional<uint8_t> WasmMemoryImpl::orderOf(WasmSize size) {
+    if (size > kMaxAllocation) {
+      return boost::none;
     }
-    allocated_[ptr] = deallocated_[ptr];
-    deallocated_.erase(ptr);
-    return ptr;
-  }
-
-  WasmPointer WasmMemoryImpl::findContaining(WasmSize size) {
-    auto min_value = std::numeric_limits<WasmPointer>::max();
-    WasmPointer min_key = 0;
-    for (const auto &[key, value] : deallocated_) {
-      if (min_value <= 0) {
-        return 0;
-      }
-      if (value < static_cast<uint32_t>(min_value) and value >= size) {
-        min_value = value;
-        min_key = key;
-      }
+    uint8_t order = 0;
+    while ((kMinAllocation << order) < size) {
+      ++order;
     }
-    return min_key;
+    return order;
   }
 
-  WasmPointer WasmMemoryImpl::growAlloc(WasmSize size) {
+  boost::optional<WasmPointer> WasmMemoryImpl::bump(uint8_t order) {
+    const uint64_t chunk_size = kHeaderSize + (kMinAllocation << order);
+    const uint64_t new_offset = offset_ + chunk_size;
     // check that we do not exceed max memory size
-    if (static_cast<uint32_t>(offset_) > kMaxMemorySize - size) {
+    if (new_offset > kMaxMemorySize) {
       logger_->error(
-          "Memory size exceeded when growing it on {} bytes, offset was 0x{:x}",
-          size,
+          "Memory size exceeded when allocating {} bytes, offset was 0x{:x}",
+          chunk_size,
           offset_);
-      return 0;
+      return boost::none;
     }
-    // try to increase memory size up to offset + size * 4 (we multiply by 4
-    // to have more memory than currently needed to avoid resizing every time
-    // when we exceed current memory)
-    if (static_cast<uint32_t>(offset_) < kMaxMemorySize - size * 4) {
-      resize(offset_ + size * 4);
-    } else {
-      // if we can't increase by size * 4 then increase memory size by
-      // provided size
-      resize(offset_ + size);
+    if (new_offset > size_) {
+      // try to increase memory size up to offset + size * 4 (we multiply by 4
+      // to have more memory than currently needed to avoid resizing every
+      // time when we exceed current memory)
+      resize(static_cast<WasmSize>(std::min<uint64_t>(
+          offset_ + chunk_size * 4, kMaxMemorySize)));
     }
-    return allocate(size);
+    const auto header = offset_;
+    offset_ = static_cast<WasmPointer>(new_offset);
+    return header;
   }
 
   int8_t WasmMemoryImpl::load8s(WasmPointer addr) const {
@@ -157,23 +165,32 @@ namespace kagome::runtime::binaryen {
 
   common::Buffer WasmMemoryImpl::loadN(kagome::runtime::WasmPointer addr,
                                        kagome::runtime::WasmSize n) const {
-    // TODO (kamilsa) PRE-98: check if we do not go outside of memory
-    common::Buffer res;
-    res.reserve(n);
-    for (auto i = addr; i < addr + n; i++) {
-      res.putUint8(memory_->get<uint8_t>(i));
-    }
-    return res;
+    auto bytes = view(addr, n);
+    return common::Buffer{bytes.begin(), bytes.end()};
   }
 
   std::string WasmMemoryImpl::loadStr(kagome::runtime::WasmPointer addr,
                                       kagome::runtime::WasmSize n) const {
-    std::string res;
-    res.reserve(n);
-    for (auto i = addr; i < addr + n; i++) {
-      res.push_back(memory_->get<uint8_t>(i));
+    return std::string(checkedAddress(addr, n), n);
+  }
+
+  gsl::span<const uint8_t> WasmMemoryImpl::view(WasmPointer addr,
+                                                WasmSize n) const {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    return {reinterpret_cast<const uint8_t *>(checkedAddress(addr, n)), n};
+  }
+
+  const char *WasmMemoryImpl::checkedAddress(WasmPointer addr,
+                                             WasmSize n) const {
+    if (static_cast<uint64_t>(addr) + n > memory_->size()) {
+      logger_->error(
+          "access to {} bytes at 0x{:x} is out of memory bounds of {} bytes",
+          n,
+          addr,
+          memory_->size());
+      throw wasm::TrapException{};
     }
-    return res;
+    return memory_->data() + addr;
   }
 
   void WasmMemoryImpl::store8(WasmPointer addr, int8_t value) {
@@ -194,12 +211,12 @@ namespace kagome::runtime::binaryen {
   }
   void WasmMemoryImpl::storeBuffer(kagome::runtime::WasmPointer addr,
                                    gsl::span<const uint8_t> value) {
-    // TODO (kamilsa) PRE-98: check if we do not go outside of memory
-    // boundaries, 04.04.2019
-    for (size_t i = addr, j = 0; i < addr + static_cast<size_t>(value.size());
-         i++, j++) {
-      memory_->set(i, value[j]);
+    if (value.empty()) {
+      return;
     }
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    auto dest = const_cast<char *>(checkedAddress(addr, value.size()));
+    std::memcpy(dest, value.data(), value.size());
   }
 
   WasmSpan WasmMemoryImpl::storeBuffer(gsl::span<const uint8_t> value) {
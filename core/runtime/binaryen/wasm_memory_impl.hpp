@@ -10,11 +10,12 @@
 
 #include <array>
 #include <cstring>  // for std::memset in gcc
+#include <limits>
 #include <memory>
-#include <unordered_map>
 
 #include <boost/optional.hpp>
 
+#include "runtime/binaryen/linear_memory.hpp"
 #include "runtime/wasm_memory.hpp"
 #include "common/logger.hpp"
 
@@ -28,13 +29,21 @@ namespace kagome::runtime::binaryen {
    * Memory implementation for wasm environment
    * Most code is taken from Binaryen's implementation here:
    * https://github.com/WebAssembly/binaryen/blob/master/src/shell-interface.h#L37
+   * Allocations are served by a freeing-bump allocator, like the substrate's
+   * one:
+   * https://github.com/paritytech/substrate/blob/743981a083f244a090b40ccfb5ce902199b55334/primitives/allocator/src/freeing_bump.rs
+   * Each chunk has a power of two size from 8 bytes to 32 MiB and is preceded
+   * by an 8-byte header in the wasm memory. The header of an allocated chunk
+   * keeps the order of its size, the header of a deallocated one keeps the
+   * pointer to the header of the next deallocated chunk of the same size, so
+   * that both allocation and deallocation take constant time
    * @note Memory size of this implementation is at least of the size of one
    * wasm page (4096 bytes)
    */
   class WasmMemoryImpl : public WasmMemory {
    public:
     explicit WasmMemoryImpl(
-        wasm::ShellExternalInterface::Memory *memory,
+        LinearMemory *memory,
         WasmSize size =
             1114112);  // default value for binaryen's shell interface
     WasmMemoryImpl(const WasmMemoryImpl &copy) = delete;
@@ -48,6 +57,10 @@ namespace kagome::runtime::binaryen {
     WasmSize size() const override;
     void resize(WasmSize newSize) override;
 
+    /**
+     * @throws wasm::TrapException if the list of the deallocated chunks of
+     * the size is corrupted by the runtime, which makes the wasm call fail
+     */
     WasmPointer allocate(WasmSize size) override;
     boost::optional<WasmSize> deallocate(WasmPointer ptr) override;
 
@@ -64,6 +77,8 @@ namespace kagome::runtime::binaryen {
                          kagome::runtime::WasmSize n) const override;
     std::string loadStr(kagome::runtime::WasmPointer addr,
                         kagome::runtime::WasmSize n) const override;
+    gsl::span<const uint8_t> view(WasmPointer addr,
+                                  WasmSize n) const override;
 
     void store8(WasmPointer addr, int8_t value) override;
     void store16(WasmPointer addr, int16_t value) override;
@@ -76,19 +91,29 @@ namespace kagome::runtime::binaryen {
 
     WasmSpan storeBuffer(gsl::span<const uint8_t> value) override;
 
+    /// Size of the smallest chunk
+    static constexpr WasmSize kMinAllocation = 8;
+    /// Size of the largest chunk
+    static constexpr WasmSize kMaxAllocation = 32 * 1024 * 1024;
+
    private:
-    wasm::ShellExternalInterface::Memory *memory_;
+    /// Number of the chunk sizes, from kMinAllocation to kMaxAllocation
+    static constexpr size_t kOrders = 23;
+    static constexpr WasmSize kHeaderSize = 8;
+    /// Marks the end of a list of deallocated chunks
+    static constexpr WasmPointer kNil = std::numeric_limits<WasmPointer>::max();
+    /// Set in the header of an allocated chunk
+    static constexpr uint64_t kOccupied = 1ull << 32u;
+
+    LinearMemory *memory_;
     WasmSize size_;
     common::Logger logger_;
 
-    // Offset on the tail of the last allocated MemoryImpl chunk
+    // Offset of the header of the next chunk to be bumped
     WasmPointer offset_;
 
-    // map containing addresses of allocated MemoryImpl chunks
-    std::unordered_map<WasmPointer, WasmSize> allocated_;
-
-    // map containing addresses to the deallocated MemoryImpl chunks
-    std::unordered_map<WasmPointer, WasmSize> deallocated_;
+    // Headers of the last deallocated chunks of each size, kNil if none
+    std::array<WasmPointer, kOrders> free_lists_;
 
     template <typename T>
     static bool aligned(const char *address) {
@@ -98,31 +123,27 @@ namespace kagome::runtime::binaryen {
     }
 
     /**
-     * Finds memory segment of given size among deallocated pieces of memory
-     * and allocates a memory there
-     * @param size of target memory
-     * @return address of memory of given size, or -1 if it is impossible to
-     * allocate this amount of memory
+     * Order of the size of the chunk, which fits given size
+     * @return order, or none if the size exceeds kMaxAllocation
      */
-    WasmPointer freealloc(WasmSize size);
+    static boost::optional<uint8_t> orderOf(WasmSize size);
 
     /**
-     * Finds memory segment of given size among deallocated pieces of memory
-     * @param size of target memory
-     * @return address of memory of given size, or 0 if it is impossible to
-     * allocate this amount of memory
+     * Places a new chunk of the size of given order after the bumped ones,
+     * resizing memory if needed
+     * @return header of the chunk, or none if the memory cannot fit it
      */
-    WasmPointer findContaining(WasmSize size);
+    boost::optional<WasmPointer> bump(uint8_t order);
+
+    void resizeInternal(WasmSize newSize);
 
     /**
-     * Resize memory and allocate memory segment of given size
-     * @param size memory size to be allocated
-     * @return pointer to the allocated memory @or 0 if it is impossible to
-     * allocate this amount of memory
+     * Checks that n bytes at provided address lie within the memory
+     * @return pointer to the first of the bytes
+     * @throws wasm::TrapException if they do not, which makes the wasm call
+     * fail
      */
-    WasmPointer growAlloc(WasmSize size);
-
-    void resizeInternal(WasmSize newSize);
+    const char *checkedAddress(WasmPointer addr, WasmSize n) const;
   };
 
   /**
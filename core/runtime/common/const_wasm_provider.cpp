@@ -5,12 +5,16 @@
 
 #include "runtime/common/const_wasm_provider.hpp"
 
+#include "crypto/twox/twox.hpp"
+
 namespace kagome::runtime {
 
   ConstWasmProvider::ConstWasmProvider(common::Buffer code)
-      : code_{std::move(code)} {}
+      : code_{std::make_shared<const common::Buffer>(std::move(code)), {}} {
+    code_.hash = crypto::make_twox256(*code_.code);
+  }
 
-  const common::Buffer &ConstWasmProvider::getStateCode() const {
+  WasmProvider::StateCode ConstWasmProvider::getStateCodeAndHash() const {
     return code_;
   }
 
@@ -14,10 +14,10 @@ namespace kagome::runtime {
    public:
     explicit ConstWasmProvider(common::Buffer code);
 
-    const common::Buffer &getStateCode() const override;
+    StateCode getStateCodeAndHash() const override;
 
    private:
-    common::Buffer code_;
+    StateCode code_;
   };
 
 }  // namespace kagome::runtime
@@ -5,6 +5,8 @@
 
 #include "runtime/common/storage_wasm_provider.hpp"
 
+#include "crypto/twox/twox.hpp"
+
 namespace kagome::runtime {
 
   StorageWasmProvider::StorageWasmProvider(
@@ -13,28 +15,31 @@ namespace kagome::runtime {
     BOOST_ASSERT(storage_ != nullptr);
 
     last_state_root_ = storage_->getRootHash();
-    auto batch = storage_->getEphemeralBatch();
-    BOOST_ASSERT_MSG(batch.has_value(), "Error getting a batch of the storage");
-    auto state_code_res = batch.value()->get(kRuntimeKey);
-    BOOST_ASSERT_MSG(state_code_res.has_value(),
-                     "Runtime code does not exist in the storage");
-    state_code_ = state_code_res.value();
+    updateStateCode();
   }
 
-  const common::Buffer &StorageWasmProvider::getStateCode() const {
+  WasmProvider::StateCode StorageWasmProvider::getStateCodeAndHash() const {
     auto current_state_root = storage_->getRootHash();
-    if (last_state_root_ == current_state_root) {
-      return state_code_;
+    std::lock_guard lock{mutex_};
+    if (last_state_root_ != current_state_root) {
+      last_state_root_ = current_state_root;
+      updateStateCode();
     }
-    last_state_root_ = current_state_root;
+    return state_code_;
+  }
 
+  void StorageWasmProvider::updateStateCode() const {
     auto batch = storage_->getEphemeralBatch();
     BOOST_ASSERT_MSG(batch.has_value(), "Error getting a batch of the storage");
-    auto state_code_res = batch.value()->get(kRuntimeKey);
+    auto state_code_res =
+        batch.value()->getIfChanged(kRuntimeKey, state_code_merkle_value_);
     BOOST_ASSERT_MSG(state_code_res.has_value(),
                      "Runtime code does not exist in the storage");
-    state_code_ = state_code_res.value();
-    return state_code_;
+    if (state_code_res.value()) {
+      auto code = std::make_shared<const common::Buffer>(
+          std::move(state_code_res.value().value()));
+      state_code_ = StateCode{code, crypto::make_twox256(*code)};
+    }
   }
 
 }  // namespace kagome::runtime
@@ -8,12 +8,21 @@
 
 #include "runtime/wasm_provider.hpp"
 
+#include <mutex>
+
 #include "storage/trie/trie_storage.hpp"
 
 namespace kagome::runtime {
 
   inline const common::Buffer kRuntimeKey = common::Buffer().put(":code");
 
+  /**
+   * Provides the runtime code of the latest state. When the state changes,
+   * the code is read again only if the trie node it is stored in has
+   * changed, and it is hashed only when it is read.
+   * A snapshot of the code is shared with callers, so the code and its hash
+   * stay consistent while the state code is changed by another thread
+   */
   class StorageWasmProvider : public WasmProvider {
    public:
     ~StorageWasmProvider() override = default;
@@ -21,11 +30,17 @@ namespace kagome::runtime {
     explicit StorageWasmProvider(
         std::shared_ptr<const storage::trie::TrieStorage> storage);
 
-    const common::Buffer &getStateCode() const override;
+    StateCode getStateCodeAndHash() const override;
 
    private:
+    void updateStateCode() const;
+
     std::shared_ptr<const storage::trie::TrieStorage> storage_;
-    mutable common::Buffer state_code_;
+    // runtime calls of different threads take the code
+    mutable std::mutex mutex_;
+    mutable StateCode state_code_;
+    // merkle value of the trie node the code was read from
+    mutable common::Buffer state_code_merkle_value_;
     mutable common::Buffer last_state_root_;
   };
 
@@ -9,14 +9,27 @@
 #include "storage/trie/impl/topper_trie_batch_impl.hpp"
 
 namespace kagome::runtime {
-  using storage::trie::TopperTrieBatch;
   using storage::trie::TopperTrieBatchImpl;
   using storage::trie::TrieStorage;
 
   TrieStorageProviderImpl::TrieStorageProviderImpl(
       std::shared_ptr<TrieStorage> trie_storage)
-      : trie_storage_(std::move(trie_storage)) {
+      : TrieStorageProviderImpl(std::move(trie_storage),
+                                std::make_shared<PersistentState>()) {}
+
+  TrieStorageProviderImpl::TrieStorageProviderImpl(
+      std::shared_ptr<TrieStorage> trie_storage,
+      std::shared_ptr<PersistentState> persistent_state)
+      : trie_storage_(std::move(trie_storage)),
+        persistent_state_(std::move(persistent_state)) {
     BOOST_ASSERT(trie_storage_ != nullptr);
+    BOOST_ASSERT(persistent_state_ != nullptr);
+  }
+
+  std::shared_ptr<TrieStorageProvider>
+  TrieStorageProviderImpl::createThreadProvider() const {
+    return std::shared_ptr<TrieStorageProviderImpl>(
+        new TrieStorageProviderImpl(trie_storage_, persistent_state_));
   }
 
   outcome::result<void> TrieStorageProviderImpl::setToEphemeral() {
@@ -33,19 +46,21 @@ namespace kagome::runtime {
   }
 
   outcome::result<void> TrieStorageProviderImpl::setToPersistent() {
-    if (persistent_batch_ == nullptr) {
+    std::lock_guard lock{persistent_state_->mutex};
+    if (persistent_state_->batch == nullptr) {
       OUTCOME_TRY(batch, trie_storage_->getPersistentBatch());
-      persistent_batch_ = std::move(batch);
+      persistent_state_->batch = std::move(batch);
     }
-    current_batch_ = persistent_batch_;
+    current_batch_ = persistent_state_->batch;
     return outcome::success();
   }
 
   outcome::result<void> TrieStorageProviderImpl::setToPersistentAt(
       const common::Hash256 &state_root) {
     OUTCOME_TRY(batch, trie_storage_->getPersistentBatchAt(state_root));
-    persistent_batch_ = std::move(batch);
-    current_batch_ = persistent_batch_;
+    std::lock_guard lock{persistent_state_->mutex};
+    persistent_state_->batch = std::move(batch);
+    current_batch_ = persistent_state_->batch;
     return outcome::success();
   }
 
@@ -56,8 +71,13 @@ namespace kagome::runtime {
 
   boost::optional<std::shared_ptr<TrieStorageProviderImpl::PersistentBatch>>
   TrieStorageProviderImpl::tryGetPersistentBatch() const {
-    return isCurrentlyPersistent() ? boost::make_optional(persistent_batch_)
-                                   : boost::none;
+    // the shared persistent batch might have been replaced by another thread
+    // since it became the current batch of this one
+    auto batch = std::dynamic_pointer_cast<PersistentBatch>(current_batch_);
+    if (batch != nullptr) {
+      return batch;
+    }
+    return boost::none;
   }
 
   bool TrieStorageProviderImpl::isCurrentlyPersistent() const {
@@ -66,42 +86,66 @@ namespace kagome::runtime {
   }
 
   outcome::result<common::Buffer> TrieStorageProviderImpl::forceCommit() {
-    if (persistent_batch_ != nullptr) {
-      return persistent_batch_->commit();
+    std::lock_guard lock{persistent_state_->mutex};
+    if (persistent_state_->batch != nullptr) {
+      return persistent_state_->batch->commit();
+    }
+    return common::Buffer{};
+  }
+
+  outcome::result<common::Buffer>
+  TrieStorageProviderImpl::calculatePersistentRoot() const {
+    std::lock_guard lock{persistent_state_->mutex};
+    if (persistent_state_->batch != nullptr) {
+      return persistent_state_->batch->calculateRoot();
     }
     return common::Buffer{};
   }
 
   outcome::result<void> TrieStorageProviderImpl::startTransaction() {
-    stack_of_batches_.emplace(current_batch_);
-    current_batch_ =
-        std::make_shared<TopperTrieBatchImpl>(std::move(current_batch_));
+    if (transaction_batch_ != nullptr) {
+      transaction_batch_->setSavepoint();
+      nested_transactions_++;
+      return outcome::success();
+    }
+    batch_before_transactions_ = current_batch_;
+    transaction_batch_ = std::make_shared<TopperTrieBatchImpl>(current_batch_);
+    current_batch_ = transaction_batch_;
     return outcome::success();
   }
 
   outcome::result<void> TrieStorageProviderImpl::rollbackTransaction() {
-    if (stack_of_batches_.empty()) {
+    if (transaction_batch_ == nullptr) {
       return RuntimeTransactionError::NO_TRANSACTIONS_WERE_STARTED;
     }
 
-    current_batch_ = std::move(stack_of_batches_.top());
-    stack_of_batches_.pop();
+    if (nested_transactions_ > 0) {
+      OUTCOME_TRY(transaction_batch_->rollbackToSavepoint());
+      nested_transactions_--;
+      return outcome::success();
+    }
+    finishTransactions();
     return outcome::success();
   }
 
   outcome::result<void> TrieStorageProviderImpl::commitTransaction() {
-    if (stack_of_batches_.empty()) {
+    if (transaction_batch_ == nullptr) {
       return RuntimeTransactionError::NO_TRANSACTIONS_WERE_STARTED;
     }
 
-    auto commitee_batch =
-        std::dynamic_pointer_cast<TopperTrieBatch>(current_batch_);
-    BOOST_ASSERT(commitee_batch != nullptr);
-    OUTCOME_TRY(commitee_batch->writeBack());
-
-    current_batch_ = std::move(stack_of_batches_.top());
-    stack_of_batches_.pop();
+    if (nested_transactions_ > 0) {
+      OUTCOME_TRY(transaction_batch_->releaseSavepoint());
+      nested_transactions_--;
+      return outcome::success();
+    }
+    OUTCOME_TRY(transaction_batch_->writeBack());
+    finishTransactions();
     return outcome::success();
   }
 
+  void TrieStorageProviderImpl::finishTransactions() {
+    current_batch_ = std::move(batch_before_transactions_);
+    transaction_batch_.reset();
+  }
+
 }  // namespace kagome::runtime
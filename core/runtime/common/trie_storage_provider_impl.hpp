@@ -8,7 +8,7 @@
 
 #include "runtime/trie_storage_provider.hpp"
 
-#include <stack>
+#include <mutex>
 
 #include "common/buffer.hpp"
 #include "runtime/common/runtime_transaction_error.hpp"
@@ -23,6 +23,8 @@ namespace kagome::runtime {
 
     ~TrieStorageProviderImpl() override = default;
 
+    std::shared_ptr<TrieStorageProvider> createThreadProvider() const override;
+
     outcome::result<void> setToEphemeral() override;
     outcome::result<void> setToEphemeralAt(
         const common::Hash256 &state_root) override;
@@ -37,21 +39,45 @@ namespace kagome::runtime {
     bool isCurrentlyPersistent() const override;
 
     outcome::result<common::Buffer> forceCommit() override;
+    outcome::result<common::Buffer> calculatePersistentRoot() const override;
 
     outcome::result<void> startTransaction() override;
     outcome::result<void> rollbackTransaction() override;
     outcome::result<void> commitTransaction() override;
 
    private:
+    /**
+     * The persistent batch has to be the same in different runtime calls to
+     * keep accumulated changes for commit to the main storage, thus it is
+     * shared by the providers of all threads
+     */
+    struct PersistentState {
+      std::mutex mutex;
+      std::shared_ptr<PersistentBatch> batch;
+    };
+
+    TrieStorageProviderImpl(
+        std::shared_ptr<storage::trie::TrieStorage> trie_storage,
+        std::shared_ptr<PersistentState> persistent_state);
+
+    /**
+     * Makes the batch, which was current before the outermost transaction
+     * started, current again
+     */
+    void finishTransactions();
+
     std::shared_ptr<storage::trie::TrieStorage> trie_storage_;
 
-    std::stack<std::shared_ptr<Batch>> stack_of_batches_;
+    /// batch, which was current before the outermost transaction started
+    std::shared_ptr<Batch> batch_before_transactions_;
+
+    /// batch of all the started transactions, nested ones are its savepoints
+    std::shared_ptr<storage::trie::TopperTrieBatch> transaction_batch_;
+    size_t nested_transactions_ = 0;
 
     std::shared_ptr<Batch> current_batch_;
 
-    // need to store it because it has to be the same in different runtime calls
-    // to keep accumulated changes for commit to the main storage
-    std::shared_ptr<PersistentBatch> persistent_batch_;
+    std::shared_ptr<PersistentState> persistent_state_;
   };
 
 }  // namespace kagome::runtime
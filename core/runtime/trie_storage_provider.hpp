@@ -19,7 +19,10 @@ namespace kagome::runtime {
    * As some calls need an access to a temporary storage (called 'ephemeral')
    * and some introduce changes that need to persist, TrieStorageProvider
    * maintains a 'current batch', which can be either persistent or ephemeral,
-   * and provides it for runtime calls
+   * and provides it for runtime calls.
+   * The current batch belongs to a single thread of execution, so runtime
+   * calls made in parallel need providers of their own (@see
+   * createThreadProvider)
    */
   class TrieStorageProvider {
    public:
@@ -28,6 +31,15 @@ namespace kagome::runtime {
 
     virtual ~TrieStorageProvider() = default;
 
+    /**
+     * Creates a provider for runtime calls made on another thread. It has its
+     * own current batch and transactions, so that its calls do not interfere
+     * with the calls of this provider, while the persistent batch, which
+     * accumulates changes for commit, is shared with this provider
+     */
+    virtual std::shared_ptr<TrieStorageProvider> createThreadProvider()
+        const = 0;
+
     /**
      * Sets the current batch to a new ephemeral batch
      */
@@ -74,6 +86,13 @@ namespace kagome::runtime {
      */
     virtual outcome::result<common::Buffer> forceCommit() = 0;
 
+    /**
+     * Calculates the root of the persistent batch without committing it, even
+     * if the current batch is not persistent
+     */
+    virtual outcome::result<common::Buffer> calculatePersistentRoot()
+        const = 0;
+
     // ------ Transaction methods ------
 
     /// Start nested transaction
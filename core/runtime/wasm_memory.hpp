@@ -81,6 +81,18 @@ namespace kagome::runtime {
      * @return Buffer of length N
      */
     virtual common::Buffer loadN(WasmPointer addr, WasmSize n) const = 0;
+    /**
+     * Provides n bytes at provided address without copying them
+     * @param addr address in memory of the bytes
+     * @param n number of bytes
+     * @return span over the memory, which stays valid until the memory is
+     * resized, that is until an allocation or a wasm call, so it must not be
+     * kept across them
+     * @note the range is checked to lie within the memory, and the wasm call
+     * traps otherwise
+     */
+    virtual gsl::span<const uint8_t> view(WasmPointer addr,
+                                          WasmSize n) const = 0;
     /**
      * Load string from address into buffer of size n
      * @param addr address in memory to load bytes
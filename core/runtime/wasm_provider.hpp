@@ -6,6 +6,9 @@
 #ifndef KAGOME_CORE_RUNTIME_WASM_PROVIDER_HPP
 #define KAGOME_CORE_RUNTIME_WASM_PROVIDER_HPP
 
+#include <memory>
+
+#include "common/blob.hpp"
 #include "common/buffer.hpp"
 
 namespace kagome::runtime {
@@ -14,12 +17,21 @@ namespace kagome::runtime {
    */
   class WasmProvider {
    public:
+    /**
+     * Runtime code together with its twox256 hash, taken at once
+     */
+    struct StateCode {
+      std::shared_ptr<const common::Buffer> code;
+      common::Hash256 hash;
+    };
+
     virtual ~WasmProvider() = default;
 
     /**
-     * @return wasm runtime code
+     * @return wasm runtime code and the hash identifying it; the code stays
+     * valid while the snapshot is held, even if the state code is changed
      */
-    virtual const common::Buffer &getStateCode() const = 0;
+    virtual StateCode getStateCodeAndHash() const = 0;
   };
 }  // namespace kagome::runtime
 
@@ -70,4 +70,40 @@ namespace kagome::scale {
         self_encoded.end(), opaque_value.v.begin(), opaque_value.v.end());
     return outcome::success();
   }
+
+  outcome::result<AppendableVec> AppendableVec::create(
+      gsl::span<const uint8_t> self_encoded) {
+    AppendableVec vec;
+    if (self_encoded.empty()) {
+      return vec;
+    }
+    OUTCOME_TRY(len, scale::decode<CompactInteger>(self_encoded));
+    OUTCOME_TRY(encoded_len, scale::encode(len));
+    vec.size_ = len.convert_to<size_t>();
+    vec.values_.assign(self_encoded.begin() + encoded_len.size(),
+                       self_encoded.end());
+    return vec;
+  }
+
+  void AppendableVec::append(gsl::span<const uint8_t> input) {
+    values_.insert(values_.end(), input.begin(), input.end());
+    size_++;
+  }
+
+  AppendableVec::Mark AppendableVec::mark() const {
+    return Mark{size_, values_.size()};
+  }
+
+  void AppendableVec::truncate(const Mark &mark) {
+    BOOST_ASSERT(mark.size <= size_ and mark.values_size <= values_.size());
+    size_ = mark.size;
+    values_.resize(mark.values_size);
+  }
+
+  std::vector<uint8_t> AppendableVec::encode() const {
+    auto encoded = scale::encode(CompactInteger{size_}).value();
+    encoded.reserve(encoded.size() + values_.size());
+    encoded.insert(encoded.end(), values_.begin(), values_.end());
+    return encoded;
+  }
 }  // namespace kagome::scale
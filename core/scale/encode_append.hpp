@@ -44,6 +44,52 @@ namespace kagome::scale {
    */
   outcome::result<void> append_or_new_vec(std::vector<uint8_t> &self_encoded,
                                           gsl::span<const uint8_t> input);
+
+  /**
+   * Scale encoded vector of EncodeOpaqueValue, which is appended to without
+   * re-encoding it: its length and the encoded values are kept apart until the
+   * vector is encoded, so that an append costs as much as the appended value
+   */
+  class AppendableVec {
+   public:
+    /**
+     * State of the vector, to which it can be truncated
+     */
+    struct Mark {
+      size_t size;
+      size_t values_size;
+    };
+
+    /**
+     * @param self_encoded current encoded vector, which is considered empty if
+     * it is empty, as in append_or_new_vec
+     * @return the vector or an error if self_encoded is not an encoded vector
+     */
+    static outcome::result<AppendableVec> create(
+        gsl::span<const uint8_t> self_encoded);
+
+    /**
+     * Adds input to the vector as EncodeOpaqueValue
+     */
+    void append(gsl::span<const uint8_t> input);
+
+    Mark mark() const;
+
+    /**
+     * Removes the values appended after the mark was taken
+     */
+    void truncate(const Mark &mark);
+
+    /**
+     * @return the vector with all the values appended, encoded as
+     * append_or_new_vec would do
+     */
+    std::vector<uint8_t> encode() const;
+
+   private:
+    size_t size_ = 0;
+    std::vector<uint8_t> values_;
+  };
 }  // namespace kagome::scale
 
 #endif  // KAGOME_CORE_SCALE_ENCODE_APPEND_HPP
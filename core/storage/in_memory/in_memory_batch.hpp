@@ -6,6 +6,8 @@
 #ifndef KAGOME_IN_MEMORY_BATCH_HPP
 #define KAGOME_IN_MEMORY_BATCH_HPP
 
+#include <boost/optional.hpp>
+
 #include "common/buffer.hpp"
 #include "storage/in_memory/in_memory_storage.hpp"
 
@@ -31,14 +33,18 @@ namespace kagome::storage {
     }
 
     outcome::result<void> remove(const Buffer &key) override {
-      entries.erase(key.toHex());
+      entries[key.toHex()] = boost::none;
       return outcome::success();
     }
 
     outcome::result<void> commit() override {
       for (auto &entry : entries) {
-        OUTCOME_TRY(
-            db.put(Buffer::fromHex(entry.first).value(), entry.second));
+        auto key = Buffer::fromHex(entry.first).value();
+        if (entry.second) {
+          OUTCOME_TRY(db.put(key, entry.second.value()));
+        } else {
+          OUTCOME_TRY(db.remove(key));
+        }
       }
       return outcome::success();
     }
@@ -48,7 +54,8 @@ namespace kagome::storage {
     }
 
    private:
-    std::map<std::string, Buffer> entries;
+    // none stands for a removed entry
+    std::map<std::string, boost::optional<Buffer>> entries;
     InMemoryStorage &db;
   };
 }  // namespace kagome::storage
@@ -29,6 +29,30 @@ namespace kagome::storage {
     return error_as_result<std::shared_ptr<LevelDB>>(status);
   }
 
+  outcome::result<std::shared_ptr<LevelDB>> LevelDB::create(
+      std::string_view path, const LevelDbProfile &profile) {
+    std::unique_ptr<leveldb::Cache> block_cache{
+        leveldb::NewLRUCache(profile.block_cache_size)};
+    std::unique_ptr<const leveldb::FilterPolicy> filter_policy;
+    if (profile.bloom_filter_bits > 0) {
+      filter_policy.reset(
+          leveldb::NewBloomFilterPolicy(profile.bloom_filter_bits));
+    }
+
+    leveldb::Options options;
+    options.create_if_missing = true;
+    options.block_cache = block_cache.get();
+    options.filter_policy = filter_policy.get();
+    options.write_buffer_size = profile.write_buffer_size;
+    options.compression = profile.compression ? leveldb::kSnappyCompression
+                                              : leveldb::kNoCompression;
+
+    OUTCOME_TRY(db, create(path, options));
+    db->block_cache_ = std::move(block_cache);
+    db->filter_policy_ = std::move(filter_policy);
+    return db;
+  }
+
   std::unique_ptr<BufferMapCursor> LevelDB::cursor() {
     auto it = std::unique_ptr<leveldb::Iterator>(db_->NewIterator(ro_));
     return std::make_unique<Cursor>(std::move(it));
@@ -46,6 +70,29 @@ namespace kagome::storage {
     wo_ = wo;
   }
 
+  boost::optional<std::string> LevelDB::getProperty(
+      const std::string &name) const {
+    std::string value;
+    if (not db_->GetProperty(name, &value)) {
+      return boost::none;
+    }
+    return value;
+  }
+
+  uint64_t LevelDB::getApproximateSize() const {
+    auto it = std::unique_ptr<leveldb::Iterator>(db_->NewIterator(ro_));
+    it->SeekToLast();
+    if (not it->Valid()) {
+      return 0;
+    }
+    // the range is up to the last key inclusively
+    auto limit = it->key().ToString() + '\0';
+    leveldb::Range range{leveldb::Slice{}, limit};
+    uint64_t size = 0;
+    db_->GetApproximateSizes(&range, 1, &size);
+    return size;
+  }
+
   outcome::result<Buffer> LevelDB::get(const Buffer &key) const {
     std::string value;
     auto status = db_->Get(ro_, make_slice(key), &value);
@@ -6,11 +6,16 @@
 #ifndef KAGOME_LEVELDB_HPP
 #define KAGOME_LEVELDB_HPP
 
+#include <leveldb/cache.h>
 #include <leveldb/db.h>
+#include <leveldb/filter_policy.h>
 #include <leveldb/write_batch.h>
 
+#include <boost/optional.hpp>
+
 #include "common/logger.hpp"
 #include "storage/buffer_map_types.hpp"
+#include "storage/leveldb/leveldb_profile.hpp"
 
 namespace kagome::storage {
 
@@ -34,6 +39,17 @@ namespace kagome::storage {
     static outcome::result<std::shared_ptr<LevelDB>> create(
         std::string_view path, leveldb::Options options = leveldb::Options());
 
+    /**
+     * @brief Factory method to create an instance of LevelDB class, which
+     * owns the block cache and the filter policy configured by the profile.
+     * The database is created if missing.
+     * @param path filesystem path where database is going to be
+     * @param profile tuning of the database
+     * @return instance of LevelDB
+     */
+    static outcome::result<std::shared_ptr<LevelDB>> create(
+        std::string_view path, const LevelDbProfile &profile);
+
     /**
      * @brief Set read options, which are used in @see LevelDB#get
      * @param ro options
@@ -46,6 +62,17 @@ namespace kagome::storage {
      */
     void setWriteOptions(leveldb::WriteOptions wo);
 
+    /**
+     * @param name of a property, such as "leveldb.stats"
+     * @return value of the property or none if it is not known
+     */
+    boost::optional<std::string> getProperty(const std::string &name) const;
+
+    /**
+     * @return approximate size of all the data in the file system, bytes
+     */
+    uint64_t getApproximateSize() const;
+
     std::unique_ptr<BufferMapCursor> cursor() override;
 
     std::unique_ptr<BufferBatch> batch() override;
@@ -64,6 +91,10 @@ namespace kagome::storage {
     outcome::result<void> remove(const Buffer &key) override;
 
    private:
+    // referenced by the options of the database, thus destroyed after it
+    std::unique_ptr<leveldb::Cache> block_cache_;
+    std::unique_ptr<const leveldb::FilterPolicy> filter_policy_;
+
     std::unique_ptr<leveldb::DB> db_;
     leveldb::ReadOptions ro_;
     leveldb::WriteOptions wo_;
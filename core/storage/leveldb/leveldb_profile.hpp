@@ -0,0 +1,45 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_LEVELDB_PROFILE_HPP
+#define KAGOME_STORAGE_LEVELDB_PROFILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace kagome::storage {
+
+  /**
+   * Tuning of a LevelDB instance for the access pattern of the data it keeps
+   */
+  struct LevelDbProfile {
+    /// capacity of the LRU cache of uncompressed blocks, bytes
+    size_t block_cache_size = 8 * 1024 * 1024;
+    /// bits per key of bloom filters, 0 disables the filters
+    uint32_t bloom_filter_bits = 10;
+    /// size of the in-memory table, which is written to disk when full, bytes
+    size_t write_buffer_size = 4 * 1024 * 1024;
+    /// whether blocks are compressed with snappy
+    bool compression = true;
+
+    /**
+     * Trie nodes are read randomly by their hashes, which bloom filters and a
+     * large cache help with, and contain hashes, which do not compress
+     */
+    static LevelDbProfile trieNodes() {
+      return LevelDbProfile{256 * 1024 * 1024, 10, 64 * 1024 * 1024, false};
+    }
+
+    /**
+     * Blocks and headers are mostly read near the head of the chain
+     */
+    static LevelDbProfile blocks() {
+      return LevelDbProfile{32 * 1024 * 1024, 10, 16 * 1024 * 1024, true};
+    }
+  };
+
+}  // namespace kagome::storage
+
+#endif  // KAGOME_STORAGE_LEVELDB_PROFILE_HPP
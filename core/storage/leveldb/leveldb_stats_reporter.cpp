@@ -0,0 +1,69 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/leveldb/leveldb_stats_reporter.hpp"
+
+namespace kagome::storage {
+
+  LevelDbStatsReporter::LevelDbStatsReporter(
+      const std::shared_ptr<application::AppStateManager> &app_state_manager,
+      std::shared_ptr<boost::asio::io_context> io_context,
+      std::vector<Database> databases,
+      std::chrono::seconds period)
+      : io_context_{std::move(io_context)},
+        databases_{std::move(databases)},
+        period_{period},
+        timer_{*io_context_},
+        logger_{common::createLogger("LevelDbStats")} {
+    BOOST_ASSERT(app_state_manager != nullptr);
+    for (const auto &database : databases_) {
+      BOOST_ASSERT(database.db != nullptr);
+    }
+    app_state_manager->takeControl(*this);
+  }
+
+  bool LevelDbStatsReporter::prepare() {
+    return true;
+  }
+
+  bool LevelDbStatsReporter::start() {
+    if (period_.count() > 0) {
+      scheduleReport();
+    }
+    return true;
+  }
+
+  void LevelDbStatsReporter::stop() {
+    timer_.cancel();
+  }
+
+  void LevelDbStatsReporter::scheduleReport() {
+    timer_.expires_after(period_);
+    timer_.async_wait([wp = weak_from_this()](const auto &ec) {
+      if (ec) {
+        return;
+      }
+      if (auto self = wp.lock()) {
+        self->report();
+        self->scheduleReport();
+      }
+    });
+  }
+
+  void LevelDbStatsReporter::report() const {
+    for (const auto &[name, db] : databases_) {
+      logger_->info("Database '{}': approximate size {} bytes, {} bytes of "
+                    "memory used",
+                    name,
+                    db->getApproximateSize(),
+                    db->getProperty("leveldb.approximate-memory-usage")
+                        .value_or("unknown"));
+      if (auto stats = db->getProperty("leveldb.stats")) {
+        logger_->debug("Database '{}':\n{}", name, stats.value());
+      }
+    }
+  }
+
+}  // namespace kagome::storage
@@ -0,0 +1,70 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_LEVELDB_STATS_REPORTER_HPP
+#define KAGOME_STORAGE_LEVELDB_STATS_REPORTER_HPP
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+#include "application/app_state_manager.hpp"
+#include "common/logger.hpp"
+#include "storage/leveldb/leveldb.hpp"
+
+namespace kagome::storage {
+
+  /**
+   * Periodically logs the internal statistics of LevelDB instances: sizes at
+   * the info level and per-level compaction stats at the debug level
+   */
+  class LevelDbStatsReporter
+      : public std::enable_shared_from_this<LevelDbStatsReporter> {
+   public:
+    struct Database {
+      std::string name;
+      std::shared_ptr<LevelDB> db;
+    };
+
+    /**
+     * @param period of reports, zero disables them
+     */
+    LevelDbStatsReporter(
+        const std::shared_ptr<application::AppStateManager> &app_state_manager,
+        std::shared_ptr<boost::asio::io_context> io_context,
+        std::vector<Database> databases,
+        std::chrono::seconds period);
+
+    /** @see AppStateManager::takeControl */
+    bool prepare();
+
+    /** @see AppStateManager::takeControl */
+    bool start();
+
+    /** @see AppStateManager::takeControl */
+    void stop();
+
+    /**
+     * Logs the statistics of the databases
+     */
+    void report() const;
+
+   private:
+    void scheduleReport();
+
+    std::shared_ptr<boost::asio::io_context> io_context_;
+    std::vector<Database> databases_;
+    std::chrono::seconds period_;
+    boost::asio::steady_timer timer_;
+    common::Logger logger_;
+  };
+
+}  // namespace kagome::storage
+
+#endif  // KAGOME_STORAGE_LEVELDB_STATS_REPORTER_HPP
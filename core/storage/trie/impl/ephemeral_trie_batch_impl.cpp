@@ -5,7 +5,10 @@
 
 #include "storage/trie/impl/ephemeral_trie_batch_impl.hpp"
 
+#include "scale/encode_append.hpp"
 #include "storage/trie/polkadot_trie/polkadot_trie_cursor_impl.hpp"
+#include "storage/trie/polkadot_trie/trie_error.hpp"
+#include "storage/trie/serialization/polkadot_codec.hpp"
 
 namespace kagome::storage::trie {
 
@@ -20,6 +23,22 @@ namespace kagome::storage::trie {
     return trie_->get(key);
   }
 
+  outcome::result<boost::optional<Buffer>> EphemeralTrieBatchImpl::getIfChanged(
+      const Buffer &key, Buffer &merkle_value) const {
+    OUTCOME_TRY(node,
+                trie_->getNodeIfChanged(PolkadotCodec::keyToNibbles(key),
+                                        merkle_value));
+    if (not node) {
+      return boost::none;
+    }
+    if (node.value() == nullptr or not node.value()->value) {
+      return TrieError::NO_VALUE;
+    }
+    // a node without a merkle value, like the root, is read every time
+    merkle_value = node.value()->merkle_value.value_or(Buffer{});
+    return node.value()->value;
+  }
+
   std::unique_ptr<PolkadotTrieCursor> EphemeralTrieBatchImpl::trieCursor() {
     return std::make_unique<PolkadotTrieCursorImpl>(*trie_);
   }
@@ -50,4 +69,14 @@ namespace kagome::storage::trie {
   outcome::result<void> EphemeralTrieBatchImpl::remove(const Buffer &key) {
     return trie_->remove(key);
   }
+
+  outcome::result<void> EphemeralTrieBatchImpl::append(
+      const Buffer &key, gsl::span<const uint8_t> value) {
+    // ephemeral batches serve short calls, which do not append much, thus the
+    // vector is just re-encoded
+    auto current = trie_->get(key);
+    auto encoded = current ? std::move(current.value()) : Buffer{};
+    OUTCOME_TRY(scale::append_or_new_vec(encoded.toVector(), value));
+    return trie_->put(key, std::move(encoded));
+  }
 }  // namespace kagome::storage::trie
@@ -19,6 +19,8 @@ namespace kagome::storage::trie {
     ~EphemeralTrieBatchImpl() override = default;
 
     outcome::result<Buffer> get(const Buffer &key) const override;
+    outcome::result<boost::optional<Buffer>> getIfChanged(
+        const Buffer &key, Buffer &merkle_value) const override;
     std::unique_ptr<PolkadotTrieCursor> trieCursor() override;
     bool contains(const Buffer &key) const override;
     bool empty() const override;
@@ -26,6 +28,8 @@ namespace kagome::storage::trie {
     outcome::result<void> put(const Buffer &key, const Buffer &value) override;
     outcome::result<void> put(const Buffer &key, Buffer &&value) override;
     outcome::result<void> remove(const Buffer &key) override;
+    outcome::result<void> append(const Buffer &key,
+                                 gsl::span<const uint8_t> value) override;
 
    private:
     std::shared_ptr<Codec> codec_;
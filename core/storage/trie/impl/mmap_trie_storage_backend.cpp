@@ -0,0 +1,736 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/impl/mmap_trie_storage_backend.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+
+#include <boost/container_hash/hash.hpp>
+#include <boost/crc.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include "storage/database_error.hpp"
+
+namespace kagome::storage::trie {
+
+  namespace {
+    constexpr auto kSegmentPrefix = "segment-";
+
+    /**
+     * A record is [u32 key size][u32 value size][u8 kind][u32 checksum] key
+     * value, the checksum covering the rest of the header and the payload.
+     * Segment files are zero-filled when created, so a zero kind marks the
+     * end of the records. The pages of a mapped file are written back in any
+     * order, so a crash might leave a part of a record on the disk; its
+     * checksum does not match then, and the replay stops at it
+     */
+    constexpr size_t kChecksumOffset = 2 * sizeof(uint32_t) + 1;
+    constexpr size_t kHeaderSize = kChecksumOffset + sizeof(uint32_t);
+    constexpr uint8_t kEnd = 0;
+    constexpr uint8_t kPut = 1;
+    constexpr uint8_t kRemove = 2;
+
+    struct RecordHeader {
+      uint32_t key_size;
+      uint32_t value_size;
+      uint8_t kind;
+      uint32_t checksum;
+
+      size_t recordSize() const {
+        return kHeaderSize + key_size + value_size;
+      }
+    };
+
+    RecordHeader readHeader(const uint8_t *record) {
+      RecordHeader header{};
+      std::memcpy(&header.key_size, record, sizeof(uint32_t));
+      std::memcpy(
+          &header.value_size, record + sizeof(uint32_t), sizeof(uint32_t));
+      header.kind = record[2 * sizeof(uint32_t)];
+      std::memcpy(
+          &header.checksum, record + kChecksumOffset, sizeof(uint32_t));
+      return header;
+    }
+
+    /**
+     * @param record with the header fields before the checksum and the
+     * payload written
+     */
+    uint32_t checksumOf(const uint8_t *record, size_t payload_size) {
+      boost::crc_32_type crc;
+      crc.process_bytes(record, kChecksumOffset);
+      crc.process_bytes(record + kHeaderSize, payload_size);
+      return crc.checksum();
+    }
+
+    /**
+     * Writes the header of a record, which payload is written already
+     */
+    void writeHeader(uint8_t *record, const RecordHeader &header) {
+      std::memcpy(record, &header.key_size, sizeof(uint32_t));
+      std::memcpy(
+          record + sizeof(uint32_t), &header.value_size, sizeof(uint32_t));
+      record[2 * sizeof(uint32_t)] = header.kind;
+      auto checksum =
+          checksumOf(record, header.recordSize() - kHeaderSize);
+      std::memcpy(record + kChecksumOffset, &checksum, sizeof(uint32_t));
+    }
+
+    std::string segmentName(uint32_t id) {
+      auto number = std::to_string(id);
+      return kSegmentPrefix + std::string(10 - number.size(), '0') + number;
+    }
+  }  // namespace
+
+  struct MmapTrieStorageBackend::Segment {
+    Segment(uint32_t id,
+            boost::filesystem::path path,
+            uint8_t *data,
+            size_t capacity)
+        : id{id}, path{std::move(path)}, data{data}, capacity{capacity} {}
+
+    ~Segment() {
+      ::munmap(data, capacity);
+    }
+
+    Segment(const Segment &) = delete;
+    Segment &operator=(const Segment &) = delete;
+
+    const uint32_t id;
+    const boost::filesystem::path path;
+    uint8_t *const data;
+    const size_t capacity;
+    /// size of the records written to the segment
+    size_t size = 0;
+    /// size of the records, which the index refers to
+    size_t live_bytes = 0;
+    /// size of the records flushed to the disk
+    size_t synced = 0;
+  };
+
+  class MmapTrieStorageBackend::Batch
+      : public face::WriteBatch<Buffer, Buffer> {
+   public:
+    explicit Batch(MmapTrieStorageBackend &storage) : storage_{storage} {}
+
+    outcome::result<void> put(const Buffer &key, const Buffer &value) override {
+      operations_.emplace_back(key, value);
+      return outcome::success();
+    }
+
+    outcome::result<void> put(const Buffer &key, Buffer &&value) override {
+      operations_.emplace_back(key, std::move(value));
+      return outcome::success();
+    }
+
+    outcome::result<void> remove(const Buffer &key) override {
+      operations_.emplace_back(key, boost::none);
+      return outcome::success();
+    }
+
+    outcome::result<void> commit() override {
+      OUTCOME_TRY(storage_.write(operations_));
+      operations_.clear();
+      return outcome::success();
+    }
+
+    void clear() override {
+      operations_.clear();
+    }
+
+   private:
+    MmapTrieStorageBackend &storage_;
+    std::vector<Operation> operations_;
+  };
+
+  class MmapTrieStorageBackend::Cursor
+      : public face::MapCursor<Buffer, Buffer> {
+   public:
+    Cursor(const MmapTrieStorageBackend &storage, std::vector<Buffer> keys)
+        : storage_{storage}, keys_{std::move(keys)}, pos_{keys_.size()} {}
+
+    outcome::result<bool> seekFirst() override {
+      pos_ = 0;
+      return isValid();
+    }
+
+    outcome::result<bool> seek(const Buffer &key) override {
+      pos_ = std::lower_bound(keys_.begin(), keys_.end(), key) - keys_.begin();
+      return isValid();
+    }
+
+    outcome::result<bool> seekLast() override {
+      pos_ = keys_.empty() ? 0 : keys_.size() - 1;
+      return isValid();
+    }
+
+    bool isValid() const override {
+      return pos_ < keys_.size();
+    }
+
+    outcome::result<void> next() override {
+      if (isValid()) {
+        ++pos_;
+      }
+      return outcome::success();
+    }
+
+    boost::optional<Buffer> key() const override {
+      return isValid() ? boost::make_optional(keys_[pos_]) : boost::none;
+    }
+
+    boost::optional<Buffer> value() const override {
+      if (not isValid()) {
+        return boost::none;
+      }
+      auto value = storage_.get(keys_[pos_]);
+      return value ? boost::make_optional(std::move(value.value()))
+                   : boost::none;
+    }
+
+   private:
+    const MmapTrieStorageBackend &storage_;
+    std::vector<Buffer> keys_;
+    size_t pos_;
+  };
+
+  outcome::result<std::shared_ptr<MmapTrieStorageBackend>>
+  MmapTrieStorageBackend::create(const boost::filesystem::path &path,
+                                 Config config) {
+    BOOST_ASSERT(config.segment_size > 0);
+    BOOST_ASSERT(config.segment_size <= std::numeric_limits<uint32_t>::max());
+    std::shared_ptr<MmapTrieStorageBackend> storage{
+        new MmapTrieStorageBackend(path, config)};
+    OUTCOME_TRY(storage->open());
+    if (config.background_compaction) {
+      storage->compactor_ = std::thread{[self = storage.get()] {
+        self->runCompactor();
+      }};
+      // segments left to be compacted before the restart
+      storage->requestCompaction();
+    }
+    return storage;
+  }
+
+  size_t MmapTrieStorageBackend::NodeKeyHash::operator()(
+      const NodeKey &key) const {
+    return boost::hash_range(key.bytes.begin(), key.bytes.begin() + key.size);
+  }
+
+  boost::optional<MmapTrieStorageBackend::NodeKey>
+  MmapTrieStorageBackend::toNodeKey(gsl::span<const uint8_t> key) {
+    if (static_cast<size_t>(key.size()) > kMaxKeySize) {
+      return boost::none;
+    }
+    NodeKey node_key;
+    std::copy(key.begin(), key.end(), node_key.bytes.begin());
+    node_key.size = key.size();
+    return node_key;
+  }
+
+  MmapTrieStorageBackend::MmapTrieStorageBackend(boost::filesystem::path path,
+                                                 Config config)
+      : path_{std::move(path)},
+        config_{config},
+        logger_{common::createLogger("MmapTrieStorage")} {}
+
+  MmapTrieStorageBackend::~MmapTrieStorageBackend() {
+    {
+      std::lock_guard lock{compactor_mutex_};
+      stopped_ = true;
+    }
+    compaction_cv_.notify_one();
+    if (compactor_.joinable()) {
+      compactor_.join();
+    }
+  }
+
+  outcome::result<void> MmapTrieStorageBackend::open() {
+    boost::system::error_code ec;
+    boost::filesystem::create_directories(path_, ec);
+    if (ec) {
+      logger_->error(
+          "Cannot create directory {}: {}", path_.string(), ec.message());
+      return DatabaseError::IO_ERROR;
+    }
+    std::vector<uint32_t> ids;
+    for (const auto &entry : boost::filesystem::directory_iterator{path_, ec}) {
+      auto name = entry.path().filename().string();
+      if (name.rfind(kSegmentPrefix, 0) != 0) {
+        continue;
+      }
+      try {
+        ids.push_back(std::stoul(name.substr(std::strlen(kSegmentPrefix))));
+      } catch (const std::exception &) {
+        logger_->warn("Unexpected file {} is ignored", name);
+      }
+    }
+    if (ec) {
+      logger_->error(
+          "Cannot list directory {}: {}", path_.string(), ec.message());
+      return DatabaseError::IO_ERROR;
+    }
+    std::sort(ids.begin(), ids.end());
+
+    for (auto id : ids) {
+      auto path = path_ / segmentName(id);
+      auto fd = ::open(path.c_str(), O_RDWR);
+      if (fd < 0) {
+        logger_->error(
+            "Cannot open {}: {}", path.string(), std::strerror(errno));
+        return DatabaseError::IO_ERROR;
+      }
+      struct stat st {};
+      if (::fstat(fd, &st) == 0 and st.st_size == 0) {
+        // a crash right after the creation of the segment
+        ::close(fd);
+        boost::filesystem::remove(path, ec);
+        continue;
+      }
+      auto *data = ::mmap(
+          nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      auto error = errno;
+      ::close(fd);
+      if (data == MAP_FAILED) {
+        logger_->error(
+            "Cannot map {}: {}", path.string(), std::strerror(error));
+        return DatabaseError::IO_ERROR;
+      }
+      auto segment = std::make_shared<Segment>(
+          id, path, static_cast<uint8_t *>(data), st.st_size);
+      segments_.emplace(id, segment);
+      replay(*segment);
+    }
+    logger_->info("Opened {} segments with {} records in {}",
+                  segments_.size(),
+                  index_.size(),
+                  path_.string());
+    return outcome::success();
+  }
+
+  void MmapTrieStorageBackend::replay(Segment &segment) {
+    size_t pos = 0;
+    while (pos + kHeaderSize <= segment.capacity) {
+      auto header = readHeader(segment.data + pos);
+      if (header.kind == kEnd) {
+        break;
+      }
+      if ((header.kind != kPut and header.kind != kRemove)
+          or header.key_size > kMaxKeySize
+          or header.recordSize() > segment.capacity - pos
+          or header.checksum
+                 != checksumOf(segment.data + pos,
+                               header.recordSize() - kHeaderSize)) {
+        logger_->warn("Segment {} is corrupted at offset {}, the rest of it "
+                      "is discarded",
+                      segment.id,
+                      pos);
+        std::memset(segment.data + pos, 0, segment.capacity - pos);
+        break;
+      }
+      auto key = toNodeKey(gsl::make_span(segment.data + pos + kHeaderSize,
+                                          header.key_size))
+                     .value();
+      auto it = index_.find(key);
+      if (it != index_.end()) {
+        forget(it->second);
+      }
+      if (header.kind == kPut) {
+        Location location{segment.id, static_cast<uint32_t>(pos)};
+        if (it != index_.end()) {
+          it->second = location;
+        } else {
+          index_.emplace(key, location);
+        }
+        segment.live_bytes += header.recordSize();
+      } else if (it != index_.end()) {
+        index_.erase(it);
+      }
+      pos += header.recordSize();
+    }
+    segment.size = pos;
+    segment.synced = pos;
+  }
+
+  outcome::result<std::shared_ptr<MmapTrieStorageBackend::Segment>>
+  MmapTrieStorageBackend::createSegment(uint32_t id, size_t capacity) const {
+    auto path = path_ / segmentName(id);
+    auto fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd < 0) {
+      logger_->error(
+          "Cannot create {}: {}", path.string(), std::strerror(errno));
+      return DatabaseError::IO_ERROR;
+    }
+    void *data = MAP_FAILED;
+    // the size of the file has to be on the disk before the records are
+    if (::ftruncate(fd, capacity) == 0 and ::fsync(fd) == 0) {
+      data = ::mmap(
+          nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    auto error = errno;
+    ::close(fd);
+    if (data == MAP_FAILED) {
+      logger_->error("Cannot map {}: {}", path.string(), std::strerror(error));
+      boost::system::error_code ec;
+      boost::filesystem::remove(path, ec);
+      return DatabaseError::IO_ERROR;
+    }
+    return std::make_shared<Segment>(
+        id, path, static_cast<uint8_t *>(data), capacity);
+  }
+
+  outcome::result<void> MmapTrieStorageBackend::write(
+      const std::vector<Operation> &operations) {
+    bool compaction_needed = false;
+    {
+      std::lock_guard lock{mutex_};
+      for (const auto &[key, value] : operations) {
+        auto node_key = toNodeKey(key);
+        if (value.has_value()) {
+          if (not node_key) {
+            return DatabaseError::INVALID_ARGUMENT;
+          }
+          OUTCOME_TRY(applyPut(*node_key, value.value()));
+        } else if (node_key) {
+          OUTCOME_TRY(applyRemove(*node_key));
+        }
+      }
+      compaction_needed = std::any_of(
+          segments_.begin(), segments_.end(), [this](const auto &segment) {
+            return needsCompaction(*segment.second);
+          });
+    }
+    OUTCOME_TRY(sync());
+    if (compaction_needed and config_.background_compaction) {
+      requestCompaction();
+    }
+    return outcome::success();
+  }
+
+  outcome::result<void> MmapTrieStorageBackend::applyPut(const NodeKey &key,
+                                                         const Buffer &value) {
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+      auto stored = valueAt(it->second);
+      // nodes are content-addressed, so the same node is usually stored again
+      if (std::equal(
+              stored.begin(), stored.end(), value.begin(), value.end())) {
+        return outcome::success();
+      }
+    }
+    OUTCOME_TRY(location, append(kPut, key, value));
+    segments_.at(location.segment)->live_bytes +=
+        kHeaderSize + key.size + value.size();
+    if (it != index_.end()) {
+      forget(it->second);
+      it->second = location;
+    } else {
+      index_.emplace(key, location);
+    }
+    return outcome::success();
+  }
+
+  outcome::result<void> MmapTrieStorageBackend::applyRemove(
+      const NodeKey &key) {
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+      return outcome::success();
+    }
+    OUTCOME_TRY(append(kRemove, key, {}));
+    forget(it->second);
+    index_.erase(it);
+    return outcome::success();
+  }
+
+  outcome::result<MmapTrieStorageBackend::Location>
+  MmapTrieStorageBackend::append(uint8_t kind,
+                                 const NodeKey &key,
+                                 gsl::span<const uint8_t> value) {
+    RecordHeader header{key.size,
+                        static_cast<uint32_t>(value.size()),
+                        kind,
+                        0};
+    auto record_size = header.recordSize();
+    std::shared_ptr<Segment> active =
+        segments_.empty() ? nullptr : segments_.rbegin()->second;
+    if (active == nullptr or record_size > active->capacity - active->size) {
+      auto id = active == nullptr ? 0 : active->id + 1;
+      auto capacity = std::max(config_.segment_size, record_size);
+      OUTCOME_TRY(segment, createSegment(id, capacity));
+      OUTCOME_TRY(syncDirectory());
+      segments_.emplace(id, segment);
+      active = std::move(segment);
+    }
+    auto *record = active->data + active->size;
+    std::copy_n(key.bytes.begin(), key.size, record + kHeaderSize);
+    std::copy(value.begin(), value.end(), record + kHeaderSize + key.size);
+    writeHeader(record, header);
+    Location location{active->id, static_cast<uint32_t>(active->size)};
+    active->size += record_size;
+    return location;
+  }
+
+  gsl::span<const uint8_t> MmapTrieStorageBackend::valueAt(
+      const Location &location) const {
+    const auto &segment = segments_.at(location.segment);
+    const auto *record = segment->data + location.offset;
+    auto header = readHeader(record);
+    return gsl::make_span(record + kHeaderSize + header.key_size,
+                          header.value_size);
+  }
+
+  void MmapTrieStorageBackend::forget(const Location &location) {
+    auto &segment = segments_.at(location.segment);
+    segment->live_bytes -=
+        readHeader(segment->data + location.offset).recordSize();
+  }
+
+  bool MmapTrieStorageBackend::needsCompaction(const Segment &segment) const {
+    // the last segment is the one written to
+    if (segment.id == segments_.rbegin()->first or segment.size == 0) {
+      return false;
+    }
+    return static_cast<double>(segment.size - segment.live_bytes)
+           >= config_.compaction_threshold * segment.size;
+  }
+
+  outcome::result<void> MmapTrieStorageBackend::compact() {
+    std::lock_guard compaction_lock{compaction_mutex_};
+    std::vector<std::shared_ptr<Segment>> segments;
+    {
+      std::lock_guard lock{mutex_};
+      for (const auto &[id, segment] : segments_) {
+        if (needsCompaction(*segment)) {
+          segments.push_back(segment);
+        }
+      }
+    }
+    for (const auto &segment : segments) {
+      OUTCOME_TRY(compactSegment(segment));
+    }
+    return outcome::success();
+  }
+
+  outcome::result<void> MmapTrieStorageBackend::compactSegment(
+      const std::shared_ptr<Segment> &segment) {
+    // a sealed segment is not modified, so it is read without the lock
+    size_t pos = 0;
+    while (pos < segment->size) {
+      const auto *record = segment->data + pos;
+      auto header = readHeader(record);
+      auto key =
+          toNodeKey(gsl::make_span(record + kHeaderSize, header.key_size))
+              .value();
+      std::lock_guard lock{mutex_};
+      auto it = index_.find(key);
+      if (header.kind == kPut) {
+        if (it != index_.end() and it->second.segment == segment->id
+            and it->second.offset == pos) {
+          OUTCOME_TRY(location,
+                      append(kPut,
+                             key,
+                             gsl::make_span(record + kHeaderSize + key.size,
+                                            header.value_size)));
+          segment->live_bytes -= header.recordSize();
+          segments_.at(location.segment)->live_bytes += header.recordSize();
+          it->second = location;
+        }
+      } else if (it == index_.end()
+                 and segments_.begin()->first < segment->id) {
+        // the removal has to outlive the older records of the key
+        OUTCOME_TRY(append(kRemove, key, {}));
+      }
+      pos += header.recordSize();
+    }
+    // the copies have to be on the disk before the originals are deleted
+    OUTCOME_TRY(sync());
+    {
+      std::lock_guard lock{mutex_};
+      segments_.erase(segment->id);
+    }
+    // the mapping stays valid for the values obtained from the segment
+    boost::system::error_code ec;
+    boost::filesystem::remove(segment->path, ec);
+    if (ec) {
+      logger_->warn("Cannot remove compacted segment {}: {}",
+                    segment->path.string(),
+                    ec.message());
+    } else if (auto res = syncDirectory(); not res) {
+      logger_->warn("Cannot sync the removal of compacted segment {}",
+                    segment->path.string());
+    }
+    logger_->debug("Compacted segment {}", segment->id);
+    return outcome::success();
+  }
+
+  outcome::result<void> MmapTrieStorageBackend::sync() {
+    std::lock_guard sync_lock{sync_mutex_};
+    struct Range {
+      std::shared_ptr<Segment> segment;
+      size_t begin;
+      size_t end;
+    };
+    std::vector<Range> ranges;
+    {
+      std::lock_guard lock{mutex_};
+      for (const auto &[id, segment] : segments_) {
+        if (segment->synced < segment->size) {
+          ranges.push_back({segment, segment->synced, segment->size});
+        }
+      }
+    }
+    // the records are not modified once written, so they are flushed without
+    // blocking the readers
+    static const size_t page_size = ::sysconf(_SC_PAGESIZE);
+    for (const auto &range : ranges) {
+      auto begin = range.begin / page_size * page_size;
+      if (::msync(range.segment->data + begin, range.end - begin, MS_SYNC)
+          != 0) {
+        logger_->error("Cannot sync segment {}: {}",
+                       range.segment->id,
+                       std::strerror(errno));
+        return DatabaseError::IO_ERROR;
+      }
+    }
+    std::lock_guard lock{mutex_};
+    for (const auto &range : ranges) {
+      range.segment->synced = std::max(range.segment->synced, range.end);
+    }
+    return outcome::success();
+  }
+
+  outcome::result<void> MmapTrieStorageBackend::syncDirectory() const {
+    auto fd = ::open(path_.c_str(), O_RDONLY | O_DIRECTORY);
+    auto ok = fd >= 0 and ::fsync(fd) == 0;
+    auto error = errno;
+    if (fd >= 0) {
+      ::close(fd);
+    }
+    if (not ok) {
+      logger_->error(
+          "Cannot sync {}: {}", path_.string(), std::strerror(error));
+      return DatabaseError::IO_ERROR;
+    }
+    return outcome::success();
+  }
+
+  void MmapTrieStorageBackend::requestCompaction() {
+    {
+      std::lock_guard lock{compactor_mutex_};
+      compaction_requested_ = true;
+    }
+    compaction_cv_.notify_one();
+  }
+
+  void MmapTrieStorageBackend::runCompactor() {
+    while (true) {
+      {
+        std::unique_lock lock{compactor_mutex_};
+        compaction_cv_.wait(
+            lock, [this] { return stopped_ or compaction_requested_; });
+        if (stopped_) {
+          return;
+        }
+        compaction_requested_ = false;
+      }
+      if (auto res = compact(); not res) {
+        logger_->error("Compaction failed: {}", res.error().message());
+      }
+    }
+  }
+
+  outcome::result<MmapTrieStorageBackend::ValueView>
+  MmapTrieStorageBackend::getView(const Buffer &key) const {
+    auto node_key = toNodeKey(key);
+    if (not node_key) {
+      return DatabaseError::NOT_FOUND;
+    }
+    std::lock_guard lock{mutex_};
+    auto it = index_.find(*node_key);
+    if (it == index_.end()) {
+      return DatabaseError::NOT_FOUND;
+    }
+    return ValueView{segments_.at(it->second.segment), valueAt(it->second)};
+  }
+
+  MmapTrieStorageBackend::Stats MmapTrieStorageBackend::getStats() const {
+    std::lock_guard lock{mutex_};
+    Stats stats{segments_.size(), index_.size(), 0, 0};
+    for (const auto &[id, segment] : segments_) {
+      stats.live_bytes += segment->live_bytes;
+      stats.total_bytes += segment->size;
+    }
+    return stats;
+  }
+
+  std::unique_ptr<face::MapCursor<Buffer, Buffer>>
+  MmapTrieStorageBackend::cursor() {
+    std::vector<Buffer> keys;
+    {
+      std::lock_guard lock{mutex_};
+      keys.reserve(index_.size());
+      for (const auto &[key, location] : index_) {
+        keys.emplace_back(gsl::make_span(key.bytes.data(), key.size));
+      }
+    }
+    std::sort(keys.begin(), keys.end());
+    return std::make_unique<Cursor>(*this, std::move(keys));
+  }
+
+  std::unique_ptr<face::WriteBatch<Buffer, Buffer>>
+  MmapTrieStorageBackend::batch() {
+    return std::make_unique<Batch>(*this);
+  }
+
+  outcome::result<Buffer> MmapTrieStorageBackend::get(const Buffer &key) const {
+    auto node_key = toNodeKey(key);
+    if (not node_key) {
+      return DatabaseError::NOT_FOUND;
+    }
+    std::lock_guard lock{mutex_};
+    auto it = index_.find(*node_key);
+    if (it == index_.end()) {
+      return DatabaseError::NOT_FOUND;
+    }
+    return Buffer{valueAt(it->second)};
+  }
+
+  bool MmapTrieStorageBackend::contains(const Buffer &key) const {
+    auto node_key = toNodeKey(key);
+    if (not node_key) {
+      return false;
+    }
+    std::lock_guard lock{mutex_};
+    return index_.count(*node_key) != 0;
+  }
+
+  bool MmapTrieStorageBackend::empty() const {
+    std::lock_guard lock{mutex_};
+    return index_.empty();
+  }
+
+  outcome::result<void> MmapTrieStorageBackend::put(const Buffer &key,
+                                                    const Buffer &value) {
+    return write({{key, value}});
+  }
+
+  outcome::result<void> MmapTrieStorageBackend::put(const Buffer &key,
+                                                    Buffer &&value) {
+    return write({{key, std::move(value)}});
+  }
+
+  outcome::result<void> MmapTrieStorageBackend::remove(const Buffer &key) {
+    return write({{key, boost::none}});
+  }
+
+}  // namespace kagome::storage::trie
@@ -0,0 +1,195 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_TRIE_IMPL_MMAP_TRIE_STORAGE_BACKEND
+#define KAGOME_STORAGE_TRIE_IMPL_MMAP_TRIE_STORAGE_BACKEND
+
+#include "storage/trie/trie_storage_backend.hpp"
+
+#include <array>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/filesystem/path.hpp>
+#include <boost/optional.hpp>
+#include <gsl/span>
+
+#include "common/blob.hpp"
+#include "common/logger.hpp"
+
+namespace kagome::storage::trie {
+
+  /**
+   * Storage of trie nodes in memory-mapped append-only segment files.
+   * As trie nodes are content-addressed and never modified, they need neither
+   * sorting nor rewriting, which an LSM tree would spend its write
+   * amplification on. Every put or remove appends a record to the current
+   * segment, and an in-memory index maps keys to the locations of the records.
+   * The index is rebuilt by scanning the segments on opening, so the segments
+   * are all that is synced to the disk, on every write.
+   * Keys are merkle values of nodes, at most 32 bytes long.
+   * Segments, whose records are mostly obsolete, are compacted by rewriting
+   * the actual records to the current segment and deleting the segment file
+   */
+  class MmapTrieStorageBackend : public TrieStorageBackend {
+   public:
+    struct Config {
+      /// size of a segment file, a larger record gets a segment of its own
+      size_t segment_size = 64 * 1024 * 1024;
+      /// share of obsolete bytes in a segment to compact it at
+      double compaction_threshold = 0.5;
+      /// whether segments are compacted in a background thread as obsolete
+      /// records accumulate, otherwise compact() has to be called
+      bool background_compaction = true;
+    };
+
+    struct Stats {
+      size_t segments;
+      size_t records;
+      /// size of the actual records
+      size_t live_bytes;
+      /// size of all the records, including the obsolete ones
+      size_t total_bytes;
+    };
+
+    /**
+     * Opens the storage in a directory, creating it if needed
+     * @param path directory with the segment files
+     */
+    static outcome::result<std::shared_ptr<MmapTrieStorageBackend>> create(
+        const boost::filesystem::path &path, Config config);
+
+    ~MmapTrieStorageBackend() override;
+
+    MmapTrieStorageBackend(const MmapTrieStorageBackend &) = delete;
+    MmapTrieStorageBackend &operator=(const MmapTrieStorageBackend &) = delete;
+
+    /**
+     * Compacts the segments, whose share of obsolete bytes reached the
+     * threshold
+     */
+    outcome::result<void> compact();
+
+    Stats getStats() const;
+
+    /**
+     * The cursor iterates over the keys stored at the moment of its creation
+     * in their order; the value of a key removed since then is none
+     */
+    std::unique_ptr<face::MapCursor<Buffer, Buffer>> cursor() override;
+    std::unique_ptr<face::WriteBatch<Buffer, Buffer>> batch() override;
+
+    /**
+     * The value refers to the mapped segment, which stays mapped while the
+     * value is alive, even if the segment is compacted meanwhile
+     */
+    outcome::result<ValueView> getView(const Buffer &key) const override;
+
+    outcome::result<Buffer> get(const Buffer &key) const override;
+    bool contains(const Buffer &key) const override;
+    bool empty() const override;
+
+    outcome::result<void> put(const Buffer &key, const Buffer &value) override;
+    outcome::result<void> put(const Buffer &key, Buffer &&value) override;
+    outcome::result<void> remove(const Buffer &key) override;
+
+   private:
+    struct Segment;
+    class Batch;
+    class Cursor;
+
+    /// operation on a key, boost::none value stands for removal
+    using Operation = std::pair<Buffer, boost::optional<Buffer>>;
+
+    struct Location {
+      uint32_t segment;
+      uint32_t offset;
+    };
+
+    static constexpr size_t kMaxKeySize = common::Hash256::size();
+
+    /**
+     * Hash of a node, or the encoding of a node shorter than a hash, kept
+     * inline so that the index does not allocate a key per node
+     */
+    struct NodeKey {
+      std::array<uint8_t, kMaxKeySize> bytes{};
+      uint8_t size = 0;
+
+      bool operator==(const NodeKey &other) const {
+        return size == other.size and bytes == other.bytes;
+      }
+    };
+
+    struct NodeKeyHash {
+      size_t operator()(const NodeKey &key) const;
+    };
+
+    /**
+     * @return none if the key is longer than a hash
+     */
+    static boost::optional<NodeKey> toNodeKey(gsl::span<const uint8_t> key);
+
+    MmapTrieStorageBackend(boost::filesystem::path path, Config config);
+
+    outcome::result<void> open();
+    void replay(Segment &segment);
+    outcome::result<std::shared_ptr<Segment>> createSegment(
+        uint32_t id, size_t capacity) const;
+
+    /**
+     * Applies operations atomically with respect to readers
+     */
+    outcome::result<void> write(const std::vector<Operation> &operations);
+
+    /// mutex_ has to be locked by the callers of the methods below
+    outcome::result<void> applyPut(const NodeKey &key, const Buffer &value);
+    outcome::result<void> applyRemove(const NodeKey &key);
+    outcome::result<Location> append(uint8_t kind,
+                                     const NodeKey &key,
+                                     gsl::span<const uint8_t> value);
+    gsl::span<const uint8_t> valueAt(const Location &location) const;
+    void forget(const Location &location);
+    bool needsCompaction(const Segment &segment) const;
+
+    /**
+     * Flushes the records appended since the last call to the disk
+     */
+    outcome::result<void> sync();
+    outcome::result<void> syncDirectory() const;
+
+    outcome::result<void> compactSegment(
+        const std::shared_ptr<Segment> &segment);
+    void requestCompaction();
+    void runCompactor();
+
+    boost::filesystem::path path_;
+    Config config_;
+    mutable std::mutex mutex_;
+    std::map<uint32_t, std::shared_ptr<Segment>> segments_;
+    std::unordered_map<NodeKey, Location, NodeKeyHash> index_;
+
+    // serializes syncs, so that they flush the records in their order
+    std::mutex sync_mutex_;
+
+    // serializes compactions of the background thread and compact() calls
+    std::mutex compaction_mutex_;
+
+    std::mutex compactor_mutex_;
+    std::condition_variable compaction_cv_;
+    bool compaction_requested_ = false;
+    bool stopped_ = false;
+    std::thread compactor_;
+
+    common::Logger logger_;
+  };
+
+}  // namespace kagome::storage::trie
+
+#endif  // KAGOME_STORAGE_TRIE_IMPL_MMAP_TRIE_STORAGE_BACKEND
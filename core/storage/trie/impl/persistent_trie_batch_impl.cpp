@@ -24,12 +24,14 @@ namespace kagome::storage::trie {
       std::shared_ptr<TrieSerializer> serializer,
       boost::optional<std::shared_ptr<changes_trie::ChangesTracker>> changes,
       std::unique_ptr<PolkadotTrie> trie,
-      RootChangedEventHandler &&handler)
+      RootChangedEventHandler &&handler,
+      std::shared_ptr<TriePruner> pruner)
       : codec_{std::move(codec)},
         serializer_{std::move(serializer)},
         changes_{std::move(changes)},
         trie_{std::move(trie)},
-        root_changed_handler_{std::move(handler)} {
+        root_changed_handler_{std::move(handler)},
+        pruner_{std::move(pruner)} {
     BOOST_ASSERT(codec_ != nullptr);
     BOOST_ASSERT(serializer_ != nullptr);
     BOOST_ASSERT((changes_.has_value() && changes_.value() != nullptr)
@@ -48,34 +50,54 @@ namespace kagome::storage::trie {
   }
 
   outcome::result<Buffer> PersistentTrieBatchImpl::commit() {
+    OUTCOME_TRY(applyAppends());
     OUTCOME_TRY(root, serializer_->storeTrie(*trie_));
+    if (pruner_ != nullptr) {
+      OUTCOME_TRY(pruner_->addState(root));
+    }
     root_changed_handler_(root);
     return std::move(root);
   }
 
+  outcome::result<Buffer> PersistentTrieBatchImpl::calculateRoot() const {
+    OUTCOME_TRY(applyAppends());
+    return serializer_->calculateRootHash(*trie_);
+  }
+
   std::unique_ptr<TopperTrieBatch> PersistentTrieBatchImpl::batchOnTop() {
     return std::make_unique<TopperTrieBatchImpl>(shared_from_this());
   }
 
   outcome::result<Buffer> PersistentTrieBatchImpl::get(
       const Buffer &key) const {
+    if (auto it = appends_.find(key); it != appends_.end()) {
+      return Buffer{it->second.encode()};
+    }
     return trie_->get(key);
   }
 
   std::unique_ptr<PolkadotTrieCursor> PersistentTrieBatchImpl::trieCursor() {
+    if (not applyAppends()) {
+      return nullptr;
+    }
     return std::make_unique<PolkadotTrieCursorImpl>(*trie_);
   }
 
   bool PersistentTrieBatchImpl::contains(const Buffer &key) const {
-    return trie_->contains(key);
+    return appends_.find(key) != appends_.end() or trie_->contains(key);
   }
 
   bool PersistentTrieBatchImpl::empty() const {
-    return trie_->empty();
+    return appends_.empty() and trie_->empty();
   }
 
   outcome::result<void> PersistentTrieBatchImpl::clearPrefix(
       const Buffer &prefix) {
+    auto it = appends_.lower_bound(prefix);
+    while (it != appends_.end()
+           and it->first.subbuffer(0, prefix.size()) == prefix) {
+      it = appends_.erase(it);
+    }
     // TODO(Harrm): notify changes tracker
     return trie_->clearPrefix(prefix);
   }
@@ -87,15 +109,12 @@ namespace kagome::storage::trie {
 
   outcome::result<void> PersistentTrieBatchImpl::put(const Buffer &key,
                                                      Buffer &&value) {
-    bool is_new_entry = not trie_->contains(key);
-    auto res = trie_->put(key, value);
-    if (res and changes_.has_value()) {
-      OUTCOME_TRY(changes_.value()->onPut(key, value, is_new_entry));
-    }
-    return res;
+    OUTCOME_TRY(prepareChange(key));
+    return putToTrie(key, std::move(value));
   }
 
   outcome::result<void> PersistentTrieBatchImpl::remove(const Buffer &key) {
+    OUTCOME_TRY(prepareChange(key));
     auto res = trie_->remove(key);
     if (res and changes_.has_value()) {
       OUTCOME_TRY(changes_.value()->onRemove(key));
@@ -103,4 +122,51 @@ namespace kagome::storage::trie {
     return res;
   }
 
+  outcome::result<void> PersistentTrieBatchImpl::append(
+      const Buffer &key, gsl::span<const uint8_t> value) {
+    auto it = appends_.find(key);
+    if (it == appends_.end()) {
+      Buffer current;
+      if (auto res = trie_->get(key); res) {
+        current = std::move(res.value());
+      } else if (res.error() != TrieError::NO_VALUE) {
+        return res.error();
+      }
+      OUTCOME_TRY(vec, scale::AppendableVec::create(current));
+      it = appends_.emplace(key, std::move(vec)).first;
+    }
+    it->second.append(value);
+    return outcome::success();
+  }
+
+  outcome::result<void> PersistentTrieBatchImpl::applyAppends() const {
+    for (auto &[key, vec] : appends_) {
+      OUTCOME_TRY(putToTrie(key, Buffer{vec.encode()}));
+    }
+    appends_.clear();
+    return outcome::success();
+  }
+
+  outcome::result<void> PersistentTrieBatchImpl::prepareChange(
+      const Buffer &key) {
+    // the changes tracker attributes changes to the extrinsic, which index is
+    // stored by the key, thus the appends made by the previous one are tracked
+    // before it changes
+    if (changes_.has_value() and key == EXTRINSIC_INDEX_KEY) {
+      OUTCOME_TRY(applyAppends());
+    }
+    appends_.erase(key);
+    return outcome::success();
+  }
+
+  outcome::result<void> PersistentTrieBatchImpl::putToTrie(
+      const Buffer &key, Buffer &&value) const {
+    bool is_new_entry = not trie_->contains(key);
+    auto res = trie_->put(key, value);
+    if (res and changes_.has_value()) {
+      OUTCOME_TRY(changes_.value()->onPut(key, value, is_new_entry));
+    }
+    return res;
+  }
+
 }  // namespace kagome::storage::trie
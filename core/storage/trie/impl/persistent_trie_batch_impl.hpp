@@ -6,10 +6,14 @@
 #ifndef KAGOME_STORAGE_TRIE_IMPL_PERSISTENT_TRIE_BATCH
 #define KAGOME_STORAGE_TRIE_IMPL_PERSISTENT_TRIE_BATCH
 
+#include <map>
+
+#include "scale/encode_append.hpp"
 #include "storage/changes_trie/changes_tracker.hpp"
 #include "storage/trie/codec.hpp"
 #include "storage/trie/serialization/trie_serializer.hpp"
 #include "storage/trie/trie_batches.hpp"
+#include "storage/trie/trie_pruner.hpp"
 
 namespace kagome::storage::trie {
 
@@ -17,15 +21,20 @@ namespace kagome::storage::trie {
    public:
     using RootChangedEventHandler = std::function<void(const common::Buffer &)>;
 
+    /**
+     * @param pruner is notified of every committed state, if not nullptr
+     */
     PersistentTrieBatchImpl(
         std::shared_ptr<Codec> codec,
         std::shared_ptr<TrieSerializer> serializer,
         boost::optional<std::shared_ptr<changes_trie::ChangesTracker>> changes,
         std::unique_ptr<PolkadotTrie> trie,
-        RootChangedEventHandler &&handler);
+        RootChangedEventHandler &&handler,
+        std::shared_ptr<TriePruner> pruner = nullptr);
     ~PersistentTrieBatchImpl() override = default;
 
     outcome::result<Buffer> commit() override;
+    outcome::result<Buffer> calculateRoot() const override;
     std::unique_ptr<TopperTrieBatch> batchOnTop() override;
 
     outcome::result<Buffer> get(const Buffer &key) const override;
@@ -36,13 +45,32 @@ namespace kagome::storage::trie {
     outcome::result<void> put(const Buffer &key, const Buffer &value) override;
     outcome::result<void> put(const Buffer &key, Buffer &&value) override;
     outcome::result<void> remove(const Buffer &key) override;
+    outcome::result<void> append(const Buffer &key,
+                                 gsl::span<const uint8_t> value) override;
 
    private:
+    /**
+     * Puts the vectors appended to into the trie.
+     * Doesn't change the content of the batch, thus is allowed in const
+     * methods, like calculateRoot()
+     */
+    outcome::result<void> applyAppends() const;
+
+    /**
+     * Discards the appends to the key, which is about to change
+     */
+    outcome::result<void> prepareChange(const Buffer &key);
+
+    outcome::result<void> putToTrie(const Buffer &key, Buffer &&value) const;
+
     std::shared_ptr<Codec> codec_;
     std::shared_ptr<TrieSerializer> serializer_;
     boost::optional<std::shared_ptr<changes_trie::ChangesTracker>> changes_;
     std::unique_ptr<PolkadotTrie> trie_;
     RootChangedEventHandler root_changed_handler_;
+    std::shared_ptr<TriePruner> pruner_;
+    /// vectors appended to, which are not put into the trie yet
+    mutable std::map<Buffer, scale::AppendableVec> appends_;
   };
 
 }  // namespace kagome::storage::trie
@@ -5,6 +5,7 @@
 
 #include "storage/trie/impl/topper_trie_batch_impl.hpp"
 
+#include "scale/encode_append.hpp"
 #include "storage/trie/polkadot_trie/trie_error.hpp"
 
 OUTCOME_CPP_DEFINE_CATEGORY(kagome::storage::trie,
@@ -14,17 +15,45 @@ OUTCOME_CPP_DEFINE_CATEGORY(kagome::storage::trie,
   switch (e) {
     case E::PARENT_EXPIRED:
       return "Pointer to the parent batch expired";
+    case E::NO_SAVEPOINT:
+      return "No savepoint was set in the batch";
   }
   return "Unknown error";
 }
 
 namespace kagome::storage::trie {
 
+  namespace {
+    bool startsWith(const Buffer &key, const Buffer &prefix) {
+      return key.size() >= prefix.size()
+             and std::equal(prefix.begin(), prefix.end(), key.begin());
+    }
+  }  // namespace
+
   TopperTrieBatchImpl::TopperTrieBatchImpl(
       const std::shared_ptr<TrieBatch> &parent)
       : parent_(parent) {}
 
   outcome::result<Buffer> TopperTrieBatchImpl::get(const Buffer &key) const {
+    auto appended = appends_.find(key);
+    if (appended == appends_.end()) {
+      return getWithoutAppends(key);
+    }
+    Buffer current;
+    if (auto res = getWithoutAppends(key); res) {
+      current = std::move(res.value());
+    } else if (res.error() != TrieError::NO_VALUE) {
+      return res.error();
+    }
+    OUTCOME_TRY(vec, scale::AppendableVec::create(current));
+    for (auto &value : appended->second) {
+      vec.append(value);
+    }
+    return Buffer{vec.encode()};
+  }
+
+  outcome::result<Buffer> TopperTrieBatchImpl::getWithoutAppends(
+      const Buffer &key) const {
     if (auto it = cache_.find(key); it != cache_.end()) {
       if (it->second.has_value()) {
         return it->second.value();
@@ -48,6 +77,9 @@ namespace kagome::storage::trie {
   }
 
   bool TopperTrieBatchImpl::contains(const Buffer &key) const {
+    if (appends_.find(key) != appends_.end()) {
+      return true;
+    }
     if (auto it = cache_.find(key); it != cache_.end()) {
       return it->second.has_value();
     }
@@ -61,6 +93,9 @@ namespace kagome::storage::trie {
   }
 
   bool TopperTrieBatchImpl::empty() const {
+    if (not appends_.empty()) {
+      return false;
+    }
     if (not cache_.empty()
         and std::any_of(cache_.begin(), cache_.end(), [](auto &p) {
               return p.second.has_value();
@@ -82,39 +117,74 @@ namespace kagome::storage::trie {
 
   outcome::result<void> TopperTrieBatchImpl::put(const Buffer &key,
                                                  Buffer &&value) {
-    cache_[key] = std::move(value);
+    setValue(key, std::move(value));
     return outcome::success();
   }
 
   outcome::result<void> TopperTrieBatchImpl::remove(const Buffer &key) {
-    cache_[key] = boost::none;
+    setValue(key, boost::none);
     return outcome::success();
   }
 
   outcome::result<void> TopperTrieBatchImpl::clearPrefix(const Buffer &prefix) {
-    for (auto &p : cache_) {
-      if (p.first.subbuffer(0, prefix.size()) == prefix) {
-        cache_[p.first] = boost::none;
+    for (auto it = appends_.lower_bound(prefix);
+         it != appends_.end() and startsWith(it->first, prefix);) {
+      dropAppends(it++);
+    }
+    // the cleared values are dropped from the overlay, as the prefix shadows
+    // the ones of the parent anyway
+    auto it = cache_.lower_bound(prefix);
+    while (it != cache_.end() and startsWith(it->first, prefix)) {
+      if (not savepoints_.empty()) {
+        journal_.push_back({JournalEntry::Kind::VALUE,
+                            it->first,
+                            boost::make_optional(std::move(it->second))});
       }
+      it = cache_.erase(it);
+    }
+    if (not wasClearedByPrefix(prefix)) {
+      addClearedPrefix(prefix);
     }
-    cleared_prefixes_.push_back(prefix);
     if (parent_.lock() != nullptr) {
       return outcome::success();
     }
     return Error::PARENT_EXPIRED;
   }
 
+  outcome::result<void> TopperTrieBatchImpl::append(
+      const Buffer &key, gsl::span<const uint8_t> value) {
+    // the vector is not read, the parent appends the values to it on write back
+    auto it = appends_.lower_bound(key);
+    if (it == appends_.end() or key < it->first) {
+      it = appends_.emplace_hint(it, key, std::vector<Buffer>{});
+      if (not savepoints_.empty()) {
+        journal_.push_back({JournalEntry::Kind::APPENDED, key});
+      }
+    } else if (not savepoints_.empty()) {
+      journal_.push_back({JournalEntry::Kind::APPENDED,
+                          key,
+                          boost::none,
+                          it->second.size()});
+    }
+    it->second.emplace_back(value);
+    return outcome::success();
+  }
+
   outcome::result<void> TopperTrieBatchImpl::writeBack() {
     if (auto p = parent_.lock(); p != nullptr) {
-      auto it = cache_.begin();
       for (auto &prefix : cleared_prefixes_) {
         OUTCOME_TRY(p->clearPrefix(prefix));
       }
-      for (; it != cache_.end(); it++) {
-        if (it->second.has_value()) {
-          OUTCOME_TRY(p->put(it->first, it->second.value()));
+      for (auto &[key, value] : cache_) {
+        if (value.has_value()) {
+          OUTCOME_TRY(p->put(key, value.value()));
         } else {
-          OUTCOME_TRY(p->remove(it->first));
+          OUTCOME_TRY(p->remove(key));
+        }
+      }
+      for (auto &[key, values] : appends_) {
+        for (auto &value : values) {
+          OUTCOME_TRY(p->append(key, value));
         }
       }
       return outcome::success();
@@ -122,14 +192,121 @@ namespace kagome::storage::trie {
     return Error::PARENT_EXPIRED;
   }
 
+  void TopperTrieBatchImpl::setSavepoint() {
+    savepoints_.push_back(journal_.size());
+  }
+
+  outcome::result<void> TopperTrieBatchImpl::rollbackToSavepoint() {
+    if (savepoints_.empty()) {
+      return Error::NO_SAVEPOINT;
+    }
+    auto journal_size = savepoints_.back();
+    savepoints_.pop_back();
+    while (journal_.size() > journal_size) {
+      undo(journal_.back());
+      journal_.pop_back();
+    }
+    return outcome::success();
+  }
+
+  outcome::result<void> TopperTrieBatchImpl::releaseSavepoint() {
+    if (savepoints_.empty()) {
+      return Error::NO_SAVEPOINT;
+    }
+    savepoints_.pop_back();
+    // the changes are now kept by the enclosing savepoint, if there is one
+    if (savepoints_.empty()) {
+      journal_.clear();
+    }
+    return outcome::success();
+  }
+
+  void TopperTrieBatchImpl::setValue(const Buffer &key,
+                                     boost::optional<Buffer> value) {
+    if (auto it = appends_.find(key); it != appends_.end()) {
+      dropAppends(it);
+    }
+    auto it = cache_.lower_bound(key);
+    if (it == cache_.end() or key < it->first) {
+      if (not savepoints_.empty()) {
+        journal_.push_back({JournalEntry::Kind::VALUE, key, boost::none});
+      }
+      cache_.emplace_hint(it, key, std::move(value));
+      return;
+    }
+    if (not savepoints_.empty()) {
+      journal_.push_back({JournalEntry::Kind::VALUE,
+                          key,
+                          boost::make_optional(std::move(it->second))});
+    }
+    it->second = std::move(value);
+  }
+
+  void TopperTrieBatchImpl::dropAppends(
+      std::map<Buffer, std::vector<Buffer>>::iterator it) {
+    if (not savepoints_.empty()) {
+      journal_.push_back({JournalEntry::Kind::APPENDS_DROPPED,
+                          it->first,
+                          boost::none,
+                          boost::none,
+                          std::move(it->second)});
+    }
+    appends_.erase(it);
+  }
+
+  void TopperTrieBatchImpl::addClearedPrefix(const Buffer &prefix) {
+    // the prefixes it covers become redundant
+    auto it = cleared_prefixes_.lower_bound(prefix);
+    while (it != cleared_prefixes_.end() and startsWith(*it, prefix)) {
+      if (not savepoints_.empty()) {
+        journal_.push_back(
+            {JournalEntry::Kind::PREFIX_REMOVED, *it, boost::none});
+      }
+      it = cleared_prefixes_.erase(it);
+    }
+    cleared_prefixes_.emplace_hint(it, prefix);
+    if (not savepoints_.empty()) {
+      journal_.push_back({JournalEntry::Kind::PREFIX_ADDED, prefix, boost::none});
+    }
+  }
+
+  void TopperTrieBatchImpl::undo(JournalEntry &entry) {
+    switch (entry.kind) {
+      case JournalEntry::Kind::VALUE:
+        if (entry.previous.has_value()) {
+          cache_[entry.key] = std::move(entry.previous.value());
+        } else {
+          cache_.erase(entry.key);
+        }
+        break;
+      case JournalEntry::Kind::PREFIX_ADDED:
+        cleared_prefixes_.erase(entry.key);
+        break;
+      case JournalEntry::Kind::PREFIX_REMOVED:
+        cleared_prefixes_.insert(std::move(entry.key));
+        break;
+      case JournalEntry::Kind::APPENDED:
+        if (entry.appended.has_value()) {
+          appends_.at(entry.key).resize(entry.appended.value());
+        } else {
+          appends_.erase(entry.key);
+        }
+        break;
+      case JournalEntry::Kind::APPENDS_DROPPED:
+        appends_.emplace(std::move(entry.key),
+                         std::move(entry.dropped.value()));
+        break;
+    }
+  }
+
   bool TopperTrieBatchImpl::wasClearedByPrefix(const Buffer &key) const {
-    for (auto prefix : cleared_prefixes_) {
-      auto key_end = key.begin();
-      std::advance(key_end, std::min(key.size(), prefix.size()) - 1);
-      auto is_cleared = std::equal(key.begin(), key_end, prefix.begin());
-      if (is_cleared) return true;
+    // as no cleared prefix is a prefix of another one, the only one which may
+    // be a prefix of the key is the greatest one not exceeding it
+    auto it = cleared_prefixes_.upper_bound(key);
+    if (it == cleared_prefixes_.begin()) {
+      return false;
     }
-    return false;
+    return startsWith(key, *std::prev(it));
   }
 
 }  // namespace kagome::storage::trie
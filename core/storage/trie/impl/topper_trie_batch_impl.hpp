@@ -8,13 +8,23 @@
 
 #include "storage/trie/trie_batches.hpp"
 
+#include <map>
+#include <set>
+#include <vector>
+
 #include "storage/trie/polkadot_trie/polkadot_trie_factory.hpp"
 
 namespace kagome::storage::trie {
 
+  /**
+   * Keeps the changes in a single overlay over the parent batch. Nested
+   * transactions are savepoints in a journal of the changes, which is only
+   * kept while there are savepoints, so that rolling one back costs as much as
+   * the changes made after it, and releasing one costs nothing
+   */
   class TopperTrieBatchImpl : public TopperTrieBatch {
    public:
-    enum class Error { PARENT_EXPIRED = 1 };
+    enum class Error { PARENT_EXPIRED = 1, NO_SAVEPOINT };
 
     explicit TopperTrieBatchImpl(const std::shared_ptr<TrieBatch> &parent);
 
@@ -31,14 +41,59 @@ namespace kagome::storage::trie {
     outcome::result<void> put(const Buffer &key, Buffer &&value) override;
     outcome::result<void> remove(const Buffer &key) override;
     outcome::result<void> clearPrefix(const Buffer &prefix) override;
+    outcome::result<void> append(const Buffer &key,
+                                 gsl::span<const uint8_t> value) override;
 
     outcome::result<void> writeBack() override;
 
+    void setSavepoint() override;
+    outcome::result<void> rollbackToSavepoint() override;
+    outcome::result<void> releaseSavepoint() override;
+
    private:
-    bool wasClearedByPrefix(const Buffer& key) const;
+    /**
+     * Change of the overlay, which is undone on rollback
+     */
+    struct JournalEntry {
+      enum class Kind {
+        VALUE,
+        PREFIX_ADDED,
+        PREFIX_REMOVED,
+        APPENDED,
+        APPENDS_DROPPED
+      };
+
+      Kind kind;
+      /// key of the changed value or vector, or the cleared prefix
+      Buffer key;
+      /// previous value of the key in the overlay, boost::none if it had none
+      boost::optional<boost::optional<Buffer>> previous;
+      /// number of the values appended before, boost::none if there were none
+      boost::optional<size_t> appended;
+      /// values, which appends were dropped
+      boost::optional<std::vector<Buffer>> dropped;
+    };
+
+    /**
+     * @return the value of the key without the values appended to it
+     */
+    outcome::result<Buffer> getWithoutAppends(const Buffer &key) const;
+
+    void setValue(const Buffer &key, boost::optional<Buffer> value);
+    void dropAppends(std::map<Buffer, std::vector<Buffer>>::iterator it);
+    void addClearedPrefix(const Buffer &prefix);
+    void undo(JournalEntry &entry);
+    bool wasClearedByPrefix(const Buffer &key) const;
 
     std::map<Buffer, boost::optional<Buffer>> cache_;
-    std::list<Buffer> cleared_prefixes_;
+    /// values appended to the vectors, which are the values of the keys in
+    /// cache_, or nothing if cleared by a prefix, or the values of the parent
+    std::map<Buffer, std::vector<Buffer>> appends_;
+    /// no prefix in the set is a prefix of another one
+    std::set<Buffer> cleared_prefixes_;
+    std::vector<JournalEntry> journal_;
+    /// sizes of the journal at the moments the savepoints were set
+    std::vector<size_t> savepoints_;
     std::weak_ptr<TrieBatch> parent_;
   };
 
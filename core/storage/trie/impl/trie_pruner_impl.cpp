@@ -0,0 +1,172 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/impl/trie_pruner_impl.hpp"
+
+#include "scale/scale.hpp"
+#include "storage/database_error.hpp"
+#include "storage/trie/polkadot_trie/polkadot_node.hpp"
+
+namespace kagome::storage::trie {
+
+  TriePrunerImpl::TriePrunerImpl(
+      std::shared_ptr<TrieStorageBackend> node_storage,
+      std::shared_ptr<BufferStorage> refcount_storage,
+      std::shared_ptr<Codec> codec)
+      : node_storage_{std::move(node_storage)},
+        refcount_storage_{std::move(refcount_storage)},
+        codec_{std::move(codec)},
+        logger_{common::createLogger("TriePruner")} {
+    BOOST_ASSERT(node_storage_ != nullptr);
+    BOOST_ASSERT(refcount_storage_ != nullptr);
+    BOOST_ASSERT(codec_ != nullptr);
+    empty_root_ = Buffer{codec_->hash256({0})};
+  }
+
+  outcome::result<void> TriePrunerImpl::addState(
+      const common::Buffer &state_root) {
+    // an empty trie has no nodes in the storage
+    if (state_root == empty_root_) {
+      return outcome::success();
+    }
+    std::lock_guard lock{mutex_};
+    RefCounts counts;
+    OUTCOME_TRY(addRef(state_root, counts));
+    logger_->debug("Added state {}, {} nodes referenced",
+                   state_root.toHex(),
+                   counts.size());
+    return writeRefCounts(counts);
+  }
+
+  outcome::result<void> TriePrunerImpl::addExistingState(
+      const common::Buffer &state_root) {
+    if (state_root == empty_root_) {
+      return outcome::success();
+    }
+    std::lock_guard lock{mutex_};
+    RefCounts counts;
+    // the root of a registered state is counted by the registration
+    OUTCOME_TRY(count, getRefCount(state_root, counts));
+    if (count.has_value()) {
+      return outcome::success();
+    }
+    logger_->info("Registering state {} written before the pruning",
+                  state_root.toHex());
+    OUTCOME_TRY(addRef(state_root, counts));
+    logger_->info("Registered state {}, {} nodes referenced",
+                  state_root.toHex(),
+                  counts.size());
+    return writeRefCounts(counts);
+  }
+
+  outcome::result<void> TriePrunerImpl::pruneState(
+      const common::Buffer &state_root) {
+    if (state_root == empty_root_) {
+      return outcome::success();
+    }
+    std::lock_guard lock{mutex_};
+    RefCounts counts;
+    std::vector<Buffer> removed;
+    OUTCOME_TRY(removeRef(state_root, counts, removed));
+
+    // reference counts are written first: if the nodes removal fails
+    // afterwards, the nodes are just left in the storage untracked
+    OUTCOME_TRY(writeRefCounts(counts));
+    auto batch = node_storage_->batch();
+    for (const auto &key : removed) {
+      OUTCOME_TRY(batch->remove(key));
+    }
+    OUTCOME_TRY(batch->commit());
+    logger_->debug("Pruned state {}, {} nodes removed",
+                   state_root.toHex(),
+                   removed.size());
+    return outcome::success();
+  }
+
+  outcome::result<void> TriePrunerImpl::addRef(const common::Buffer &key,
+                                               RefCounts &counts) {
+    OUTCOME_TRY(count, getRefCount(key, counts));
+    if (count.has_value()) {
+      // references of the node to its children are already counted
+      counts[key] = count.value() + 1;
+      return outcome::success();
+    }
+    counts[key] = 1;
+    OUTCOME_TRY(children, getChildren(key));
+    for (const auto &child : children) {
+      OUTCOME_TRY(addRef(child, counts));
+    }
+    return outcome::success();
+  }
+
+  outcome::result<void> TriePrunerImpl::removeRef(
+      const common::Buffer &key,
+      RefCounts &counts,
+      std::vector<common::Buffer> &removed) {
+    OUTCOME_TRY(count, getRefCount(key, counts));
+    if (not count.has_value() or count.value() == 0) {
+      return outcome::success();
+    }
+    counts[key] = count.value() - 1;
+    if (count.value() > 1) {
+      return outcome::success();
+    }
+    // the node is not referenced anymore, so are its children by it
+    removed.push_back(key);
+    OUTCOME_TRY(children, getChildren(key));
+    for (const auto &child : children) {
+      OUTCOME_TRY(removeRef(child, counts, removed));
+    }
+    return outcome::success();
+  }
+
+  outcome::result<boost::optional<uint32_t>> TriePrunerImpl::getRefCount(
+      const common::Buffer &key, const RefCounts &counts) const {
+    if (auto it = counts.find(key); it != counts.end()) {
+      return it->second;
+    }
+    auto res = refcount_storage_->get(key);
+    if (res.has_error()) {
+      if (res == outcome::failure(DatabaseError::NOT_FOUND)) {
+        return boost::none;
+      }
+      return res.error();
+    }
+    OUTCOME_TRY(count, scale::decode<uint32_t>(res.value()));
+    return count;
+  }
+
+  outcome::result<std::vector<common::Buffer>> TriePrunerImpl::getChildren(
+      const common::Buffer &key) const {
+    OUTCOME_TRY(enc, node_storage_->getView(key));
+    OUTCOME_TRY(node, codec_->decodeNode(enc.data));
+    auto branch = std::dynamic_pointer_cast<BranchNode>(node);
+    if (branch == nullptr) {
+      return std::vector<Buffer>{};
+    }
+    std::vector<Buffer> children;
+    for (const auto &child : branch->children) {
+      if (child != nullptr) {
+        // children of a decoded node are dummies referencing the stored ones
+        children.push_back(std::dynamic_pointer_cast<DummyNode>(child)->db_key);
+      }
+    }
+    return children;
+  }
+
+  outcome::result<void> TriePrunerImpl::writeRefCounts(
+      const RefCounts &counts) {
+    auto batch = refcount_storage_->batch();
+    for (const auto &[key, count] : counts) {
+      if (count == 0) {
+        OUTCOME_TRY(batch->remove(key));
+      } else {
+        OUTCOME_TRY(batch->put(key, Buffer{scale::encode(count).value()}));
+      }
+    }
+    return batch->commit();
+  }
+
+}  // namespace kagome::storage::trie
@@ -0,0 +1,88 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_TRIE_IMPL_TRIE_PRUNER_IMPL
+#define KAGOME_STORAGE_TRIE_IMPL_TRIE_PRUNER_IMPL
+
+#include "storage/trie/trie_pruner.hpp"
+
+#include <map>
+#include <mutex>
+
+#include <boost/optional.hpp>
+
+#include "common/logger.hpp"
+#include "storage/buffer_map_types.hpp"
+#include "storage/trie/codec.hpp"
+#include "storage/trie/trie_storage_backend.hpp"
+
+namespace kagome::storage::trie {
+
+  /**
+   * Reference counting pruner. A node is referenced by each stored branch
+   * node which has it as a child and by each registration of a state with it
+   * as the root; the node is removed from the storage once the count drops to
+   * zero.
+   * Nodes without a reference count record (e.g. written before the pruning
+   * was enabled) are counted when they are reached from a registered state
+   * for the first time, and are never removed otherwise. The references of
+   * the states written before are not counted, unless the states are
+   * registered with addExistingState
+   */
+  class TriePrunerImpl : public TriePruner {
+   public:
+    /**
+     * @param node_storage storage of trie nodes
+     * @param refcount_storage storage of reference counts of the nodes,
+     * separated from the trie nodes key space
+     * @param codec used to decode nodes to find out their children
+     */
+    TriePrunerImpl(std::shared_ptr<TrieStorageBackend> node_storage,
+                   std::shared_ptr<BufferStorage> refcount_storage,
+                   std::shared_ptr<Codec> codec);
+    ~TriePrunerImpl() override = default;
+
+    outcome::result<void> addState(const common::Buffer &state_root) override;
+
+    outcome::result<void> addExistingState(
+        const common::Buffer &state_root) override;
+
+    outcome::result<void> pruneState(
+        const common::Buffer &state_root) override;
+
+   private:
+    /// reference counts modified by the current operation, not written yet
+    using RefCounts = std::map<common::Buffer, uint32_t>;
+
+    outcome::result<void> addRef(const common::Buffer &key, RefCounts &counts);
+    outcome::result<void> removeRef(const common::Buffer &key,
+                                    RefCounts &counts,
+                                    std::vector<common::Buffer> &removed);
+
+    /**
+     * @return reference count of a node, boost::none if it is not tracked
+     */
+    outcome::result<boost::optional<uint32_t>> getRefCount(
+        const common::Buffer &key, const RefCounts &counts) const;
+
+    /**
+     * @return database keys of the children of a stored node
+     */
+    outcome::result<std::vector<common::Buffer>> getChildren(
+        const common::Buffer &key) const;
+
+    outcome::result<void> writeRefCounts(const RefCounts &counts);
+
+    std::shared_ptr<TrieStorageBackend> node_storage_;
+    std::shared_ptr<BufferStorage> refcount_storage_;
+    std::shared_ptr<Codec> codec_;
+    common::Buffer empty_root_;
+    std::mutex mutex_;
+    common::Logger logger_;
+  };
+
+}  // namespace kagome::storage::trie
+
+#endif  // KAGOME_STORAGE_TRIE_IMPL_TRIE_PRUNER_IMPL
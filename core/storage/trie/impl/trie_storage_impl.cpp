@@ -19,7 +19,8 @@ namespace kagome::storage::trie {
       const std::shared_ptr<PolkadotTrieFactory> &trie_factory,
       std::shared_ptr<Codec> codec,
       std::shared_ptr<TrieSerializer> serializer,
-      boost::optional<std::shared_ptr<changes_trie::ChangesTracker>> changes) {
+      boost::optional<std::shared_ptr<changes_trie::ChangesTracker>> changes,
+      std::shared_ptr<TriePruner> pruner) {
     // will never be used, so content of the callback doesn't matter
     auto empty_trie = trie_factory->createEmpty(
         [](const auto &branch, auto idx) { return nullptr; });
@@ -29,7 +30,8 @@ namespace kagome::storage::trie {
         new TrieStorageImpl(std::move(empty_root),
                             std::move(codec),
                             std::move(serializer),
-                            std::move(changes)));
+                            std::move(changes),
+                            std::move(pruner)));
   }
 
   outcome::result<std::unique_ptr<TrieStorageImpl>>
@@ -37,23 +39,27 @@ namespace kagome::storage::trie {
       const common::Buffer &root_hash,
       std::shared_ptr<Codec> codec,
       std::shared_ptr<TrieSerializer> serializer,
-      boost::optional<std::shared_ptr<changes_trie::ChangesTracker>> changes) {
+      boost::optional<std::shared_ptr<changes_trie::ChangesTracker>> changes,
+      std::shared_ptr<TriePruner> pruner) {
     return std::unique_ptr<TrieStorageImpl>(
         new TrieStorageImpl(root_hash,
                             std::move(codec),
                             std::move(serializer),
-                            std::move(changes)));
+                            std::move(changes),
+                            std::move(pruner)));
   }
 
   TrieStorageImpl::TrieStorageImpl(
       common::Buffer root_hash,
       std::shared_ptr<Codec> codec,
       std::shared_ptr<TrieSerializer> serializer,
-      boost::optional<std::shared_ptr<changes_trie::ChangesTracker>> changes)
+      boost::optional<std::shared_ptr<changes_trie::ChangesTracker>> changes,
+      std::shared_ptr<TriePruner> pruner)
       : root_hash_{std::move(root_hash)},
         codec_{std::move(codec)},
         serializer_{std::move(serializer)},
         changes_{std::move(changes)},
+        pruner_{std::move(pruner)},
         logger_{common::createLogger("Trie Storage: ")} {
     BOOST_ASSERT(codec_ != nullptr);
     BOOST_ASSERT(serializer_ != nullptr);
@@ -64,12 +70,13 @@ namespace kagome::storage::trie {
 
   outcome::result<std::unique_ptr<PersistentTrieBatch>>
   TrieStorageImpl::getPersistentBatch() {
+    auto root_hash = getRootHash();
     logger_->debug("Initialize persistent trie batch with root: {}",
-                   root_hash_.toHex());
-    auto trie_res = serializer_->retrieveTrie(Buffer{root_hash_});
+                   root_hash.toHex());
+    auto trie_res = serializer_->retrieveTrie(root_hash);
     if (trie_res.has_error()) {
       logger_->error("Batch initialization failed, invalid root: {}",
-                     root_hash_.toHex());
+                     root_hash.toHex());
       return trie_res.error();
     }
     return std::make_unique<PersistentTrieBatchImpl>(
@@ -77,17 +84,16 @@ namespace kagome::storage::trie {
         serializer_,
         changes_,
         std::move(trie_res.value()),
-        [this](const auto &new_root) {
-          root_hash_ = new_root;
-          logger_->debug("Update state root: {}", root_hash_);
-        });
+        [this](const auto &new_root) { setRootHash(new_root); },
+        pruner_);
   }
 
   outcome::result<std::unique_ptr<EphemeralTrieBatch>>
   TrieStorageImpl::getEphemeralBatch() const {
+    auto root_hash = getRootHash();
     logger_->debug("Initialize ephemeral trie batch with root: {}",
-                   root_hash_.toHex());
-    OUTCOME_TRY(trie, serializer_->retrieveTrie(Buffer{root_hash_}));
+                   root_hash.toHex());
+    OUTCOME_TRY(trie, serializer_->retrieveTrie(root_hash));
     return std::make_unique<EphemeralTrieBatchImpl>(codec_, std::move(trie));
   }
 
@@ -106,21 +112,26 @@ namespace kagome::storage::trie {
         serializer_,
         changes_,
         std::move(trie_res.value()),
-        [this](const auto &new_root) {
-          root_hash_ = new_root;
-          logger_->debug("Update state root: {}", root_hash_);
-        });
+        [this](const auto &new_root) { setRootHash(new_root); },
+        pruner_);
   }
 
   outcome::result<std::unique_ptr<EphemeralTrieBatch>>
   TrieStorageImpl::getEphemeralBatchAt(const common::Hash256 &root) const {
     logger_->debug("Initialize ephemeral trie batch with root: {}",
-                   root_hash_.toHex());
+                   root.toHex());
     OUTCOME_TRY(trie, serializer_->retrieveTrie(Buffer{root}));
     return std::make_unique<EphemeralTrieBatchImpl>(codec_, std::move(trie));
   }
 
   common::Buffer TrieStorageImpl::getRootHash() const {
+    std::lock_guard lock{root_hash_mutex_};
     return root_hash_;
   }
+
+  void TrieStorageImpl::setRootHash(common::Buffer root_hash) {
+    logger_->debug("Update state root: {}", root_hash.toHex());
+    std::lock_guard lock{root_hash_mutex_};
+    root_hash_ = std::move(root_hash);
+  }
 }  // namespace kagome::storage::trie
@@ -8,34 +8,41 @@
 
 #include "storage/trie/trie_storage.hpp"
 
+#include <mutex>
+
 #include "common/logger.hpp"
 #include "storage/changes_trie/changes_tracker.hpp"
 #include "storage/trie/codec.hpp"
 #include "storage/trie/polkadot_trie/polkadot_trie_factory.hpp"
 #include "storage/trie/serialization/trie_serializer.hpp"
+#include "storage/trie/trie_pruner.hpp"
 #include "subscription/subscription_engine.hpp"
 
 namespace kagome::storage::trie {
 
   class TrieStorageImpl : public TrieStorage {
    public:
+    /**
+     * @param pruner registers states committed by persistent batches, if not
+     * nullptr
+     */
     static outcome::result<std::unique_ptr<TrieStorageImpl>> createEmpty(
         const std::shared_ptr<PolkadotTrieFactory> &trie_factory,
         std::shared_ptr<Codec> codec,
         std::shared_ptr<TrieSerializer> serializer,
-        boost::optional<std::shared_ptr<changes_trie::ChangesTracker>> changes);
+        boost::optional<std::shared_ptr<changes_trie::ChangesTracker>> changes,
+        std::shared_ptr<TriePruner> pruner = nullptr);
 
     static outcome::result<std::unique_ptr<TrieStorageImpl>> createFromStorage(
         const common::Buffer &root_hash,
         std::shared_ptr<Codec> codec,
         std::shared_ptr<TrieSerializer> serializer,
-        boost::optional<std::shared_ptr<changes_trie::ChangesTracker>> changes);
+        boost::optional<std::shared_ptr<changes_trie::ChangesTracker>> changes,
+        std::shared_ptr<TriePruner> pruner = nullptr);
 
     TrieStorageImpl(TrieStorageImpl const &) = delete;
     void operator=(const TrieStorageImpl &) = delete;
 
-    TrieStorageImpl(TrieStorageImpl &&) = default;
-    TrieStorageImpl &operator=(TrieStorageImpl &&) = default;
     ~TrieStorageImpl() override = default;
 
     outcome::result<std::unique_ptr<PersistentTrieBatch>> getPersistentBatch()
@@ -55,13 +62,20 @@ namespace kagome::storage::trie {
         common::Buffer root_hash,
         std::shared_ptr<Codec> codec,
         std::shared_ptr<TrieSerializer> serializer,
-        boost::optional<std::shared_ptr<changes_trie::ChangesTracker>> changes);
+        boost::optional<std::shared_ptr<changes_trie::ChangesTracker>> changes,
+        std::shared_ptr<TriePruner> pruner = nullptr);
 
    private:
+    void setRootHash(common::Buffer root_hash);
+
+    // the root is updated by commits of persistent batches, while batches
+    // are created by runtime calls of other threads
+    mutable std::mutex root_hash_mutex_;
     common::Buffer root_hash_;
     std::shared_ptr<Codec> codec_;
     std::shared_ptr<TrieSerializer> serializer_;
     boost::optional<std::shared_ptr<changes_trie::ChangesTracker>> changes_;
+    std::shared_ptr<TriePruner> pruner_;
     common::Logger logger_;
   };
 
@@ -0,0 +1,49 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/impl/trie_storage_migration.hpp"
+
+#include "storage/database_error.hpp"
+
+namespace kagome::storage::trie {
+
+  outcome::result<size_t> moveEntriesByPrefix(BufferStorage &source,
+                                              const common::Buffer &prefix,
+                                              BufferStorage &target) {
+    auto cursor = source.cursor();
+    if (cursor == nullptr) {
+      return DatabaseError::NOT_SUPPORTED;
+    }
+    auto source_batch = source.batch();
+    auto target_batch = target.batch();
+    auto flush = [&]() -> outcome::result<void> {
+      OUTCOME_TRY(target_batch->commit());
+      OUTCOME_TRY(source_batch->commit());
+      target_batch->clear();
+      source_batch->clear();
+      return outcome::success();
+    };
+
+    size_t moved = 0;
+    OUTCOME_TRY(cursor->seek(prefix));
+    while (cursor->isValid()) {
+      auto key = cursor->key().value();
+      if (key.size() < prefix.size()
+          or not std::equal(prefix.begin(), prefix.end(), key.begin())) {
+        break;
+      }
+      OUTCOME_TRY(target_batch->put(key.subbuffer(prefix.size()),
+                                    cursor->value().value()));
+      OUTCOME_TRY(source_batch->remove(key));
+      if (++moved % kMigrationBatchSize == 0) {
+        OUTCOME_TRY(flush());
+      }
+      OUTCOME_TRY(cursor->next());
+    }
+    OUTCOME_TRY(flush());
+    return moved;
+  }
+
+}  // namespace kagome::storage::trie
@@ -0,0 +1,36 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_TRIE_IMPL_TRIE_STORAGE_MIGRATION
+#define KAGOME_STORAGE_TRIE_IMPL_TRIE_STORAGE_MIGRATION
+
+#include "common/buffer.hpp"
+#include "outcome/outcome.hpp"
+#include "storage/buffer_map_types.hpp"
+
+namespace kagome::storage::trie {
+
+  /// number of entries moved by one write to each of the storages
+  constexpr size_t kMigrationBatchSize = 10000;
+
+  /**
+   * Moves the entries, which keys start with the prefix, out of a storage,
+   * which kept trie nodes along with the other data before they got a
+   * storage of their own. The target is written before the entries are
+   * removed from the source, so an interrupted move is resumed by calling
+   * it again
+   * @param source storage with the prefixed entries
+   * @param prefix prefix of the keys
+   * @param target storage, which gets the entries by the keys without the
+   * prefix
+   * @return number of the moved entries
+   */
+  outcome::result<size_t> moveEntriesByPrefix(BufferStorage &source,
+                                              const common::Buffer &prefix,
+                                              BufferStorage &target);
+
+}  // namespace kagome::storage::trie
+
+#endif  // KAGOME_STORAGE_TRIE_IMPL_TRIE_STORAGE_MIGRATION
@@ -0,0 +1,287 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_TRIE_KEY_NIBBLES
+#define KAGOME_STORAGE_TRIE_KEY_NIBBLES
+
+#include <algorithm>
+#include <initializer_list>
+#include <ostream>
+
+#include <boost/assert.hpp>
+#include <boost/container/small_vector.hpp>
+#include <gsl/span>
+
+#include "common/buffer.hpp"
+
+namespace kagome::storage::trie {
+
+  class KeyNibbles;
+
+  /**
+   * Non-owning view of a sequence of nibbles packed two per byte (the first
+   * one in the high half of a byte), which may start in the middle of a byte.
+   * Taking a subspan of a view does not copy anything, so a key may be
+   * consumed nibble by nibble during a trie traversal for free. A view must
+   * not outlive the nibbles it refers to
+   */
+  class KeyNibblesView {
+   public:
+    KeyNibblesView() = default;
+
+    /**
+     * @param data packed nibbles
+     * @param offset index of the first nibble of the view in {@param data}
+     * @param size number of nibbles in the view
+     */
+    KeyNibblesView(const uint8_t *data, size_t offset, size_t size)
+        : data_{data + offset / 2}, offset_{offset % 2}, size_{size} {}
+
+    // defined below, as KeyNibbles is incomplete here
+    KeyNibblesView(const KeyNibbles &nibbles);  // NOLINT
+
+    size_t size() const {
+      return size_;
+    }
+
+    bool empty() const {
+      return size_ == 0;
+    }
+
+    uint8_t operator[](size_t i) const {
+      BOOST_ASSERT(i < size_);
+      auto pos = offset_ + i;
+      auto byte = data_[pos / 2];
+      return pos % 2 == 0 ? byte >> 4u : byte & 0xfu;
+    }
+
+    /**
+     * @return view of {@param length} nibbles starting from {@param offset},
+     * or of all the nibbles after the offset if there are not as many
+     */
+    KeyNibblesView subspan(size_t offset = 0, size_t length = -1) const {
+      offset = std::min(offset, size_);
+      length = std::min(length, size_ - offset);
+      return KeyNibblesView{data_, offset_ + offset, length};
+    }
+
+    /**
+     * @return number of leading nibbles equal in this and {@param other}
+     */
+    size_t commonPrefixLength(const KeyNibblesView &other) const {
+      auto limit = std::min(size_, other.size_);
+      size_t i = 0;
+      if (offset_ == other.offset_) {
+        // nibbles are equally aligned, so whole bytes may be compared
+        if (offset_ == 1 and limit > 0) {
+          if ((*this)[0] != other[0]) {
+            return 0;
+          }
+          i = 1;
+        }
+        auto *lhs = data_ + (offset_ + i) / 2;
+        auto *rhs = other.data_ + (other.offset_ + i) / 2;
+        while (i + 1 < limit and *lhs == *rhs) {
+          i += 2;
+          ++lhs;
+          ++rhs;
+        }
+      }
+      while (i < limit and (*this)[i] == other[i]) {
+        ++i;
+      }
+      return i;
+    }
+
+    bool startsWith(const KeyNibblesView &prefix) const {
+      return prefix.size_ <= size_
+             and commonPrefixLength(prefix) == prefix.size_;
+    }
+
+    friend bool operator==(const KeyNibblesView &lhs,
+                           const KeyNibblesView &rhs) {
+      return lhs.size_ == rhs.size_
+             and lhs.commonPrefixLength(rhs) == lhs.size_;
+    }
+
+    friend bool operator!=(const KeyNibblesView &lhs,
+                           const KeyNibblesView &rhs) {
+      return not(lhs == rhs);
+    }
+
+   private:
+    friend class KeyNibbles;
+
+    const uint8_t *data_ = nullptr;
+    // 0 if the view starts at the high half of the first byte, 1 otherwise
+    size_t offset_ = 0;
+    size_t size_ = 0;
+  };
+
+  /**
+   * Key of a trie node as a sequence of nibbles packed two per byte, so that
+   * a key of a full byte length is the key itself. Short keys, which are the
+   * most of partial keys of nodes, are stored inline without allocations
+   */
+  class KeyNibbles {
+   public:
+    /// number of bytes (i.e. twice as many nibbles) stored inline
+    static constexpr size_t kInlineBytes = 16;
+
+    KeyNibbles() = default;
+
+    /**
+     * @param nibbles nibbles stored one per byte
+     */
+    explicit KeyNibbles(const common::Buffer &nibbles)
+        : KeyNibbles(nibbles.begin(), nibbles.end()) {}
+
+    KeyNibbles(std::initializer_list<uint8_t> nibbles)
+        : KeyNibbles(nibbles.begin(), nibbles.end()) {}
+
+    /**
+     * Copies the nibbles of the view
+     */
+    explicit KeyNibbles(const KeyNibblesView &view) {
+      bytes_.reserve((view.size() + 1) / 2);
+      if (view.offset_ == 0) {
+        bytes_.insert(
+            bytes_.end(), view.data_, view.data_ + (view.size() + 1) / 2);
+        if (view.size() % 2 == 1) {
+          // keep the unused half of the last byte zero
+          bytes_.back() &= 0xf0u;
+        }
+        size_ = view.size();
+        return;
+      }
+      for (size_t i = 0; i + 1 < view.size(); i += 2) {
+        bytes_.push_back((view[i] << 4u) | view[i + 1]);
+      }
+      if (view.size() % 2 == 1) {
+        bytes_.push_back(view[view.size() - 1] << 4u);
+      }
+      size_ = view.size();
+    }
+
+    /**
+     * @return nibbles of the key, which is just a copy of the key bytes
+     */
+    static KeyNibbles fromBytes(gsl::span<const uint8_t> key) {
+      KeyNibbles nibbles;
+      nibbles.bytes_.assign(key.begin(), key.end());
+      nibbles.size_ = key.size() * 2;
+      return nibbles;
+    }
+
+    /**
+     * Assigns nibbles stored one per byte
+     */
+    KeyNibbles &operator=(const common::Buffer &nibbles) {
+      return *this = KeyNibbles{nibbles};
+    }
+
+    /**
+     * Assigns a copy of the viewed nibbles, which may belong to this key
+     */
+    KeyNibbles &operator=(const KeyNibblesView &view) {
+      return *this = KeyNibbles{view};
+    }
+
+    size_t size() const {
+      return size_;
+    }
+
+    bool empty() const {
+      return size_ == 0;
+    }
+
+    uint8_t operator[](size_t i) const {
+      return KeyNibblesView{*this}[i];
+    }
+
+    /**
+     * @return packed nibbles, the unused half of the last byte of a key of
+     * odd length is zero
+     */
+    const uint8_t *data() const {
+      return bytes_.data();
+    }
+
+    /**
+     * @return view of the nibbles, which is invalidated by any modification
+     * of the key
+     */
+    KeyNibblesView subspan(size_t offset = 0, size_t length = -1) const {
+      return KeyNibblesView{*this}.subspan(offset, length);
+    }
+
+    KeyNibbles &putNibble(uint8_t nibble) {
+      BOOST_ASSERT(nibble <= 0xfu);
+      if (size_ % 2 == 0) {
+        bytes_.push_back(nibble << 4u);
+      } else {
+        bytes_.back() |= nibble & 0xfu;
+      }
+      ++size_;
+      return *this;
+    }
+
+    /**
+     * Appends nibbles, which must not belong to this key
+     */
+    KeyNibbles &put(const KeyNibblesView &nibbles) {
+      size_t i = 0;
+      if (size_ % 2 == 0 and nibbles.offset_ == 0) {
+        // both are aligned to bytes, thus whole bytes are copied
+        auto bytes = nibbles.size() / 2;
+        bytes_.insert(bytes_.end(), nibbles.data_, nibbles.data_ + bytes);
+        size_ += bytes * 2;
+        i = bytes * 2;
+      }
+      for (; i < nibbles.size(); ++i) {
+        putNibble(nibbles[i]);
+      }
+      return *this;
+    }
+
+   private:
+    template <typename It>
+    KeyNibbles(It begin, It end) {
+      bytes_.reserve((std::distance(begin, end) + 1) / 2);
+      std::for_each(begin, end, [this](uint8_t n) { putNibble(n); });
+    }
+
+    boost::container::small_vector<uint8_t, kInlineBytes> bytes_;
+    size_t size_ = 0;
+  };
+
+  inline KeyNibblesView::KeyNibblesView(const KeyNibbles &nibbles)
+      : data_{nibbles.data()}, offset_{0}, size_{nibbles.size()} {}
+
+  inline bool operator==(const KeyNibbles &lhs, const KeyNibbles &rhs) {
+    return KeyNibblesView{lhs} == KeyNibblesView{rhs};
+  }
+
+  inline bool operator!=(const KeyNibbles &lhs, const KeyNibbles &rhs) {
+    return not(lhs == rhs);
+  }
+
+  inline std::ostream &operator<<(std::ostream &os,
+                                  const KeyNibblesView &nibbles) {
+    constexpr auto kDigits = "0123456789abcdef";
+    for (size_t i = 0; i < nibbles.size(); ++i) {
+      os << kDigits[nibbles[i]];
+    }
+    return os;
+  }
+
+  inline std::ostream &operator<<(std::ostream &os,
+                                  const KeyNibbles &nibbles) {
+    return os << KeyNibblesView{nibbles};
+  }
+
+}  // namespace kagome::storage::trie
+
+#endif  // KAGOME_STORAGE_TRIE_KEY_NIBBLES
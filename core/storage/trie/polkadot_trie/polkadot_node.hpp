@@ -11,25 +11,10 @@
 #include "common/blob.hpp"
 #include "common/buffer.hpp"
 #include "storage/trie/node.hpp"
+#include "storage/trie/polkadot_trie/key_nibbles.hpp"
 
 namespace kagome::storage::trie {
 
-  struct KeyNibbles : public common::Buffer {
-    KeyNibbles() = default;
-
-    explicit KeyNibbles(common::Buffer b) : Buffer{std::move(b)} {}
-    KeyNibbles(std::initializer_list<uint8_t> b) : Buffer{b} {}
-
-    KeyNibbles &operator=(common::Buffer b) {
-      Buffer::operator=(std::move(b));
-      return *this;
-    }
-
-    KeyNibbles subspan(size_t offset = 0, size_t length = -1) const {
-      return KeyNibbles{Buffer::subbuffer(offset, length)};
-    }
-  };
-
   /**
    * For specification see
    * https://github.com/w3f/polkadot-re-spec/blob/master/polkadot_re_spec.pdf
@@ -65,6 +50,13 @@ namespace kagome::storage::trie {
 
     KeyNibbles key_nibbles;
     boost::optional<common::Buffer> value;
+
+    /**
+     * Merkle value of the node as of its last encoding. Allows unchanged
+     * subtrees to be skipped when the root hash is recalculated, thus it must
+     * be reset on every modification of the node or of its descendants
+     */
+    boost::optional<common::Buffer> merkle_value;
   };
 
   struct BranchNode : public PolkadotNode {
@@ -44,13 +44,24 @@ namespace kagome::storage::trie {
      * \arg key_nibbles (includes parent's key nibbles)
      */
     virtual outcome::result<NodePtr> getNode(
-        NodePtr parent, const KeyNibbles &key_nibbles) const = 0;
+        NodePtr parent, const KeyNibblesView &key_nibbles) const = 0;
+    /**
+     * Same as getNode() from the root, except that the sought node is not
+     * retrieved from the storage if its merkle value equals
+     * \arg known_merkle_value, as then the node is known to be unchanged
+     * @returns the node, nullptr if there is no such node, or boost::none if
+     * the node is unchanged
+     */
+    virtual outcome::result<boost::optional<NodePtr>> getNodeIfChanged(
+        const KeyNibblesView &key_nibbles,
+        const common::Buffer &known_merkle_value) const = 0;
+
     /**
      * @returns a sequence of nodes in between \arg parent and the node found by
      * following \arg key_nibbles. The parent is included, the end node isn't.
      */
     virtual outcome::result<std::list<std::pair<BranchPtr, uint8_t>>> getPath(
-        NodePtr parent, const KeyNibbles &key_nibbles) const = 0;
+        NodePtr parent, const KeyNibblesView &key_nibbles) const = 0;
 
     virtual std::unique_ptr<PolkadotTrieCursor> trieCursor() = 0;
 
@@ -8,7 +8,6 @@
 #include <spdlog/spdlog.h>
 
 #include "macro/unreachable.hpp"
-#include "common/buffer_back_insert_iterator.hpp"
 #include "storage/trie/polkadot_trie/polkadot_trie.hpp"
 #include "storage/trie/serialization/polkadot_codec.hpp"
 
@@ -28,13 +27,6 @@ OUTCOME_CPP_DEFINE_CATEGORY(kagome::storage::trie,
 
 namespace kagome::storage::trie {
 
-  size_t getCommonLength(gsl::span<const uint8_t> first,
-                         gsl::span<const uint8_t> second) {
-    auto &&[left_nibbles_mismatch, current_nibbles_mismatch] =
-        std::mismatch(first.begin(), first.end(), second.begin(), second.end());
-    return left_nibbles_mismatch - first.begin();
-  }
-
   PolkadotTrieCursorImpl::PolkadotTrieCursorImpl(const PolkadotTrie &trie)
       : trie_{trie}, current_{nullptr} {}
 
@@ -121,24 +113,22 @@ namespace kagome::storage::trie {
     }
     visited_root_ = true;
     auto nibbles = PolkadotCodec::keyToNibbles(key);
-    gsl::span<const uint8_t> left_nibbles(nibbles);
-    BOOST_ASSERT(left_nibbles.size() >= 0);
+    KeyNibblesView left_nibbles{nibbles};
     NodePtr current = trie_.getRoot();
     while (true) {
-      auto [left_mismatch, current_mismatch] =
-          std::mismatch(left_nibbles.begin(),
-                        left_nibbles.end(),
-                        current->key_nibbles.begin(),
-                        current->key_nibbles.end());
+      // index of the first mismatching nibble
+      auto mismatch = left_nibbles.commonPrefixLength(current->key_nibbles);
+      bool left_end = mismatch == left_nibbles.size();
+      bool current_end = mismatch == current->key_nibbles.size();
       // parts of every sequence within their common length (minimum of their
       // lenghts) are equal
-      bool part_equal = left_mismatch == left_nibbles.end()
-                        or current_mismatch == current->key_nibbles.end();
+      bool part_equal = left_end or current_end;
       // if current choice is lexicographically less or equal to the left part
       // of the sought key, we just take the closest node with value
       bool less_or_eq =
-          (part_equal and left_mismatch == left_nibbles.end())
-          or (not part_equal and *left_mismatch < *current_mismatch);
+          (part_equal and left_end)
+          or (not part_equal
+              and left_nibbles[mismatch] < current->key_nibbles[mismatch]);
       if (less_or_eq) {
         switch (current->getTrieType()) {
           case NodeType::BranchEmptyValue:
@@ -158,8 +148,7 @@ namespace kagome::storage::trie {
       // its prefix is equal to the key, then we proceed to a child node that
       // starts with a nibble that is greater of equal to the first nibble of
       // the left part (if there is no such child, proceed to the next case)
-      bool longer = (part_equal and left_mismatch != left_nibbles.end()
-                     and current_mismatch == current->key_nibbles.end());
+      bool longer = (part_equal and not left_end and current_end);
       if (longer) {
         switch (current->getTrieType()) {
           case NodeType::BranchEmptyValue:
@@ -167,7 +156,7 @@ namespace kagome::storage::trie {
             auto current_as_branch =
                 std::dynamic_pointer_cast<BranchNode>(current);
             OUTCOME_TRY(child_idx,
-                        getChildWithMinIdx(current_as_branch, *left_mismatch));
+                        getChildWithMinIdx(current_as_branch, left_nibbles[mismatch]));
             if (child_idx != -1) {
               last_visited_child_.emplace_back(current_as_branch, child_idx);
               OUTCOME_TRY(new_current,
@@ -190,7 +179,9 @@ namespace kagome::storage::trie {
       // lexicographically greater than the current, we must return to its
       // parent and find a child greater than the current one
       bool longer_or_bigger =
-          longer or (not part_equal and *left_mismatch > *current_mismatch);
+          longer
+          or (not part_equal
+              and left_nibbles[mismatch] > current->key_nibbles[mismatch]);
       if (longer_or_bigger) {
         while (not last_visited_child_.empty()) {
           auto [parent, idx] = last_visited_child_.back();
@@ -325,10 +316,7 @@ namespace kagome::storage::trie {
     for (const auto &node_idx : last_visited_child_) {
       const auto &node = node_idx.parent;
       auto idx = node_idx.child_idx;
-      std::copy(node->key_nibbles.begin(),
-                node->key_nibbles.end(),
-                std::back_inserter<Buffer>(key_nibbles));
-      key_nibbles.putUint8(idx);
+      key_nibbles.put(node->key_nibbles).putNibble(idx);
     }
     key_nibbles.put(current_->key_nibbles);
     using Codec = kagome::storage::trie::PolkadotCodec;
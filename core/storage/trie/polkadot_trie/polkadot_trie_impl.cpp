@@ -53,8 +53,10 @@ namespace kagome::storage::trie {
     // insert fetches a sequence of nodes (a path) from the storage and
     // these nodes are processed in memory, so any changes applied to them
     // will be written back to the storage only on storeNode call
-    OUTCOME_TRY(n,
-                insert(root, k_enc, std::make_shared<LeafNode>(k_enc, value)));
+    // the key of the new leaf is assigned on insertion
+    OUTCOME_TRY(
+        n,
+        insert(root, k_enc, std::make_shared<LeafNode>(KeyNibbles{}, value)));
     root_ = n;
 
     return outcome::success();
@@ -73,12 +75,13 @@ namespace kagome::storage::trie {
   }
 
   outcome::result<PolkadotTrie::NodePtr> PolkadotTrieImpl::insert(
-      const NodePtr &parent, const KeyNibbles &key_nibbles, NodePtr node) {
+      const NodePtr &parent, const KeyNibblesView &key_nibbles, NodePtr node) {
     using T = PolkadotNode::Type;
 
     // just update the node key and return it as the new root
     if (parent == nullptr) {
       node->key_nibbles = key_nibbles;
+      node->merkle_value.reset();
       return node;
     }
 
@@ -99,8 +102,7 @@ namespace kagome::storage::trie {
           return node;
         }
 
-        br->key_nibbles = key_nibbles.subbuffer(0, length);
-        auto parentKey = parent->key_nibbles;
+        br->key_nibbles = key_nibbles.subspan(0, length);
 
         // value goes at this branch
         if (key_nibbles.size() == length) {
@@ -109,14 +111,16 @@ namespace kagome::storage::trie {
           // if we are not replacing previous leaf, then add it as a
           // child to the new branch
           if (parent->key_nibbles.size() > key_nibbles.size()) {
-            parent->key_nibbles = parent->key_nibbles.subbuffer(length + 1);
-            br->children.at(parentKey[length]) = parent;
+            auto parent_idx = parent->key_nibbles[length];
+            parent->key_nibbles = parent->key_nibbles.subspan(length + 1);
+            parent->merkle_value.reset();
+            br->children.at(parent_idx) = parent;
           }
 
           return br;
         }
 
-        node->key_nibbles = key_nibbles.subbuffer(length + 1);
+        node->key_nibbles = key_nibbles.subspan(length + 1);
 
         if (length == parent->key_nibbles.size()) {
           // if leaf's key is covered by this branch, then make the leaf's
@@ -126,8 +130,10 @@ namespace kagome::storage::trie {
         } else {
           // otherwise, make the leaf a child of the branch and update its
           // partial key
-          parent->key_nibbles = parent->key_nibbles.subbuffer(length + 1);
-          br->children.at(parentKey[length]) = parent;
+          auto parent_idx = parent->key_nibbles[length];
+          parent->key_nibbles = parent->key_nibbles.subspan(length + 1);
+          parent->merkle_value.reset();
+          br->children.at(parent_idx) = parent;
           br->children.at(key_nibbles[length]) = node;
         }
 
@@ -139,10 +145,12 @@ namespace kagome::storage::trie {
   }
 
   outcome::result<PolkadotTrie::NodePtr> PolkadotTrieImpl::updateBranch(
-      BranchPtr parent, const KeyNibbles &key_nibbles, const NodePtr &node) {
+      BranchPtr parent, const KeyNibblesView &key_nibbles, const NodePtr &node) {
     auto length = getCommonPrefixLength(key_nibbles, parent->key_nibbles);
 
     if (length == parent->key_nibbles.size()) {
+      // the parent is modified in any case below
+      parent->merkle_value.reset();
       // just set the value in the parent to the node value
       if (key_nibbles == parent->key_nibbles) {
         parent->value = node->value;
@@ -154,11 +162,12 @@ namespace kagome::storage::trie {
         parent->children.at(key_nibbles[length]) = n;
         return parent;
       }
-      node->key_nibbles = key_nibbles.subbuffer(length + 1);
+      node->key_nibbles = key_nibbles.subspan(length + 1);
       parent->children.at(key_nibbles[length]) = node;
       return parent;
     }
-    auto br = std::make_shared<BranchNode>(key_nibbles.subspan(0, length));
+    auto br =
+        std::make_shared<BranchNode>(KeyNibbles{key_nibbles.subspan(0, length)});
     auto parentIdx = parent->key_nibbles[length];
     OUTCOME_TRY(
         new_branch,
@@ -188,7 +197,7 @@ namespace kagome::storage::trie {
   }
 
   outcome::result<PolkadotTrie::NodePtr> PolkadotTrieImpl::getNode(
-      NodePtr parent, const KeyNibbles &key_nibbles) const {
+      NodePtr parent, const KeyNibblesView &key_nibbles) const {
     using T = PolkadotNode::Type;
     if (parent == nullptr) {
       return nullptr;
@@ -218,9 +227,65 @@ namespace kagome::storage::trie {
     return nullptr;
   }
 
+  outcome::result<boost::optional<PolkadotTrie::NodePtr>>
+  PolkadotTrieImpl::getNodeIfChanged(
+      const KeyNibblesView &key_nibbles,
+      const common::Buffer &known_merkle_value) const {
+    using T = PolkadotNode::Type;
+    auto is_known = [&known_merkle_value](const PolkadotNode &node) {
+      if (known_merkle_value.empty()) {
+        return false;
+      }
+      if (node.isDummy()) {
+        return static_cast<const DummyNode &>(node).db_key
+               == known_merkle_value;
+      }
+      return node.merkle_value == known_merkle_value;
+    };
+    auto node = root_;
+    auto nibbles = key_nibbles;
+    while (node != nullptr) {
+      if (is_known(*node)) {
+        return boost::none;
+      }
+      switch (node->getTrieType()) {
+        case T::BranchEmptyValue:
+        case T::BranchWithValue: {
+          if (node->key_nibbles == nibbles or nibbles.empty()) {
+            return node;
+          }
+          if (nibbles.size() < node->key_nibbles.size()) {
+            return NodePtr{};
+          }
+          auto branch = std::dynamic_pointer_cast<BranchNode>(node);
+          auto length = getCommonPrefixLength(node->key_nibbles, nibbles);
+          auto idx = nibbles[length];
+          // checked before the retrieval, which is what is saved for an
+          // unchanged node
+          if (branch->children.at(idx) != nullptr
+              and is_known(*branch->children.at(idx))) {
+            return boost::none;
+          }
+          OUTCOME_TRY(child, retrieveChild(branch, idx));
+          node = std::move(child);
+          nibbles = nibbles.subspan(length + 1);
+          break;
+        }
+        case T::Leaf:
+          if (node->key_nibbles == nibbles) {
+            return node;
+          }
+          return NodePtr{};
+        case T::Special:
+          return Error::INVALID_NODE_TYPE;
+      }
+    }
+    return NodePtr{};
+  }
+
   outcome::result<std::list<std::pair<PolkadotTrieImpl::BranchPtr, uint8_t>>>
   PolkadotTrieImpl::getPath(NodePtr parent,
-                            const KeyNibbles &key_nibbles) const {
+                            const KeyNibblesView &key_nibbles) const {
     using Path = std::list<std::pair<PolkadotTrieImpl::BranchPtr, uint8_t>>;
     using T = PolkadotNode::Type;
     if (parent == nullptr) {
@@ -233,9 +298,8 @@ namespace kagome::storage::trie {
         if (parent->key_nibbles == key_nibbles or key_nibbles.empty()) {
           return Path{};
         }
-        auto common_nibbles =
-            gsl::make_span(parent->key_nibbles.data(), length);
-        if (key_nibbles == common_nibbles
+        // the sought key is a prefix of the parent's one
+        if (key_nibbles.size() == length
             and key_nibbles.size() < parent->key_nibbles.size()) {
           return Path{};
         }
@@ -288,7 +352,7 @@ namespace kagome::storage::trie {
   }
 
   outcome::result<PolkadotTrie::NodePtr> PolkadotTrieImpl::deleteNode(
-      NodePtr parent, const KeyNibbles &key_nibbles) {
+      NodePtr parent, const KeyNibblesView &key_nibbles) {
     if (parent == nullptr) {
       return nullptr;
     }
@@ -299,6 +363,7 @@ namespace kagome::storage::trie {
       case T::BranchEmptyValue: {
         auto length = getCommonPrefixLength(parent->key_nibbles, key_nibbles);
         auto parent_as_branch = std::dynamic_pointer_cast<BranchNode>(parent);
+        parent->merkle_value.reset();
         if (parent->key_nibbles == key_nibbles or key_nibbles.empty()) {
           parent->value = boost::none;
           newRoot = parent;
@@ -323,14 +388,14 @@ namespace kagome::storage::trie {
   }
 
   outcome::result<PolkadotTrie::NodePtr> PolkadotTrieImpl::handleDeletion(
-      const BranchPtr &parent, NodePtr node, const KeyNibbles &key_nibbles) {
+      const BranchPtr &parent, NodePtr node, const KeyNibblesView &key_nibbles) {
     auto newRoot = std::move(node);
     auto length = getCommonPrefixLength(key_nibbles, parent->key_nibbles);
     auto bitmap = parent->childrenBitmap();
     // turn branch node left with no children to a leaf node
     if (bitmap == 0 and parent->value) {
-      newRoot = std::make_shared<LeafNode>(key_nibbles.subspan(0, length),
-                                           parent->value);
+      newRoot = std::make_shared<LeafNode>(
+          KeyNibbles{key_nibbles.subspan(0, length)}, parent->value);
     } else if (parent->childrenNum() == 1 && !parent->value) {
       size_t idx = 0;
       for (idx = 0; idx < 16; idx++) {
@@ -343,15 +408,15 @@ namespace kagome::storage::trie {
       using T = PolkadotNode::Type;
       if (child->getTrieType() == T::Leaf) {
         auto newKey = parent->key_nibbles;
-        newKey.putUint8(idx);
-        newKey.putBuffer(child->key_nibbles);
+        newKey.putNibble(idx);
+        newKey.put(child->key_nibbles);
         newRoot = std::make_shared<LeafNode>(newKey, child->value);
       } else if (child->getTrieType() == T::BranchEmptyValue
                  or child->getTrieType() == T::BranchWithValue) {
         auto branch = std::make_shared<BranchNode>();
-        branch->key_nibbles.putBuffer(parent->key_nibbles)
-            .putUint8(idx)
-            .putBuffer(child->key_nibbles);
+        branch->key_nibbles.put(parent->key_nibbles)
+            .putNibble(idx)
+            .put(child->key_nibbles);
         auto child_as_branch = std::dynamic_pointer_cast<BranchNode>(child);
         for (size_t i = 0; i < child_as_branch->children.size(); i++) {
           if (child_as_branch->children.at(i)) {
@@ -366,26 +431,20 @@ namespace kagome::storage::trie {
   }
 
   outcome::result<PolkadotTrie::NodePtr> PolkadotTrieImpl::detachNode(
-      const NodePtr &parent, const KeyNibbles &prefix_nibbles) {
+      const NodePtr &parent, const KeyNibblesView &prefix_nibbles) {
     if (parent == nullptr) {
       return nullptr;
     }
     if (parent->key_nibbles.size() >= prefix_nibbles.size()) {
       // if this is the node to be detached -- detach it
-      bool prefix_equal = std::equal(prefix_nibbles.begin(),
-                                     prefix_nibbles.end(),
-                                     parent->key_nibbles.begin());
-      if (prefix_equal) {
+      if (KeyNibblesView{parent->key_nibbles}.startsWith(prefix_nibbles)) {
         return nullptr;
       }
       return parent;
     }
     // if parent's key is smaller and it is not a prefix of the prefix, don't
     // change anything
-    bool prefix_equal = std::equal(parent->key_nibbles.begin(),
-                                   parent->key_nibbles.end(),
-                                   prefix_nibbles.begin());
-    if (not prefix_equal) {
+    if (not prefix_nibbles.startsWith(parent->key_nibbles)) {
       return parent;
     }
     using T = PolkadotNode::Type;
@@ -399,7 +458,11 @@ namespace kagome::storage::trie {
       }
       OUTCOME_TRY(n, detachNode(child, prefix_nibbles.subspan(length + 1)));
       branch->children.at(prefix_nibbles[length]) = n;
-      return branch;
+      branch->merkle_value.reset();
+      // a branch left with a single child and no value is merged with it, as
+      // on removal of an entry
+      OUTCOME_TRY(merged, handleDeletion(branch, branch, branch->key_nibbles));
+      return std::move(merged);
     }
     return parent;
   }
@@ -410,10 +473,8 @@ namespace kagome::storage::trie {
   }
 
   uint32_t PolkadotTrieImpl::getCommonPrefixLength(
-      const KeyNibbles &first, const KeyNibbles &second) const {
-    auto &&[it1, it2] =
-        std::mismatch(first.begin(), first.end(), second.begin(), second.end());
-    return it1 - first.begin();
+      const KeyNibblesView &first, const KeyNibblesView &second) const {
+    return first.commonPrefixLength(second);
   }
 
 }  // namespace kagome::storage::trie
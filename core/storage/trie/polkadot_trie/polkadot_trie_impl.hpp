@@ -42,10 +42,14 @@ namespace kagome::storage::trie {
     NodePtr getRoot() const override;
 
     outcome::result<NodePtr> getNode(
-        NodePtr parent, const KeyNibbles &key_nibbles) const override;
+        NodePtr parent, const KeyNibblesView &key_nibbles) const override;
+
+    outcome::result<boost::optional<NodePtr>> getNodeIfChanged(
+        const KeyNibblesView &key_nibbles,
+        const common::Buffer &known_merkle_value) const override;
 
     outcome::result<std::list<std::pair<BranchPtr, uint8_t>>> getPath(
-        NodePtr parent, const KeyNibbles &key_nibbles) const override;
+        NodePtr parent, const KeyNibblesView &key_nibbles) const override;
 
     /**
      * Remove all entries, which key starts with the prefix
@@ -72,24 +76,24 @@ namespace kagome::storage::trie {
 
    private:
     outcome::result<NodePtr> insert(const NodePtr &parent,
-                                    const KeyNibbles &key_nibbles,
+                                    const KeyNibblesView &key_nibbles,
                                     NodePtr node);
 
     outcome::result<NodePtr> updateBranch(BranchPtr parent,
-                                          const KeyNibbles &key_nibbles,
+                                          const KeyNibblesView &key_nibbles,
                                           const NodePtr &node);
 
     outcome::result<NodePtr> deleteNode(NodePtr parent,
-                                        const KeyNibbles &key_nibbles);
+                                        const KeyNibblesView &key_nibbles);
     outcome::result<NodePtr> handleDeletion(const BranchPtr &parent,
                                             NodePtr node,
-                                            const KeyNibbles &key_nibbles);
+                                            const KeyNibblesView &key_nibbles);
     // remove a node with its children
     outcome::result<NodePtr> detachNode(const NodePtr &parent,
-                                        const KeyNibbles &prefix_nibbles);
+                                        const KeyNibblesView &prefix_nibbles);
 
-    uint32_t getCommonPrefixLength(const KeyNibbles &pref1,
-                                   const KeyNibbles &pref2) const;
+    uint32_t getCommonPrefixLength(const KeyNibblesView &pref1,
+                                   const KeyNibblesView &pref2) const;
 
     outcome::result<NodePtr> retrieveChild(BranchPtr parent,
                                            uint8_t idx) const override;
@@ -7,10 +7,8 @@
 #define KAGOME_ORDERED_TRIE_HASH_HPP
 
 #include "common/buffer.hpp"
-#include "crypto/hasher.hpp"
 #include "scale/scale.hpp"
-#include "storage/trie/polkadot_trie/polkadot_trie_impl.hpp"
-#include "storage/trie/serialization/polkadot_codec.hpp"
+#include "storage/trie/serialization/trie_root_builder.hpp"
 
 namespace kagome::storage::trie {
 
@@ -18,32 +16,33 @@ namespace kagome::storage::trie {
    * Calculates the hash of a Merkle tree containing the items from the provided
    * range [begin; end) as values and compact-encoded indices of those
    * values(starting from 0) as keys
-   * @tparam It an iterator type of a container of common::Buffers
+   * @tparam It an iterator type of a container of byte containers, like
+   * common::Buffers or spans of bytes
    * @return the Merkle tree root hash of the tree containing provided values
    */
   template <typename It>
   outcome::result<common::Buffer> calculateOrderedTrieHash(const It &begin,
                                                            const It &end) {
-    PolkadotTrieImpl trie;
-    PolkadotCodec codec;
-    // empty root
-    if (begin == end) {
-      static const auto empty_root = common::Buffer{}.put(codec.hash256({0}));
-      return empty_root;
+    // the keys are encoded to a single buffer, which is not reallocated after
+    // the builder gets spans of it
+    common::Buffer keys;
+    std::vector<size_t> key_ends;
+    for (auto it = begin; it != end; it++) {
+      OUTCOME_TRY(key, scale::encode(scale::CompactInteger{key_ends.size()}));
+      keys.put(key);
+      key_ends.push_back(keys.size());
     }
-    // clang-format off
-    static_assert(
-        std::is_same_v<std::decay_t<decltype(*begin)>, common::Buffer>);
-    // clang-format on
-    It it = begin;
-    scale::CompactInteger key = 0;
-    while (it != end) {
-      OUTCOME_TRY(enc, scale::encode(key++));
-      OUTCOME_TRY(trie.put(common::Buffer{enc}, *it));
-      it++;
+
+    TrieRootBuilder builder;
+    size_t key_begin = 0;
+    auto key_end = key_ends.begin();
+    for (auto it = begin; it != end; it++, key_end++) {
+      builder.add(gsl::make_span(keys).subspan(key_begin, *key_end - key_begin),
+                  *it);
+      key_begin = *key_end;
     }
-    OUTCOME_TRY(enc, codec.encodeNode(*trie.getRoot()));
-    return common::Buffer{codec.hash256(enc)};
+    OUTCOME_TRY(root, builder.calculateRoot());
+    return common::Buffer{root};
   }
 
 }  // namespace kagome::storage::trie
@@ -43,38 +43,22 @@ namespace kagome::storage::trie {
   }
 
   common::Buffer PolkadotCodec::nibblesToKey(const KeyNibbles &nibbles) {
-    Buffer res;
     if (nibbles.size() % 2 == 0) {
-      res = Buffer(nibbles.size() / 2, 0);
-      for (size_t i = 0; i < nibbles.size(); i += 2) {
-        res[i / 2] = byteFromNibbles(nibbles[i], nibbles[i + 1]);
-      }
-    } else {
-      res = Buffer(nibbles.size() / 2 + 1, 0);
-      res[0] = nibbles[0];
-      for (size_t i = 2; i < nibbles.size(); i += 2) {
-        res[i / 2] = byteFromNibbles(nibbles[i - 1], nibbles[i]);
-      }
+      // packed nibbles of even length are the key itself
+      return Buffer(nibbles.data(), nibbles.data() + nibbles.size() / 2);
+    }
+    // the first nibble of an odd length key takes a whole byte, so the rest
+    // of them are shifted by a nibble
+    Buffer res(nibbles.size() / 2 + 1, 0);
+    res[0] = nibbles[0];
+    for (size_t i = 2; i < nibbles.size(); i += 2) {
+      res[i / 2] = byteFromNibbles(nibbles[i - 1], nibbles[i]);
     }
     return res;
   }
 
   KeyNibbles PolkadotCodec::keyToNibbles(const common::Buffer &key) {
-    if (key.empty()) {
-      return {};
-    }
-    if (key.size() == 1 && key[0] == 0) {
-      return KeyNibbles{common::Buffer{0, 0}};
-    }
-
-    auto l = key.size() * 2;
-    KeyNibbles res(common::Buffer(l, 0));
-    for (size_t i = 0; i < key.size(); i++) {
-      res[2 * i] = key[i] >> 4u;
-      res[2 * i + 1] = key[i] & 0xfu;
-    }
-
-    return res;
+    return KeyNibbles::fromBytes(key);
   }
 
   common::Buffer PolkadotCodec::merkleValue(const common::Buffer &buf) const {
@@ -117,17 +101,23 @@ namespace kagome::storage::trie {
 
   outcome::result<common::Buffer> PolkadotCodec::encodeHeader(
       const PolkadotNode &node) const {
-    if (node.key_nibbles.size() > 0xffffu) {
+    return encodeHeader(static_cast<PolkadotNode::Type>(node.getType()),
+                        node.key_nibbles.size());
+  }
+
+  outcome::result<common::Buffer> PolkadotCodec::encodeHeader(
+      PolkadotNode::Type type, size_t partial_key_nibbles) const {
+    if (partial_key_nibbles > 0xffffu) {
       return Error::TOO_MANY_NIBBLES;
     }
 
     uint8_t head = 0;
     // set bits 6..7
-    switch (static_cast<PolkadotNode::Type>(node.getType())) {
+    switch (type) {
       case PolkadotNode::Type::BranchEmptyValue:
       case PolkadotNode::Type::BranchWithValue:
       case PolkadotNode::Type::Leaf:
-        head = node.getType();
+        head = static_cast<uint8_t>(type);
         break;
       default:
         return Error::UNKNOWN_NODE_TYPE;
@@ -136,15 +126,15 @@ namespace kagome::storage::trie {
     head <<= 6u;  // head_{6..7} * 64
 
     // set bits 0..5, partial key length
-    if (node.key_nibbles.size() < 63u) {
-      head |= uint8_t(node.key_nibbles.size());
+    if (partial_key_nibbles < 63u) {
+      head |= uint8_t(partial_key_nibbles);
       return Buffer{head};  // header contains 1 byte
     }
     // if partial key length is greater than 62, then the rest of the length is
     // stored in consequent bytes
     head += 63u;
 
-    size_t l = node.key_nibbles.size() - 63u;
+    size_t l = partial_key_nibbles - 63u;
     Buffer out(1u +             /// 1 byte head
                    l / 0xffu +  /// number of 255 in l
                    1u,          /// for last byte
@@ -184,6 +174,10 @@ namespace kagome::storage::trie {
               std::dynamic_pointer_cast<DummyNode>(child)->db_key;
           OUTCOME_TRY(scale_enc, scale::encode(std::move(merkle_value)));
           encoding.put(scale_enc);
+        } else if (child->merkle_value) {
+          // the child is unchanged since it was last encoded
+          OUTCOME_TRY(scale_enc, scale::encode(child->merkle_value.value()));
+          encoding.put(scale_enc);
         } else {
           OUTCOME_TRY(enc, encodeNode(*child));
           OUTCOME_TRY(scale_enc, scale::encode(merkleValue(enc)));
@@ -211,7 +205,7 @@ namespace kagome::storage::trie {
   }
 
   outcome::result<std::shared_ptr<Node>> PolkadotCodec::decodeNode(
-      const common::Buffer &encoded_data) const {
+      gsl::span<const uint8_t> encoded_data) const {
     BufferStream stream{encoded_data};
     // decode the header with the node type and the partial key length
     OUTCOME_TRY(header, decodeHeader(stream));
@@ -274,11 +268,10 @@ namespace kagome::storage::trie {
       }
       partial_key.putUint8(stream.next());
     }
-    // array of nibbles is much more convenient than array of bytes, though it
-    // wastes some memory
-    KeyNibbles partial_key_nibbles = keyToNibbles(partial_key);
+    auto partial_key_nibbles = keyToNibbles(partial_key);
     if (nibbles_num % 2 == 1) {
-      partial_key_nibbles = partial_key_nibbles.subbuffer(1);
+      // the first nibble of an odd length key is padded to a whole byte
+      return KeyNibbles{partial_key_nibbles.subspan(1)};
     }
     return partial_key_nibbles;
   }
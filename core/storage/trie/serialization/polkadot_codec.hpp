@@ -33,7 +33,7 @@ namespace kagome::storage::trie {
     outcome::result<Buffer> encodeNode(const Node &node) const override;
 
     outcome::result<std::shared_ptr<Node>> decodeNode(
-        const common::Buffer &encoded_data) const override;
+        gsl::span<const uint8_t> encoded_data) const override;
 
     common::Buffer merkleValue(const Buffer &buf) const override;
 
@@ -41,7 +41,8 @@ namespace kagome::storage::trie {
 
     /**
      * Def. 14 KeyEncode
-     * Splits a key to an array of nibbles (a nibble is a half of a byte)
+     * Splits a key to an array of nibbles (a nibble is a half of a byte).
+     * As nibbles are stored packed, it is a mere copy of the key
      */
     static KeyNibbles keyToNibbles(const Buffer &key);
 
@@ -56,6 +57,13 @@ namespace kagome::storage::trie {
      */
     outcome::result<Buffer> encodeHeader(const PolkadotNode &node) const;
 
+    /**
+     * Encodes a header of a node of the type with a partial key of the length
+     * @see Algorithm 3: partial key length encoding
+     */
+    outcome::result<Buffer> encodeHeader(PolkadotNode::Type type,
+                                         size_t partial_key_nibbles) const;
+
    private:
     outcome::result<Buffer> encodeBranch(const BranchNode &node) const;
     outcome::result<Buffer> encodeLeaf(const LeafNode &node) const;
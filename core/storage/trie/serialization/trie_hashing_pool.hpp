@@ -0,0 +1,44 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_TRIE_SERIALIZATION_TRIE_HASHING_POOL
+#define KAGOME_STORAGE_TRIE_SERIALIZATION_TRIE_HASHING_POOL
+
+#include "common/thread_pool.hpp"
+
+namespace kagome::storage::trie {
+
+  /**
+   * Worker threads, which encode and hash independent subtrees of a trie in
+   * parallel when the trie is stored
+   */
+  class TrieHashingPool : public common::ThreadPool {
+   public:
+    /**
+     * Below this number of nodes to be written a trie is stored in the
+     * calling thread, as the synchronization would cost more than it saves
+     */
+    static constexpr size_t kDefaultThreshold = 1024;
+
+    /**
+     * @param threads number of worker threads
+     * @param threshold minimal number of nodes to be written to store a trie
+     * in parallel
+     */
+    explicit TrieHashingPool(size_t threads,
+                             size_t threshold = kDefaultThreshold)
+        : ThreadPool{threads}, threshold_{threshold} {}
+
+    size_t threshold() const {
+      return threshold_;
+    }
+
+   private:
+    size_t threshold_;
+  };
+
+}  // namespace kagome::storage::trie
+
+#endif  // KAGOME_STORAGE_TRIE_SERIALIZATION_TRIE_HASHING_POOL
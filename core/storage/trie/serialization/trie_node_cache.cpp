@@ -0,0 +1,97 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/serialization/trie_node_cache.hpp"
+
+#include <boost/assert.hpp>
+
+namespace kagome::storage::trie {
+
+  TrieNodeCache::TrieNodeCache(size_t capacity) : capacity_{capacity} {
+    BOOST_ASSERT(capacity_ > 0);
+  }
+
+  std::shared_ptr<PolkadotNode> TrieNodeCache::get(
+      const common::Buffer &db_key) {
+    std::shared_ptr<const PolkadotNode> node;
+    {
+      std::lock_guard lock{mutex_};
+      auto it = index_.find(db_key);
+      if (it == index_.end()) {
+        misses_++;
+        return nullptr;
+      }
+      // move the entry to the front as the most recently used one
+      lru_.splice(lru_.begin(), lru_, it->second);
+      node = it->second->second;
+    }
+    hits_++;
+    // the cached instance is immutable, so it can be copied without the lock
+    return copyNode(*node);
+  }
+
+  void TrieNodeCache::put(const common::Buffer &db_key,
+                          const PolkadotNode &node) {
+    auto copy = copyNode(node);
+    if (copy == nullptr) {
+      return;
+    }
+    std::lock_guard lock{mutex_};
+    if (auto it = index_.find(db_key); it != index_.end()) {
+      // nodes are content-addressed, so the cached one is the same
+      lru_.splice(lru_.begin(), lru_, it->second);
+      return;
+    }
+    lru_.emplace_front(db_key, std::move(copy));
+    index_.emplace(db_key, lru_.begin());
+    while (lru_.size() > capacity_) {
+      index_.erase(lru_.back().first);
+      lru_.pop_back();
+      evictions_++;
+    }
+  }
+
+  void TrieNodeCache::clear() {
+    std::lock_guard lock{mutex_};
+    index_.clear();
+    lru_.clear();
+  }
+
+  TrieNodeCache::Stats TrieNodeCache::getStats() const {
+    size_t size;
+    {
+      std::lock_guard lock{mutex_};
+      size = lru_.size();
+    }
+    return Stats{hits_.load(), misses_.load(), evictions_.load(), size};
+  }
+
+  std::shared_ptr<PolkadotNode> TrieNodeCache::copyNode(
+      const PolkadotNode &node) {
+    using T = PolkadotNode::Type;
+    switch (node.getTrieType()) {
+      case T::BranchEmptyValue:
+      case T::BranchWithValue: {
+        const auto &branch = static_cast<const BranchNode &>(node);
+        auto copy = std::make_shared<BranchNode>(branch.key_nibbles,
+                                                 branch.value);
+        for (size_t i = 0; i < branch.children.size(); i++) {
+          const auto &child = branch.children.at(i);
+          // dummy nodes are never modified in place, so they can be shared
+          BOOST_ASSERT(child == nullptr or child->isDummy());
+          copy->children.at(i) = child;
+        }
+        return copy;
+      }
+      case T::Leaf:
+        return std::make_shared<LeafNode>(node.key_nibbles, node.value);
+      case T::Special:
+        // a dummy node carries no data worth caching
+        break;
+    }
+    return nullptr;
+  }
+
+}  // namespace kagome::storage::trie
@@ -0,0 +1,81 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_TRIE_SERIALIZATION_TRIE_NODE_CACHE_HPP
+#define KAGOME_STORAGE_TRIE_SERIALIZATION_TRIE_NODE_CACHE_HPP
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include "common/buffer.hpp"
+#include "storage/trie/polkadot_trie/polkadot_node.hpp"
+
+namespace kagome::storage::trie {
+
+  /**
+   * Bounded LRU cache of decoded trie nodes, keyed by their merkle value
+   * (which is the key of a node in the trie storage backend). Shared by all
+   * batches of a trie storage, so that hot parts of the state are not read
+   * from the database and decoded again for every batch.
+   * Nodes become mutable once they are a part of a trie, thus the cache owns
+   * its instances and hands out copies of them.
+   */
+  class TrieNodeCache {
+   public:
+    static constexpr size_t kDefaultCapacity = 65536;
+
+    struct Stats {
+      uint64_t hits;
+      uint64_t misses;
+      uint64_t evictions;
+      size_t size;
+    };
+
+    explicit TrieNodeCache(size_t capacity = kDefaultCapacity);
+
+    /**
+     * @return a copy of a node stored under {@param db_key} or nullptr if it
+     * is not cached
+     */
+    std::shared_ptr<PolkadotNode> get(const common::Buffer &db_key);
+
+    /**
+     * Caches a copy of {@param node} under {@param db_key}, evicting the least
+     * recently used node if the capacity is exceeded. Children of a branch
+     * node must be dummy nodes, as only such nodes are independent of the
+     * trie they are taken from
+     */
+    void put(const common::Buffer &db_key, const PolkadotNode &node);
+
+    void clear();
+
+    Stats getStats() const;
+
+    size_t capacity() const {
+      return capacity_;
+    }
+
+   private:
+    using Entry = std::pair<common::Buffer, std::shared_ptr<const PolkadotNode>>;
+    using LruList = std::list<Entry>;
+
+    static std::shared_ptr<PolkadotNode> copyNode(const PolkadotNode &node);
+
+    const size_t capacity_;
+
+    mutable std::mutex mutex_;
+    LruList lru_;
+    std::unordered_map<common::Buffer, LruList::iterator> index_;
+
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> evictions_{0};
+  };
+
+}  // namespace kagome::storage::trie
+
+#endif  // KAGOME_STORAGE_TRIE_SERIALIZATION_TRIE_NODE_CACHE_HPP
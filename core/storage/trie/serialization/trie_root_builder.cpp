@@ -0,0 +1,133 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/serialization/trie_root_builder.hpp"
+
+#include <algorithm>
+
+#include "scale/scale.hpp"
+
+namespace kagome::storage::trie {
+
+  namespace {
+    bool less(gsl::span<const uint8_t> lhs, gsl::span<const uint8_t> rhs) {
+      return std::lexicographical_compare(
+          lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    size_t nibblesNum(gsl::span<const uint8_t> key) {
+      return key.size() * 2;
+    }
+
+    uint8_t nibbleAt(gsl::span<const uint8_t> key, size_t i) {
+      return i % 2 == 0 ? key[i / 2] >> 4u : key[i / 2] & 0xfu;
+    }
+
+    /**
+     * Puts the nibbles [begin; end) of the key, packed as
+     * PolkadotCodec::nibblesToKey does
+     */
+    void putNibbles(common::Buffer &out,
+                    gsl::span<const uint8_t> key,
+                    size_t begin,
+                    size_t end) {
+      if ((end - begin) % 2 != 0) {
+        out.putUint8(nibbleAt(key, begin++));
+      }
+      for (auto i = begin; i < end; i += 2) {
+        out.putUint8(nibbleAt(key, i) << 4u | nibbleAt(key, i + 1));
+      }
+    }
+
+    /**
+     * Puts the bytes scale encoded as a vector
+     */
+    void putEncoded(common::Buffer &out, gsl::span<const uint8_t> bytes) {
+      out.put(scale::encode(scale::CompactInteger{bytes.size()}).value());
+      out.put(bytes);
+    }
+  }  // namespace
+
+  void TrieRootBuilder::add(gsl::span<const uint8_t> key,
+                            gsl::span<const uint8_t> value) {
+    sorted_ = sorted_ and (entries_.empty() or less(entries_.back().first, key));
+    entries_.emplace_back(key, value);
+  }
+
+  outcome::result<common::Hash256> TrieRootBuilder::calculateRoot() {
+    if (not sorted_) {
+      std::stable_sort(
+          entries_.begin(), entries_.end(), [](auto &lhs, auto &rhs) {
+            return less(lhs.first, rhs.first);
+          });
+      // the last of the entries with the same key takes place of the others
+      auto end = std::unique(
+          entries_.rbegin(), entries_.rend(), [](auto &lhs, auto &rhs) {
+            return not less(lhs.first, rhs.first)
+                   and not less(rhs.first, lhs.first);
+          });
+      entries_.erase(entries_.begin(), end.base());
+      sorted_ = true;
+    }
+    if (entries_.empty()) {
+      return codec_.hash256({0});
+    }
+    OUTCOME_TRY(encoded_root, encodeNode(entries_, 0));
+    return codec_.hash256(encoded_root);
+  }
+
+  outcome::result<common::Buffer> TrieRootBuilder::encodeNode(
+      gsl::span<const Entry> entries, size_t depth) const {
+    auto &[first_key, first_value] = entries[0];
+    if (entries.size() == 1) {
+      OUTCOME_TRY(encoding,
+                  codec_.encodeHeader(PolkadotNode::Type::Leaf,
+                                      nibblesNum(first_key) - depth));
+      putNibbles(encoding, first_key, depth, nibblesNum(first_key));
+      putEncoded(encoding, first_value);
+      return std::move(encoding);
+    }
+
+    // the common prefix of the first and the last keys is the one of all the
+    // keys, as they are sorted
+    auto &last_key = entries[entries.size() - 1].first;
+    auto end = depth;
+    while (end < nibblesNum(first_key) and end < nibblesNum(last_key)
+           and nibbleAt(first_key, end) == nibbleAt(last_key, end)) {
+      end++;
+    }
+    // the key, which is the common prefix, is the first one
+    bool has_value = nibblesNum(first_key) == end;
+    auto children = has_value ? entries.subspan(1) : entries;
+
+    uint16_t children_bitmap = 0;
+    common::Buffer encoded_children;
+    for (size_t begin = 0, next = 0; begin < children.size(); begin = next) {
+      auto index = nibbleAt(children[begin].first, end);
+      while (next < children.size()
+             and nibbleAt(children[next].first, end) == index) {
+        next++;
+      }
+      OUTCOME_TRY(child,
+                  encodeNode(children.subspan(begin, next - begin), end + 1));
+      children_bitmap |= 1u << index;
+      putEncoded(encoded_children, codec_.merkleValue(child));
+    }
+
+    OUTCOME_TRY(encoding,
+                codec_.encodeHeader(has_value
+                                        ? PolkadotNode::Type::BranchWithValue
+                                        : PolkadotNode::Type::BranchEmptyValue,
+                                    end - depth));
+    putNibbles(encoding, first_key, depth, end);
+    encoding.putUint8(children_bitmap & 0xffu).putUint8(children_bitmap >> 8u);
+    if (has_value) {
+      putEncoded(encoding, first_value);
+    }
+    encoding.put(encoded_children);
+    return std::move(encoding);
+  }
+
+}  // namespace kagome::storage::trie
@@ -0,0 +1,59 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_TRIE_SERIALIZATION_TRIE_ROOT_BUILDER
+#define KAGOME_STORAGE_TRIE_SERIALIZATION_TRIE_ROOT_BUILDER
+
+#include <vector>
+
+#include <gsl/span>
+
+#include "common/blob.hpp"
+#include "common/buffer.hpp"
+#include "storage/trie/serialization/polkadot_codec.hpp"
+
+namespace kagome::storage::trie {
+
+  /**
+   * Calculates the root hash of a trie with the given entries without
+   * constructing the trie: as the entries are ordered by their keys, the
+   * entries of every subtrie are adjacent, so the nodes are encoded and hashed
+   * bottom-up right from the entries, without node objects or copies of the
+   * values
+   */
+  class TrieRootBuilder {
+   public:
+    /**
+     * Adds an entry, which replaces the entry with the same key added before.
+     * The key and the value are not copied, thus have to stay valid until the
+     * root is calculated
+     */
+    void add(gsl::span<const uint8_t> key, gsl::span<const uint8_t> value);
+
+    /**
+     * @return the root hash of the trie with the added entries. If they were
+     * added in the ascending order of their keys, they are not sorted
+     */
+    outcome::result<common::Hash256> calculateRoot();
+
+   private:
+    using Entry = std::pair<gsl::span<const uint8_t>, gsl::span<const uint8_t>>;
+
+    /**
+     * Encodes the node of a subtrie
+     * @param entries entries of the subtrie, which keys share the first depth
+     * nibbles
+     */
+    outcome::result<common::Buffer> encodeNode(gsl::span<const Entry> entries,
+                                               size_t depth) const;
+
+    PolkadotCodec codec_;
+    std::vector<Entry> entries_;
+    bool sorted_ = true;
+  };
+
+}  // namespace kagome::storage::trie
+
+#endif  // KAGOME_STORAGE_TRIE_SERIALIZATION_TRIE_ROOT_BUILDER
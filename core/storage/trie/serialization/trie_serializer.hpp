@@ -29,6 +29,14 @@ namespace kagome::storage::trie {
      */
     virtual outcome::result<common::Buffer> storeTrie(PolkadotTrie &trie) = 0;
 
+    /**
+     * Calculates the root hash of a trie without writing it to the storage.
+     * Merkle values of unchanged nodes are cached in the nodes, so only
+     * modified paths are re-hashed on subsequent calls
+     */
+    virtual outcome::result<common::Buffer> calculateRootHash(
+        PolkadotTrie &trie) const = 0;
+
     /**
      * Fetches a trie from the storage. A nullptr is returned in case that there
      * is no entry for provided key.
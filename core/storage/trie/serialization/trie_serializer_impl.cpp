@@ -5,15 +5,56 @@
 
 #include "storage/trie/serialization/trie_serializer_impl.hpp"
 
+#include <vector>
+
 namespace kagome::storage::trie {
 
+  namespace {
+    /**
+     * Batch which just accumulates the nodes stored by a worker, so that
+     * they are put to the storage batch afterwards in a definite order
+     */
+    class NodesCollector : public BufferBatch {
+     public:
+      outcome::result<void> put(const Buffer &key,
+                                const Buffer &value) override {
+        nodes.emplace_back(key, value);
+        return outcome::success();
+      }
+
+      outcome::result<void> put(const Buffer &key, Buffer &&value) override {
+        nodes.emplace_back(key, std::move(value));
+        return outcome::success();
+      }
+
+      outcome::result<void> remove(const Buffer &key) override {
+        // nodes are never removed while a trie is stored
+        return std::errc::not_supported;
+      }
+
+      outcome::result<void> commit() override {
+        return std::errc::not_supported;
+      }
+
+      void clear() override {
+        nodes.clear();
+      }
+
+      std::vector<std::pair<Buffer, Buffer>> nodes;
+    };
+  }  // namespace
+
   TrieSerializerImpl::TrieSerializerImpl(
       std::shared_ptr<PolkadotTrieFactory> factory,
       std::shared_ptr<Codec> codec,
-      std::shared_ptr<TrieStorageBackend> backend)
+      std::shared_ptr<TrieStorageBackend> backend,
+      std::shared_ptr<TrieNodeCache> cache,
+      std::shared_ptr<TrieHashingPool> hashing_pool)
       : trie_factory_{std::move(factory)},
         codec_{std::move(codec)},
-        backend_{std::move(backend)} {
+        backend_{std::move(backend)},
+        cache_{std::move(cache)},
+        hashing_pool_{std::move(hashing_pool)} {
     BOOST_ASSERT(trie_factory_ != nullptr);
     BOOST_ASSERT(codec_ != nullptr);
     BOOST_ASSERT(backend_ != nullptr);
@@ -30,6 +71,20 @@ namespace kagome::storage::trie {
     return storeRootNode(*trie.getRoot());
   }
 
+  outcome::result<Buffer> TrieSerializerImpl::calculateRootHash(
+      PolkadotTrie &trie) const {
+    if (trie.getRoot() == nullptr) {
+      return getEmptyRootHash();
+    }
+    OUTCOME_TRY(merkle_value, calculateMerkleValue(*trie.getRoot()));
+    // unlike other nodes, the root is hashed even if its encoding is shorter
+    // than a hash, in which case the merkle value is the encoding itself
+    if (merkle_value.size() < common::Hash256::size()) {
+      return Buffer{codec_->hash256(merkle_value)};
+    }
+    return std::move(merkle_value);
+  }
+
   outcome::result<std::unique_ptr<PolkadotTrie>>
   TrieSerializerImpl::retrieveTrie(const common::Buffer &db_key) const {
     PolkadotTrieFactory::ChildRetrieveFunctor f =
@@ -54,13 +109,22 @@ namespace kagome::storage::trie {
     if (node.getTrieType() == T::BranchEmptyValue
         || node.getTrieType() == T::BranchWithValue) {
       auto &branch = dynamic_cast<BranchNode &>(node);
-      OUTCOME_TRY(storeChildren(branch, *batch));
+      if (hashing_pool_ != nullptr
+          and countNodesToStore(node, hashing_pool_->threshold())
+                  >= hashing_pool_->threshold()) {
+        OUTCOME_TRY(storeChildrenInParallel(branch, *batch));
+      } else {
+        OUTCOME_TRY(storeChildren(branch, *batch));
+      }
     }
 
     OUTCOME_TRY(enc, codec_->encodeNode(node));
     auto key = Buffer{codec_->hash256(enc)};
     OUTCOME_TRY(batch->put(key, enc));
     OUTCOME_TRY(batch->commit());
+    if (cache_) {
+      cache_->put(key, node);
+    }
 
     return key;
   }
@@ -80,6 +144,11 @@ namespace kagome::storage::trie {
     OUTCOME_TRY(enc, codec_->encodeNode(node));
     auto key = Buffer{codec_->merkleValue(enc)};
     OUTCOME_TRY(batch.put(key, enc));
+    // the node is written only on batch commit, but it is content-addressed,
+    // so a failed commit cannot make the cached entry incorrect
+    if (cache_) {
+      cache_->put(key, node);
+    }
     return key;
   }
 
@@ -96,6 +165,79 @@ namespace kagome::storage::trie {
     return outcome::success();
   }
 
+  outcome::result<void> TrieSerializerImpl::storeChildrenInParallel(
+      BranchNode &branch, BufferBatch &batch) {
+    using Stored = outcome::result<std::pair<Buffer, NodesCollector>>;
+    std::vector<std::pair<uint8_t, std::future<Stored>>> tasks;
+    for (uint8_t idx = 0; idx < BranchNode::kMaxChildren; ++idx) {
+      auto child = branch.children.at(idx);
+      if (child and not child->isDummy()) {
+        // subtrees of different children are disjoint, thus no node is
+        // accessed by several workers
+        tasks.emplace_back(idx, hashing_pool_->submit([this, child]() -> Stored {
+          NodesCollector collector;
+          OUTCOME_TRY(key, storeNode(*child, collector));
+          return std::make_pair(std::move(key), std::move(collector));
+        }));
+      }
+    }
+    // all the tasks are awaited before any result is processed, so that none
+    // of them is left working on the trie after an error is returned
+    std::vector<std::pair<uint8_t, Stored>> results;
+    results.reserve(tasks.size());
+    for (auto &[idx, task] : tasks) {
+      results.emplace_back(idx, task.get());
+    }
+    for (auto &[idx, result] : results) {
+      OUTCOME_TRY(stored, std::move(result));
+      auto &[key, collector] = stored;
+      for (auto &[node_key, node_enc] : collector.nodes) {
+        OUTCOME_TRY(batch.put(node_key, std::move(node_enc)));
+      }
+      branch.children.at(idx) = std::make_shared<DummyNode>(std::move(key));
+    }
+    return outcome::success();
+  }
+
+  size_t TrieSerializerImpl::countNodesToStore(const PolkadotNode &node,
+                                               size_t limit) const {
+    // every node that is not a dummy is encoded and written on store
+    if (node.isDummy() or limit == 0) {
+      return 0;
+    }
+    size_t count = 1;
+    if (node.isBranch()) {
+      for (auto &child : dynamic_cast<const BranchNode &>(node).children) {
+        if (child != nullptr and count < limit) {
+          count += countNodesToStore(*child, limit - count);
+        }
+      }
+    }
+    return count;
+  }
+
+  outcome::result<common::Buffer> TrieSerializerImpl::calculateMerkleValue(
+      PolkadotNode &node) const {
+    if (node.isDummy()) {
+      return dynamic_cast<DummyNode &>(node).db_key;
+    }
+    if (node.merkle_value) {
+      return node.merkle_value.value();
+    }
+    // merkle values of changed children are required to encode a branch
+    if (node.isBranch()) {
+      auto &branch = dynamic_cast<BranchNode &>(node);
+      for (auto &child : branch.children) {
+        if (child and not child->isDummy()) {
+          OUTCOME_TRY(calculateMerkleValue(*child));
+        }
+      }
+    }
+    OUTCOME_TRY(enc, codec_->encodeNode(node));
+    node.merkle_value = codec_->merkleValue(enc);
+    return node.merkle_value.value();
+  }
+
   outcome::result<PolkadotTrie::NodePtr> TrieSerializerImpl::retrieveChild(
       const PolkadotTrie::BranchPtr &parent, uint8_t idx) const {
     if (parent->children.at(idx) == nullptr) {
@@ -105,6 +247,11 @@ namespace kagome::storage::trie {
       auto dummy =
           std::dynamic_pointer_cast<DummyNode>(parent->children.at(idx));
       OUTCOME_TRY(n, retrieveNode(dummy->db_key));
+      // a child is referenced by its merkle value, which is unchanged until
+      // the child is modified
+      if (n != nullptr) {
+        n->merkle_value = dummy->db_key;
+      }
       parent->children.at(idx) = n;
     }
     return parent->children.at(idx);
@@ -115,9 +262,20 @@ namespace kagome::storage::trie {
     if (db_key.empty() or db_key == getEmptyRootHash()) {
       return nullptr;
     }
-    OUTCOME_TRY(enc, backend_->get(db_key));
-    OUTCOME_TRY(n, codec_->decodeNode(enc));
-    return std::dynamic_pointer_cast<PolkadotNode>(n);
+    if (cache_) {
+      if (auto cached = cache_->get(db_key); cached != nullptr) {
+        return cached;
+      }
+    }
+    // the node is decoded right from the storage memory, if possible, as the
+    // values and keys of the node are copied anyway
+    OUTCOME_TRY(enc, backend_->getView(db_key));
+    OUTCOME_TRY(n, codec_->decodeNode(enc.data));
+    auto node = std::dynamic_pointer_cast<PolkadotNode>(n);
+    if (cache_ and node != nullptr) {
+      cache_->put(db_key, *node);
+    }
+    return node;
   }
 
 }  // namespace kagome::storage::trie
@@ -11,21 +11,34 @@
 #include "storage/buffer_map_types.hpp"
 #include "storage/trie/codec.hpp"
 #include "storage/trie/polkadot_trie/polkadot_trie_factory.hpp"
+#include "storage/trie/serialization/trie_hashing_pool.hpp"
+#include "storage/trie/serialization/trie_node_cache.hpp"
 #include "storage/trie/trie_storage_backend.hpp"
 
 namespace kagome::storage::trie {
 
   class TrieSerializerImpl : public TrieSerializer {
    public:
+    /**
+     * @param cache decoded nodes cache shared with other serializers over the
+     * same backend, caching is disabled if it is nullptr
+     * @param hashing_pool workers to store large tries with, tries are always
+     * stored in the calling thread if it is nullptr
+     */
     TrieSerializerImpl(std::shared_ptr<PolkadotTrieFactory> factory,
                        std::shared_ptr<Codec> codec,
-                       std::shared_ptr<TrieStorageBackend> backend);
+                       std::shared_ptr<TrieStorageBackend> backend,
+                       std::shared_ptr<TrieNodeCache> cache = nullptr,
+                       std::shared_ptr<TrieHashingPool> hashing_pool = nullptr);
     ~TrieSerializerImpl() override = default;
 
     common::Buffer getEmptyRootHash() const override;
 
     outcome::result<common::Buffer> storeTrie(PolkadotTrie &trie) override;
 
+    outcome::result<common::Buffer> calculateRootHash(
+        PolkadotTrie &trie) const override;
+
     outcome::result<std::unique_ptr<PolkadotTrie>> retrieveTrie(
         const common::Buffer &db_key) const override;
 
@@ -39,6 +52,26 @@ namespace kagome::storage::trie {
     outcome::result<common::Buffer> storeNode(PolkadotNode &node,
                                               BufferBatch &batch);
     outcome::result<void> storeChildren(BranchNode &branch, BufferBatch &batch);
+    /**
+     * Stores the children of a branch as storeChildren does, but each of the
+     * changed children subtrees is encoded by a separate worker. The encoded
+     * nodes are put to the batch in the order of the children, thus the
+     * result does not depend on the scheduling
+     */
+    outcome::result<void> storeChildrenInParallel(BranchNode &branch,
+                                                  BufferBatch &batch);
+    /**
+     * @return number of nodes of a subtree to be written on store, i.e. the
+     * ones loaded from the storage or changed, but not greater than
+     * {@param limit}
+     */
+    size_t countNodesToStore(const PolkadotNode &node, size_t limit) const;
+    /**
+     * Calculates the merkle value of a node, reusing the cached merkle values
+     * of unchanged descendants and caching the ones of changed descendants
+     */
+    outcome::result<common::Buffer> calculateMerkleValue(
+        PolkadotNode &node) const;
     /**
      * Fetches a node from the storage. A nullptr is returned in case that there
      * is no entry for provided key. Mind that a branch node will have dummy
@@ -56,6 +89,8 @@ namespace kagome::storage::trie {
     std::shared_ptr<PolkadotTrieFactory> trie_factory_;
     std::shared_ptr<Codec> codec_;
     std::shared_ptr<TrieStorageBackend> backend_;
+    std::shared_ptr<TrieNodeCache> cache_;
+    std::shared_ptr<TrieHashingPool> hashing_pool_;
   };
 }  // namespace kagome::storage::trie
 
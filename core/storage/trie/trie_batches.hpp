@@ -27,6 +27,14 @@ namespace kagome::storage::trie {
      * Remove all trie entries which key begins with the supplied prefix
      */
     virtual outcome::result<void> clearPrefix(const Buffer &prefix) = 0;
+
+    /**
+     * Appends the value to the scale encoded vector of opaque values stored by
+     * the key, as scale::append_or_new_vec does
+     * @param value scale encoded value
+     */
+    virtual outcome::result<void> append(const Buffer &key,
+                                         gsl::span<const uint8_t> value) = 0;
   };
 
   class TopperTrieBatch;
@@ -45,6 +53,13 @@ namespace kagome::storage::trie {
      */
     virtual outcome::result<Buffer> commit() = 0;
 
+    /**
+     * Calculates the root of the trie with all the changes applied, without
+     * writing anything to the persistent storage
+     * @returns the root of the trie
+     */
+    virtual outcome::result<Buffer> calculateRoot() const = 0;
+
     /**
      * Creates a batch on top of this batch
      */
@@ -55,7 +70,19 @@ namespace kagome::storage::trie {
    * A temporary in-memory trie built on top of a persistent one
    * All changes to it are simply discarded when the batch is destroyed
    */
-  class EphemeralTrieBatch : public TrieBatch {};
+  class EphemeralTrieBatch : public TrieBatch {
+   public:
+    /**
+     * Reads the value of \arg key, unless the merkle value of its node equals
+     * \arg merkle_value. Allows to skip retrieving a large value, which was
+     * read before and has not changed since then
+     * @param merkle_value merkle value of the node the value was read from
+     * before, updated to the actual one if the value is read
+     * @return the value or boost::none if it is unchanged
+     */
+    virtual outcome::result<boost::optional<Buffer>> getIfChanged(
+        const Buffer &key, Buffer &merkle_value) const = 0;
+  };
 
   /**
    * A batch on top of another batch
@@ -67,6 +94,23 @@ namespace kagome::storage::trie {
      * Writes changes to the parent batch
      */
     virtual outcome::result<void> writeBack() = 0;
+
+    /**
+     * Marks the current state of the batch, so that the changes made after it
+     * could be discarded. Savepoints nest, which allows to use a single batch
+     * for nested transactions
+     */
+    virtual void setSavepoint() = 0;
+
+    /**
+     * Discards the changes made after the latest savepoint and removes it
+     */
+    virtual outcome::result<void> rollbackToSavepoint() = 0;
+
+    /**
+     * Removes the latest savepoint, keeping the changes made after it
+     */
+    virtual outcome::result<void> releaseSavepoint() = 0;
   };
 
 }  // namespace kagome::storage::trie
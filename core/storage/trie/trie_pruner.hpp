@@ -0,0 +1,56 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_TRIE_TRIE_PRUNER
+#define KAGOME_STORAGE_TRIE_TRIE_PRUNER
+
+#include <outcome/outcome.hpp>
+
+#include "common/buffer.hpp"
+
+namespace kagome::storage::trie {
+
+  /**
+   * Keeps track of trie nodes shared between states, so that the nodes of a
+   * state which is not needed anymore (a state of a block from a discarded
+   * fork or of an old finalized block) can be removed from the storage without
+   * affecting other states
+   */
+  class TriePruner {
+   public:
+    virtual ~TriePruner() = default;
+
+    /**
+     * Registers a state that has just been written to the storage. Its nodes
+     * are kept until the state is pruned. A state committed several times
+     * must be pruned the same number of times to be removed
+     * @param state_root root hash of the stored trie
+     */
+    virtual outcome::result<void> addState(
+        const common::Buffer &state_root) = 0;
+
+    /**
+     * Registers a state, which might have been written before the pruner kept
+     * track of the states, unless it is registered already. The nodes of an
+     * unregistered state are not counted, so they would be removed along with
+     * the states that share them; thus the states to be kept must be
+     * registered before any state is pruned
+     * @param state_root root hash of the stored trie
+     */
+    virtual outcome::result<void> addExistingState(
+        const common::Buffer &state_root) = 0;
+
+    /**
+     * Removes the nodes of a state which are not referenced by other states.
+     * States which were not registered are left untouched
+     * @param state_root root hash of the state to be removed
+     */
+    virtual outcome::result<void> pruneState(
+        const common::Buffer &state_root) = 0;
+  };
+
+}  // namespace kagome::storage::trie
+
+#endif  // KAGOME_STORAGE_TRIE_TRIE_PRUNER
@@ -6,6 +6,7 @@
 #ifndef KAGOME_TRIE_DB_BACKEND_HPP
 #define KAGOME_TRIE_DB_BACKEND_HPP
 
+#include <gsl/span>
 #include <outcome/outcome.hpp>
 
 #include "common/buffer.hpp"
@@ -20,7 +21,26 @@ namespace kagome::storage::trie {
    */
   class TrieStorageBackend : public BufferStorage {
    public:
+    /**
+     * Stored value, which may refer to the memory of the storage instead of
+     * being a copy; the memory is kept alive as long as the value
+     */
+    struct ValueView {
+      std::shared_ptr<const void> owner;
+      gsl::span<const uint8_t> data;
+    };
+
     ~TrieStorageBackend() override = default;
+
+    /**
+     * Unlike get(), provides the value without copying it, if the storage
+     * keeps it in memory
+     */
+    virtual outcome::result<ValueView> getView(const Buffer &key) const {
+      OUTCOME_TRY(value, get(key));
+      auto owner = std::make_shared<const Buffer>(std::move(value));
+      return ValueView{owner, *owner};
+    }
   };
 
 }  // namespace kagome::storage::trie
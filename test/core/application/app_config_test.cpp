@@ -143,6 +143,7 @@ TEST_F(AppConfigurationTest, DefaultValuesTest) {
   ASSERT_EQ(app_config_->rpc_ws_endpoint(), ws_endpoint);
   ASSERT_EQ(app_config_->verbosity(), spdlog::level::level_enum::info);
   ASSERT_EQ(app_config_->is_only_finalizing(), false);
+  ASSERT_EQ(app_config_->state_pruning_window().value(), 256);
 }
 
 /**
@@ -201,6 +202,144 @@ TEST_F(AppConfigurationTest, GenesisPathTest) {
   ASSERT_EQ(app_config_->genesis_path(), "genesis_path");
 }
 
+/**
+ * @given new created AppConfigurationImpl
+ * @when --state_pruning cmd line arg is provided
+ * @then we must receive the window or none for archive mode
+ */
+TEST_F(AppConfigurationTest, StatePruningTest) {
+  char const *args[] = {"/path/",
+                        "--genesis",
+                        "genesis_path",
+                        "--leveldb",
+                        "leveldb_path",
+                        "--keystore",
+                        "keystore path",
+                        "--state_pruning",
+                        "16"};
+  ASSERT_TRUE(app_config_->initialize_from_args(
+      AppConfiguration::LoadScheme::kValidating,
+      sizeof(args) / sizeof(args[0]),
+      (char **)args));
+  ASSERT_EQ(app_config_->state_pruning_window().value(), 16);
+
+  args[8] = "archive";
+  ASSERT_TRUE(app_config_->initialize_from_args(
+      AppConfiguration::LoadScheme::kValidating,
+      sizeof(args) / sizeof(args[0]),
+      (char **)args));
+  ASSERT_FALSE(app_config_->state_pruning_window());
+
+  args[8] = "0";
+  ASSERT_FALSE(app_config_->initialize_from_args(
+      AppConfiguration::LoadScheme::kValidating,
+      sizeof(args) / sizeof(args[0]),
+      (char **)args));
+}
+
+/**
+ * @given new created AppConfigurationImpl
+ * @when --trie_backend cmd line arg is provided
+ * @then we must receive the selected backend, leveldb by default
+ */
+TEST_F(AppConfigurationTest, TrieBackendTest) {
+  char const *args[] = {"/path/",
+                        "--genesis",
+                        "genesis_path",
+                        "--leveldb",
+                        "leveldb_path",
+                        "--keystore",
+                        "keystore path",
+                        "--trie_backend",
+                        "mmap"};
+  ASSERT_EQ(app_config_->trie_backend(),
+            AppConfiguration::TrieBackend::kLevelDb);
+  ASSERT_TRUE(app_config_->initialize_from_args(
+      AppConfiguration::LoadScheme::kValidating,
+      sizeof(args) / sizeof(args[0]),
+      (char **)args));
+  ASSERT_EQ(app_config_->trie_backend(), AppConfiguration::TrieBackend::kMmap);
+
+  args[8] = "rocksdb";
+  ASSERT_FALSE(app_config_->initialize_from_args(
+      AppConfiguration::LoadScheme::kValidating,
+      sizeof(args) / sizeof(args[0]),
+      (char **)args));
+}
+
+/**
+ * @given new created AppConfigurationImpl
+ * @when leveldb tuning cmd line args are provided for the trie nodes
+ * @then the trie nodes profile is tuned, while the other one is default
+ */
+TEST_F(AppConfigurationTest, LevelDbProfileTest) {
+  char const *args[] = {"/path/",
+                        "--genesis",
+                        "genesis_path",
+                        "--leveldb",
+                        "leveldb_path",
+                        "--keystore",
+                        "keystore path",
+                        "--trie_db_cache_size",
+                        "512",
+                        "--trie_db_bloom_bits",
+                        "0",
+                        "--trie_db_compression",
+                        "snappy",
+                        "--db_stats_period",
+                        "60"};
+  ASSERT_TRUE(app_config_->initialize_from_args(
+      AppConfiguration::LoadScheme::kValidating,
+      sizeof(args) / sizeof(args[0]),
+      (char **)args));
+  const auto &trie_profile = app_config_->trie_leveldb_profile();
+  ASSERT_EQ(trie_profile.block_cache_size, 512 * 1024 * 1024);
+  ASSERT_EQ(trie_profile.bloom_filter_bits, 0);
+  ASSERT_TRUE(trie_profile.compression);
+  ASSERT_EQ(trie_profile.write_buffer_size,
+            kagome::storage::LevelDbProfile::trieNodes().write_buffer_size);
+  ASSERT_EQ(app_config_->leveldb_profile().block_cache_size,
+            kagome::storage::LevelDbProfile::blocks().block_cache_size);
+  ASSERT_EQ(app_config_->leveldb_stats_period(), std::chrono::seconds{60});
+
+  args[12] = "lz4";
+  ASSERT_FALSE(app_config_->initialize_from_args(
+      AppConfiguration::LoadScheme::kValidating,
+      sizeof(args) / sizeof(args[0]),
+      (char **)args));
+}
+
+/**
+ * @given new created AppConfigurationImpl
+ * @when --wasm_execution cmd line arg is provided
+ * @then we must receive the selected execution, interpreted by default
+ */
+TEST_F(AppConfigurationTest, WasmExecutionTest) {
+  char const *args[] = {"/path/",
+                        "--genesis",
+                        "genesis_path",
+                        "--leveldb",
+                        "leveldb_path",
+                        "--keystore",
+                        "keystore path",
+                        "--wasm_execution",
+                        "optimized"};
+  ASSERT_EQ(app_config_->wasm_execution(),
+            AppConfiguration::WasmExecution::kInterpreted);
+  ASSERT_TRUE(app_config_->initialize_from_args(
+      AppConfiguration::LoadScheme::kValidating,
+      sizeof(args) / sizeof(args[0]),
+      (char **)args));
+  ASSERT_EQ(app_config_->wasm_execution(),
+            AppConfiguration::WasmExecution::kOptimized);
+
+  args[8] = "compiled";
+  ASSERT_FALSE(app_config_->initialize_from_args(
+      AppConfiguration::LoadScheme::kValidating,
+      sizeof(args) / sizeof(args[0]),
+      (char **)args));
+}
+
 /**
  * @given new created AppConfigurationImpl
  * @when correct endpoint data provided in config file and in cmd line args
@@ -0,0 +1,124 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "blockchain/impl/block_header_cache.hpp"
+
+#include <gtest/gtest.h>
+
+#include "testutil/literals.hpp"
+
+using kagome::blockchain::BlockHeaderCache;
+using kagome::primitives::BlockHash;
+using kagome::primitives::BlockHeader;
+using kagome::primitives::BlockNumber;
+
+namespace {
+  BlockHeader makeHeader(BlockNumber number) {
+    BlockHeader header{};
+    header.number = number;
+    header.state_root = "010203"_hash256;
+    return header;
+  }
+}  // namespace
+
+/**
+ * @given a cache of two entries
+ * @when a third header is stored after the first one is used
+ * @then the least recently used header is evicted
+ */
+TEST(BlockHeaderCacheTest, EvictsLeastRecentlyUsed) {
+  BlockHeaderCache cache{2};
+  cache.onHeaderStored("1"_hash256, makeHeader(1));
+  cache.onHeaderStored("2"_hash256, makeHeader(2));
+  ASSERT_TRUE(cache.getHeader(BlockHash{"1"_hash256}));
+
+  cache.onHeaderStored("3"_hash256, makeHeader(3));
+
+  ASSERT_TRUE(cache.getHeader(BlockHash{"1"_hash256}));
+  ASSERT_FALSE(cache.getHeader(BlockHash{"2"_hash256}));
+  ASSERT_EQ(cache.getHeader(BlockNumber{3})->number, 3);
+  ASSERT_EQ(cache.getStats().size, 2);
+}
+
+/**
+ * @given a cache with a stored header
+ * @when the number is mapped to another block, and the block is removed
+ * @then the number no longer resolves to the block, and the block is not
+ * cached anymore
+ */
+TEST(BlockHeaderCacheTest, WritesInvalidateEntries) {
+  BlockHeaderCache cache;
+  cache.onHeaderStored("1"_hash256, makeHeader(1));
+  ASSERT_EQ(cache.getHashByNumber(1), BlockHash{"1"_hash256});
+
+  cache.onNumberIndexed(1);
+  ASSERT_FALSE(cache.getHashByNumber(1));
+  ASSERT_FALSE(cache.getHeader(BlockNumber{1}));
+  ASSERT_TRUE(cache.getHeader(BlockHash{"1"_hash256}));
+
+  cache.onBlockRemoved("1"_hash256, 1);
+  ASSERT_FALSE(cache.getHeader(BlockHash{"1"_hash256}));
+  ASSERT_FALSE(cache.getNumberByHash("1"_hash256));
+}
+
+/**
+ * @given a header read from the storage before a write to it
+ * @when the header is put with the generation taken before the read
+ * @then it is not cached, while the one read after the write is
+ */
+TEST(BlockHeaderCacheTest, DropsReadsRacingWrites) {
+  BlockHeaderCache cache;
+  auto generation = cache.generation();
+  cache.onNumberIndexed(1);
+
+  cache.putHeader("1"_hash256, makeHeader(1), true, generation);
+  ASSERT_FALSE(cache.getHeader(BlockHash{"1"_hash256}));
+
+  cache.putHeader("1"_hash256, makeHeader(1), true, cache.generation());
+  ASSERT_TRUE(cache.getHeader(BlockHash{"1"_hash256}));
+  ASSERT_EQ(cache.getHashByNumber(1), BlockHash{"1"_hash256});
+}
+
+/**
+ * @given a number of a block read from the storage before the block is
+ * removed
+ * @when the number is put with the generation taken before the read
+ * @then it is not cached, while the one read after the write is
+ */
+TEST(BlockHeaderCacheTest, DropsNumberReadsRacingWrites) {
+  BlockHeaderCache cache;
+  auto generation = cache.generation();
+  cache.onBlockRemoved("1"_hash256, 1);
+
+  cache.putNumberByHash("1"_hash256, 1, generation);
+  ASSERT_FALSE(cache.getNumberByHash("1"_hash256));
+
+  cache.putNumberByHash("1"_hash256, 1, cache.generation());
+  ASSERT_EQ(cache.getNumberByHash("1"_hash256), BlockNumber{1});
+}
+
+/**
+ * @given an empty cache
+ * @when entries are requested before and after they are cached
+ * @then misses and hits are counted
+ */
+TEST(BlockHeaderCacheTest, CountsHitsAndMisses) {
+  BlockHeaderCache cache;
+  ASSERT_FALSE(cache.getHeader(BlockNumber{1}));
+  ASSERT_FALSE(cache.getNumberByHash("1"_hash256));
+
+  cache.onHeaderStored("1"_hash256, makeHeader(1));
+  ASSERT_TRUE(cache.getHeader(BlockNumber{1}));
+  ASSERT_TRUE(cache.getHashByNumber(1));
+  ASSERT_TRUE(cache.getNumberByHash("1"_hash256));
+
+  auto stats = cache.getStats();
+  ASSERT_EQ(stats.header_hits, 1);
+  ASSERT_EQ(stats.header_misses, 1);
+  ASSERT_EQ(stats.hash_hits, 1);
+  ASSERT_EQ(stats.hash_misses, 0);
+  ASSERT_EQ(stats.number_hits, 1);
+  ASSERT_EQ(stats.number_misses, 1);
+}
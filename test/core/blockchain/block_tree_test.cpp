@@ -16,6 +16,7 @@
 #include "mock/core/blockchain/block_storage_mock.hpp"
 #include "mock/core/runtime/core_mock.hpp"
 #include "mock/core/storage/persistent_map_mock.hpp"
+#include "mock/core/storage/trie/trie_pruner_mock.hpp"
 #include "network/impl/extrinsic_observer_impl.hpp"
 #include "primitives/block_id.hpp"
 #include "primitives/justification.hpp"
@@ -47,7 +48,9 @@ struct BlockTreeTest : public testing::Test {
                                         extrinsic_observer_,
                                         hasher_,
                                         events_engine,
-                                        runtime_core_)
+                                        runtime_core_,
+                                        state_pruner_,
+                                        boost::none)
                       .value();
   }
 
@@ -99,6 +102,9 @@ struct BlockTreeTest : public testing::Test {
   std::shared_ptr<runtime::CoreMock> runtime_core_ =
       std::make_shared<runtime::CoreMock>();
 
+  std::shared_ptr<trie::TriePrunerMock> state_pruner_ =
+      std::make_shared<trie::TriePrunerMock>();
+
   std::shared_ptr<BlockTreeImpl> block_tree_;
 
   const BlockId kLastFinalizedBlockId = kFinalizedBlockHash;
@@ -220,6 +226,78 @@ TEST_F(BlockTreeTest, Finalize) {
   ASSERT_EQ(block_tree_->getLastFinalized().block_hash, hash);
 }
 
+/**
+ * @given block tree with pruning window of one state, which contains two
+ * blocks on different forks
+ * @when finalizing one of the blocks
+ * @then the states of the block on the other fork and of the previously
+ * finalized block are pruned
+ */
+TEST_F(BlockTreeTest, FinalizePrunesStates) {
+  // GIVEN
+  EXPECT_CALL(*storage_, getBlockHeader(kLastFinalizedBlockId))
+      .WillRepeatedly(Return(finalized_block_header_));
+  EXPECT_CALL(*state_pruner_,
+              addExistingState(Buffer{finalized_block_header_.state_root}))
+      .WillOnce(Return(outcome::success()));
+  block_tree_ = BlockTreeImpl::create(
+                    header_repo_,
+                    storage_,
+                    kLastFinalizedBlockId,
+                    extrinsic_observer_,
+                    hasher_,
+                    std::make_shared<
+                        subscriptions::EventsSubscriptionEngineType>(),
+                    runtime_core_,
+                    state_pruner_,
+                    1)
+                    .value();
+
+  BlockHeader header{.parent_hash = kFinalizedBlockHash,
+                     .number = 1,
+                     .state_root = Hash256::fromString(
+                                       "finalized_state_root____________")
+                                       .value(),
+                     .digest = {PreRuntime{}}};
+  auto hash = addBlock(Block{header, {}});
+  BlockHeader fork_header{.parent_hash = kFinalizedBlockHash,
+                          .number = 1,
+                          .state_root = Hash256::fromString(
+                                            "fork_state_root_________________")
+                                            .value(),
+                          .digest = {Consensus{}}};
+  auto fork_hash = addBlock(Block{fork_header, {}});
+
+  Justification justification{{0x45, 0xF4}};
+  EXPECT_CALL(*storage_, getJustification(primitives::BlockId(hash)))
+      .WillOnce(Return(outcome::failure(boost::system::error_code{})));
+  EXPECT_CALL(*storage_, putJustification(justification, hash, header.number))
+      .WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*storage_, setLastFinalizedBlockHash(hash))
+      .WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*storage_, getBlockHeader(primitives::BlockId(hash)))
+      .WillRepeatedly(Return(header));
+  EXPECT_CALL(*storage_, getBlockHeader(primitives::BlockId(fork_hash)))
+      .WillRepeatedly(Return(fork_header));
+  EXPECT_CALL(*storage_, getBlockBody(primitives::BlockId(fork_hash)))
+      .WillOnce(Return(outcome::failure(boost::system::error_code{})));
+  EXPECT_CALL(*storage_, removeBlock(fork_hash, fork_header.number))
+      .WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*runtime_core_, version(_))
+      .WillRepeatedly(Return(primitives::Version{}));
+
+  // THEN
+  EXPECT_CALL(*state_pruner_, pruneState(Buffer{fork_header.state_root}))
+      .WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*state_pruner_,
+              pruneState(Buffer{finalized_block_header_.state_root}))
+      .WillOnce(Return(outcome::success()));
+
+  // WHEN
+  ASSERT_TRUE(block_tree_->finalize(hash, justification));
+  ASSERT_EQ(block_tree_->getLastFinalized().block_hash, hash);
+}
+
 /**
  * @given block tree with at least three blocks inside
  * @when asking for chain from the lowest block to the closest finalized one
@@ -316,6 +394,54 @@ TEST_F(BlockTreeTest, GetChainByBlockDescending) {
   ASSERT_EQ(chain, expected_chain);
 }
 
+/**
+ * @given a long chain of blocks in the tree with a fork from its middle
+ * @when checking ancestry of the blocks and asking for chains between them
+ * @then the chains are found for the blocks on the same branch only, without
+ * asking the repository
+ */
+TEST_F(BlockTreeTest, AncestryInLongChain) {
+  // GIVEN
+  std::vector<BlockHash> main_chain{kFinalizedBlockHash};
+  for (BlockNumber number = 1; number <= 200; ++number) {
+    main_chain.push_back(addHeaderToRepository(main_chain.back(), number));
+  }
+  std::vector<BlockHash> fork{main_chain[100]};
+  for (BlockNumber number = 101; number <= 150; ++number) {
+    BlockHeader header{.parent_hash = fork.back(),
+                       .number = number,
+                       .digest = {Consensus{}}};
+    fork.push_back(addBlock(Block{header, {}}));
+  }
+  EXPECT_CALL(*header_repo_, getBlockHeader(_)).Times(0);
+
+  // WHEN & THEN
+  ASSERT_TRUE(block_tree_->hasDirectChain(main_chain[0], main_chain[200]));
+  ASSERT_TRUE(block_tree_->hasDirectChain(main_chain[37], main_chain[163]));
+  ASSERT_TRUE(block_tree_->hasDirectChain(main_chain[100], fork[50]));
+  ASSERT_TRUE(block_tree_->hasDirectChain(fork[1], fork[1]));
+  ASSERT_FALSE(block_tree_->hasDirectChain(main_chain[163], main_chain[37]));
+  ASSERT_FALSE(block_tree_->hasDirectChain(main_chain[101], fork[50]));
+  ASSERT_FALSE(block_tree_->hasDirectChain(fork[1], main_chain[200]));
+
+  EXPECT_OUTCOME_TRUE(chain,
+                      block_tree_->getChainByBlocks(main_chain[37],
+                                                    main_chain[163]));
+  ASSERT_EQ(chain,
+            std::vector<BlockHash>(main_chain.begin() + 37,
+                                   main_chain.begin() + 164));
+  EXPECT_OUTCOME_TRUE(fork_chain,
+                      block_tree_->getChainByBlocks(main_chain[0], fork[50]));
+  std::vector<BlockHash> expected_fork_chain(main_chain.begin(),
+                                             main_chain.begin() + 100);
+  expected_fork_chain.insert(
+      expected_fork_chain.end(), fork.begin(), fork.end());
+  ASSERT_EQ(fork_chain, expected_fork_chain);
+  EXPECT_OUTCOME_FALSE(err,
+                       block_tree_->getChainByBlocks(fork[1], main_chain[200]));
+  ASSERT_EQ(err, BlockTreeError::INCORRECT_ARGS);
+}
+
 /**
  * @given a block tree with one block in it
  * @when trying to obtain the best chain that contais a block, which is
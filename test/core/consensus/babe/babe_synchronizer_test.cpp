@@ -0,0 +1,296 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "consensus/babe/impl/babe_synchronizer_impl.hpp"
+
+#include <gtest/gtest.h>
+
+#include <deque>
+
+#include "common/visitor.hpp"
+#include "mock/core/blockchain/block_header_repository_mock.hpp"
+
+using kagome::blockchain::BlockHeaderRepositoryMock;
+using kagome::consensus::BabeSynchronizerImpl;
+using kagome::network::BlocksRequest;
+using kagome::network::BlocksResponse;
+using kagome::network::SyncClientsSet;
+using kagome::network::SyncProtocolClient;
+using kagome::primitives::Block;
+using kagome::primitives::BlockData;
+using kagome::primitives::BlockHash;
+using kagome::primitives::BlockHeader;
+using kagome::primitives::BlockId;
+using kagome::primitives::BlockInfo;
+using kagome::primitives::BlockNumber;
+using testing::_;
+using testing::Return;
+
+namespace {
+  constexpr BlockNumber kChainLength = 1000;
+  constexpr std::chrono::milliseconds kRequestTimeout{20};
+
+  BlockHash blockHash(BlockNumber number) {
+    BlockHash hash;
+    hash[0] = 1;
+    hash[1] = number & 0xffu;
+    hash[2] = number >> 8u;
+    return hash;
+  }
+
+  BlockNumber blockNumber(const BlockHash &hash) {
+    return hash[1] | (hash[2] << 8u);
+  }
+
+  /**
+   * Peer, which has a chain of kChainLength blocks and responds, when the
+   * test tells it to, as the sync protocol observer does: the response
+   * starts with the requested block and is cut by the maximal number of
+   * blocks, which stands for the size limits of the peer
+   */
+  class ChainClient : public SyncProtocolClient {
+   public:
+    enum class Behaviour {
+      RESPONDS,
+      FAILS,
+      /// never responds
+      HANGS,
+      /// stands for the node itself
+      SELF
+    };
+
+    explicit ChainClient(Behaviour behaviour = Behaviour::RESPONDS,
+                         BlockNumber max_response_blocks = 128)
+        : behaviour_{behaviour}, max_response_blocks_{max_response_blocks} {}
+
+    void requestBlocks(
+        const BlocksRequest &request,
+        std::function<void(outcome::result<BlocksResponse>)> cb) override {
+      requests_++;
+      if (behaviour_ != Behaviour::HANGS) {
+        pending_.emplace_back(request, std::move(cb));
+      }
+    }
+
+    bool servesRequests() const override {
+      return behaviour_ != Behaviour::SELF;
+    }
+
+    /**
+     * Responds to the oldest pending request
+     * @return false if there is none
+     */
+    bool respond() {
+      if (pending_.empty()) {
+        return false;
+      }
+      auto [request, cb] = std::move(pending_.front());
+      pending_.pop_front();
+      if (behaviour_ == Behaviour::FAILS) {
+        cb(std::make_error_code(std::errc::timed_out));
+        return true;
+      }
+      BlocksResponse response{request.id};
+      auto from = kagome::visit_in_place(
+          request.from,
+          [](BlockNumber number) { return number; },
+          [](const BlockHash &hash) { return blockNumber(hash); });
+      auto last = request.to ? blockNumber(*request.to) : kChainLength - 1;
+      last = std::min(last, from + request.max.value_or(128) - 1);
+      last = std::min(last, from + max_response_blocks_ - 1);
+      for (auto number = from; number <= last; ++number) {
+        BlockHeader header{};
+        header.number = number;
+        header.parent_hash = blockHash(number - 1);
+        response.blocks.push_back(BlockData{blockHash(number), header});
+      }
+      cb(response);
+      return true;
+    }
+
+    size_t requests() const {
+      return requests_;
+    }
+
+   private:
+    Behaviour behaviour_;
+    BlockNumber max_response_blocks_;
+    size_t requests_ = 0;
+    std::deque<std::pair<BlocksRequest,
+                         std::function<void(outcome::result<BlocksResponse>)>>>
+        pending_;
+  };
+}  // namespace
+
+class BabeSynchronizerTest : public testing::Test {
+ public:
+  void SetUp() override {
+    EXPECT_CALL(*block_headers_, getNumberByHash(blockHash(0)))
+        .WillRepeatedly(Return(0));
+  }
+
+  void addClients(std::vector<std::shared_ptr<ChainClient>> clients) {
+    clients_ = std::move(clients);
+    for (auto &client : clients_) {
+      sync_clients_->clients.push_back(client);
+    }
+    synchronizer_ = std::make_shared<BabeSynchronizerImpl>(
+        sync_clients_, block_headers_, io_context_, kRequestTimeout);
+  }
+
+  /**
+   * Makes the peers respond in turns until no request is pending
+   */
+  void respondAll() {
+    for (auto responded = true; responded;) {
+      responded = false;
+      for (auto &client : clients_) {
+        responded = client->respond() or responded;
+      }
+    }
+  }
+
+  std::vector<BlockNumber> requestChain(BlockNumber last = kChainLength - 1) {
+    std::vector<BlockNumber> received;
+    synchronizer_->request(
+        blockHash(0),
+        BlockInfo{last, blockHash(last)},
+        0,
+        [&received](const std::vector<Block> &blocks) {
+          for (auto &block : blocks) {
+            received.push_back(block.header.number);
+          }
+        });
+    respondAll();
+    // the requests, which are left without a response, time out
+    while (io_context_->run_one() != 0) {
+      respondAll();
+    }
+    return received;
+  }
+
+  std::vector<BlockNumber> wholeChain(
+      BlockNumber last = kChainLength - 1) const {
+    std::vector<BlockNumber> chain;
+    for (BlockNumber number = 1; number <= last; ++number) {
+      chain.push_back(number);
+    }
+    return chain;
+  }
+
+  std::shared_ptr<SyncClientsSet> sync_clients_ =
+      std::make_shared<SyncClientsSet>();
+  std::shared_ptr<BlockHeaderRepositoryMock> block_headers_ =
+      std::make_shared<BlockHeaderRepositoryMock>();
+  std::shared_ptr<boost::asio::io_context> io_context_ =
+      std::make_shared<boost::asio::io_context>();
+  std::vector<std::shared_ptr<ChainClient>> clients_;
+  std::shared_ptr<BabeSynchronizerImpl> synchronizer_;
+};
+
+/**
+ * @given peers with a long chain
+ * @when the chain is requested
+ * @then it is downloaded in chunks from all the peers, and all of its blocks
+ * are handled once in their order
+ */
+TEST_F(BabeSynchronizerTest, DownloadsChunksFromAllPeers) {
+  addClients({std::make_shared<ChainClient>(),
+              std::make_shared<ChainClient>(),
+              std::make_shared<ChainClient>()});
+
+  ASSERT_EQ(requestChain(), wholeChain());
+  for (auto &client : clients_) {
+    ASSERT_GT(client->requests(), 1);
+    auto stats = synchronizer_->getPeerStats(client);
+    ASSERT_TRUE(stats);
+    ASSERT_TRUE(stats->measured);
+    ASSERT_EQ(stats->failures, 0);
+    ASSERT_EQ(stats->requests_in_flight, 0);
+  }
+}
+
+/**
+ * @given peers with a long chain, one of which fails to respond
+ * @when the chain is requested
+ * @then the chunks it failed to provide are requested from the others, and
+ * all the blocks are handled once in their order
+ */
+TEST_F(BabeSynchronizerTest, RerequestsFailedChunks) {
+  addClients({std::make_shared<ChainClient>(ChainClient::Behaviour::FAILS),
+              std::make_shared<ChainClient>()});
+
+  ASSERT_EQ(requestChain(), wholeChain());
+  auto stats = synchronizer_->getPeerStats(clients_[0]);
+  ASSERT_TRUE(stats);
+  ASSERT_FALSE(stats->measured);
+  ASSERT_GT(stats->failures, 0);
+}
+
+/**
+ * @given peers with a long chain, one of which never responds
+ * @when the chain is requested
+ * @then the requests to it time out, the chunks are requested from the other
+ * peer, and all the blocks are handled once in their order
+ */
+TEST_F(BabeSynchronizerTest, RerequestsTimedOutChunks) {
+  addClients({std::make_shared<ChainClient>(ChainClient::Behaviour::HANGS),
+              std::make_shared<ChainClient>()});
+
+  ASSERT_EQ(requestChain(), wholeChain());
+  ASSERT_GT(clients_[0]->requests(), 0);
+  auto stats = synchronizer_->getPeerStats(clients_[0]);
+  ASSERT_TRUE(stats);
+  ASSERT_FALSE(stats->measured);
+  ASSERT_GT(stats->failures, 0);
+  ASSERT_EQ(stats->requests_in_flight, 0);
+}
+
+/**
+ * @given a peer with a long chain and the client standing for the node itself
+ * @when the chain is requested
+ * @then it is downloaded from the peer only
+ */
+TEST_F(BabeSynchronizerTest, SkipsClientsNotServingRequests) {
+  addClients({std::make_shared<ChainClient>(ChainClient::Behaviour::SELF),
+              std::make_shared<ChainClient>()});
+
+  ASSERT_EQ(requestChain(), wholeChain());
+  ASSERT_EQ(clients_[0]->requests(), 0);
+  ASSERT_GT(clients_[1]->requests(), 1);
+}
+
+/**
+ * @given peers with a long chain, which cut their responses shorter than the
+ * requested chunks
+ * @when the chain is requested
+ * @then the received parts of the chunks are kept, the rest of them is
+ * requested again, and all the blocks are handled once in their order
+ */
+TEST_F(BabeSynchronizerTest, CompletesTruncatedChunks) {
+  addClients(
+      {std::make_shared<ChainClient>(ChainClient::Behaviour::RESPONDS, 50),
+       std::make_shared<ChainClient>(ChainClient::Behaviour::RESPONDS, 50)});
+
+  ASSERT_EQ(requestChain(), wholeChain());
+  for (auto &client : clients_) {
+    ASSERT_EQ(synchronizer_->getPeerStats(client)->failures, 0);
+  }
+}
+
+/**
+ * @given a peer, which cuts its responses
+ * @when a range shorter than a chunk is requested from it at once
+ * @then the rest of the range is requested from the last received block,
+ * until all the blocks are handled once in their order
+ */
+TEST_F(BabeSynchronizerTest, RerequestsRestOfTruncatedResponse) {
+  constexpr BlockNumber kLast = 100;
+  addClients(
+      {std::make_shared<ChainClient>(ChainClient::Behaviour::RESPONDS, 30)});
+
+  ASSERT_EQ(requestChain(kLast), wholeChain(kLast));
+  ASSERT_EQ(clients_[0]->requests(), 4);
+}
@@ -0,0 +1,339 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "consensus/babe/impl/block_executor.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "blockchain/block_tree_error.hpp"
+#include "consensus/babe/types/consensus_log.hpp"
+#include "crypto/hasher/hasher_impl.hpp"
+#include "mock/core/blockchain/block_tree_mock.hpp"
+#include "mock/core/consensus/authority/authority_update_observer_mock.hpp"
+#include "mock/core/consensus/babe/babe_synchronizer_mock.hpp"
+#include "mock/core/consensus/babe/epoch_storage_mock.hpp"
+#include "mock/core/consensus/validation/block_validator_mock.hpp"
+#include "mock/core/runtime/core_mock.hpp"
+#include "mock/core/transaction_pool/transaction_pool_mock.hpp"
+#include "scale/scale.hpp"
+#include "testutil/literals.hpp"
+
+using namespace kagome;
+using namespace consensus;
+
+using kagome::authority::AuthorityUpdateObserverMock;
+using kagome::blockchain::BlockTreeError;
+using kagome::blockchain::BlockTreeMock;
+using kagome::common::Buffer;
+using kagome::crypto::HasherImpl;
+using kagome::primitives::Block;
+using kagome::primitives::BlockHash;
+using kagome::primitives::BlockHeader;
+using kagome::primitives::BlockInfo;
+using kagome::runtime::CoreMock;
+using kagome::transaction_pool::TransactionPoolMock;
+using testing::_;
+using testing::Invoke;
+using testing::InvokeArgument;
+using testing::Return;
+using testing::SaveArg;
+
+// TODO (kamilsa): workaround unless we bump gtest version to 1.8.1+
+namespace kagome::primitives {
+  std::ostream &operator<<(std::ostream &s,
+                           const detail::DigestItemCommon &dic) {
+    return s;
+  }
+}  // namespace kagome::primitives
+
+class BlockExecutorTest : public testing::Test {
+ public:
+  void SetUp() override {
+    configuration_->epoch_length = 2;
+    configuration_->leadership_rate = {1, 4};
+    configuration_->randomness.fill(0);
+    configuration_->genesis_authorities = {
+        primitives::Authority{{"genesis"_hash256}, 1}};
+
+    block_executor_ =
+        std::make_shared<BlockExecutor>(block_tree_,
+                                        core_,
+                                        configuration_,
+                                        babe_synchronizer_,
+                                        block_validator_,
+                                        epoch_storage_,
+                                        tx_pool_,
+                                        hasher_,
+                                        authority_update_observer_,
+                                        import_pool_);
+
+    EXPECT_CALL(*block_tree_, getBlockBody(_))
+        .WillRepeatedly(Return(BlockTreeError::NO_SUCH_BLOCK));
+    EXPECT_CALL(*epoch_storage_, getEpochDescriptor(_))
+        .WillRepeatedly(Return(BlockTreeError::NO_SUCH_BLOCK));
+    EXPECT_CALL(*tx_pool_, removeOne(_))
+        .WillRepeatedly(Return(outcome::success()));
+  }
+
+  /**
+   * @return chain of blocks in the given slots, produced by the first
+   * genesis authority, each with an extrinsic
+   */
+  std::vector<Block> makeChain(
+      const std::vector<BabeSlotNumber> &slots) const {
+    std::vector<Block> blocks;
+    auto parent_hash = "genesis"_hash256;
+    for (size_t i = 0; i < slots.size(); ++i) {
+      Block block;
+      block.header.parent_hash = parent_hash;
+      block.header.number = i + 1;
+      block.header.digest.emplace_back(makePreRuntime(slots[i]));
+      block.header.digest.emplace_back(makeSeal());
+      block.body.push_back({Buffer{static_cast<uint8_t>(i)}});
+      parent_hash = hash(block.header);
+      blocks.push_back(std::move(block));
+    }
+    return blocks;
+  }
+
+  /**
+   * Adds the announcement of the epoch after next to the header, before its
+   * seal
+   */
+  static void announceEpoch(BlockHeader &header,
+                            const NextEpochDescriptor &descriptor) {
+    primitives::Consensus consensus;
+    consensus.consensus_engine_id = primitives::kBabeEngineId;
+    consensus.data =
+        Buffer{scale::encode(ConsensusLog{descriptor}).value()};
+    header.digest.insert(header.digest.end() - 1, consensus);
+  }
+
+  BlockHash hash(const BlockHeader &header) const {
+    return hasher_->blake2b_256(scale::encode(header).value());
+  }
+
+  /**
+   * Makes the synchronizer return the blocks at once
+   */
+  void expectRequest(const std::vector<Block> &blocks) {
+    EXPECT_CALL(*babe_synchronizer_, request(_, _, _, _))
+        .WillOnce(InvokeArgument<3>(blocks));
+  }
+
+  void requestBlocks(const std::vector<Block> &blocks, bool &done) {
+    block_executor_->requestBlocks(
+        "genesis"_hash256,
+        BlockInfo{blocks.back().header.number, hash(blocks.back().header)},
+        0,
+        [&done] { done = true; });
+  }
+
+  static primitives::PreRuntime makePreRuntime(BabeSlotNumber slot) {
+    primitives::PreRuntime pre_runtime;
+    pre_runtime.consensus_engine_id = primitives::kBabeEngineId;
+    pre_runtime.data = Buffer{
+        scale::encode(BabeBlockHeader{slot, {}, 0}).value()};
+    return pre_runtime;
+  }
+
+  static primitives::Seal makeSeal() {
+    primitives::Seal seal;
+    seal.consensus_engine_id = primitives::kBabeEngineId;
+    seal.data = Buffer{scale::encode(Seal{}).value()};
+    return seal;
+  }
+
+  std::shared_ptr<BlockTreeMock> block_tree_ =
+      std::make_shared<BlockTreeMock>();
+  std::shared_ptr<CoreMock> core_ = std::make_shared<CoreMock>();
+  std::shared_ptr<primitives::BabeConfiguration> configuration_ =
+      std::make_shared<primitives::BabeConfiguration>();
+  std::shared_ptr<BabeSynchronizerMock> babe_synchronizer_ =
+      std::make_shared<BabeSynchronizerMock>();
+  std::shared_ptr<BlockValidatorMock> block_validator_ =
+      std::make_shared<BlockValidatorMock>();
+  std::shared_ptr<EpochStorageMock> epoch_storage_ =
+      std::make_shared<EpochStorageMock>();
+  std::shared_ptr<TransactionPoolMock> tx_pool_ =
+      std::make_shared<TransactionPoolMock>();
+  std::shared_ptr<HasherImpl> hasher_ = std::make_shared<HasherImpl>();
+  std::shared_ptr<AuthorityUpdateObserverMock> authority_update_observer_ =
+      std::make_shared<AuthorityUpdateObserverMock>();
+  std::shared_ptr<BlockImportPool> import_pool_ =
+      std::make_shared<BlockImportPool>(4, 8);
+
+  std::shared_ptr<BlockExecutor> block_executor_;
+};
+
+/**
+ * @given a batch of blocks, whose headers are validated by the import pool,
+ * the earlier blocks taking longer
+ * @when the batch is received
+ * @then the blocks are executed and added in their order, and the sync is
+ * done
+ */
+TEST_F(BlockExecutorTest, AppliesPreparedBlocksInOrder) {
+  auto blocks = makeChain({1, 2, 3, 4, 5, 6, 7, 8, 9, 10});
+  expectRequest(blocks);
+
+  EXPECT_CALL(*block_validator_, validateHeader(_, _, _, _))
+      .WillRepeatedly(Invoke([](const BlockHeader &header, auto &, auto &, auto &)
+                                 -> outcome::result<void> {
+        // the later blocks are prepared sooner than the earlier ones
+        std::this_thread::sleep_for(std::chrono::milliseconds(
+            (11 - header.number) * 2));
+        return outcome::success();
+      }));
+  std::vector<primitives::BlockNumber> executed;
+  EXPECT_CALL(*core_, execute_block(_))
+      .WillRepeatedly(Invoke([&executed](const Block &block) {
+        executed.push_back(block.header.number);
+        return outcome::success();
+      }));
+  std::vector<primitives::BlockNumber> added;
+  EXPECT_CALL(*block_tree_, addBlock(_))
+      .WillRepeatedly(Invoke([&added](const Block &block) {
+        added.push_back(block.header.number);
+        return outcome::success();
+      }));
+
+  bool done = false;
+  requestBlocks(blocks, done);
+
+  std::vector<primitives::BlockNumber> expected{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+  ASSERT_EQ(executed, expected);
+  ASSERT_EQ(added, expected);
+  ASSERT_TRUE(done);
+}
+
+/**
+ * @given a batch, which first block announces an epoch, and a later block of
+ * which is in the announced epoch
+ * @when the batch is received
+ * @then the later block is validated with the authorities and randomness of
+ * the announced epoch, which is stored once the announcing block is applied
+ */
+TEST_F(BlockExecutorTest, ValidatesWithEpochAnnouncedInBatch) {
+  // epochs are 2 slots long, so slot 4 is in the epoch 2 announced in epoch 0
+  auto blocks = makeChain({1, 2, 4});
+  NextEpochDescriptor announced{{primitives::Authority{{"next"_hash256}, 1}},
+                                {}};
+  announced.randomness.fill(7);
+  announceEpoch(blocks[0].header, announced);
+  blocks[1].header.parent_hash = hash(blocks[0].header);
+  blocks[2].header.parent_hash = hash(blocks[1].header);
+  expectRequest(blocks);
+
+  EXPECT_CALL(*block_validator_,
+              validateHeader(_,
+                             configuration_->genesis_authorities[0].id,
+                             _,
+                             configuration_->randomness))
+      .Times(2)
+      .WillRepeatedly(Return(outcome::success()));
+  EXPECT_CALL(*block_validator_,
+              validateHeader(blocks[2].header,
+                             announced.authorities[0].id,
+                             _,
+                             announced.randomness))
+      .WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*epoch_storage_, addEpochDescriptor(2, announced))
+      .WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*authority_update_observer_, onConsensus(_, _, _))
+      .WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*core_, execute_block(_))
+      .Times(3)
+      .WillRepeatedly(Return(outcome::success()));
+  EXPECT_CALL(*block_tree_, addBlock(_))
+      .Times(3)
+      .WillRepeatedly(Return(outcome::success()));
+
+  bool done = false;
+  requestBlocks(blocks, done);
+  ASSERT_TRUE(done);
+}
+
+/**
+ * @given a batch, a block in the middle of which has an invalid header
+ * @when the batch is received
+ * @then the blocks before it are applied, the following ones are not, and the
+ * sync is done only once the blocks prepared ahead are
+ */
+TEST_F(BlockExecutorTest, StopsBatchOnFailedBlock) {
+  auto blocks = makeChain({1, 2, 3, 4, 5});
+  expectRequest(blocks);
+
+  std::atomic<size_t> prepared_after_failed{0};
+  EXPECT_CALL(*block_validator_, validateHeader(_, _, _, _))
+      .WillRepeatedly(Invoke([&prepared_after_failed](const BlockHeader &header,
+                                                      auto &,
+                                                      auto &,
+                                                      auto &)
+                                 -> outcome::result<void> {
+        if (header.number == 3) {
+          return BlockTreeError::INVALID_DB;
+        }
+        if (header.number > 3) {
+          std::this_thread::sleep_for(std::chrono::milliseconds(20));
+          prepared_after_failed++;
+        }
+        return outcome::success();
+      }));
+  std::vector<primitives::BlockNumber> executed;
+  EXPECT_CALL(*core_, execute_block(_))
+      .WillRepeatedly(Invoke([&executed](const Block &block) {
+        executed.push_back(block.header.number);
+        return outcome::success();
+      }));
+  EXPECT_CALL(*block_tree_, addBlock(_))
+      .Times(2)
+      .WillRepeatedly(Return(outcome::success()));
+
+  bool done = false;
+  requestBlocks(blocks, done);
+
+  ASSERT_EQ(executed, (std::vector<primitives::BlockNumber>{1, 2}));
+  ASSERT_TRUE(done);
+  // all of the batch fits the lookahead, so the blocks after the failed one
+  // were being prepared, and are waited for
+  ASSERT_EQ(prepared_after_failed, 2);
+}
+
+/**
+ * @given a batch, which the synchronizer receives in two parts, as the peer
+ * cuts its response
+ * @when the first part is received
+ * @then its blocks are applied, and the sync is done only once the second
+ * part is
+ */
+TEST_F(BlockExecutorTest, WaitsForRestOfTruncatedBatch) {
+  auto blocks = makeChain({1, 2, 3, 4});
+  std::vector<Block> first_part{blocks.begin(), blocks.begin() + 2};
+  std::vector<Block> second_part{blocks.begin() + 2, blocks.end()};
+  BabeSynchronizer::BlocksHandler handler;
+  EXPECT_CALL(*babe_synchronizer_, request(_, _, _, _))
+      .WillOnce(SaveArg<3>(&handler));
+
+  EXPECT_CALL(*block_validator_, validateHeader(_, _, _, _))
+      .WillRepeatedly(Return(outcome::success()));
+  EXPECT_CALL(*core_, execute_block(_))
+      .Times(4)
+      .WillRepeatedly(Return(outcome::success()));
+  EXPECT_CALL(*block_tree_, addBlock(_))
+      .Times(4)
+      .WillRepeatedly(Return(outcome::success()));
+
+  bool done = false;
+  requestBlocks(blocks, done);
+  handler(first_part);
+  ASSERT_FALSE(done);
+  handler(second_part);
+  ASSERT_TRUE(done);
+}
@@ -99,13 +99,15 @@ class CryptoExtensionTest : public ::testing::Test {
         std::make_shared<Pbkdf2ProviderImpl>());
 
     crypto_store_ = std::make_shared<CryptoStoreMock>();
+    verification_pool_ = std::make_shared<BatchVerificationPool>(2);
     crypto_ext_ = std::make_shared<CryptoExtension>(memory_,
                                                     sr25519_provider_,
                                                     ed25519_provider_,
                                                     secp256k1_provider_,
                                                     hasher_,
                                                     crypto_store_,
-                                                    bip39_provider_);
+                                                    bip39_provider_,
+                                                    verification_pool_);
 
     EXPECT_OUTCOME_TRUE(seed_tmp,
                         kagome::common::Blob<32>::fromHexWithPrefix(seed_hex));
@@ -192,6 +194,7 @@ class CryptoExtensionTest : public ::testing::Test {
   std::shared_ptr<CryptoStoreMock> crypto_store_;
   std::shared_ptr<CryptoExtension> crypto_ext_;
   std::shared_ptr<Bip39Provider> bip39_provider_;
+  std::shared_ptr<BatchVerificationPool> verification_pool_;
 
   inline static Buffer input{"6920616d2064617461"_unhex};
 
@@ -514,6 +517,65 @@ TEST_F(CryptoExtensionTest, VerificationBatching_NormalOrderAndInvalid) {
   ASSERT_ANY_THROW(crypto_ext_->ext_finish_batch_verify());
 }
 
+/**
+ * @given initialized crypto extention with started batch
+ * @when checking a valid sr25519 signature, an invalid ed25519 signature and
+ * a valid ed25519 signature, and finishing the batch
+ * @then every verification returns positive, but batch returns negative
+ * result, and a new batch can be started
+ */
+TEST_F(CryptoExtensionTest, VerificationBatching_SeveralSignaturesAndInvalid) {
+  Ed25519Signature invalid_signature;
+  invalid_signature.fill(0x11);
+
+  WasmPointer input_data = 0;
+  WasmSize input_size = input.size();
+  WasmPointer sr_sig_data_ptr = 42;
+  WasmPointer sr_pub_key_data_ptr = 123;
+  WasmPointer ed_sig_data_ptr = 142;
+  WasmPointer invalid_ed_sig_data_ptr = 242;
+  WasmPointer ed_pub_key_data_ptr = 223;
+
+  EXPECT_CALL(*memory_, loadN(input_data, input_size))
+      .Times(3)
+      .WillRepeatedly(Return(input));
+  EXPECT_CALL(*memory_,
+              loadN(sr_pub_key_data_ptr, sr25519_constants::PUBLIC_SIZE))
+      .WillOnce(Return(Buffer(sr25519_keypair.public_key)));
+  EXPECT_CALL(*memory_,
+              loadN(sr_sig_data_ptr, sr25519_constants::SIGNATURE_SIZE))
+      .WillOnce(Return(Buffer(sr25519_signature)));
+  EXPECT_CALL(*memory_,
+              loadN(ed_pub_key_data_ptr, ed25519_constants::PUBKEY_SIZE))
+      .Times(2)
+      .WillRepeatedly(Return(Buffer(ed25519_keypair.public_key)));
+  EXPECT_CALL(*memory_,
+              loadN(ed_sig_data_ptr, ed25519_constants::SIGNATURE_SIZE))
+      .WillOnce(Return(Buffer(ed25519_signature)));
+  EXPECT_CALL(*memory_,
+              loadN(invalid_ed_sig_data_ptr, ed25519_constants::SIGNATURE_SIZE))
+      .WillOnce(Return(Buffer(invalid_signature)));
+
+  ASSERT_NO_THROW(crypto_ext_->ext_start_batch_verify());
+  ASSERT_EQ(crypto_ext_->ext_sr25519_verify(
+                input_data, input_size, sr_sig_data_ptr, sr_pub_key_data_ptr),
+            CryptoExtension::kLegacyVerifySuccess);
+  ASSERT_EQ(crypto_ext_->ext_ed25519_verify(input_data,
+                                            input_size,
+                                            invalid_ed_sig_data_ptr,
+                                            ed_pub_key_data_ptr),
+            CryptoExtension::kLegacyVerifySuccess);
+  ASSERT_EQ(crypto_ext_->ext_ed25519_verify(
+                input_data, input_size, ed_sig_data_ptr, ed_pub_key_data_ptr),
+            CryptoExtension::kLegacyVerifySuccess);
+
+  ASSERT_EQ(crypto_ext_->ext_finish_batch_verify(),
+            CryptoExtension::kVerifyBatchFail);
+  ASSERT_NO_THROW(crypto_ext_->ext_start_batch_verify());
+  ASSERT_EQ(crypto_ext_->ext_finish_batch_verify(),
+            CryptoExtension::kVerifyBatchSuccess);
+}
+
 /**
  * @given initialized crypto extensions @and some bytes
  * @when XX-hashing those bytes to get 16-byte hash
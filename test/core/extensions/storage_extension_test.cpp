@@ -13,7 +13,7 @@
 #include "mock/core/storage/trie/polkadot_trie_cursor_mock.h"
 #include "mock/core/storage/trie/trie_batches_mock.hpp"
 #include "runtime/wasm_result.hpp"
-#include "scale/encode_append.hpp"
+#include "scale/scale.hpp"
 #include "testutil/literals.hpp"
 #include "testutil/outcome.hpp"
 #include "testutil/outcome/dummy_error.hpp"
@@ -400,7 +400,8 @@ TEST_P(OutcomeParameterizedTest, SetStorageTest) {
       .WillOnce(Return(value));
 
   // expect key-value pair was put to db
-  EXPECT_CALL(*trie_batch_, put(key, value)).WillOnce(Return(GetParam()));
+  EXPECT_CALL(*trie_batch_, put_rvalueHack(key, value))
+      .WillOnce(Return(GetParam()));
 
   storage_extension_->ext_set_storage(
       key_pointer, key_size, value_pointer, value_size);
@@ -426,7 +427,8 @@ TEST_P(OutcomeParameterizedTest, ExtStorageSetV1Test) {
       .WillOnce(Return(value));
 
   // expect key-value pair was put to db
-  EXPECT_CALL(*trie_batch_, put(key, value)).WillOnce(Return(GetParam()));
+  EXPECT_CALL(*trie_batch_, put_rvalueHack(key, value))
+      .WillOnce(Return(GetParam()));
 
   storage_extension_->ext_storage_set_version_1(
       WasmResult(key_pointer, key_size).combine(),
@@ -480,105 +482,30 @@ INSTANTIATE_TEST_CASE_P(Instance,
                         // empty argument for the macro
 );
 
+/**
+ * @given key and a value to append
+ * @when appending the value to the vector stored by the key
+ * @then the value is appended by the current batch, which keeps the vector
+ */
 TEST_F(StorageExtensionTest, ExtStorageAppendTest) {
-  // @given key and two values
   WasmResult key(43, 43);
   Buffer key_data(key.length, 'k');
 
-  Buffer value_data1(42, '1');
-  Buffer value_data1_encoded{kagome::scale::encode(value_data1).value()};
-  WasmResult value1(42, value_data1_encoded.size());
-
-  Buffer value_data2(43, '2');
-  Buffer value_data2_encoded{kagome::scale::encode(value_data2).value()};
-  WasmResult value2(45, value_data2_encoded.size());
+  Buffer value_data(42, '1');
+  Buffer value_data_encoded{kagome::scale::encode(value_data).value()};
+  WasmResult value(42, value_data_encoded.size());
 
-  // @given wasm memory that can provide these key and values
   EXPECT_CALL(*memory_, loadN(key.address, key.length))
-      .WillRepeatedly(Return(key_data));
-  EXPECT_CALL(*memory_, loadN(value1.address, value1.length))
-      .WillOnce(Return(value_data1_encoded));
-  EXPECT_CALL(*memory_, loadN(value2.address, value2.length))
-      .WillOnce(Return(value_data2_encoded));
-
-  std::vector<kagome::scale::EncodeOpaqueValue> vals;
-  Buffer vals_encoded;
-  {
-    // @when there is no value by given key in trie
-    EXPECT_CALL(*trie_batch_, get(key_data))
-        .WillOnce(Return(outcome::failure(boost::system::error_code{})));
-
-    // @then storage is inserted by scale encoded vector containing
-    // EncodeOpaqueValue with value1
-    vals.push_back(
-        kagome::scale::EncodeOpaqueValue{value_data1_encoded.toVector()});
-    vals_encoded = Buffer(kagome::scale::encode(vals).value());
-    EXPECT_CALL(*trie_batch_, put_rvalueHack(key_data, vals_encoded))
-        .WillOnce(Return(outcome::success()));
-
-    storage_extension_->ext_storage_append_version_1(key.combine(),
-                                                     value1.combine());
-  }
-
-  {
-    // @when there is a value by given key (inserted above)
-    EXPECT_CALL(*trie_batch_, get(key_data)).WillOnce(Return(vals_encoded));
-
-    // @then storage is inserted by scale encoded vector containing two
-    // EncodeOpaqueValues with value1 and value2
-    vals.push_back(
-        kagome::scale::EncodeOpaqueValue{value_data2_encoded.toVector()});
-    vals_encoded = Buffer(kagome::scale::encode(vals).value());
-    EXPECT_CALL(*trie_batch_, put_rvalueHack(key_data, vals_encoded))
-        .WillOnce(Return(outcome::success()));
-
-    storage_extension_->ext_storage_append_version_1(key.combine(),
-                                                     value2.combine());
-  }
-}
-
-TEST_F(StorageExtensionTest, ExtStorageAppendTestCompactLenChanged) {
-  // @given key and two values
-  WasmResult key(43, 43);
-  Buffer key_data(key.length, 'k');
-
-  Buffer value_data1(42, '1');
-  Buffer value_data1_encoded{kagome::scale::encode(value_data1).value()};
-  WasmResult value1(42, value_data1_encoded.size());
-
-  Buffer value_data2(43, '2');
-  Buffer value_data2_encoded{kagome::scale::encode(value_data2).value()};
-  WasmResult value2(45, value_data2_encoded.size());
+      .WillOnce(Return(key_data));
+  EXPECT_CALL(*memory_, loadN(value.address, value.length))
+      .WillOnce(Return(value_data_encoded));
 
-  // @given wasm memory that can provide these key and values
-  EXPECT_CALL(*memory_, loadN(key.address, key.length))
-      .WillRepeatedly(Return(key_data));
-  EXPECT_CALL(*memory_, loadN(value2.address, value2.length))
-      .WillOnce(Return(value_data2_encoded));
-
-  // @when vals contains (2^6 - 1) elements (high limit for one-byte compact
-  // integers)
-  std::vector<kagome::scale::EncodeOpaqueValue> vals(
-      kagome::scale::compact::EncodingCategoryLimits::kMinUint16 - 1,
-      kagome::scale::EncodeOpaqueValue{value_data1_encoded.toVector()});
-  Buffer vals_encoded = Buffer(kagome::scale::encode(vals).value());
-
-  {
-    // @when encoded vals is stored by given key
-    EXPECT_CALL(*trie_batch_, get(key_data)).WillOnce(Return(vals_encoded));
-
-    // @when storage is inserted by one more value by the same key
-    vals.push_back(
-        kagome::scale::EncodeOpaqueValue{value_data2_encoded.toVector()});
-    vals_encoded = Buffer(kagome::scale::encode(vals).value());
-
-    // @then everything fine: storage is inserted with vals with new value
-    EXPECT_CALL(*trie_batch_, put_rvalueHack(key_data, vals_encoded))
-        .WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*trie_batch_,
+              append(key_data, gsl::span<const uint8_t>(value_data_encoded)))
+      .WillOnce(Return(outcome::success()));
 
-    storage_extension_->ext_storage_append_version_1(key.combine(),
-                                                     value2.combine());
-  }
+  storage_extension_->ext_storage_append_version_1(key.combine(),
+                                                   value.combine());
 }
 
 /**
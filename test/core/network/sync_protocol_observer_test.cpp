@@ -11,9 +11,11 @@
 #include <functional>
 
 #include "mock/core/blockchain/block_header_repository_mock.hpp"
+#include "mock/core/blockchain/block_storage_mock.hpp"
 #include "mock/core/blockchain/block_tree_mock.hpp"
 #include "mock/libp2p/host/host_mock.hpp"
 #include "primitives/block.hpp"
+#include "scale/scale.hpp"
 #include "testutil/gmock_actions.hpp"
 #include "testutil/literals.hpp"
 #include "testutil/outcome.hpp"
@@ -41,7 +43,30 @@ class SynchronizerTest : public testing::Test {
     block2_hash_.fill(4);
 
     sync_protocol_observer_ =
-        std::make_shared<SyncProtocolObserverImpl>(tree_, headers_);
+        std::make_shared<SyncProtocolObserverImpl>(tree_, headers_, storage_);
+  }
+
+  /**
+   * Makes the storage return the encodings of the block, as they are stored
+   */
+  void expectStored(const BlockHash &hash,
+                    const Block &block,
+                    boost::optional<Justification> justification) {
+    EXPECT_CALL(*storage_, getEncodedBlockHeader(BlockId{hash}))
+        .WillOnce(Return(Buffer{scale::encode(block.header).value()}));
+    BlockData block_data{hash, block.header, block.body};
+    block_data.message_queue = Buffer{0x77};
+    block_data.justification = std::move(justification);
+    EXPECT_CALL(*storage_, getEncodedBlockData(BlockId{hash}))
+        .WillOnce(Return(Buffer{scale::encode(block_data).value()}));
+  }
+
+  std::vector<Buffer> encodedBody(const Block &block) {
+    std::vector<Buffer> body;
+    for (const auto &extrinsic : block.body) {
+      body.emplace_back(scale::encode(extrinsic).value());
+    }
+    return body;
   }
 
   std::shared_ptr<HostMock> host_ = std::make_shared<HostMock>();
@@ -50,6 +75,8 @@ class SynchronizerTest : public testing::Test {
   std::shared_ptr<BlockTreeMock> tree_ = std::make_shared<BlockTreeMock>();
   std::shared_ptr<BlockHeaderRepositoryMock> headers_ =
       std::make_shared<BlockHeaderRepositoryMock>();
+  std::shared_ptr<BlockStorageMock> storage_ =
+      std::make_shared<BlockStorageMock>();
 
   std::shared_ptr<SyncProtocolObserver> sync_protocol_observer_;
 
@@ -75,20 +102,8 @@ TEST_F(SynchronizerTest, ProcessRequest) {
   EXPECT_CALL(*tree_, getChainByBlock(block1_hash_, false, 128))
       .WillOnce(Return(std::vector<BlockHash>{block1_hash_, block2_hash_}));
 
-  EXPECT_CALL(*headers_, getBlockHeader(BlockId{block1_hash_}))
-      .WillOnce(Return(block1_.header));
-  EXPECT_CALL(*headers_, getBlockHeader(BlockId{block2_hash_}))
-      .WillOnce(Return(block2_.header));
-
-  EXPECT_CALL(*tree_, getBlockBody(BlockId{block1_hash_}))
-      .WillOnce(Return(block1_.body));
-  EXPECT_CALL(*tree_, getBlockBody(BlockId{block2_hash_}))
-      .WillOnce(Return(block2_.body));
-
-  EXPECT_CALL(*tree_, getBlockJustification(BlockId{block1_hash_}))
-      .WillOnce(Return(::outcome::failure(boost::system::error_code{})));
-  EXPECT_CALL(*tree_, getBlockJustification(BlockId{block2_hash_}))
-      .WillOnce(Return(::outcome::failure(boost::system::error_code{})));
+  expectStored(block1_hash_, block1_, boost::none);
+  expectStored(block2_hash_, block2_, Justification{{0x01, 0x02}});
 
   // WHEN
   EXPECT_OUTCOME_TRUE(
@@ -97,16 +112,48 @@ TEST_F(SynchronizerTest, ProcessRequest) {
   // THEN
   ASSERT_EQ(response.id, received_request.id);
 
-  const auto &received_blocks = response.blocks;
+  ASSERT_TRUE(response.blocks.empty());
+  const auto &received_blocks = response.encoded_blocks;
   ASSERT_EQ(received_blocks.size(), 2);
 
   ASSERT_EQ(received_blocks[0].hash, block1_hash_);
-  ASSERT_EQ(received_blocks[0].header, block1_.header);
-  ASSERT_EQ(received_blocks[0].body, block1_.body);
+  ASSERT_EQ(received_blocks[0].header,
+            Buffer{scale::encode(block1_.header).value()});
+  ASSERT_EQ(received_blocks[0].body, encodedBody(block1_));
   ASSERT_FALSE(received_blocks[0].justification);
 
   ASSERT_EQ(received_blocks[1].hash, block2_hash_);
-  ASSERT_EQ(received_blocks[1].header, block2_.header);
-  ASSERT_EQ(received_blocks[1].body, block2_.body);
-  ASSERT_FALSE(received_blocks[1].justification);
+  ASSERT_EQ(received_blocks[1].header,
+            Buffer{scale::encode(block2_.header).value()});
+  ASSERT_EQ(received_blocks[1].body, encodedBody(block2_));
+  ASSERT_EQ(received_blocks[1].justification, (Buffer{0x01, 0x02}));
+}
+
+/**
+ * @given blocks, which bodies take more than a half of the response limit
+ * @when a request for the blocks arrives
+ * @then only the first of them is sent
+ */
+TEST_F(SynchronizerTest, LimitsResponseSize) {
+  BlocksRequest received_request{1,
+                                 BlocksRequest::kBasicAttributes,
+                                 block1_hash_,
+                                 boost::none,
+                                 Direction::DESCENDING,
+                                 boost::none};
+  auto extrinsic_size = SyncProtocolObserverImpl::maxResponseBytes / 2 + 1;
+  block1_.body = {Extrinsic{Buffer(extrinsic_size, 1)}};
+  block2_.body = {Extrinsic{Buffer(extrinsic_size, 2)}};
+
+  EXPECT_CALL(*tree_, getChainByBlock(block1_hash_, false, 128))
+      .WillOnce(Return(std::vector<BlockHash>{block1_hash_, block2_hash_}));
+  expectStored(block1_hash_, block1_, boost::none);
+  expectStored(block2_hash_, block2_, boost::none);
+
+  EXPECT_OUTCOME_TRUE(
+      response, sync_protocol_observer_->onBlocksRequest(received_request));
+
+  ASSERT_EQ(response.encoded_blocks.size(), 1);
+  ASSERT_EQ(response.encoded_blocks[0].hash, block1_hash_);
+  ASSERT_EQ(response.encoded_blocks[0].body, encodedBody(block1_));
 }
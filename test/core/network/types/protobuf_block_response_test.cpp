@@ -10,6 +10,7 @@
 
 using kagome::network::ProtobufMessageAdapter;
 using kagome::network::BlocksResponse;
+using kagome::network::EncodedBlockData;
 
 using kagome::primitives::BlockHash;
 using kagome::primitives::BlockData;
@@ -83,5 +84,45 @@ TEST_F(ProtobufBlockResponseAdapterTest, Serialization) {
   }
 }
 
+/**
+ * @given `BlocksResponse` with the encodings of the parts of the blocks
+ * @when protobuf serialized into buffer
+ * @then it is the serialization of the response with the decoded blocks
+ */
+TEST_F(ProtobufBlockResponseAdapterTest, EncodedBlocks) {
+  BlocksResponse decoded;
+  BlocksResponse encoded;
+  for (auto i = 0; i < 2; ++i) {
+    auto block = response.blocks[0];
+    block.header->number = i;
+    block.receipt = boost::none;
+    block.message_queue = boost::none;
+    block.justification = kagome::primitives::Justification{Buffer{1, 2, 3}};
+    decoded.blocks.push_back(block);
+
+    EncodedBlockData encoded_block{block.hash};
+    encoded_block.header = Buffer{kagome::scale::encode(*block.header).value()};
+    encoded_block.body = std::vector<Buffer>{};
+    for (const auto &extrinsic : *block.body) {
+      encoded_block.body->emplace_back(kagome::scale::encode(extrinsic).value());
+    }
+    encoded_block.justification = block.justification->data;
+    encoded.encoded_blocks.push_back(encoded_block);
+  }
 
+  std::vector<uint8_t> decoded_data;
+  AdapterType::write(decoded, decoded_data, decoded_data.end());
+  std::vector<uint8_t> encoded_data;
+  AdapterType::write(encoded, encoded_data, encoded_data.end());
+  ASSERT_EQ(encoded_data, decoded_data);
 
+  BlocksResponse r2;
+  EXPECT_OUTCOME_TRUE_1(AdapterType::read(r2, encoded_data, encoded_data.begin()));
+  ASSERT_EQ(r2.blocks.size(), 2);
+  for (size_t ix = 0; ix < r2.blocks.size(); ++ix) {
+    ASSERT_EQ(r2.blocks[ix].hash, decoded.blocks[ix].hash);
+    ASSERT_EQ(r2.blocks[ix].header, decoded.blocks[ix].header);
+    ASSERT_EQ(r2.blocks[ix].body, decoded.blocks[ix].body);
+    ASSERT_EQ(r2.blocks[ix].justification, decoded.blocks[ix].justification);
+  }
+}
@@ -44,7 +44,7 @@ class BlockBuilderApiTest : public RuntimeTest {
  * @then the result of the check is obtained given that the provided arguments
  * were valid
  */
-TEST_F(BlockBuilderApiTest, CheckInherents) {
+TEST_P(BlockBuilderApiTest, CheckInherents) {
   EXPECT_OUTCOME_FALSE_1(
       builder_->check_inherents(createBlock(), InherentData{}));
 }
@@ -55,7 +55,7 @@ TEST_F(BlockBuilderApiTest, CheckInherents) {
  * @then the result of the check is obtained given that the provided arguments
  * were valid
  */
-TEST_F(BlockBuilderApiTest, ApplyExtrinsic) {
+TEST_P(BlockBuilderApiTest, ApplyExtrinsic) {
   EXPECT_OUTCOME_FALSE_1(builder_->apply_extrinsic(Extrinsic{Buffer{1, 2, 3}}));
 }
 
@@ -65,7 +65,7 @@ TEST_F(BlockBuilderApiTest, ApplyExtrinsic) {
  * @then the result of the check is obtained given that the provided arguments
  * were valid
  */
-TEST_F(BlockBuilderApiTest, DISABLED_RandomSeed) {
+TEST_P(BlockBuilderApiTest, DISABLED_RandomSeed) {
   EXPECT_OUTCOME_FALSE_1(builder_->random_seed());
 }
 
@@ -75,7 +75,7 @@ TEST_F(BlockBuilderApiTest, DISABLED_RandomSeed) {
  * @then the result of the check is obtained given that the provided arguments
  * were valid
  */
-TEST_F(BlockBuilderApiTest, InherentExtrinsics) {
+TEST_P(BlockBuilderApiTest, InherentExtrinsics) {
   EXPECT_OUTCOME_FALSE_1(builder_->inherent_extrinsics(InherentData{}));
 }
 
@@ -85,6 +85,10 @@ TEST_F(BlockBuilderApiTest, InherentExtrinsics) {
  * @then the result of the check is obtained given that the provided arguments
  * were valid
  */
-TEST_F(BlockBuilderApiTest, DISABLED_FinalizeBlock) {
+TEST_P(BlockBuilderApiTest, DISABLED_FinalizeBlock) {
   EXPECT_OUTCOME_FALSE_1(builder_->finalise_block());
 }
+
+INSTANTIATE_TEST_CASE_P(WasmExecution,
+                        BlockBuilderApiTest,
+                        ::testing::Values(false, true));
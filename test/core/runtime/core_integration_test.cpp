@@ -50,16 +50,30 @@ class CoreTest : public RuntimeTest {
  * @when version is invoked
  * @then successful result is returned
  */
-TEST_F(CoreTest, VersionTest) {
+TEST_P(CoreTest, VersionTest) {
   ASSERT_TRUE(core_->version(boost::none));
 }
 
+/**
+ * @given initialized core api
+ * @when version is invoked twice
+ * @then the second result is taken from the cache of pure calls, and equals
+ * the first one
+ */
+TEST_P(CoreTest, VersionIsCached) {
+  EXPECT_OUTCOME_TRUE(version, core_->version(boost::none));
+  ASSERT_EQ(runtime_manager_->callCache().size(), 1);
+  EXPECT_OUTCOME_TRUE(cached_version, core_->version(boost::none));
+  ASSERT_EQ(cached_version, version);
+  ASSERT_EQ(runtime_manager_->callCache().size(), 1);
+}
+
 /**
  * @given initialized core api
  * @when execute_block is invoked
  * @then successful result is returned
  */
-TEST_F(CoreTest, DISABLED_ExecuteBlockTest) {
+TEST_P(CoreTest, DISABLED_ExecuteBlockTest) {
   auto block = createBlock();
 
   ASSERT_TRUE(core_->execute_block(block));
@@ -70,7 +84,7 @@ TEST_F(CoreTest, DISABLED_ExecuteBlockTest) {
  * @when initialise_block is invoked
  * @then successful result is returned
  */
-TEST_F(CoreTest, DISABLED_InitializeBlockTest) {
+TEST_P(CoreTest, DISABLED_InitializeBlockTest) {
   auto header = createBlockHeader();
 
   ASSERT_TRUE(core_->initialise_block(header));
@@ -81,7 +95,11 @@ TEST_F(CoreTest, DISABLED_InitializeBlockTest) {
  * @when authorities is invoked
  * @then successful result is returned
  */
-TEST_F(CoreTest, DISABLED_AuthoritiesTest) {
+TEST_P(CoreTest, DISABLED_AuthoritiesTest) {
   BlockId block_id = 0;
   ASSERT_TRUE(core_->authorities(block_id));
 }
+
+INSTANTIATE_TEST_CASE_P(WasmExecution,
+                        CoreTest,
+                        ::testing::Values(false, true));
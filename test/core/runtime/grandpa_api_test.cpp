@@ -55,7 +55,7 @@ class GrandpaTest : public RuntimeTest {
  * @when pendingChange() is invoked
  * @then successful result is returned
  */
-TEST_F(GrandpaTest, DISABLED_PendingChange) {
+TEST_P(GrandpaTest, DISABLED_PendingChange) {
   auto &&digest = createDigest();
   ASSERT_TRUE(api_->pending_change(digest));
 }
@@ -65,7 +65,7 @@ TEST_F(GrandpaTest, DISABLED_PendingChange) {
  * @when pendingChange() is invoked
  * @then successful result is returned
  */
-TEST_F(GrandpaTest, DISABLED_ForcedChange) {
+TEST_P(GrandpaTest, DISABLED_ForcedChange) {
   auto &&digest = createDigest();
   ASSERT_TRUE(api_->forced_change(digest));
 }
@@ -76,7 +76,11 @@ TEST_F(GrandpaTest, DISABLED_ForcedChange) {
  * @then successful result is returned
  * @brief writes "Uninteresting mock function call - returning default value"
  */
-TEST_F(GrandpaTest, DISABLED_Authorities) {
+TEST_P(GrandpaTest, DISABLED_Authorities) {
   auto block_id = createBlockId();
   ASSERT_TRUE(api_->authorities(block_id));
 }
+
+INSTANTIATE_TEST_CASE_P(WasmExecution,
+                        GrandpaTest,
+                        ::testing::Values(false, true));
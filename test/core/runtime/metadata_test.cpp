@@ -38,6 +38,10 @@ class MetadataTest : public RuntimeTest {
  * @when metadata() is invoked
  * @then successful result is returned
  */
-TEST_F(MetadataTest, metadata) {
+TEST_P(MetadataTest, metadata) {
   ASSERT_TRUE(api_->metadata({}));
 }
+
+INSTANTIATE_TEST_CASE_P(WasmExecution,
+                        MetadataTest,
+                        ::testing::Values(false, true));
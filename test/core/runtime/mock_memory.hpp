@@ -6,6 +6,8 @@
 #ifndef KAGOME_TEST_CORE_RUNTIME_MOCK_MEMORY_HPP_
 #define KAGOME_TEST_CORE_RUNTIME_MOCK_MEMORY_HPP_
 
+#include <list>
+
 #include <gmock/gmock.h>
 #include <boost/optional.hpp>
 #include "runtime/wasm_memory.hpp"
@@ -32,6 +34,12 @@ namespace kagome::runtime {
     MOCK_CONST_METHOD2(loadN, common::Buffer(WasmPointer, WasmSize));
     MOCK_CONST_METHOD2(loadStr, std::string(WasmPointer, WasmSize));
 
+    /// Views are served by loadN, so that its expectations cover both
+    gsl::span<const uint8_t> view(WasmPointer addr,
+                                  WasmSize n) const override {
+      return views_.emplace_back(loadN(addr, n));
+    }
+
     MOCK_METHOD2(store8, void(WasmPointer, int8_t));
     MOCK_METHOD2(store16, void(WasmPointer, int16_t));
     MOCK_METHOD2(store32, void(WasmPointer, int32_t));
@@ -39,6 +47,10 @@ namespace kagome::runtime {
     MOCK_METHOD2(store128, void(WasmPointer, const std::array<uint8_t, 16> &));
     MOCK_METHOD2(storeBuffer, void(WasmPointer, gsl::span<const uint8_t>));
     MOCK_METHOD1(storeBuffer, WasmSpan(gsl::span<const uint8_t>));
+
+   private:
+    // keeps the loaded bytes alive for the spans returned by view
+    mutable std::list<common::Buffer> views_;
   };
 
 }  // namespace kagome::runtime
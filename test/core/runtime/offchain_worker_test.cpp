@@ -45,6 +45,10 @@ class OffchainWorkerTest : public RuntimeTest {
  * @when offchain_worker() is invoked
  * @then successful result is returned
  */
-TEST_F(OffchainWorkerTest, DISABLED_OffchainWorkerCallSuccess) {
+TEST_P(OffchainWorkerTest, DISABLED_OffchainWorkerCallSuccess) {
   ASSERT_TRUE(api_->offchain_worker(createBlockNumber()));
 }
+
+INSTANTIATE_TEST_CASE_P(WasmExecution,
+                        OffchainWorkerTest,
+                        ::testing::Values(false, true));
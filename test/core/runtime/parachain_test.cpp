@@ -51,7 +51,7 @@ class ParachainHostTest : public RuntimeTest {
  * @when dutyRoster() is invoked
  * @then successful result is returned
  */
-TEST_F(ParachainHostTest, DISABLED_DutyRosterTest) {
+TEST_P(ParachainHostTest, DISABLED_DutyRosterTest) {
   ASSERT_TRUE(api_->duty_roster());
 }
 
@@ -60,7 +60,7 @@ TEST_F(ParachainHostTest, DISABLED_DutyRosterTest) {
  * @when activeParachains() is invoked
  * @then successful result is returned
  */
-TEST_F(ParachainHostTest, DISABLED_ActiveParachainsTest) {
+TEST_P(ParachainHostTest, DISABLED_ActiveParachainsTest) {
   ASSERT_TRUE(api_->active_parachains());
 }
 
@@ -69,7 +69,7 @@ TEST_F(ParachainHostTest, DISABLED_ActiveParachainsTest) {
  * @when parachainHead() is invoked
  * @then successful result is returned
  */
-TEST_F(ParachainHostTest, DISABLED_ParachainHeadTest) {
+TEST_P(ParachainHostTest, DISABLED_ParachainHeadTest) {
   auto id = createParachainId();
   ASSERT_TRUE(api_->parachain_head(id));
 }
@@ -79,7 +79,7 @@ TEST_F(ParachainHostTest, DISABLED_ParachainHeadTest) {
  * @when parachain_code() is invoked
  * @then successful result is returned
  */
-TEST_F(ParachainHostTest, DISABLED_ParachainCodeTest) {
+TEST_P(ParachainHostTest, DISABLED_ParachainCodeTest) {
   auto id = createParachainId();
   ASSERT_TRUE(api_->parachain_code(id));
 }
@@ -89,6 +89,10 @@ TEST_F(ParachainHostTest, DISABLED_ParachainCodeTest) {
  * @when validators() is invoked
  * @then successful result is returned
  */
-TEST_F(ParachainHostTest, DISABLED_ValidatorsTest) {
+TEST_P(ParachainHostTest, DISABLED_ValidatorsTest) {
   ASSERT_TRUE(api_->validators());
 }
+
+INSTANTIATE_TEST_CASE_P(WasmExecution,
+                        ParachainHostTest,
+                        ::testing::Values(false, true));
@@ -0,0 +1,73 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/binaryen/runtime_api/runtime_call_cache.hpp"
+
+#include <gtest/gtest.h>
+
+using kagome::common::Buffer;
+using kagome::common::Hash256;
+using kagome::runtime::binaryen::RuntimeCallCache;
+
+/**
+ * @given names of runtime methods
+ * @when checking whether they are pure
+ * @then only the whitelisted ones are
+ */
+TEST(RuntimeCallCacheTest, PureMethods) {
+  ASSERT_TRUE(RuntimeCallCache::isPure("Core_version"));
+  ASSERT_TRUE(RuntimeCallCache::isPure("Metadata_metadata"));
+  ASSERT_FALSE(RuntimeCallCache::isPure("Core_execute_block"));
+  ASSERT_FALSE(RuntimeCallCache::isPure("Core_version_"));
+}
+
+/**
+ * @given a cache with a result
+ * @when getting results of the same call, and of calls with other code,
+ * method or arguments
+ * @then only the same call is found
+ */
+TEST(RuntimeCallCacheTest, KeyedByCodeMethodAndArgs) {
+  RuntimeCallCache cache;
+  Hash256 code_hash;
+  code_hash.fill(1);
+  RuntimeCallCache::Key key{code_hash, "Core_version", Buffer{1, 2}};
+  cache.put(key, Buffer{42});
+
+  ASSERT_EQ(cache.get(key), Buffer{42});
+
+  auto other_code = key;
+  other_code.code_hash.fill(2);
+  ASSERT_FALSE(cache.get(other_code));
+
+  auto other_method = key;
+  other_method.method = "Metadata_metadata";
+  ASSERT_FALSE(cache.get(other_method));
+
+  auto other_args = key;
+  other_args.args = Buffer{1};
+  ASSERT_FALSE(cache.get(other_args));
+}
+
+/**
+ * @given a cache filled up to its capacity
+ * @when putting one more result
+ * @then the older results are dropped, so that the cache stays bounded
+ */
+TEST(RuntimeCallCacheTest, Bounded) {
+  RuntimeCallCache cache;
+  RuntimeCallCache::Key key{Hash256{}, "Core_version", Buffer{}};
+  for (size_t i = 0; i < RuntimeCallCache::kCapacity; ++i) {
+    key.code_hash[0] = i % 256;
+    key.code_hash[1] = i / 256;
+    cache.put(key, Buffer{});
+  }
+  ASSERT_EQ(cache.size(), RuntimeCallCache::kCapacity);
+
+  key.code_hash.fill(0xff);
+  cache.put(key, Buffer{1});
+  ASSERT_EQ(cache.size(), 1);
+  ASSERT_EQ(cache.get(key), Buffer{1});
+}
@@ -5,6 +5,8 @@
 
 #include "runtime/binaryen/runtime_external_interface.hpp"
 
+#include <algorithm>
+
 #include <binaryen/wasm-s-parser.h>
 #include <boost/format.hpp>
 #include <crypto/crypto_store/key_type.hpp>
@@ -105,6 +107,7 @@ class REITest : public ::testing::Test {
 
     // interpret module
     ModuleInstance instance(wasm, &rei);
+    host_function_stats_ = rei.getHostFunctionStats();
   }
 
  protected:
@@ -112,6 +115,8 @@ class REITest : public ::testing::Test {
   std::unique_ptr<ExtensionMock> extension_;
   std::shared_ptr<ExtensionFactoryMock> extension_factory_;
   std::shared_ptr<TrieStorageProviderMock> storage_provider_;
+  std::vector<RuntimeExternalInterface::HostFunctionStats>
+      host_function_stats_;
 
   // clang-format off
   const std::string wasm_template_ =
@@ -181,16 +186,16 @@ class REITest : public ::testing::Test {
       /// version 1
       "  (import \"env\" \"ext_crypto_start_batch_verify\" (func $ext_crypto_start_batch_verify_version_1 (type 11)))\n"
       "  (import \"env\" \"ext_crypto_finish_batch_verify\" (func $ext_crypto_finish_batch_verify_version_1 (type 35)))\n"
-      "  (import \"env\" \"ext_crypto_ed25519_public_keys_version_1\" (func $ext_crypto_ed25519_public_keys_version_1 (type 29)))\n"
+      "  (import \"env\" \"ext_crypto_ed25519_public_keys_version_1\" (func $ext_crypto_ed25519_public_keys_version_1 (type 14)))\n"
       "  (import \"env\" \"ext_crypto_ed25519_generate_version_1\" (func $ext_crypto_ed25519_generate_version_1 (type 30)))\n"
       "  (import \"env\" \"ext_crypto_ed25519_sign_version_1\" (func $ext_crypto_ed25519_sign_version_1 (type 31)))\n"
       "  (import \"env\" \"ext_crypto_ed25519_verify_version_1\" (func $ext_crypto_ed25519_verify_version_1 (type 32)))\n"
-      "  (import \"env\" \"ext_crypto_sr25519_public_keys_version_1\" (func $ext_crypto_sr25519_public_keys_version_1 (type 29)))\n"
+      "  (import \"env\" \"ext_crypto_sr25519_public_keys_version_1\" (func $ext_crypto_sr25519_public_keys_version_1 (type 14)))\n"
       "  (import \"env\" \"ext_crypto_sr25519_generate_version_1\" (func $ext_crypto_sr25519_generate_version_1 (type 30)))\n"
       "  (import \"env\" \"ext_crypto_sr25519_sign_version_1\" (func $ext_crypto_sr25519_sign_version_1 (type 31)))\n"
       "  (import \"env\" \"ext_crypto_sr25519_verify_version_2\" (func $ext_crypto_sr25519_verify_version_2 (type 32)))\n"
-      "  (import \"env\" \"ext_crypto_secp256k1_ecdsa_recover_version_1\" (func $ext_crypto_secp256k1_ecdsa_recover_version_1 (type 31)))\n"
-      "  (import \"env\" \"ext_crypto_secp256k1_ecdsa_recover_compressed_version_1\" (func $ext_crypto_secp256k1_ecdsa_recover_compressed_version_1 (type 31)))\n"
+      "  (import \"env\" \"ext_crypto_secp256k1_ecdsa_recover_version_1\" (func $ext_crypto_secp256k1_ecdsa_recover_version_1 (type 23)))\n"
+      "  (import \"env\" \"ext_crypto_secp256k1_ecdsa_recover_compressed_version_1\" (func $ext_crypto_secp256k1_ecdsa_recover_compressed_version_1 (type 23)))\n"
 
       /// hashing methods
       "  (import \"env\" \"ext_hashing_keccak_256_version_1\" (func $ext_hashing_keccak_256_version_1 (type 34)))\n"
@@ -258,6 +263,28 @@ TEST_F(REITest, ext_malloc_Test) {
   executeWasm(execute_code);
 }
 
+/**
+ * @given runtime external interface
+ * @when host functions are invoked from WASM
+ * @then the calls are counted for each host function
+ */
+TEST_F(REITest, HostFunctionStats) {
+  EXPECT_CALL(*extension_, ext_malloc(_)).WillRepeatedly(Return(8));
+  EXPECT_CALL(*extension_, ext_free(8)).Times(1);
+  executeWasm(
+      "    (drop (call $ext_malloc (i32.const 42)))\n"
+      "    (drop (call $ext_malloc (i32.const 42)))\n"
+      "    (call $ext_free (i32.const 8))\n");
+
+  ASSERT_EQ(host_function_stats_.size(), 2);
+  auto malloc_stats = std::find_if(
+      host_function_stats_.begin(),
+      host_function_stats_.end(),
+      [](const auto &stats) { return stats.name == "ext_malloc"; });
+  ASSERT_NE(malloc_stats, host_function_stats_.end());
+  ASSERT_EQ(malloc_stats->calls, 2);
+}
+
 TEST_F(REITest, ext_free_Test) {
   WasmPointer ptr = 123;
   EXPECT_CALL(*extension_, ext_free(ptr)).Times(1);
@@ -37,7 +37,11 @@
 #include "testutil/outcome.hpp"
 #include "testutil/runtime/common/basic_wasm_provider.hpp"
 
-class RuntimeTest : public ::testing::Test {
+/**
+ * Runs the runtime code as is or optimized by binaryen passes, as told by the
+ * parameter, so that both ways of execution pass the same tests
+ */
+class RuntimeTest : public ::testing::TestWithParam<bool> {
  public:
   using Buffer = kagome::common::Buffer;
   using Block = kagome::primitives::Block;
@@ -53,6 +57,12 @@ class RuntimeTest : public ::testing::Test {
 
     auto storage_provider =
         std::make_shared<kagome::runtime::TrieStorageProviderMock>();
+    // the calls of all threads share the mock
+    std::weak_ptr<kagome::runtime::TrieStorageProvider> weak_provider =
+        storage_provider;
+    ON_CALL(*storage_provider, createThreadProvider())
+        .WillByDefault(
+            testing::Invoke([weak_provider] { return weak_provider.lock(); }));
     ON_CALL(*storage_provider, getCurrentBatch())
         .WillByDefault(testing::Invoke(
             []() { return std::make_unique<PersistentTrieBatchMock>(); }));
@@ -102,6 +112,7 @@ class RuntimeTest : public ::testing::Test {
             hasher,
             crypto_store,
             bip39_provider,
+            std::make_shared<kagome::extensions::BatchVerificationPool>(1),
             [this](
                 std::shared_ptr<kagome::runtime::WasmProvider> wasm_provider) {
               kagome::runtime::binaryen::CoreFactoryImpl factory(
@@ -113,7 +124,9 @@ class RuntimeTest : public ::testing::Test {
             });
 
     auto module_factory =
-        std::make_shared<kagome::runtime::binaryen::WasmModuleFactoryImpl>();
+        std::make_shared<kagome::runtime::binaryen::WasmModuleFactoryImpl>(
+            kagome::runtime::binaryen::WasmModuleFactoryImpl::Configuration{
+                GetParam()});
 
     auto wasm_path = boost::filesystem::path(__FILE__).parent_path().string()
                      + "/wasm/sub2dev.wasm";
@@ -124,8 +137,7 @@ class RuntimeTest : public ::testing::Test {
         std::make_shared<kagome::runtime::binaryen::RuntimeManager>(
             std::move(extension_factory),
             std::move(module_factory),
-            std::move(storage_provider),
-            std::move(hasher));
+            std::move(storage_provider));
   }
 
   kagome::primitives::BlockHeader createBlockHeader() {
@@ -7,11 +7,13 @@
 
 #include <gtest/gtest.h>
 
+#include "crypto/twox/twox.hpp"
 #include "mock/core/storage/trie/trie_batches_mock.hpp"
 #include "mock/core/storage/trie/trie_storage_mock.hpp"
 
 using namespace kagome;  // NOLINT
 
+using ::testing::_;
 using ::testing::Invoke;
 using ::testing::Return;
 
@@ -21,8 +23,26 @@ class StorageWasmProviderTest : public ::testing::Test {
     state_code_ = common::Buffer{1, 3, 3, 7};
   }
 
+  /**
+   * @return a batch, which reads \arg code from a node with \arg merkle_value
+   */
+  static auto makeBatch(common::Buffer code, common::Buffer merkle_value) {
+    using Result = outcome::result<boost::optional<common::Buffer>>;
+    auto batch = std::make_unique<storage::trie::EphemeralTrieBatchMock>();
+    EXPECT_CALL(*batch, getIfChanged(runtime::kRuntimeKey, _))
+        .WillOnce(Invoke([code, merkle_value](auto &, auto &known) -> Result {
+          if (known == merkle_value) {
+            return boost::none;
+          }
+          known = merkle_value;
+          return code;
+        }));
+    return batch;
+  }
+
  protected:
   common::Buffer state_code_;
+  common::Buffer code_merkle_value_{4, 2};
 };
 
 /**
@@ -38,20 +58,19 @@ TEST_F(StorageWasmProviderTest, GetCodeWhenNoStorageUpdates) {
   // given
   EXPECT_CALL(*trie_db, getRootHash()).WillOnce(Return(first_state_root));
   EXPECT_CALL(*trie_db, getEphemeralBatch()).WillOnce(Invoke([this]() {
-    auto batch = std::make_unique<storage::trie::EphemeralTrieBatchMock>();
-    EXPECT_CALL(*batch, get(runtime::kRuntimeKey))
-        .WillOnce(Return(state_code_));
-    return batch;
+    return makeBatch(state_code_, code_merkle_value_);
   }));
   auto wasm_provider = std::make_shared<runtime::StorageWasmProvider>(trie_db);
 
   EXPECT_CALL(*trie_db, getRootHash()).WillOnce(Return(first_state_root));
 
   // when
-  auto obtained_state_code = wasm_provider->getStateCode();
+  auto [obtained_state_code, obtained_hash] =
+      wasm_provider->getStateCodeAndHash();
 
   // then
-  ASSERT_EQ(obtained_state_code, state_code_);
+  ASSERT_EQ(*obtained_state_code, state_code_);
+  ASSERT_EQ(obtained_hash, crypto::make_twox256(state_code_));
 }
 
 /**
@@ -69,26 +88,59 @@ TEST_F(StorageWasmProviderTest, GetCodeWhenStorageUpdates) {
   // given
   EXPECT_CALL(*trie_db, getRootHash()).WillOnce(Return(first_state_root));
   EXPECT_CALL(*trie_db, getEphemeralBatch()).WillOnce(Invoke([this]() {
-    auto batch = std::make_unique<storage::trie::EphemeralTrieBatchMock>();
-    EXPECT_CALL(*batch, get(runtime::kRuntimeKey))
-        .WillOnce(Return(state_code_));
-    return batch;
+    return makeBatch(state_code_, code_merkle_value_);
   }));
   auto wasm_provider = std::make_shared<runtime::StorageWasmProvider>(trie_db);
+  EXPECT_CALL(*trie_db, getRootHash()).WillOnce(Return(first_state_root));
+  auto old_snapshot = wasm_provider->getStateCodeAndHash();
 
   common::Buffer new_state_code{1, 3, 3, 8};
   EXPECT_CALL(*trie_db, getRootHash()).WillOnce(Return(second_state_root));
   EXPECT_CALL(*trie_db, getEphemeralBatch())
       .WillOnce(Invoke([&new_state_code]() {
-        auto batch = std::make_unique<storage::trie::EphemeralTrieBatchMock>();
-        EXPECT_CALL(*batch, get(runtime::kRuntimeKey))
-            .WillOnce(Return(new_state_code));
-        return batch;
+        return makeBatch(new_state_code, common::Buffer{4, 3});
       }));
 
   // when
-  auto obtained_state_code = wasm_provider->getStateCode();
+  auto [obtained_state_code, obtained_hash] =
+      wasm_provider->getStateCodeAndHash();
+
+  // then
+  ASSERT_EQ(*obtained_state_code, new_state_code);
+  ASSERT_EQ(obtained_hash, crypto::make_twox256(new_state_code));
+  // the snapshot taken before is not affected by the update
+  ASSERT_EQ(*old_snapshot.code, state_code_);
+  ASSERT_EQ(old_snapshot.hash, crypto::make_twox256(state_code_));
+}
+
+/**
+ * @given wasm provider initialized with a storage with "state_code"
+ * @when storage root is updated, while the node of the code stays the same
+ * @then the code and its hash are kept without reading the code again
+ */
+TEST_F(StorageWasmProviderTest, GetCodeWhenCodeIsUnchanged) {
+  auto trie_db = std::make_shared<storage::trie::TrieStorageMock>();
+  common::Buffer first_state_root{1, 1, 1, 1};
+  common::Buffer second_state_root{2, 2, 2, 2};
+
+  // given
+  EXPECT_CALL(*trie_db, getRootHash()).WillOnce(Return(first_state_root));
+  EXPECT_CALL(*trie_db, getEphemeralBatch()).WillOnce(Invoke([this]() {
+    return makeBatch(state_code_, code_merkle_value_);
+  }));
+  auto wasm_provider = std::make_shared<runtime::StorageWasmProvider>(trie_db);
+  EXPECT_CALL(*trie_db, getRootHash()).WillOnce(Return(first_state_root));
+  auto code_hash = wasm_provider->getStateCodeAndHash().hash;
+
+  // when
+  EXPECT_CALL(*trie_db, getRootHash()).WillOnce(Return(second_state_root));
+  EXPECT_CALL(*trie_db, getEphemeralBatch()).WillOnce(Invoke([this]() {
+    return makeBatch(common::Buffer{}, code_merkle_value_);
+  }));
+  auto [obtained_state_code, obtained_hash] =
+      wasm_provider->getStateCodeAndHash();
 
   // then
-  ASSERT_EQ(obtained_state_code, new_state_code);
+  ASSERT_EQ(*obtained_state_code, state_code_);
+  ASSERT_EQ(obtained_hash, code_hash);
 }
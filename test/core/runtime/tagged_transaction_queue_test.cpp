@@ -37,7 +37,7 @@ class TTQTest : public RuntimeTest {
  * @then a TransactionValidity structure is obtained after successful call,
  * otherwise an outcome error
  */
-TEST_F(TTQTest, DISABLED_ValidateTransactionSuccess) {
+TEST_P(TTQTest, DISABLED_ValidateTransactionSuccess) {
   Extrinsic ext{"01020304AABB"_hex2buf};
 
   // we test now that the functions above are called sequentially
@@ -45,3 +45,7 @@ TEST_F(TTQTest, DISABLED_ValidateTransactionSuccess) {
   EXPECT_OUTCOME_TRUE_1(
       ttq_->validate_transaction(TransactionSource::External, ext));
 }
+
+INSTANTIATE_TEST_CASE_P(WasmExecution,
+                        TTQTest,
+                        ::testing::Values(false, true));
@@ -92,10 +92,13 @@ TEST_F(TrieStorageProviderTest, NestedTransactions) {
   ASSERT_OUTCOME_SUCCESS_TRY(batch0->put("E"_buf, "-"_buf));
   check(batch0, "-----");
 
+  // nested transactions are savepoints of the batch of the outermost one
+  auto current = [this] { return storage_provider_->getCurrentBatch(); };
+
   /// @when 1. start tx 1
   {  // Transaction 1 - will be commited
     ASSERT_OUTCOME_SUCCESS_TRY(storage_provider_->startTransaction());
-    auto batch1 = storage_provider_->getCurrentBatch();
+    auto batch1 = current();
 
     /// @that 1. top level state is not changed, tx1 state like top level state
     check(batch0, "-----");
@@ -111,84 +114,96 @@ TEST_F(TrieStorageProviderTest, NestedTransactions) {
     {
       /// @when 3. start tx 2
       ASSERT_OUTCOME_SUCCESS_TRY(storage_provider_->startTransaction());
-      auto batch2 = storage_provider_->getCurrentBatch();
+      ASSERT_EQ(current(), batch1);
 
-      /// @that 3. top level and tx1 state are not changed, tx2 state like tx1
-      /// state
+      /// @that 3. top level state is not changed, tx2 state like tx1 state
       check(batch0, "-----");
-      check(batch1, "1----");
-      check(batch2, "1----");
+      check(current(), "1----");
 
       /// @when 4. change next value
-      ASSERT_OUTCOME_SUCCESS_TRY(batch2->put("B"_buf, "2"_buf));
+      ASSERT_OUTCOME_SUCCESS_TRY(current()->put("B"_buf, "2"_buf));
 
-      /// @that 4. top level and tx1 state are not changed, tx2 state is changed
+      /// @that 4. top level state is not changed, tx2 state is changed
       check(batch0, "-----");
-      check(batch1, "1----");
-      check(batch2, "12---");
+      check(current(), "12---");
 
       {
         /// @when 5. start tx 3
         ASSERT_OUTCOME_SUCCESS_TRY(storage_provider_->startTransaction());
-        auto batch3 = storage_provider_->getCurrentBatch();
 
-        /// @that 5. top level, tx1, tx2 state are not changed, tx3 state like
-        /// tx2 state
+        /// @that 5. top level state is not changed, tx3 state like tx2 state
         check(batch0, "-----");
-        check(batch1, "1----");
-        check(batch2, "12---");
-        check(batch3, "12---");
+        check(current(), "12---");
 
         /// @when 6. change next value
-        ASSERT_OUTCOME_SUCCESS_TRY(batch3->put("C"_buf, "3"_buf));
+        ASSERT_OUTCOME_SUCCESS_TRY(current()->put("C"_buf, "3"_buf));
 
-        /// @that 6. top level, tx1 and tx2 state are not changed, tx3 state is
-        /// changed
+        /// @that 6. top level state is not changed, tx3 state is changed
         check(batch0, "-----");
-        check(batch1, "1----");
-        check(batch2, "12---");
-        check(batch3, "123--");
+        check(current(), "123--");
 
         /// @when 7. commit tx3
         ASSERT_OUTCOME_SUCCESS_TRY(storage_provider_->commitTransaction());
 
-        /// @that 7. top level and tx1 state are not changed, tx2 state became
-        /// like tx3
+        /// @that 7. top level state is not changed, tx2 state became like tx3
         check(batch0, "-----");
-        check(batch1, "1----");
-        check(batch2, "123--");
-        check(batch3, "123--");
+        check(current(), "123--");
       }
 
       /// @when 8. change next value
-      ASSERT_OUTCOME_SUCCESS_TRY(batch2->put("D"_buf, "2"_buf));
+      ASSERT_OUTCOME_SUCCESS_TRY(current()->put("D"_buf, "2"_buf));
 
-      /// @that 8. top level and tx1 state are not changed, tx2 state is changed
+      /// @that 8. top level state is not changed, tx2 state is changed
       check(batch0, "-----");
-      check(batch1, "1----");
-      check(batch2, "1232-");
+      check(current(), "1232-");
 
       /// @when 9. rollback tx2
       ASSERT_OUTCOME_SUCCESS_TRY(storage_provider_->rollbackTransaction());
 
-      /// @that 9. top level and tx1 state are not changed, tx2 state does not
-      /// matter anymore
+      /// @that 9. top level state is not changed, tx1 state is restored
       check(batch0, "-----");
-      check(batch1, "1----");
+      check(current(), "1----");
     }
 
     /// @when 10. change next value
-    ASSERT_OUTCOME_SUCCESS_TRY(batch1->put("E"_buf, "1"_buf));
+    ASSERT_OUTCOME_SUCCESS_TRY(current()->put("E"_buf, "1"_buf));
 
     /// @that 10. top level is not changed, tx1 state is changed
     check(batch0, "-----");
-    check(batch1, "1---1");
+    check(current(), "1---1");
 
-    /// @when 11. commit tx3
+    /// @when 11. commit tx1
     ASSERT_OUTCOME_SUCCESS_TRY(storage_provider_->commitTransaction());
 
-    /// @that 11. top level became like tx1 state
+    /// @that 11. top level became like tx1 state and is current again
     check(batch0, "1---1");
-    check(batch1, "1---1");
+    ASSERT_EQ(current(), batch0);
   }
 }
+
+/**
+ * @given a storage provider, whose current batch is persistent
+ * @when creating a provider for another thread, which sets its current batch
+ * to an ephemeral one and starts a transaction, and then to the persistent one
+ * @then the current batch and transactions of the first provider are
+ * unaffected, while both providers share the persistent batch
+ */
+TEST_F(TrieStorageProviderTest, ThreadProvider) {
+  auto persistent_batch = storage_provider_->getCurrentBatch();
+  auto thread_provider = storage_provider_->createThreadProvider();
+
+  ASSERT_OUTCOME_SUCCESS_TRY(thread_provider->setToEphemeral());
+  ASSERT_OUTCOME_SUCCESS_TRY(thread_provider->startTransaction());
+  ASSERT_OUTCOME_SUCCESS_TRY(
+      thread_provider->getCurrentBatch()->put("A"_buf, "1"_buf));
+
+  ASSERT_TRUE(storage_provider_->isCurrentlyPersistent());
+  ASSERT_EQ(storage_provider_->getCurrentBatch(), persistent_batch);
+  ASSERT_FALSE(persistent_batch->contains("A"_buf));
+  ASSERT_OUTCOME_ERROR(storage_provider_->commitTransaction(),
+                       RuntimeTransactionError::NO_TRANSACTIONS_WERE_STARTED);
+
+  ASSERT_OUTCOME_SUCCESS_TRY(thread_provider->rollbackTransaction());
+  ASSERT_OUTCOME_SUCCESS_TRY(thread_provider->setToPersistent());
+  ASSERT_EQ(thread_provider->getCurrentBatch(), persistent_batch);
+}
@@ -61,7 +61,11 @@ using kagome::storage::trie::TrieStorageImpl;
 
 namespace fs = boost::filesystem;
 
-class WasmExecutorTest : public ::testing::Test {
+/**
+ * Runs the code as is or optimized by binaryen passes, as told by the
+ * parameter
+ */
+class WasmExecutorTest : public ::testing::TestWithParam<bool> {
  public:
   void SetUp() override {
     // path to a file with wasm code in wasm/ subfolder
@@ -110,7 +114,9 @@ class WasmExecutorTest : public ::testing::Test {
             secp256k1_provider,
             hasher,
             crypto_store,
-            bip39_provider, [this, changes_tracker](
+            bip39_provider,
+            std::make_shared<kagome::extensions::BatchVerificationPool>(1),
+            [this, changes_tracker](
     std::shared_ptr<kagome::runtime::WasmProvider> wasm_provider) {
       kagome::runtime::binaryen::CoreFactoryImpl factory(
           runtime_manager_,
@@ -121,13 +127,14 @@ class WasmExecutorTest : public ::testing::Test {
     });
 
     auto module_factory =
-        std::make_shared<kagome::runtime::binaryen::WasmModuleFactoryImpl>();
+        std::make_shared<kagome::runtime::binaryen::WasmModuleFactoryImpl>(
+            kagome::runtime::binaryen::WasmModuleFactoryImpl::Configuration{
+                GetParam()});
 
     runtime_manager_ =
         std::make_shared<RuntimeManager>(std::move(extension_factory),
                                          std::move(module_factory),
-                                         storage_provider_,
-                                         std::move(hasher));
+                                         storage_provider_);
 
     executor_ = std::make_shared<WasmExecutor>();
   }
@@ -144,10 +151,10 @@ class WasmExecutorTest : public ::testing::Test {
  * @when call is invoked with wasm code with addTwo function
  * @then proper result is returned
  */
-TEST_F(WasmExecutorTest, ExecuteCode) {
+TEST_P(WasmExecutorTest, ExecuteCode) {
   EXPECT_OUTCOME_TRUE(environment,
                       runtime_manager_->createEphemeralRuntimeEnvironment(
-                          wasm_provider_->getStateCode()));
+                          *wasm_provider_));
   auto &&[module, memory, opt_batch] = std::move(environment);
 
   auto res = executor_->call(
@@ -156,3 +163,7 @@ TEST_F(WasmExecutorTest, ExecuteCode) {
   ASSERT_TRUE(res) << res.error().message();
   ASSERT_EQ(res.value().geti32(), 3);
 }
+
+INSTANTIATE_TEST_CASE_P(WasmExecution,
+                        WasmExecutorTest,
+                        ::testing::Values(false, true));
@@ -0,0 +1,54 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "runtime/binaryen/wasm_memory_impl.hpp"
+
+using kagome::runtime::WasmPointer;
+using kagome::runtime::WasmSize;
+using kagome::runtime::binaryen::LinearMemory;
+using kagome::runtime::binaryen::WasmMemoryImpl;
+
+/**
+ * Measures the allocator of WasmMemoryImpl: allocates and deallocates chunks
+ * of random sizes, mostly small ones, as runtimes do, keeping a number of them
+ * allocated. It is not a test, so it is run by hand
+ */
+int main() {
+  constexpr size_t kOperations = 1000000;
+  constexpr size_t kLiveChunks = 2000;
+  constexpr WasmSize kMemorySize = 1114112;
+
+  LinearMemory linear_memory;
+  WasmMemoryImpl memory{&linear_memory, kMemorySize};
+
+  std::mt19937 random{42};
+  std::geometric_distribution<WasmSize> small_size{0.02};
+  std::uniform_int_distribution<size_t> victim{0, kLiveChunks - 1};
+  std::vector<WasmPointer> live;
+  live.reserve(kLiveChunks);
+
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kOperations; ++i) {
+    auto size = 1 + small_size(random);
+    if (live.size() < kLiveChunks) {
+      live.push_back(memory.allocate(size));
+      continue;
+    }
+    auto &chunk = live[victim(random)];
+    memory.deallocate(chunk);
+    chunk = memory.allocate(size);
+  }
+  auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+
+  std::cout << kOperations << " allocations with " << kLiveChunks
+            << " chunks kept allocated: " << elapsed.count() << " us\n";
+  return 0;
+}
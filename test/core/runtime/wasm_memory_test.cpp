@@ -5,15 +5,21 @@
 
 #include <gtest/gtest.h>
 
+#include <random>
+#include <vector>
+
 #include "runtime/binaryen/wasm_memory_impl.hpp"
 
+using kagome::runtime::WasmPointer;
+using kagome::runtime::WasmSize;
+using kagome::runtime::binaryen::LinearMemory;
 using kagome::runtime::binaryen::WasmMemoryImpl;
 
 class MemoryHeapTest : public ::testing::Test {
  protected:
-  wasm::ShellExternalInterface interface_;
+  LinearMemory linear_memory_;
   const static uint32_t memory_size_ = 4096;  // one page size
-  WasmMemoryImpl memory_{&interface_.memory, memory_size_};
+  WasmMemoryImpl memory_{&linear_memory_, memory_size_};
 };
 
 /**
@@ -50,16 +56,18 @@ TEST_F(MemoryHeapTest, AllocatedTooBigMemoryFailed) {
   // check that ptr1 is not -1, thus memory was allocated
   ASSERT_NE(ptr1, -1);
 
-  // The memory size that can be allocated is within interval (0, kMaxMemorySize
-  // - memory_size_]. Trying to allocate more
-  auto big_memory_size = WasmMemoryImpl::kMaxMemorySize - memory_size_ + 1;
+  // The memory size that can be allocated at once is within interval (0,
+  // kMaxAllocation]. Trying to allocate more
+  auto big_memory_size = WasmMemoryImpl::kMaxAllocation + 1;
   ASSERT_EQ(memory_.allocate(big_memory_size), 0);
 }
 
 /**
  * @given memory with already allocated memory of size1
  * @when allocate memory with size2
- * @then the pointer pointing to the end of the first memory chunk is returned
+ * @then the pointer pointing to the end of the first memory chunk, which is
+ * rounded up to a power of two, after the header of the second chunk is
+ * returned
  */
 TEST_F(MemoryHeapTest, ReturnOffsetWhenAllocated) {
   const size_t size1 = 2049;
@@ -67,19 +75,20 @@ TEST_F(MemoryHeapTest, ReturnOffsetWhenAllocated) {
 
   // allocate memory of size 1
   auto ptr1 = memory_.allocate(size1);
-  // first memory chunk is always allocated at 1
-  ASSERT_EQ(ptr1, 1);
+  // first memory chunk is always allocated after its 8-byte header
+  ASSERT_EQ(ptr1, 8);
 
   // allocated second memory chunk
   auto ptr2 = memory_.allocate(size2);
-  // second memory chunk is placed right after the first one (alligned by 4)
-  ASSERT_EQ(ptr2, kagome::runtime::binaryen::roundUpAlign(size1 + ptr1));
+  // second memory chunk is placed right after the first one of 4096 bytes
+  ASSERT_EQ(ptr2, ptr1 + 4096 + 8);
 }
 
 /**
  * @given memory with allocated memory chunk
- * @when this memory is deallocated
- * @then the size of this memory chunk is returned
+ * @when this memory is deallocated twice
+ * @then the size of this memory chunk, which is the least size of a chunk, is
+ * returned, and none is returned the second time
  */
 TEST_F(MemoryHeapTest, DeallocateExisingMemoryChunk) {
   const size_t size1 = 3;
@@ -88,7 +97,8 @@ TEST_F(MemoryHeapTest, DeallocateExisingMemoryChunk) {
 
   auto opt_deallocated_size = memory_.deallocate(ptr1);
   ASSERT_TRUE(opt_deallocated_size.has_value());
-  ASSERT_EQ(*opt_deallocated_size, size1);
+  ASSERT_EQ(*opt_deallocated_size, WasmMemoryImpl::kMinAllocation);
+  ASSERT_FALSE(memory_.deallocate(ptr1).has_value());
 }
 
 /**
@@ -134,30 +144,98 @@ TEST_F(MemoryHeapTest, AllocateAfterDeallocate) {
 
 /**
  * @given full memory with deallocated memory chunk of size1
- * @when allocate memory chunk of size bigger than size1
- * @then allocate returns memory of size bigger
+ * @when allocate memory chunk of size bigger than the chunk of size1
+ * @then allocate returns memory after the allocated chunks
  */
 TEST_F(MemoryHeapTest, AllocateTooBigMemoryAfterDeallocate) {
-  // two memory sizes totalling to the total memory size
+  // chunks of 2048 and 4096 bytes
   const size_t size1 = 2047;
   const size_t size2 = 2049;
 
-  // allocate two memory chunks with total size equal to the memory size
   auto ptr1 = memory_.allocate(size1);
   auto ptr2 = memory_.allocate(size2);
 
   // calculate memory offset after two allocations
-  auto mem_offset = ptr2 + size2;
+  auto mem_offset = ptr2 + 4096;
 
   // deallocate first memory chunk
   memory_.deallocate(ptr1);
 
-  // allocate new memory chunk with bigger size than the space left in the
-  // memory
-  auto ptr3 = memory_.allocate(size1 + 1);
+  // allocate new memory chunk with bigger size than the deallocated chunk
+  auto ptr3 = memory_.allocate(2048 + 1);
+
+  // memory is allocated after the header placed on mem offset
+  ASSERT_EQ(ptr3, mem_offset + 8);
+}
+
+/**
+ * @given memory with deallocated chunks of the same size
+ * @when allocate memory chunks, which fit that size
+ * @then the chunks are reused, the last deallocated first
+ */
+TEST_F(MemoryHeapTest, ReuseDeallocatedChunksOfSameSize) {
+  auto ptr1 = memory_.allocate(100);
+  auto ptr2 = memory_.allocate(128);
+  auto ptr3 = memory_.allocate(20);
+
+  ASSERT_EQ(memory_.deallocate(ptr1).value(), 128);
+  ASSERT_EQ(memory_.deallocate(ptr2).value(), 128);
+
+  ASSERT_EQ(memory_.allocate(65), ptr2);
+  ASSERT_EQ(memory_.allocate(127), ptr1);
+  ASSERT_GT(memory_.allocate(128), ptr3);
+}
+
+/**
+ * @given two deallocated chunks of the same size, the link between which is
+ * overwritten by the runtime
+ * @when allocating chunks of the size
+ * @then the chunk at the head of the list is allocated, but the link is not
+ * followed and the allocation traps
+ */
+TEST_F(MemoryHeapTest, CorruptedFreeListTraps) {
+  auto ptr1 = memory_.allocate(16);
+  auto ptr2 = memory_.allocate(16);
+  memory_.deallocate(ptr1);
+  memory_.deallocate(ptr2);
+
+  // the header of the chunk deallocated last links to the first one
+  memory_.store64(ptr2 - 8, 0xFFFFFFFFFFFFFFF8);
+  ASSERT_THROW(memory_.allocate(16), wasm::TrapException);
 
-  // memory is allocated on mem offset (aligned by 4)
-  ASSERT_EQ(ptr3, kagome::runtime::binaryen::roundUpAlign(mem_offset));
+  memory_.store64(ptr2 - 8, ptr2 + 1024);
+  ASSERT_THROW(memory_.allocate(16), wasm::TrapException);
+
+  memory_.store64(ptr2 - 8, ptr1 - 8);
+  ASSERT_EQ(memory_.allocate(16), ptr2);
+  ASSERT_EQ(memory_.allocate(16), ptr1);
+}
+
+/**
+ * @given memory, in which chunks of random sizes were allocated and
+ * deallocated many times, some of them being kept allocated
+ * @when allocating a chunk of each size
+ * @then all of them are allocated
+ */
+TEST_F(MemoryHeapTest, ServesAllSizesAfterChurn) {
+  std::mt19937 random{42};
+  std::geometric_distribution<WasmSize> small_size{0.02};
+  std::uniform_int_distribution<size_t> victim{0, 199};
+  std::vector<WasmPointer> live;
+  for (size_t i = 0; i < 5000; ++i) {
+    auto size = 1 + small_size(random);
+    if (live.size() < 200) {
+      live.push_back(memory_.allocate(size));
+      continue;
+    }
+    auto &chunk = live[victim(random)];
+    memory_.deallocate(chunk);
+    chunk = memory_.allocate(size);
+  }
+
+  for (WasmSize size = 1; size <= WasmMemoryImpl::kMaxAllocation; size *= 2) {
+    ASSERT_NE(memory_.allocate(size), 0);
+  }
 }
 
 /**
@@ -179,13 +257,49 @@ TEST_F(MemoryHeapTest, LoadNTest) {
 }
 
 /**
- * @given Some memory is allocated
+ * @given a buffer stored in memory
+ * @when a view of the bytes is obtained
+ * @then it points to the stored bytes, so that later stores are seen through
+ * it
+ */
+TEST_F(MemoryHeapTest, ViewTest) {
+  kagome::common::Buffer b{1, 2, 3, 4};
+  auto ptr = memory_.allocate(b.size());
+  memory_.storeBuffer(ptr, b);
+
+  auto view = memory_.view(ptr, b.size());
+  ASSERT_EQ(b, view);
+
+  memory_.store8(ptr, 42);
+  ASSERT_EQ(view[0], 42);
+}
+
+/**
+ * @given memory of memory_size_ bytes
+ * @when bytes are accessed past the end of the memory
+ * @then the access traps instead of reading or writing out of bounds
+ */
+TEST_F(MemoryHeapTest, OutOfBoundsAccessTraps) {
+  const auto size = memory_.size();
+  ASSERT_NO_THROW(memory_.view(size - 4, 4));
+  ASSERT_THROW(memory_.view(size - 4, 5), wasm::TrapException);
+  ASSERT_THROW(memory_.loadN(size, 1), wasm::TrapException);
+  ASSERT_THROW(memory_.loadStr(0xFFFFFFFF, 2), wasm::TrapException);
+  ASSERT_THROW(memory_.storeBuffer(size - 1, kagome::common::Buffer(2, 0)),
+               wasm::TrapException);
+}
+
+/**
+ * @given Some memory is allocated and deallocated
  * @when Memory is reset
- * @then Allocated memory's offset is 1
+ * @then Allocated memory's offset is 8, right after the header
  */
 TEST_F(MemoryHeapTest, ResetTest) {
   const size_t N = 42;
-  ASSERT_EQ(memory_.allocate(N), 1);
+  ASSERT_EQ(memory_.allocate(N), 8);
+  ASSERT_EQ(memory_.allocate(N), 8 + 64 + 8);
+  memory_.deallocate(8 + 64 + 8);
   memory_.reset();
-  ASSERT_EQ(memory_.allocate(N), 1);
+  ASSERT_EQ(memory_.allocate(N), 8);
+  ASSERT_EQ(memory_.allocate(N), 8 + 64 + 8);
 }
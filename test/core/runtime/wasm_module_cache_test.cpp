@@ -0,0 +1,130 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/binaryen/module/wasm_module_cache.hpp"
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include "crypto/hasher/hasher_impl.hpp"
+#include "runtime/binaryen/module/wasm_module_factory_impl.hpp"
+#include "testutil/literals.hpp"
+#include "testutil/outcome.hpp"
+#include "testutil/runtime/common/basic_wasm_provider.hpp"
+#include "testutil/storage/base_fs_test.hpp"
+
+using kagome::common::Buffer;
+using kagome::common::Hash256;
+using kagome::crypto::HasherImpl;
+using kagome::runtime::BasicWasmProvider;
+using kagome::runtime::binaryen::WasmModuleCache;
+using kagome::runtime::binaryen::WasmModuleFactoryImpl;
+
+class WasmModuleCacheTest : public test::BaseFS_Test {
+ public:
+  WasmModuleCacheTest() : BaseFS_Test("/tmp/kagome_wasm_module_cache_test") {}
+
+  void SetUp() override {
+    BaseFS_Test::SetUp();
+    code_hash.fill(0x42);
+  }
+
+  fs::path cache_directory = base_path / "runtime_cache";
+  WasmModuleCache cache{cache_directory};
+  Hash256 code_hash;
+};
+
+/**
+ * @given an empty cache
+ * @when a module is stored and loaded back
+ * @then the same module is loaded, and none is loaded for another code
+ */
+TEST_F(WasmModuleCacheTest, StoreAndLoad) {
+  ASSERT_EQ(cache.load(code_hash), boost::none);
+
+  auto module = "prepared module"_buf;
+  cache.store(code_hash, module);
+  ASSERT_EQ(cache.load(code_hash), module);
+
+  Hash256 another_hash;
+  another_hash.fill(0x24);
+  ASSERT_EQ(cache.load(another_hash), boost::none);
+}
+
+/**
+ * @given a cache with a module
+ * @when its entry is truncated, or is replaced with the one of another code
+ * or of another version of the preparation
+ * @then no module is loaded
+ */
+TEST_F(WasmModuleCacheTest, InvalidEntriesAreIgnored) {
+  cache.store(code_hash, "prepared module"_buf);
+  auto path = cache.entryPath(code_hash);
+
+  fs::resize_file(path, fs::file_size(path) - "prepared module"_buf.size());
+  ASSERT_EQ(cache.load(code_hash), boost::none);
+
+  Hash256 another_hash;
+  another_hash.fill(0x24);
+  cache.store(another_hash, "prepared module"_buf);
+  fs::rename(cache.entryPath(another_hash), path);
+  ASSERT_EQ(cache.load(code_hash), boost::none);
+
+  cache.store(code_hash, "prepared module"_buf);
+  {
+    // the version follows the magic string at the start of the header
+    std::fstream file{path.string(),
+                      std::ios::binary | std::ios::in | std::ios::out};
+    file.seekp(std::string_view{"kagome prepared wasm"}.size());
+    file.put(0x7f);
+  }
+  ASSERT_EQ(cache.load(code_hash), boost::none);
+}
+
+/**
+ * @given a cache with a module
+ * @when a byte of the module is changed in its entry
+ * @then the module does not match the checksum and is not loaded
+ */
+TEST_F(WasmModuleCacheTest, ModuleNotMatchingChecksumIsIgnored) {
+  cache.store(code_hash, "prepared module"_buf);
+  auto path = cache.entryPath(code_hash);
+  {
+    std::fstream file{path.string(),
+                      std::ios::binary | std::ios::in | std::ios::out};
+    file.seekp(-1, std::ios::end);
+    file.put('E');
+  }
+  ASSERT_EQ(cache.load(code_hash), boost::none);
+}
+
+/**
+ * @given a factory of optimized modules with the cache, which contains an
+ * invalid module for the code
+ * @when a module is created from the code
+ * @then the code is optimized, and the optimized module replaces the invalid
+ * one in the cache, so that a module is created from it afterwards
+ */
+TEST_F(WasmModuleCacheTest, FactoryStoresOptimizedModules) {
+  BasicWasmProvider wasm_provider{
+      fs::path(__FILE__).parent_path().string() + "/wasm/sumtwo.wasm"};
+  auto code_ptr = wasm_provider.getStateCodeAndHash().code;
+  auto &code = *code_ptr;
+  auto hash = HasherImpl{}.blake2b_256(code);
+  cache.store(hash, "not a wasm module"_buf);
+
+  WasmModuleFactoryImpl factory{
+      WasmModuleFactoryImpl::Configuration{true, cache_directory}};
+  EXPECT_OUTCOME_TRUE_1(factory.createModule(code, nullptr));
+  auto optimized = cache.load(hash);
+  ASSERT_TRUE(optimized);
+  ASSERT_NE(*optimized, "not a wasm module"_buf);
+
+  WasmModuleFactoryImpl another_factory{
+      WasmModuleFactoryImpl::Configuration{true, cache_directory}};
+  EXPECT_OUTCOME_TRUE_1(another_factory.createModule(code, nullptr));
+  ASSERT_EQ(cache.load(hash), optimized);
+}
@@ -0,0 +1,85 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/binaryen/module/wasm_module_instance_pool.hpp"
+
+#include <gtest/gtest.h>
+
+#include "mock/core/extensions/extension_factory_mock.hpp"
+#include "mock/core/extensions/extension_mock.hpp"
+#include "mock/core/runtime/binaryen/wasm_module_mock.hpp"
+#include "mock/core/runtime/trie_storage_provider_mock.hpp"
+
+using kagome::common::Hash256;
+using kagome::extensions::Extension;
+using kagome::extensions::ExtensionFactoryMock;
+using kagome::extensions::ExtensionMock;
+using kagome::runtime::TrieStorageProviderMock;
+using kagome::runtime::binaryen::RuntimeExternalInterface;
+using kagome::runtime::binaryen::WasmModuleInstanceMock;
+using kagome::runtime::binaryen::WasmModuleInstancePool;
+using kagome::runtime::binaryen::WasmModuleMock;
+using testing::_;
+using testing::Invoke;
+using testing::Return;
+
+class WasmModuleInstancePoolTest : public testing::Test {
+ public:
+  void SetUp() override {
+    auto extension_factory = std::make_shared<ExtensionFactoryMock>();
+    EXPECT_CALL(*extension_factory, createExtension(_, _))
+        .WillOnce(Invoke([](auto &, auto &) -> std::unique_ptr<Extension> {
+          return std::make_unique<ExtensionMock>();
+        }));
+    auto rei = std::make_shared<RuntimeExternalInterface>(
+        extension_factory, std::make_shared<TrieStorageProviderMock>());
+    pool = std::make_shared<WasmModuleInstancePool>(rei);
+    code_hash.fill(0x42);
+  }
+
+  std::shared_ptr<WasmModuleMock> module = std::make_shared<WasmModuleMock>();
+  std::shared_ptr<WasmModuleInstancePool> pool;
+  Hash256 code_hash;
+};
+
+/**
+ * @given a pool, which an instance of a module was taken from and released
+ * to
+ * @when taking an instance of the same module again
+ * @then the released instance is reset and reused instead of instantiating
+ * the module again
+ */
+TEST_F(WasmModuleInstancePoolTest, ReusesReleasedInstance) {
+  auto *instance = new WasmModuleInstanceMock;
+  EXPECT_CALL(*module, instantiateProxy(_)).WillOnce(Return(instance));
+  auto first = pool->acquire(code_hash, module);
+  ASSERT_EQ(first.get(), instance);
+  first.reset();
+  ASSERT_EQ(pool->idleCount(code_hash), 1);
+
+  EXPECT_CALL(*instance, reset()).Times(1);
+  auto second = pool->acquire(code_hash, module);
+  ASSERT_EQ(second.get(), instance);
+  ASSERT_EQ(pool->idleCount(code_hash), 0);
+}
+
+/**
+ * @given a pool, which an instance of a module is taken from
+ * @when taking another instance of the module before the first one is
+ * released, as a nested runtime call does
+ * @then a new instance is created, and both return to the pool once released
+ */
+TEST_F(WasmModuleInstancePoolTest, NestedCallsTakeDifferentInstances) {
+  EXPECT_CALL(*module, instantiateProxy(_))
+      .WillOnce(Return(new WasmModuleInstanceMock))
+      .WillOnce(Return(new WasmModuleInstanceMock));
+  auto outer = pool->acquire(code_hash, module);
+  auto inner = pool->acquire(code_hash, module);
+  ASSERT_NE(outer, inner);
+
+  inner.reset();
+  outer.reset();
+  ASSERT_EQ(pool->idleCount(code_hash), 2);
+}
@@ -38,4 +38,39 @@ namespace kagome::scale {
                                                   0, 3,  0, 0, 0, 4, 0, 0, 0,
                                                   5, 0,  0, 0, 2, 0, 0, 0})));
   }
+
+  /**
+   * @given an encoded vector, which length is the high limit for one-byte
+   * compact integers
+   * @when appending values to it as AppendableVec, and truncating it
+   * @then it is encoded as append_or_new_vec would encode it
+   */
+  TEST(EncodeAppend, AppendableVec) {
+    auto value = scale::encode(EncodeOpaqueValue{
+                                   scale::encode(uint32_t{42}).value()})
+                     .value();
+    std::vector<uint8_t> expected;
+    for (size_t i = 0; i < compact::EncodingCategoryLimits::kMinUint16 - 1;
+         i++) {
+      ASSERT_TRUE(append_or_new_vec(expected, value));
+    }
+
+    auto vec = AppendableVec::create(expected).value();
+    ASSERT_THAT(vec.encode(), ContainerEq(expected));
+
+    auto mark = vec.mark();
+    vec.append(value);
+    ASSERT_TRUE(append_or_new_vec(expected, value));
+    ASSERT_THAT(vec.encode(), ContainerEq(expected));
+
+    vec.truncate(mark);
+    vec.append(value);
+    ASSERT_THAT(vec.encode(), ContainerEq(expected));
+
+    auto empty = AppendableVec::create({}).value();
+    std::vector<uint8_t> new_vec;
+    empty.append(value);
+    ASSERT_TRUE(append_or_new_vec(new_vec, value));
+    ASSERT_THAT(empty.encode(), ContainerEq(new_vec));
+  }
 }  // namespace kagome::scale
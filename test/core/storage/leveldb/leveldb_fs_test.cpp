@@ -47,3 +47,20 @@ TEST_F(LevelDB_Open, OpenExistingDB) {
   boost::filesystem::path p(getPathString());
   EXPECT_TRUE(fs::exists(p));
 }
+
+/**
+ * @given a profile with a block cache and bloom filters
+ * @when open database with the profile
+ * @then database is created and its properties are available
+ */
+TEST_F(LevelDB_Open, OpenWithProfile) {
+  EXPECT_OUTCOME_TRUE_2(
+      db, LevelDB::create(getPathString(), LevelDbProfile::trieNodes()));
+  EXPECT_OUTCOME_TRUE_1(db->put(kagome::common::Buffer{1, 2, 3},
+                                kagome::common::Buffer{4, 5, 6}));
+  EXPECT_OUTCOME_TRUE(value, db->get(kagome::common::Buffer{1, 2, 3}));
+  EXPECT_EQ(value, (kagome::common::Buffer{4, 5, 6}));
+
+  EXPECT_TRUE(db->getProperty("leveldb.stats"));
+  EXPECT_FALSE(db->getProperty("leveldb.unknown"));
+}
@@ -0,0 +1,87 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/polkadot_trie/key_nibbles.hpp"
+
+#include <gtest/gtest.h>
+
+#include "testutil/literals.hpp"
+
+using kagome::storage::trie::KeyNibbles;
+using kagome::storage::trie::KeyNibblesView;
+
+/**
+ * @given nibbles of a key
+ * @when accessing them
+ * @then they are the halves of the key bytes, high ones first
+ */
+TEST(KeyNibblesTest, FromBytes) {
+  auto nibbles = KeyNibbles::fromBytes("a1b2"_hex2buf);
+  ASSERT_EQ(nibbles.size(), 4);
+  ASSERT_EQ(nibbles, (KeyNibbles{0xa, 0x1, 0xb, 0x2}));
+  ASSERT_EQ(nibbles[2], 0xb);
+  ASSERT_TRUE(KeyNibbles{}.empty());
+}
+
+/**
+ * @given nibbles
+ * @when taking views of them starting both at even and odd positions
+ * @then the views refer to the respective nibbles and are copied as such
+ */
+TEST(KeyNibblesTest, Subspan) {
+  KeyNibbles nibbles{1, 2, 3, 4, 5, 6, 7};
+
+  auto odd = nibbles.subspan(1, 4);
+  ASSERT_EQ(odd, (KeyNibbles{2, 3, 4, 5}));
+  ASSERT_EQ(odd.subspan(1), (KeyNibbles{3, 4, 5}));
+  ASSERT_EQ(KeyNibbles{odd}, (KeyNibbles{2, 3, 4, 5}));
+
+  auto even = nibbles.subspan(2);
+  ASSERT_EQ(KeyNibbles{even}, (KeyNibbles{3, 4, 5, 6, 7}));
+
+  ASSERT_TRUE(nibbles.subspan(7).empty());
+  ASSERT_TRUE(nibbles.subspan(8).empty());
+  ASSERT_EQ(nibbles.subspan(5, 10).size(), 2);
+}
+
+/**
+ * @given views of nibbles with different alignment
+ * @when calculating their common prefix length
+ * @then it is the number of leading nibbles equal in both
+ */
+TEST(KeyNibblesTest, CommonPrefixLength) {
+  KeyNibbles first{1, 2, 3, 4, 5, 6, 7, 8};
+  KeyNibbles second{0, 1, 2, 3, 4, 5, 0xf};
+
+  ASSERT_EQ(KeyNibblesView{first}.commonPrefixLength(second), 0);
+  ASSERT_EQ(first.subspan(0).commonPrefixLength(second.subspan(1)), 5);
+  ASSERT_EQ(first.subspan(1).commonPrefixLength(second.subspan(2)), 4);
+  ASSERT_EQ(first.subspan(1).commonPrefixLength(first.subspan(1, 3)), 3);
+  ASSERT_TRUE(first.subspan(1).startsWith(second.subspan(2, 4)));
+  ASSERT_FALSE(first.subspan(1).startsWith(second.subspan(2)));
+}
+
+/**
+ * @given nibbles
+ * @when appending single nibbles and views of different alignment to them
+ * @then the nibbles are concatenated
+ */
+TEST(KeyNibblesTest, Put) {
+  KeyNibbles source{1, 2, 3, 4, 5};
+  KeyNibbles nibbles;
+  nibbles.put(source.subspan(0, 4)).putNibble(0xa).put(source.subspan(1));
+  ASSERT_EQ(nibbles, (KeyNibbles{1, 2, 3, 4, 0xa, 2, 3, 4, 5}));
+}
+
+/**
+ * @given nibbles
+ * @when assigning a view of them to themselves
+ * @then the nibbles are replaced with the viewed ones
+ */
+TEST(KeyNibblesTest, AssignOwnView) {
+  KeyNibbles nibbles{1, 2, 3, 4, 5};
+  nibbles = nibbles.subspan(1);
+  ASSERT_EQ(nibbles, (KeyNibbles{2, 3, 4, 5}));
+}
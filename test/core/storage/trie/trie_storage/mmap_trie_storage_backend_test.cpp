@@ -0,0 +1,223 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/impl/mmap_trie_storage_backend.hpp"
+
+#include <gtest/gtest.h>
+
+#include "storage/database_error.hpp"
+#include "testutil/outcome.hpp"
+#include "testutil/storage/base_fs_test.hpp"
+
+using kagome::common::Buffer;
+using kagome::storage::DatabaseError;
+using kagome::storage::trie::MmapTrieStorageBackend;
+
+class MmapTrieStorageBackendTest : public test::BaseFS_Test {
+ public:
+  MmapTrieStorageBackendTest()
+      : test::BaseFS_Test("/tmp/kagome_mmap_trie_storage_test") {}
+
+  void SetUp() override {
+    BaseFS_Test::SetUp();
+    open();
+  }
+
+  void open() {
+    storage.reset();
+    // small segments, so that a few records fill one
+    MmapTrieStorageBackend::Config config{1024, 0.5, false};
+    storage = MmapTrieStorageBackend::create(base_path, config).value();
+  }
+
+  static Buffer key(uint8_t i) {
+    return Buffer{i, 0x42};
+  }
+
+  static Buffer value(uint8_t i) {
+    return Buffer(100, i);
+  }
+
+  std::shared_ptr<MmapTrieStorageBackend> storage;
+};
+
+/**
+ * @given an empty storage
+ * @when putting, overwriting and removing values
+ * @then the actual values are read, including the mapped ones
+ */
+TEST_F(MmapTrieStorageBackendTest, PutGetRemove) {
+  ASSERT_TRUE(storage->empty());
+  EXPECT_OUTCOME_TRUE_1(storage->put(key(1), value(1)));
+  EXPECT_OUTCOME_TRUE_1(storage->put(key(2), value(2)));
+  EXPECT_OUTCOME_TRUE_1(storage->put(key(1), value(3)));
+  EXPECT_OUTCOME_TRUE_1(storage->remove(key(2)));
+
+  EXPECT_OUTCOME_TRUE(v1, storage->get(key(1)));
+  ASSERT_EQ(v1, value(3));
+  EXPECT_OUTCOME_TRUE(mapped, storage->getView(key(1)));
+  ASSERT_EQ(Buffer{mapped.data}, value(3));
+  ASSERT_FALSE(storage->contains(key(2)));
+  ASSERT_EQ(storage->get(key(2)).error(), DatabaseError::NOT_FOUND);
+  ASSERT_EQ(storage->getStats().records, 1);
+}
+
+/**
+ * @given a storage written in a batch across several segments
+ * @when reopening the storage
+ * @then the same values are read
+ */
+TEST_F(MmapTrieStorageBackendTest, Reopen) {
+  auto batch = storage->batch();
+  for (uint8_t i = 0; i < 32; i++) {
+    EXPECT_OUTCOME_TRUE_1(batch->put(key(i), value(i)));
+  }
+  EXPECT_OUTCOME_TRUE_1(batch->remove(key(0)));
+  EXPECT_OUTCOME_TRUE_1(batch->commit());
+  ASSERT_GT(storage->getStats().segments, 1);
+
+  open();
+  ASSERT_FALSE(storage->contains(key(0)));
+  for (uint8_t i = 1; i < 32; i++) {
+    EXPECT_OUTCOME_TRUE(v, storage->get(key(i)));
+    ASSERT_EQ(v, value(i));
+  }
+}
+
+/**
+ * @given a storage, most of which values are removed
+ * @when compacting it
+ * @then the obsolete segments are deleted, the remaining values are still
+ * readable, as well as the value mapped before the compaction, also after
+ * reopening the storage
+ */
+TEST_F(MmapTrieStorageBackendTest, Compaction) {
+  for (uint8_t i = 0; i < 64; i++) {
+    EXPECT_OUTCOME_TRUE_1(storage->put(key(i), value(i)));
+  }
+  EXPECT_OUTCOME_TRUE(mapped, storage->getView(key(0)));
+  for (uint8_t i = 0; i < 64; i++) {
+    if (i % 8 != 0) {
+      EXPECT_OUTCOME_TRUE_1(storage->remove(key(i)));
+    }
+  }
+  auto before = storage->getStats();
+
+  EXPECT_OUTCOME_TRUE_1(storage->compact());
+  auto after = storage->getStats();
+  ASSERT_LT(after.segments, before.segments);
+  ASSERT_LT(after.total_bytes, before.total_bytes);
+  ASSERT_EQ(after.live_bytes, before.live_bytes);
+  ASSERT_EQ(Buffer{mapped.data}, value(0));
+
+  open();
+  ASSERT_EQ(storage->getStats().records, 8);
+  for (uint8_t i = 0; i < 64; i++) {
+    if (i % 8 == 0) {
+      EXPECT_OUTCOME_TRUE(v, storage->get(key(i)));
+      ASSERT_EQ(v, value(i));
+    } else {
+      ASSERT_FALSE(storage->contains(key(i)));
+    }
+  }
+}
+
+/**
+ * @given a storage, whose last record is corrupted as by a crash
+ * @when reopening it
+ * @then the preceding records are read, and new ones are written instead of
+ * the corrupted one
+ */
+TEST_F(MmapTrieStorageBackendTest, CorruptedTail) {
+  EXPECT_OUTCOME_TRUE_1(storage->put(key(1), value(1)));
+  EXPECT_OUTCOME_TRUE_1(storage->put(key(2), value(2)));
+  storage.reset();
+
+  // the kind of the second record, which follows the 13-byte header, key and
+  // value of the first one
+  fs::fstream file{base_path / "segment-0000000000",
+                   std::ios::in | std::ios::out | std::ios::binary};
+  file.seekp(13 + 2 + 100 + 8);
+  file.put(0x7f);
+  file.close();
+
+  open();
+  ASSERT_TRUE(storage->contains(key(1)));
+  ASSERT_FALSE(storage->contains(key(2)));
+  EXPECT_OUTCOME_TRUE_1(storage->put(key(3), value(3)));
+  open();
+  EXPECT_OUTCOME_TRUE(v, storage->get(key(3)));
+  ASSERT_EQ(v, value(3));
+}
+
+/**
+ * @given a storage, whose last record has a valid header, but a part of its
+ * value is not written, as by a crash, which left some pages unsynced
+ * @when reopening it
+ * @then the torn record is discarded, and the preceding ones are read
+ */
+TEST_F(MmapTrieStorageBackendTest, TornRecord) {
+  EXPECT_OUTCOME_TRUE_1(storage->put(key(1), value(1)));
+  EXPECT_OUTCOME_TRUE_1(storage->put(key(2), value(2)));
+  storage.reset();
+
+  // the end of the value of the second record
+  fs::fstream file{base_path / "segment-0000000000",
+                   std::ios::in | std::ios::out | std::ios::binary};
+  file.seekp(2 * (13 + 2 + 100) - 1);
+  file.put(0);
+  file.close();
+
+  open();
+  EXPECT_OUTCOME_TRUE(v, storage->get(key(1)));
+  ASSERT_EQ(v, value(1));
+  ASSERT_FALSE(storage->contains(key(2)));
+}
+
+/**
+ * @given a storage with values written across several segments
+ * @when iterating over it with a cursor
+ * @then all the values are visited in the order of their keys, and seeking
+ * finds the first key not less than the given one
+ */
+TEST_F(MmapTrieStorageBackendTest, Cursor) {
+  for (uint8_t i : {5, 1, 9, 3, 7}) {
+    EXPECT_OUTCOME_TRUE_1(storage->put(key(i), value(i)));
+  }
+  EXPECT_OUTCOME_TRUE_1(storage->remove(key(9)));
+
+  auto cursor = storage->cursor();
+  ASSERT_NE(cursor, nullptr);
+  std::vector<Buffer> keys;
+  EXPECT_OUTCOME_TRUE_1(cursor->seekFirst());
+  while (cursor->isValid()) {
+    keys.push_back(cursor->key().value());
+    ASSERT_EQ(cursor->value().value(), value(keys.back()[0]));
+    EXPECT_OUTCOME_TRUE_1(cursor->next());
+  }
+  ASSERT_EQ(keys, (std::vector<Buffer>{key(1), key(3), key(5), key(7)}));
+
+  EXPECT_OUTCOME_TRUE(found, cursor->seek(Buffer{4}));
+  ASSERT_TRUE(found);
+  ASSERT_EQ(cursor->key().value(), key(5));
+  EXPECT_OUTCOME_TRUE(last, cursor->seekLast());
+  ASSERT_TRUE(last);
+  ASSERT_EQ(cursor->key().value(), key(7));
+  EXPECT_OUTCOME_TRUE_1(cursor->next());
+  ASSERT_FALSE(cursor->isValid());
+}
+
+/**
+ * @given an empty storage
+ * @when putting a value by a key longer than a node hash
+ * @then it is rejected, as the index has room for a hash only
+ */
+TEST_F(MmapTrieStorageBackendTest, LongKeyRejected) {
+  Buffer long_key(33, 1);
+  ASSERT_EQ(storage->put(long_key, value(1)).error(),
+            DatabaseError::INVALID_ARGUMENT);
+  ASSERT_FALSE(storage->contains(long_key));
+  ASSERT_TRUE(storage->empty());
+}
@@ -6,13 +6,18 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include "mock/core/storage/trie/trie_batches_mock.hpp"
+#include "scale/encode_append.hpp"
 #include "storage/changes_trie/impl/storage_changes_tracker_impl.hpp"
 #include "storage/in_memory/in_memory_storage.hpp"
+#include "storage/trie/impl/mmap_trie_storage_backend.hpp"
 #include "storage/trie/impl/persistent_trie_batch_impl.hpp"
+#include "storage/trie/impl/topper_trie_batch_impl.hpp"
 #include "storage/trie/impl/trie_storage_backend_impl.hpp"
 #include "storage/trie/impl/trie_storage_impl.hpp"
 #include "storage/trie/polkadot_trie/polkadot_trie_factory_impl.hpp"
 #include "storage/trie/polkadot_trie/trie_error.hpp"
+#include "storage/trie/serialization/trie_root_builder.hpp"
 #include "storage/trie/serialization/trie_serializer_impl.hpp"
 #include "storage/trie/trie_batches.hpp"
 #include "testutil/literals.hpp"
@@ -34,7 +39,12 @@ using SessionPtr = std::shared_ptr<Session>;
 using SubscriptionEngineType =
     SubscriptionEngine<Buffer, SessionPtr, Buffer, BlockHash>;
 
-class TrieBatchTest : public test::BaseLevelDB_Test {
+/**
+ * Runs against the LevelDB backend and the memory-mapped one, as told by the
+ * parameter
+ */
+class TrieBatchTest : public test::BaseLevelDB_Test,
+                      public testing::WithParamInterface<bool> {
  public:
   TrieBatchTest() : BaseLevelDB_Test("/tmp/leveldbtest") {}
 
@@ -42,20 +52,34 @@ class TrieBatchTest : public test::BaseLevelDB_Test {
     open();
     auto factory = std::make_shared<PolkadotTrieFactoryImpl>();
     auto codec = std::make_shared<PolkadotCodec>();
-    auto serializer = std::make_shared<TrieSerializerImpl>(
-        factory,
-        codec,
-        std::make_shared<TrieStorageBackendImpl>(std::move(db_), kNodePrefix));
+    std::shared_ptr<TrieStorageBackend> backend;
+    if (GetParam()) {
+      backend = MmapTrieStorageBackend::create(
+                    kMmapPath, MmapTrieStorageBackend::Config{})
+                    .value();
+    } else {
+      backend =
+          std::make_shared<TrieStorageBackendImpl>(std::move(db_), kNodePrefix);
+    }
+    auto serializer =
+        std::make_shared<TrieSerializerImpl>(factory, codec, backend);
 
     trie = TrieStorageImpl::createEmpty(factory, codec, serializer, boost::none)
                .value();
   }
 
+  void TearDown() override {
+    trie.reset();
+    boost::filesystem::remove_all(kMmapPath);
+    BaseLevelDB_Test::TearDown();
+  }
+
   static const std::vector<std::pair<Buffer, Buffer>> data;
 
   std::unique_ptr<TrieStorage> trie;
 
   static const Buffer kNodePrefix;
+  static constexpr auto kMmapPath = "/tmp/kagome_mmap_trie_batch_test";
 };
 
 const Buffer TrieBatchTest::kNodePrefix{1};
@@ -96,7 +120,7 @@ class MockDb : public kagome::storage::InMemoryStorage {
  * @when putting some entries into it using a batch
  * @then all inserted entries are accessible from the trie
  */
-TEST_F(TrieBatchTest, Put) {
+TEST_P(TrieBatchTest, Put) {
   auto batch = trie->getPersistentBatch().value();
   FillSmallTrieWithBatch(*batch);
   // changes are not yet commited
@@ -122,12 +146,71 @@ TEST_F(TrieBatchTest, Put) {
   ASSERT_EQ(v2, "0a0b0c"_hex2buf);
 }
 
+/**
+ * @return the root of a trie with the entries, calculated without the trie
+ */
+Buffer expectedRoot(const std::map<Buffer, Buffer> &entries) {
+  TrieRootBuilder builder;
+  for (auto &[key, value] : entries) {
+    builder.add(key, value);
+  }
+  return Buffer{builder.calculateRoot().value()};
+}
+
+/**
+ * @given a persistent batch with some changes
+ * @when calculating its root in memory between the modifications, including
+ * the ones of batches, which nodes are retrieved from the storage
+ * @then the calculated roots match the ones obtained by commit and the roots
+ * of tries with the same entries built anew, and the state root of the
+ * storage is not updated until the commit
+ */
+TEST_P(TrieBatchTest, CalculateRoot) {
+  std::map<Buffer, Buffer> entries{data.begin(), data.end()};
+  auto initial_root = trie->getRootHash();
+  auto batch = trie->getPersistentBatch().value();
+  FillSmallTrieWithBatch(*batch);
+  EXPECT_OUTCOME_TRUE(root, batch->calculateRoot());
+  ASSERT_EQ(root, expectedRoot(entries));
+  ASSERT_EQ(trie->getRootHash(), initial_root);
+
+  EXPECT_OUTCOME_TRUE_1(batch->put("102030"_hex2buf, "010203"_hex2buf));
+  entries["102030"_hex2buf] = "010203"_hex2buf;
+  EXPECT_OUTCOME_TRUE(modified_root, batch->calculateRoot());
+  ASSERT_EQ(modified_root, expectedRoot(entries));
+  EXPECT_OUTCOME_TRUE(committed_root, batch->commit());
+  ASSERT_EQ(modified_root, committed_root);
+
+  // a new batch, which nodes are retrieved from the storage; the removal
+  // leaves the branch of the removed entry with a single child, which is
+  // merged into it
+  auto new_batch = trie->getPersistentBatch().value();
+  EXPECT_OUTCOME_TRUE_1(new_batch->remove(data[2].first));
+  entries.erase(data[2].first);
+  EXPECT_OUTCOME_TRUE_1(new_batch->put(data[0].first, "abcdef"_hex2buf));
+  entries[data[0].first] = "abcdef"_hex2buf;
+  EXPECT_OUTCOME_TRUE(new_root, new_batch->calculateRoot());
+  ASSERT_EQ(new_root, expectedRoot(entries));
+  EXPECT_OUTCOME_TRUE(new_committed_root, new_batch->commit());
+  ASSERT_EQ(new_root, new_committed_root);
+
+  // the cleared prefix detaches a subtrie of a batch from the storage
+  auto cleared_batch = trie->getPersistentBatch().value();
+  EXPECT_OUTCOME_TRUE_1(cleared_batch->clearPrefix("12"_hex2buf));
+  entries.erase(data[0].first);
+  entries.erase(data[1].first);
+  EXPECT_OUTCOME_TRUE(cleared_root, cleared_batch->calculateRoot());
+  ASSERT_EQ(cleared_root, expectedRoot(entries));
+  EXPECT_OUTCOME_TRUE(cleared_committed_root, cleared_batch->commit());
+  ASSERT_EQ(cleared_root, cleared_committed_root);
+}
+
 /**
  * @given a small trie
  * @when removing some entries from it using a batch
  * @then removed entries are no longer in the trie, while the rest of them stays
  */
-TEST_F(TrieBatchTest, Remove) {
+TEST_P(TrieBatchTest, Remove) {
   auto batch = trie->getPersistentBatch().value();
   FillSmallTrieWithBatch(*batch);
 
@@ -151,7 +234,7 @@ TEST_F(TrieBatchTest, Remove) {
  * batch
  * @then the value on the key is updated
  */
-TEST_F(TrieBatchTest, Replace) {
+TEST_P(TrieBatchTest, Replace) {
   auto batch = trie->getPersistentBatch().value();
   EXPECT_OUTCOME_TRUE_1(batch->put(data[1].first, data[3].second));
   EXPECT_OUTCOME_TRUE_1(batch->commit());
@@ -166,7 +249,7 @@ TEST_F(TrieBatchTest, Replace) {
  * @then no changes from the failing batch reach the trie, thus guaranteeing its
  * consistency
  */
-TEST_F(TrieBatchTest, ConsistentOnFailure) {
+TEST_P(TrieBatchTest, ConsistentOnFailure) {
   auto db = std::make_unique<MockDb>();
   /**
    * Five times the storage will function correctly, after which it will yield
@@ -206,7 +289,7 @@ TEST_F(TrieBatchTest, ConsistentOnFailure) {
   ASSERT_EQ(trie->getRootHash(), old_root);
 }
 
-TEST_F(TrieBatchTest, TopperBatchAtomic) {
+TEST_P(TrieBatchTest, TopperBatchAtomic) {
   std::shared_ptr<PersistentTrieBatch> p_batch =
       trie->getPersistentBatch().value();
   EXPECT_OUTCOME_TRUE_1(p_batch->put("123"_buf, "abc"_buf));
@@ -232,3 +315,211 @@ TEST_F(TrieBatchTest, TopperBatchAtomic) {
   ASSERT_TRUE(p_batch->contains("678"_buf));
   ASSERT_FALSE(p_batch->contains("123"_buf));
 }
+
+/**
+ * @given a topper batch with nested savepoints, in which values are put and
+ * prefixes are cleared
+ * @when rolling back and releasing the savepoints
+ * @then the batch returns to the states at the savepoints, keeping the
+ * released changes, and writes back only the changes it kept
+ */
+TEST_P(TrieBatchTest, TopperBatchSavepoints) {
+  std::shared_ptr<PersistentTrieBatch> p_batch =
+      trie->getPersistentBatch().value();
+  EXPECT_OUTCOME_TRUE_1(p_batch->put("abc"_buf, "1"_buf));
+  EXPECT_OUTCOME_TRUE_1(p_batch->put("abd"_buf, "1"_buf));
+  EXPECT_OUTCOME_TRUE_1(p_batch->put("b"_buf, "1"_buf));
+
+  auto t_batch = p_batch->batchOnTop();
+  ASSERT_FALSE(t_batch->rollbackToSavepoint());
+  EXPECT_OUTCOME_TRUE_1(t_batch->put("abe"_buf, "2"_buf));
+
+  t_batch->setSavepoint();
+  EXPECT_OUTCOME_TRUE_1(t_batch->clearPrefix("abc"_buf));
+  EXPECT_OUTCOME_TRUE_1(t_batch->put("b"_buf, "3"_buf));
+
+  t_batch->setSavepoint();
+  EXPECT_OUTCOME_TRUE_1(t_batch->clearPrefix("ab"_buf));
+  EXPECT_OUTCOME_TRUE_1(t_batch->put("abf"_buf, "4"_buf));
+  ASSERT_FALSE(t_batch->contains("abc"_buf));
+  ASSERT_FALSE(t_batch->contains("abd"_buf));
+  ASSERT_FALSE(t_batch->contains("abe"_buf));
+  ASSERT_TRUE(t_batch->contains("abf"_buf));
+
+  // the state at the second savepoint
+  EXPECT_OUTCOME_TRUE_1(t_batch->rollbackToSavepoint());
+  ASSERT_FALSE(t_batch->contains("abc"_buf));
+  ASSERT_TRUE(t_batch->contains("abd"_buf));
+  ASSERT_TRUE(t_batch->contains("abe"_buf));
+  ASSERT_FALSE(t_batch->contains("abf"_buf));
+  EXPECT_OUTCOME_TRUE(b, t_batch->get("b"_buf));
+  ASSERT_EQ(b, "3"_buf);
+
+  EXPECT_OUTCOME_TRUE_1(t_batch->releaseSavepoint());
+  ASSERT_FALSE(t_batch->releaseSavepoint());
+
+  EXPECT_OUTCOME_TRUE_1(t_batch->writeBack());
+  ASSERT_FALSE(p_batch->contains("abc"_buf));
+  ASSERT_TRUE(p_batch->contains("abd"_buf));
+  ASSERT_TRUE(p_batch->contains("abe"_buf));
+  EXPECT_OUTCOME_TRUE(p_b, p_batch->get("b"_buf));
+  ASSERT_EQ(p_b, "3"_buf);
+}
+
+/**
+ * @given a persistent batch with a vector of values
+ * @when appending values to the vector
+ * @then the vector with the appended values is read and committed, as if it
+ * was put at once
+ */
+TEST_P(TrieBatchTest, PersistentBatchAppend) {
+  auto key = "events"_buf;
+  std::vector<kagome::scale::EncodeOpaqueValue> values;
+  std::vector<Buffer> encoded_values;
+  for (uint32_t i = 0; i < 100; i++) {
+    encoded_values.emplace_back(kagome::scale::encode(i).value());
+  }
+  for (auto &value : encoded_values) {
+    values.push_back({value});
+  }
+  Buffer expected{kagome::scale::encode(values).value()};
+
+  auto expected_batch = trie->getPersistentBatch().value();
+  EXPECT_OUTCOME_TRUE_1(expected_batch->put(key, expected));
+  EXPECT_OUTCOME_TRUE(expected_root, expected_batch->calculateRoot());
+
+  auto batch = trie->getPersistentBatch().value();
+  for (auto &value : encoded_values) {
+    EXPECT_OUTCOME_TRUE_1(batch->append(key, value));
+  }
+  ASSERT_TRUE(batch->contains(key));
+  EXPECT_OUTCOME_TRUE(value, batch->get(key));
+  ASSERT_EQ(value, expected);
+  EXPECT_OUTCOME_TRUE(root, batch->commit());
+  ASSERT_EQ(root, expected_root);
+}
+
+/**
+ * @given a topper batch with nested savepoints
+ * @when appending values to a vector of the parent batch, rolling back a
+ * savepoint and overwriting another vector
+ * @then only the values appended before the savepoint and the overwritten
+ * value are written back
+ */
+TEST_P(TrieBatchTest, TopperBatchAppend) {
+  auto one = kagome::scale::encode(uint32_t{1}).value();
+  auto two = kagome::scale::encode(uint32_t{2}).value();
+  auto vec = [](std::vector<gsl::span<const uint8_t>> values) {
+    std::vector<uint8_t> encoded;
+    for (auto &value : values) {
+      EXPECT_TRUE(kagome::scale::append_or_new_vec(encoded, value));
+    }
+    return Buffer{encoded};
+  };
+
+  std::shared_ptr<PersistentTrieBatch> p_batch =
+      trie->getPersistentBatch().value();
+  EXPECT_OUTCOME_TRUE_1(p_batch->put("a"_buf, vec({one})));
+
+  auto t_batch = p_batch->batchOnTop();
+  EXPECT_OUTCOME_TRUE_1(t_batch->append("a"_buf, one));
+  EXPECT_OUTCOME_TRUE_1(t_batch->append("b"_buf, one));
+
+  t_batch->setSavepoint();
+  EXPECT_OUTCOME_TRUE_1(t_batch->append("a"_buf, two));
+  EXPECT_OUTCOME_TRUE_1(t_batch->put("b"_buf, "x"_buf));
+  EXPECT_OUTCOME_TRUE(a, t_batch->get("a"_buf));
+  ASSERT_EQ(a, vec({one, one, two}));
+  EXPECT_OUTCOME_TRUE_1(t_batch->rollbackToSavepoint());
+
+  EXPECT_OUTCOME_TRUE(b, t_batch->get("b"_buf));
+  ASSERT_EQ(b, vec({one}));
+  EXPECT_OUTCOME_TRUE_1(t_batch->put("b"_buf, "x"_buf));
+
+  EXPECT_OUTCOME_TRUE_1(t_batch->writeBack());
+  EXPECT_OUTCOME_TRUE(p_a, p_batch->get("a"_buf));
+  ASSERT_EQ(p_a, vec({one, one}));
+  EXPECT_OUTCOME_TRUE(p_b, p_batch->get("b"_buf));
+  ASSERT_EQ(p_b, "x"_buf);
+}
+
+/**
+ * @given a topper batch over a parent batch
+ * @when appending values to a vector of the parent and to an overwritten one
+ * @then the vector of the parent is not read, and the appended values are
+ * forwarded to the parent as appends after the overwriting value
+ */
+TEST(TopperTrieBatchTest, ForwardsAppends) {
+  auto parent = std::make_shared<PersistentTrieBatchMock>();
+  TopperTrieBatchImpl t_batch{parent};
+  auto one = kagome::scale::encode(uint32_t{1}).value();
+  auto two = kagome::scale::encode(uint32_t{2}).value();
+
+  EXPECT_CALL(*parent, get(_)).Times(0);
+  EXPECT_OUTCOME_TRUE_1(t_batch.append("a"_buf, one));
+  EXPECT_OUTCOME_TRUE_1(t_batch.append("a"_buf, two));
+  EXPECT_OUTCOME_TRUE_1(t_batch.put("b"_buf, "x"_buf));
+  EXPECT_OUTCOME_TRUE_1(t_batch.append("b"_buf, one));
+
+  std::vector<std::pair<Buffer, Buffer>> appended;
+  testing::Sequence b_sequence;
+  EXPECT_CALL(*parent, put("b"_buf, "x"_buf))
+      .InSequence(b_sequence)
+      .WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*parent, append(_, _))
+      .Times(3)
+      .InSequence(b_sequence)
+      .WillRepeatedly(
+          Invoke([&](const Buffer &key, gsl::span<const uint8_t> value) {
+            appended.emplace_back(key, Buffer{value});
+            return outcome::success();
+          }));
+  EXPECT_CALL(*parent, put("a"_buf, _)).Times(0);
+  EXPECT_OUTCOME_TRUE_1(t_batch.writeBack());
+  ASSERT_EQ(appended,
+            (std::vector<std::pair<Buffer, Buffer>>{{"a"_buf, Buffer{one}},
+                                                    {"a"_buf, Buffer{two}},
+                                                    {"b"_buf, Buffer{one}}}));
+}
+
+/**
+ * @given a trie with a large value, which was read from it before
+ * @when reading the value with the merkle value of its node from batches at
+ * later states of the trie
+ * @then the value is not read until it is changed, regardless of changes to
+ * other entries
+ */
+TEST_P(TrieBatchTest, GetIfChanged) {
+  auto key = ":code"_buf;
+  Buffer code(1024, 0x42);
+  auto batch = trie->getPersistentBatch().value();
+  FillSmallTrieWithBatch(*batch);
+  EXPECT_OUTCOME_TRUE_1(batch->put(key, code));
+  EXPECT_OUTCOME_TRUE_1(batch->commit());
+
+  Buffer merkle_value;
+  EXPECT_OUTCOME_TRUE(
+      read, trie->getEphemeralBatch().value()->getIfChanged(key, merkle_value));
+  ASSERT_EQ(read, code);
+  ASSERT_FALSE(merkle_value.empty());
+
+  EXPECT_OUTCOME_TRUE_1(batch->put("0a0b0d"_hex2buf, "01"_hex2buf));
+  EXPECT_OUTCOME_TRUE_1(batch->commit());
+  auto known_merkle_value = merkle_value;
+  EXPECT_OUTCOME_TRUE(
+      unchanged,
+      trie->getEphemeralBatch().value()->getIfChanged(key, merkle_value));
+  ASSERT_EQ(unchanged, boost::none);
+  ASSERT_EQ(merkle_value, known_merkle_value);
+
+  code[0] = 0x43;
+  EXPECT_OUTCOME_TRUE_1(batch->put(key, code));
+  EXPECT_OUTCOME_TRUE_1(batch->commit());
+  EXPECT_OUTCOME_TRUE(
+      changed,
+      trie->getEphemeralBatch().value()->getIfChanged(key, merkle_value));
+  ASSERT_EQ(changed, code);
+  ASSERT_NE(merkle_value, known_merkle_value);
+}
+
+INSTANTIATE_TEST_CASE_P(Backends, TrieBatchTest, testing::Bool());
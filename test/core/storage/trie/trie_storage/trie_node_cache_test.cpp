@@ -0,0 +1,92 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "storage/trie/serialization/trie_node_cache.hpp"
+#include "testutil/literals.hpp"
+
+using kagome::common::Buffer;
+using kagome::storage::trie::BranchNode;
+using kagome::storage::trie::DummyNode;
+using kagome::storage::trie::KeyNibbles;
+using kagome::storage::trie::LeafNode;
+using kagome::storage::trie::TrieNodeCache;
+
+/**
+ * @given an empty node cache
+ * @when getting a node from it
+ * @then nullptr is returned and a miss is counted
+ */
+TEST(TrieNodeCacheTest, Miss) {
+  TrieNodeCache cache{2};
+  ASSERT_EQ(cache.get("abc"_buf), nullptr);
+  auto stats = cache.getStats();
+  ASSERT_EQ(stats.misses, 1);
+  ASSERT_EQ(stats.hits, 0);
+  ASSERT_EQ(stats.size, 0);
+}
+
+/**
+ * @given a node cache containing a leaf
+ * @when getting the leaf and modifying the returned node
+ * @then the cached node stays intact
+ */
+TEST(TrieNodeCacheTest, HitReturnsCopy) {
+  TrieNodeCache cache{2};
+  cache.put("abc"_buf, LeafNode{KeyNibbles{1, 2}, "v"_buf});
+
+  auto node = cache.get("abc"_buf);
+  ASSERT_NE(node, nullptr);
+  ASSERT_EQ(node->key_nibbles, (KeyNibbles{1, 2}));
+  ASSERT_EQ(node->value.value(), "v"_buf);
+  node->value = "changed"_buf;
+
+  auto again = cache.get("abc"_buf);
+  ASSERT_EQ(again->value.value(), "v"_buf);
+  ASSERT_EQ(cache.getStats().hits, 2);
+}
+
+/**
+ * @given a node cache containing a branch with dummy children
+ * @when getting the branch
+ * @then its copy keeps the children
+ */
+TEST(TrieNodeCacheTest, Branch) {
+  TrieNodeCache cache{2};
+  BranchNode branch{KeyNibbles{3}, "v"_buf};
+  branch.children.at(5) = std::make_shared<DummyNode>("child"_buf);
+  cache.put("br"_buf, branch);
+
+  auto node = cache.get("br"_buf);
+  ASSERT_NE(node, nullptr);
+  ASSERT_TRUE(node->isBranch());
+  auto copy = std::dynamic_pointer_cast<BranchNode>(node);
+  ASSERT_EQ(copy->childrenBitmap(), branch.childrenBitmap());
+  ASSERT_TRUE(copy->children.at(5)->isDummy());
+}
+
+/**
+ * @given a node cache of capacity 2
+ * @when putting three nodes into it
+ * @then the least recently used one is evicted
+ */
+TEST(TrieNodeCacheTest, EvictsLeastRecentlyUsed) {
+  TrieNodeCache cache{2};
+  cache.put("a"_buf, LeafNode{KeyNibbles{1}, "1"_buf});
+  cache.put("b"_buf, LeafNode{KeyNibbles{2}, "2"_buf});
+  // touch "a", so "b" becomes the least recently used
+  ASSERT_NE(cache.get("a"_buf), nullptr);
+  cache.put("c"_buf, LeafNode{KeyNibbles{3}, "3"_buf});
+
+  ASSERT_EQ(cache.get("b"_buf), nullptr);
+  ASSERT_NE(cache.get("a"_buf), nullptr);
+  ASSERT_NE(cache.get("c"_buf), nullptr);
+  auto stats = cache.getStats();
+  ASSERT_EQ(stats.evictions, 1);
+  ASSERT_EQ(stats.size, 2);
+}
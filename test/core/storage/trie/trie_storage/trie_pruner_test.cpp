@@ -0,0 +1,216 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/impl/trie_pruner_impl.hpp"
+
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+
+#include "storage/in_memory/in_memory_storage.hpp"
+#include "storage/trie/impl/mmap_trie_storage_backend.hpp"
+#include "storage/trie/impl/trie_storage_backend_impl.hpp"
+#include "storage/trie/impl/trie_storage_impl.hpp"
+#include "storage/trie/polkadot_trie/polkadot_trie_factory_impl.hpp"
+#include "storage/trie/serialization/polkadot_codec.hpp"
+#include "storage/trie/serialization/trie_serializer_impl.hpp"
+#include "testutil/literals.hpp"
+#include "testutil/outcome.hpp"
+
+using kagome::common::Buffer;
+using kagome::common::Hash256;
+using kagome::storage::InMemoryStorage;
+using namespace kagome::storage::trie;
+
+/**
+ * Runs against the prefixed key-value storage backend and the memory-mapped
+ * one, as told by the parameter
+ */
+class TriePrunerTest : public testing::TestWithParam<bool> {
+ public:
+  void SetUp() override {
+    auto factory = std::make_shared<PolkadotTrieFactoryImpl>();
+    auto codec = std::make_shared<PolkadotCodec>();
+    if (GetParam()) {
+      node_storage = MmapTrieStorageBackend::create(
+                         mmap_dir, MmapTrieStorageBackend::Config{})
+                         .value();
+    } else {
+      node_storage = std::make_shared<TrieStorageBackendImpl>(
+          std::make_shared<InMemoryStorage>(), kNodePrefix);
+    }
+    serializer =
+        std::make_shared<TrieSerializerImpl>(factory, codec, node_storage);
+    pruner = std::make_shared<TriePrunerImpl>(
+        node_storage,
+        std::make_shared<TrieStorageBackendImpl>(refcount_db, kNodePrefix),
+        codec);
+    trie = TrieStorageImpl::createEmpty(
+               factory, codec, serializer, boost::none, pruner)
+               .value();
+  }
+
+  void TearDown() override {
+    node_storage.reset();
+    boost::filesystem::remove_all(mmap_dir);
+  }
+
+  /**
+   * Commits a state derived from the one with root {@param parent_root},
+   * putting {@param count} values starting with {@param first} key
+   * @return root of the committed state
+   */
+  Buffer commitState(const Buffer &parent_root, uint8_t first, uint8_t count) {
+    auto batch =
+        trie->getPersistentBatchAt(Hash256::fromSpan(parent_root).value())
+            .value();
+    for (uint8_t i = first; i < first + count; i++) {
+      EXPECT_OUTCOME_TRUE_1(batch->put(Buffer{i, 0x42}, Buffer(40, i)));
+    }
+    return batch->commit().value();
+  }
+
+  /**
+   * Checks that all {@param count} values starting with {@param first} key
+   * are readable from the state with root {@param root}
+   */
+  void checkState(const Buffer &root, uint8_t first, uint8_t count) {
+    auto batch =
+        trie->getEphemeralBatchAt(Hash256::fromSpan(root).value()).value();
+    for (uint8_t i = first; i < first + count; i++) {
+      EXPECT_OUTCOME_TRUE(value, batch->get(Buffer{i, 0x42}));
+      ASSERT_EQ(value, Buffer(40, i));
+    }
+  }
+
+  /**
+   * Commits {@param count} values starting with zero key without
+   * registering the state in the pruner, as it was before the pruning
+   * @return root of the committed state
+   */
+  Buffer commitUntrackedState(uint8_t count) {
+    auto factory = std::make_shared<PolkadotTrieFactoryImpl>();
+    auto codec = std::make_shared<PolkadotCodec>();
+    auto untracked_trie =
+        TrieStorageImpl::createEmpty(factory, codec, serializer, boost::none)
+            .value();
+    auto batch = untracked_trie->getPersistentBatch().value();
+    for (uint8_t i = 0; i < count; i++) {
+      EXPECT_OUTCOME_TRUE_1(batch->put(Buffer{i, 0x42}, Buffer(40, i)));
+    }
+    return batch->commit().value();
+  }
+
+  bool isStored(const Buffer &db_key) const {
+    return node_storage->contains(db_key);
+  }
+
+  static const Buffer kNodePrefix;
+
+  boost::filesystem::path mmap_dir = boost::filesystem::temp_directory_path()
+                                     / boost::filesystem::unique_path();
+  std::shared_ptr<TrieStorageBackend> node_storage;
+  std::shared_ptr<InMemoryStorage> refcount_db =
+      std::make_shared<InMemoryStorage>();
+  std::shared_ptr<TrieSerializer> serializer;
+  std::shared_ptr<TriePruner> pruner;
+  std::unique_ptr<TrieStorage> trie;
+};
+
+const Buffer TriePrunerTest::kNodePrefix = "\1"_buf;
+
+/**
+ * @given a state and two states on different forks derived from it
+ * @when pruning the states one by one
+ * @then the remaining states stay intact, and the storage is empty after all
+ * of them are pruned
+ */
+TEST_P(TriePrunerTest, PruneForks) {
+  auto empty_root = serializer->getEmptyRootHash();
+  auto root = commitState(empty_root, 0, 64);
+  auto fork1 = commitState(root, 60, 8);
+  auto fork2 = commitState(root, 62, 8);
+
+  EXPECT_OUTCOME_TRUE_1(pruner->pruneState(fork2));
+  ASSERT_FALSE(isStored(fork2));
+  checkState(root, 0, 64);
+  checkState(fork1, 0, 68);
+
+  EXPECT_OUTCOME_TRUE_1(pruner->pruneState(root));
+  ASSERT_FALSE(isStored(root));
+  checkState(fork1, 0, 68);
+
+  EXPECT_OUTCOME_TRUE_1(pruner->pruneState(fork1));
+  ASSERT_TRUE(node_storage->empty());
+  ASSERT_TRUE(refcount_db->empty());
+}
+
+/**
+ * @given a state committed twice
+ * @when pruning it once
+ * @then the state stays intact
+ */
+TEST_P(TriePrunerTest, StateCommittedTwice) {
+  auto empty_root = serializer->getEmptyRootHash();
+  auto root = commitState(empty_root, 0, 16);
+  ASSERT_EQ(commitState(empty_root, 0, 16), root);
+
+  EXPECT_OUTCOME_TRUE_1(pruner->pruneState(root));
+  checkState(root, 0, 16);
+
+  EXPECT_OUTCOME_TRUE_1(pruner->pruneState(root));
+  ASSERT_TRUE(node_storage->empty());
+}
+
+/**
+ * @given a state stored without being registered in the pruner
+ * @when pruning it
+ * @then it stays intact
+ */
+TEST_P(TriePrunerTest, UntrackedState) {
+  auto root = commitUntrackedState(16);
+
+  EXPECT_OUTCOME_TRUE_1(pruner->pruneState(root));
+  checkState(root, 0, 16);
+  ASSERT_TRUE(refcount_db->empty());
+}
+
+/**
+ * @given a state stored without being registered in the pruner, which is
+ * registered as an existing one afterwards
+ * @when pruning a state derived from it, which shares most of its nodes
+ * @then the registered state stays intact, and the storage is empty after it
+ * is pruned too
+ */
+TEST_P(TriePrunerTest, ExistingStateSharedWithDerived) {
+  auto root = commitUntrackedState(16);
+  EXPECT_OUTCOME_TRUE_1(pruner->addExistingState(root));
+
+  auto derived = commitState(root, 15, 2);
+  checkState(derived, 0, 17);
+  EXPECT_OUTCOME_TRUE_1(pruner->pruneState(derived));
+  ASSERT_FALSE(isStored(derived));
+  checkState(root, 0, 16);
+
+  EXPECT_OUTCOME_TRUE_1(pruner->pruneState(root));
+  ASSERT_TRUE(node_storage->empty());
+  ASSERT_TRUE(refcount_db->empty());
+}
+
+/**
+ * @given a state registered when it was committed
+ * @when registering it as an existing one
+ * @then it is not counted again, so that pruning it once removes it
+ */
+TEST_P(TriePrunerTest, ExistingStateRegisteredOnce) {
+  auto empty_root = serializer->getEmptyRootHash();
+  auto root = commitState(empty_root, 0, 16);
+  EXPECT_OUTCOME_TRUE_1(pruner->addExistingState(root));
+
+  EXPECT_OUTCOME_TRUE_1(pruner->pruneState(root));
+  ASSERT_TRUE(node_storage->empty());
+  ASSERT_TRUE(refcount_db->empty());
+}
+
+INSTANTIATE_TEST_CASE_P(Backends, TriePrunerTest, testing::Bool());
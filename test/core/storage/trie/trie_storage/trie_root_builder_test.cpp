@@ -0,0 +1,100 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/serialization/trie_root_builder.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "storage/trie/polkadot_trie/polkadot_trie_impl.hpp"
+#include "storage/trie/serialization/ordered_trie_hash.hpp"
+#include "testutil/literals.hpp"
+#include "testutil/outcome.hpp"
+
+using kagome::common::Buffer;
+using kagome::common::Hash256;
+using kagome::storage::trie::calculateOrderedTrieHash;
+using kagome::storage::trie::PolkadotCodec;
+using kagome::storage::trie::PolkadotTrieImpl;
+using kagome::storage::trie::TrieRootBuilder;
+
+namespace {
+  /**
+   * Root of the trie with the entries, constructed node by node
+   */
+  Hash256 trieRoot(const std::vector<std::pair<Buffer, Buffer>> &entries) {
+    PolkadotTrieImpl trie;
+    PolkadotCodec codec;
+    for (auto &[key, value] : entries) {
+      EXPECT_OUTCOME_TRUE_1(trie.put(key, value));
+    }
+    if (trie.getRoot() == nullptr) {
+      return codec.hash256({0});
+    }
+    return codec.hash256(codec.encodeNode(*trie.getRoot()).value());
+  }
+
+  Hash256 builderRoot(const std::vector<std::pair<Buffer, Buffer>> &entries) {
+    TrieRootBuilder builder;
+    for (auto &[key, value] : entries) {
+      builder.add(key, value);
+    }
+    return builder.calculateRoot().value();
+  }
+}  // namespace
+
+/**
+ * @given entries, which keys are prefixes of each other, have long common
+ * prefixes, repeat or are empty, added in an arbitrary order
+ * @when calculating the root with the builder
+ * @then it is the root of the trie with the entries
+ */
+TEST(TrieRootBuilderTest, MatchesTrie) {
+  std::vector<std::pair<Buffer, Buffer>> entries{
+      {"abc"_buf, "1"_buf},
+      {"ab"_buf, "2"_buf},
+      {""_buf, "3"_buf},
+      {"abd"_buf, Buffer(40, 4)},
+      {Buffer(40, 0xab), "5"_buf},
+      {Buffer(40, 0xab).put("c"), ""_buf},
+      {"b"_buf, "6"_buf},
+      {"ab"_buf, "7"_buf},
+  };
+  ASSERT_EQ(builderRoot({}), trieRoot({}));
+  ASSERT_EQ(builderRoot({entries[0]}), trieRoot({entries[0]}));
+  ASSERT_EQ(builderRoot(entries), trieRoot(entries));
+
+  std::mt19937 random{42};
+  std::uniform_int_distribution<size_t> size{0, 8};
+  std::uniform_int_distribution<uint8_t> byte{0, 3};
+  for (auto i = 0; i < 100; i++) {
+    std::vector<std::pair<Buffer, Buffer>> random_entries(size(random) * 4);
+    for (auto &[key, value] : random_entries) {
+      key.resize(size(random));
+      std::generate(key.begin(), key.end(), [&] { return byte(random); });
+      value = Buffer(size(random) * 5, byte(random));
+    }
+    ASSERT_EQ(builderRoot(random_entries), trieRoot(random_entries));
+  }
+}
+
+/**
+ * @given a number of values, which keys take one and two bytes when encoded
+ * @when calculating their ordered trie hash
+ * @then it is the root of the trie with the values by their encoded indices
+ */
+TEST(TrieRootBuilderTest, OrderedTrieHash) {
+  std::vector<Buffer> values;
+  std::vector<std::pair<Buffer, Buffer>> entries;
+  for (uint32_t i = 0; i < 200; i++) {
+    values.emplace_back(kagome::scale::encode(i).value());
+    entries.emplace_back(
+        Buffer{kagome::scale::encode(kagome::scale::CompactInteger{i}).value()},
+        values.back());
+  }
+  EXPECT_OUTCOME_TRUE(hash, calculateOrderedTrieHash(values.begin(), values.end()));
+  ASSERT_EQ(hash, Buffer{trieRoot(entries)});
+}
@@ -0,0 +1,116 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/serialization/trie_serializer_impl.hpp"
+
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+
+#include "storage/in_memory/in_memory_storage.hpp"
+#include "storage/trie/impl/mmap_trie_storage_backend.hpp"
+#include "storage/trie/impl/trie_storage_backend_impl.hpp"
+#include "storage/trie/impl/trie_storage_impl.hpp"
+#include "storage/trie/polkadot_trie/polkadot_trie_factory_impl.hpp"
+#include "storage/trie/serialization/polkadot_codec.hpp"
+#include "testutil/literals.hpp"
+#include "testutil/outcome.hpp"
+
+using kagome::common::Buffer;
+using kagome::common::Hash256;
+using kagome::storage::InMemoryStorage;
+using namespace kagome::storage::trie;
+
+/**
+ * Runs against the prefixed key-value storage backend and the memory-mapped
+ * one, as told by the parameter
+ */
+class TrieSerializerTest : public testing::TestWithParam<bool> {
+ public:
+  void TearDown() override {
+    boost::filesystem::remove_all(mmap_dir);
+  }
+
+  std::unique_ptr<TrieStorage> createStorage(
+      std::shared_ptr<TrieHashingPool> pool) {
+    std::shared_ptr<TrieStorageBackend> backend;
+    if (GetParam()) {
+      backend = MmapTrieStorageBackend::create(
+                    mmap_dir / std::to_string(storages++),
+                    MmapTrieStorageBackend::Config{})
+                    .value();
+    } else {
+      backend = std::make_shared<TrieStorageBackendImpl>(
+          std::make_shared<InMemoryStorage>(), "\1"_buf);
+    }
+    auto serializer = std::make_shared<TrieSerializerImpl>(
+        factory, codec, backend, nullptr, std::move(pool));
+    return TrieStorageImpl::createEmpty(factory, codec, serializer, boost::none)
+        .value();
+  }
+
+  /**
+   * Puts {@param count} values, derived from {@param seed}, to the state
+   * with root {@param root}
+   * @return root of the committed state
+   */
+  Buffer commit(TrieStorage &storage,
+                const Buffer &root,
+                uint32_t count,
+                uint8_t seed) {
+    auto batch =
+        storage.getPersistentBatchAt(Hash256::fromSpan(root).value()).value();
+    for (uint32_t i = 0; i < count; i++) {
+      EXPECT_OUTCOME_TRUE_1(batch->put(key(i), Buffer(8, seed).putUint32(i)));
+    }
+    return batch->commit().value();
+  }
+
+  static Buffer key(uint32_t i) {
+    // spread the keys over the trie like hashed keys would be
+    return Buffer{codec->hash256(Buffer{}.putUint32(i))}.subbuffer(0, 8);
+  }
+
+  std::shared_ptr<PolkadotTrieFactory> factory =
+      std::make_shared<PolkadotTrieFactoryImpl>();
+  static std::shared_ptr<Codec> codec;
+  boost::filesystem::path mmap_dir = "/tmp/kagome_mmap_trie_serializer_test";
+  size_t storages = 0;
+};
+
+std::shared_ptr<Codec> TrieSerializerTest::codec =
+    std::make_shared<PolkadotCodec>();
+
+/**
+ * @given a storage storing tries sequentially and one storing large tries in
+ * parallel
+ * @when committing the same changes to both of them, large and small ones
+ * @then the resulting states are the same
+ */
+TEST_P(TrieSerializerTest, ParallelStoreMatchesSequential) {
+  auto sequential = createStorage(nullptr);
+  auto parallel = createStorage(std::make_shared<TrieHashingPool>(4, 64));
+  auto empty_root = Buffer{codec->hash256({0})};
+
+  auto root = commit(*sequential, empty_root, 2000, 1);
+  ASSERT_EQ(commit(*parallel, empty_root, 2000, 1), root);
+
+  // below the threshold
+  auto small_root = commit(*sequential, root, 10, 2);
+  ASSERT_EQ(commit(*parallel, root, 10, 2), small_root);
+
+  // above the threshold, partially stored already
+  auto large_root = commit(*sequential, small_root, 500, 3);
+  ASSERT_EQ(commit(*parallel, small_root, 500, 3), large_root);
+
+  auto batch =
+      parallel->getEphemeralBatchAt(Hash256::fromSpan(large_root).value())
+          .value();
+  for (uint32_t i = 0; i < 2000; i++) {
+    EXPECT_OUTCOME_TRUE(value, batch->get(key(i)));
+    ASSERT_EQ(value, Buffer(8, i < 500 ? 3 : 1).putUint32(i));
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(Backends, TrieSerializerTest, testing::Bool());
@@ -0,0 +1,103 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/impl/trie_storage_migration.hpp"
+
+#include <gtest/gtest.h>
+
+#include <boost/filesystem/operations.hpp>
+
+#include "storage/in_memory/in_memory_storage.hpp"
+#include "storage/trie/impl/mmap_trie_storage_backend.hpp"
+#include "storage/trie/impl/trie_storage_backend_impl.hpp"
+#include "testutil/outcome.hpp"
+#include "testutil/storage/base_leveldb_test.hpp"
+
+using kagome::common::Buffer;
+using kagome::storage::InMemoryStorage;
+using kagome::storage::trie::kMigrationBatchSize;
+using kagome::storage::trie::MmapTrieStorageBackend;
+using kagome::storage::trie::TrieStorageBackendImpl;
+using kagome::storage::trie::moveEntriesByPrefix;
+
+class TrieStorageMigrationTest : public test::BaseLevelDB_Test {
+ public:
+  TrieStorageMigrationTest()
+      : BaseLevelDB_Test("/tmp/kagome_trie_storage_migration_test") {}
+
+  static Buffer key(uint8_t prefix, uint32_t i) {
+    return Buffer{prefix}.putUint32(i);
+  }
+};
+
+/**
+ * @given a database with entries of several prefixes, more than fit in a
+ * batch
+ * @when moving the entries of one of the prefixes to another storage
+ * @then they are in the target by the keys without the prefix and not in the
+ * source, while the others are kept, and moving them again finds none
+ */
+TEST_F(TrieStorageMigrationTest, MovesPrefixedEntries) {
+  const uint32_t count = kMigrationBatchSize + 10;
+  for (uint32_t i = 0; i < count; i++) {
+    EXPECT_OUTCOME_TRUE_1(db_->put(key(7, i), Buffer{}.putUint32(i)));
+  }
+  EXPECT_OUTCOME_TRUE_1(db_->put(key(6, 0), Buffer{6}));
+  EXPECT_OUTCOME_TRUE_1(db_->put(key(8, 0), Buffer{8}));
+  InMemoryStorage target;
+
+  EXPECT_OUTCOME_TRUE(moved, moveEntriesByPrefix(*db_, Buffer{7}, target));
+
+  ASSERT_EQ(moved, count);
+  for (uint32_t i = 0; i < count; i++) {
+    ASSERT_FALSE(db_->contains(key(7, i)));
+    EXPECT_OUTCOME_TRUE(value, target.get(Buffer{}.putUint32(i)));
+    ASSERT_EQ(value, Buffer{}.putUint32(i));
+  }
+  ASSERT_TRUE(db_->contains(key(6, 0)));
+  ASSERT_TRUE(db_->contains(key(8, 0)));
+  EXPECT_OUTCOME_TRUE(moved_again,
+                      moveEntriesByPrefix(*db_, Buffer{7}, target));
+  ASSERT_EQ(moved_again, 0);
+}
+
+/**
+ * @given trie nodes kept by the leveldb backend
+ * @when moving them to the mmap backend and back, as switching the backend
+ * of an existing database does
+ * @then every node is in the chosen backend and none is left in the other
+ */
+TEST_F(TrieStorageMigrationTest, MovesNodesBetweenBackends) {
+  const boost::filesystem::path mmap_path =
+      "/tmp/kagome_trie_storage_migration_test_nodes";
+  boost::filesystem::remove_all(mmap_path);
+  MmapTrieStorageBackend::Config config;
+  config.background_compaction = false;
+  EXPECT_OUTCOME_TRUE(mmap, MmapTrieStorageBackend::create(mmap_path, config));
+  TrieStorageBackendImpl leveldb_backend{db_, Buffer{7}};
+  const uint32_t count = 100;
+  for (uint32_t i = 0; i < count; i++) {
+    EXPECT_OUTCOME_TRUE_1(db_->put(key(7, i), Buffer{}.putUint32(i)));
+  }
+
+  EXPECT_OUTCOME_TRUE(to_mmap, moveEntriesByPrefix(*db_, Buffer{7}, *mmap));
+  ASSERT_EQ(to_mmap, count);
+  for (uint32_t i = 0; i < count; i++) {
+    ASSERT_FALSE(leveldb_backend.contains(Buffer{}.putUint32(i)));
+    EXPECT_OUTCOME_TRUE(value, mmap->get(Buffer{}.putUint32(i)));
+    ASSERT_EQ(value, Buffer{}.putUint32(i));
+  }
+
+  EXPECT_OUTCOME_TRUE(to_leveldb,
+                      moveEntriesByPrefix(*mmap, Buffer{}, leveldb_backend));
+  ASSERT_EQ(to_leveldb, count);
+  for (uint32_t i = 0; i < count; i++) {
+    ASSERT_FALSE(mmap->contains(Buffer{}.putUint32(i)));
+    EXPECT_OUTCOME_TRUE(value, leveldb_backend.get(Buffer{}.putUint32(i)));
+    ASSERT_EQ(value, Buffer{}.putUint32(i));
+  }
+  mmap.reset();
+  boost::filesystem::remove_all(mmap_path);
+}
@@ -10,6 +10,7 @@
 
 #include "outcome/outcome.hpp"
 #include "storage/leveldb/leveldb.hpp"
+#include "storage/trie/impl/mmap_trie_storage_backend.hpp"
 #include "storage/trie/impl/trie_storage_backend_impl.hpp"
 #include "storage/trie/polkadot_trie/polkadot_trie_factory_impl.hpp"
 #include "storage/trie/serialization/polkadot_codec.hpp"
@@ -21,9 +22,11 @@
 using kagome::common::Buffer;
 using kagome::primitives::BlockHash;
 using kagome::storage::LevelDB;
+using kagome::storage::trie::MmapTrieStorageBackend;
 using kagome::storage::trie::PolkadotCodec;
 using kagome::storage::trie::PolkadotTrieFactoryImpl;
 using kagome::storage::trie::TrieSerializerImpl;
+using kagome::storage::trie::TrieStorageBackend;
 using kagome::storage::trie::TrieStorageBackendImpl;
 using kagome::storage::trie::TrieStorageImpl;
 using kagome::subscription::SubscriptionEngine;
@@ -31,26 +34,47 @@ using kagome::subscription::SubscriptionEngine;
 static Buffer kNodePrefix = "\1"_buf;
 
 /**
- * @given an empty persistent trie with LevelDb backend
+ * Runs against the LevelDB backend and the memory-mapped one, as told by the
+ * parameter
+ */
+class TriePersistencyTest : public testing::TestWithParam<bool> {
+ public:
+  void TearDown() override {
+    boost::filesystem::remove_all(kPath);
+  }
+
+  /**
+   * Opens the storage of trie nodes, creating it if needed
+   */
+  std::shared_ptr<TrieStorageBackend> openBackend() {
+    if (GetParam()) {
+      return MmapTrieStorageBackend::create(kPath,
+                                            MmapTrieStorageBackend::Config{})
+          .value();
+    }
+    leveldb::Options options;
+    options.create_if_missing = true;  // intentionally
+    EXPECT_OUTCOME_TRUE(level_db, LevelDB::create(kPath, options));
+    return std::make_shared<TrieStorageBackendImpl>(std::move(level_db),
+                                                    kNodePrefix);
+  }
+
+  static constexpr auto kPath = "/tmp/kagome_leveldb_persistency_test";
+};
+
+/**
+ * @given an empty persistent trie
  * @when putting a value into it @and its intance is destroyed @and a new
  * instance initialsed with the same DB
  * @then the new instance contains the same data
  */
-TEST(TriePersistencyTest, CreateDestroyCreate) {
+TEST_P(TriePersistencyTest, CreateDestroyCreate) {
   Buffer root;
   auto factory = std::make_shared<PolkadotTrieFactoryImpl>();
   auto codec = std::make_shared<PolkadotCodec>();
   {
-    leveldb::Options options;
-    options.create_if_missing = true;  // intentionally
-    EXPECT_OUTCOME_TRUE(
-        level_db,
-        LevelDB::create("/tmp/kagome_leveldb_persistency_test", options));
-    auto serializer = std::make_shared<TrieSerializerImpl>(
-        factory,
-        codec,
-        std::make_shared<TrieStorageBackendImpl>(std::move(level_db),
-                                                 kNodePrefix));
+    auto serializer =
+        std::make_shared<TrieSerializerImpl>(factory, codec, openBackend());
 
     auto storage =
         TrieStorageImpl::createEmpty(factory, codec, serializer, boost::none)
@@ -63,13 +87,8 @@ TEST(TriePersistencyTest, CreateDestroyCreate) {
     EXPECT_OUTCOME_TRUE(root_, batch->commit());
     root = root_;
   }
-  EXPECT_OUTCOME_TRUE(new_level_db,
-                      LevelDB::create("/tmp/kagome_leveldb_persistency_test"));
-  auto serializer = std::make_shared<TrieSerializerImpl>(
-      factory,
-      codec,
-      std::make_shared<TrieStorageBackendImpl>(std::move(new_level_db),
-                                               kNodePrefix));
+  auto serializer =
+      std::make_shared<TrieSerializerImpl>(factory, codec, openBackend());
   auto storage =
       TrieStorageImpl::createFromStorage(root, codec, serializer, boost::none)
           .value();
@@ -80,6 +99,6 @@ TEST(TriePersistencyTest, CreateDestroyCreate) {
   ASSERT_EQ(v2, "def"_buf);
   EXPECT_OUTCOME_TRUE(v3, batch->get("678"_buf));
   ASSERT_EQ(v3, "xyz"_buf);
-
-  boost::filesystem::remove_all("/tmp/kagome_leveldb_persistency_test");
 }
+
+INSTANTIATE_TEST_CASE_P(Backends, TriePersistencyTest, testing::Bool());
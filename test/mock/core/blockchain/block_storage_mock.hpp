@@ -38,6 +38,14 @@ namespace kagome::blockchain {
                        outcome::result<primitives::Justification>(
                            const primitives::BlockId &));
 
+    MOCK_CONST_METHOD1(
+        getEncodedBlockHeader,
+        outcome::result<common::Buffer>(const primitives::BlockId &));
+
+    MOCK_CONST_METHOD1(
+        getEncodedBlockData,
+        outcome::result<common::Buffer>(const primitives::BlockId &));
+
     MOCK_METHOD1(putBlockHeader,
                  outcome::result<primitives::BlockHash>(
                      const primitives::BlockHeader &header));
@@ -16,7 +16,7 @@ namespace kagome::consensus {
    public:
     MOCK_METHOD4(request,
                  void(const primitives::BlockId &,
-                      const primitives::BlockHash &,
+                      const primitives::BlockInfo &,
                       primitives::AuthorityIndex,
                       const BlocksHandler &));
   };
@@ -16,13 +16,14 @@ namespace kagome::crypto {
    public:
     Ed25519Keypair;
     Ed25519Keypair;
-    MOCK_CONST_METHOD2(sign,
-                       outcome::result<Ed25519Signature>(const Ed25519Keypair &,
-                                                         gsl::span<uint8_t>));
+    MOCK_CONST_METHOD2(
+        sign,
+        outcome::result<Ed25519Signature>(const Ed25519Keypair &,
+                                          gsl::span<const uint8_t>));
     MOCK_CONST_METHOD3(
         verify,
         outcome::result<bool>(const Ed25519Signature &signature,
-                              gsl::span<uint8_t> message,
+                              gsl::span<const uint8_t> message,
                               const Ed25519PublicKey &public_key));
   };
 
@@ -0,0 +1,40 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_TEST_MOCK_CORE_RUNTIME_BINARYEN_WASM_MODULE_MOCK
+#define KAGOME_TEST_MOCK_CORE_RUNTIME_BINARYEN_WASM_MODULE_MOCK
+
+#include "runtime/binaryen/module/wasm_module.hpp"
+
+#include <gmock/gmock.h>
+
+namespace kagome::runtime::binaryen {
+
+  class WasmModuleMock : public WasmModule {
+   public:
+    std::unique_ptr<WasmModuleInstance> instantiate(
+        const std::shared_ptr<RuntimeExternalInterface> &externalInterface)
+        const override {
+      return std::unique_ptr<WasmModuleInstance>(
+          instantiateProxy(externalInterface));
+    }
+
+    // gmock cannot return move-only types
+    MOCK_CONST_METHOD1(
+        instantiateProxy,
+        WasmModuleInstance *(const std::shared_ptr<RuntimeExternalInterface> &));
+  };
+
+  class WasmModuleInstanceMock : public WasmModuleInstance {
+   public:
+    MOCK_METHOD2(callExport,
+                 wasm::Literal(wasm::Name name,
+                               const std::vector<wasm::Literal> &arguments));
+    MOCK_METHOD0(reset, void());
+  };
+
+}  // namespace kagome::runtime::binaryen
+
+#endif  // KAGOME_TEST_MOCK_CORE_RUNTIME_BINARYEN_WASM_MODULE_MOCK
@@ -14,6 +14,8 @@ namespace kagome::runtime {
 
   class TrieStorageProviderMock : public TrieStorageProvider {
    public:
+    MOCK_CONST_METHOD0(createThreadProvider,
+                       std::shared_ptr<TrieStorageProvider>());
     MOCK_METHOD0(setToEphemeral, outcome::result<void>());
     MOCK_METHOD1(setToEphemeralAt,
                  outcome::result<void>(const common::Hash256 &));
@@ -25,6 +27,8 @@ namespace kagome::runtime {
                        boost::optional<std::shared_ptr<PersistentBatch>>());
     MOCK_CONST_METHOD0(isCurrentlyPersistent, bool());
     MOCK_METHOD0(forceCommit, outcome::result<common::Buffer>());
+    MOCK_CONST_METHOD0(calculatePersistentRoot,
+                       outcome::result<common::Buffer>());
     MOCK_METHOD0(startTransaction, outcome::result<void>());
     MOCK_METHOD0(rollbackTransaction, outcome::result<void>());
     MOCK_METHOD0(commitTransaction, outcome::result<void>());
@@ -14,7 +14,7 @@ namespace kagome::runtime {
 
   class WasmProviderMock: public WasmProvider {
    public:
-    MOCK_CONST_METHOD0(getStateCode, const common::Buffer &());
+    MOCK_CONST_METHOD0(getStateCodeAndHash, StateCode());
   };
 
 }
@@ -37,6 +37,10 @@ namespace kagome::storage::trie {
 
     MOCK_METHOD1(clearPrefix, outcome::result<void>(const common::Buffer &buf));
 
+    MOCK_METHOD2(append,
+                 outcome::result<void>(const common::Buffer &,
+                                       gsl::span<const uint8_t>));
+
     MOCK_CONST_METHOD0(empty, bool());
 
     MOCK_METHOD0(commit, outcome::result<Buffer>());
@@ -49,6 +53,10 @@ namespace kagome::storage::trie {
     MOCK_CONST_METHOD1(get,
                        outcome::result<common::Buffer>(const common::Buffer &));
 
+    MOCK_CONST_METHOD2(getIfChanged,
+                       outcome::result<boost::optional<common::Buffer>>(
+                           const common::Buffer &, common::Buffer &));
+
     // issue with gmock when mocks cannot return unique_ptr. Resolved as in
     // https://stackoverflow.com/a/11548191
     MOCK_METHOD0(trieCursorProxy, PolkadotTrieCursor *());
@@ -72,6 +80,10 @@ namespace kagome::storage::trie {
 
     MOCK_METHOD1(clearPrefix, outcome::result<void>(const common::Buffer &buf));
 
+    MOCK_METHOD2(append,
+                 outcome::result<void>(const common::Buffer &,
+                                       gsl::span<const uint8_t>));
+
     MOCK_CONST_METHOD0(empty, bool());
   };
 
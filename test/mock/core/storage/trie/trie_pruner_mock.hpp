@@ -0,0 +1,27 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_TEST_MOCK_CORE_STORAGE_TRIE_TRIE_PRUNER_MOCK
+#define KAGOME_TEST_MOCK_CORE_STORAGE_TRIE_TRIE_PRUNER_MOCK
+
+#include <gmock/gmock.h>
+
+#include "storage/trie/trie_pruner.hpp"
+
+namespace kagome::storage::trie {
+
+  class TriePrunerMock : public TriePruner {
+   public:
+    MOCK_METHOD1(addState,
+                 outcome::result<void>(const common::Buffer &state_root));
+    MOCK_METHOD1(addExistingState,
+                 outcome::result<void>(const common::Buffer &state_root));
+    MOCK_METHOD1(pruneState,
+                 outcome::result<void>(const common::Buffer &state_root));
+  };
+
+}  // namespace kagome::storage::trie
+
+#endif  // KAGOME_TEST_MOCK_CORE_STORAGE_TRIE_TRIE_PRUNER_MOCK
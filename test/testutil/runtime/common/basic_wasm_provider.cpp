@@ -7,6 +7,8 @@
 
 #include <fstream>
 
+#include "crypto/twox/twox.hpp"
+
 namespace kagome::runtime {
   using kagome::common::Buffer;
 
@@ -14,8 +16,8 @@ namespace kagome::runtime {
     initialize(path);
   }
 
-  const Buffer &BasicWasmProvider::getStateCode() const {
-    return buffer_;
+  WasmProvider::StateCode BasicWasmProvider::getStateCodeAndHash() const {
+    return code_;
   }
 
   void BasicWasmProvider::initialize(std::string_view path) {
@@ -28,6 +30,7 @@ namespace kagome::runtime {
     kagome::common::Buffer buffer(size, 0);
     // read whole file to the buffer
     ifd.read((char *)buffer.data(), size);  // NOLINT
-    buffer_ = std::move(buffer);
+    code_.hash = crypto::make_twox256(buffer);
+    code_.code = std::make_shared<const Buffer>(std::move(buffer));
   }
 }  // namespace kagome::runtime
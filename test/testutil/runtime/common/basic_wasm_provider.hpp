@@ -16,12 +16,12 @@ namespace kagome::runtime {
 
     ~BasicWasmProvider() override = default;
 
-    const kagome::common::Buffer &getStateCode() const override;
+    StateCode getStateCodeAndHash() const override;
 
    private:
     void initialize(std::string_view path);
 
-    kagome::common::Buffer buffer_;
+    StateCode code_;
   };
 
 }  // namespace kagome::runtime